@@ -6,15 +6,28 @@ use llama_cpp_2::llama_batch::LlamaBatch;
 use llama_cpp_2::model::params::LlamaModelParams;
 use llama_cpp_2::model::{AddBos, LlamaModel};
 use llama_cpp_2::sampling::LlamaSampler;
+use llama_cpp_2::token::LlamaToken;
 use serde::{Deserialize, Serialize};
 use std::num::NonZeroU32;
+use std::ops::Range;
 use std::path::Path;
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, OnceLock};
 
 const GHOST_SAMPLER_SEED: u32 = 0x5C71_7ABB;
 const RAW_OUTPUT_BYTE_CAP: usize = 160;
-const EMBED_CTX_TOKENS: u32 = 2048;
+/// Token budget of one packed embedding decode.
+const EMBED_BATCH_TOKENS: u32 = 4096;
+/// Texts packed into one decode.
+const EMBED_MAX_SEQUENCES: u32 = 8;
+/// KV cells each packed sequence gets. llama.cpp splits a context's cells
+/// evenly across its `n_seq_max` sequences, so this, not the decode budget,
+/// bounds the longest text a packed decode can hold; it fits a brain chunk.
+const EMBED_SEQ_TOKENS: u32 = 1024;
+/// Context size for decoding a single text.
+const EMBED_SINGLE_CTX_TOKENS: u32 = 2048;
+/// Longer inputs are truncated.
+const EMBED_MAX_TEXT_TOKENS: usize = EMBED_SINGLE_CTX_TOKENS as usize - 8;
 
 #[derive(Clone, Copy, Debug, PartialEq, Serialize, Deserialize)]
 pub(crate) struct GhostSamplingParams {
@@ -33,10 +46,18 @@ pub(crate) struct GhostSamplingParams {
 /// L2-normalized sentence embeddings. Kept separate from [`LoadedLocalLlm`]
 /// so the brain's embedder and the ghost-text generator can coexist without
 /// evicting each other.
+///
+/// Texts are packed into one decode per [`EMBED_BATCH_TOKENS`] budget, each on
+/// its own sequence id, and the pooled embedding of every sequence is read
+/// back. The contexts are created once and reused across requests.
 pub(crate) struct LoadedEmbedder {
     model_id: String,
+    // The contexts borrow `model`; they are declared first so they drop first.
+    packed_ctx: Option<LlamaContext<'static>>,
+    single_ctx: Option<LlamaContext<'static>>,
+    batch: LlamaBatch,
     backend: &'static LlamaBackend,
-    model: LlamaModel,
+    model: Box<LlamaModel>,
 }
 
 impl LoadedEmbedder {
@@ -49,8 +70,11 @@ impl LoadedEmbedder {
             .with_context(|| format!("load embedding gguf {}", model_path.display()))?;
         Ok(Self {
             model_id: model_id.to_string(),
+            packed_ctx: None,
+            single_ctx: None,
+            batch: LlamaBatch::new(EMBED_BATCH_TOKENS as usize, 1),
             backend,
-            model,
+            model: Box::new(model),
         })
     }
 
@@ -58,45 +82,167 @@ impl LoadedEmbedder {
         &self.model_id
     }
 
-    pub(crate) fn embed_texts(&self, texts: &[String]) -> Result<Vec<Vec<f32>>> {
-        let ctx_params = LlamaContextParams::default()
-            .with_n_ctx(NonZeroU32::new(EMBED_CTX_TOKENS))
-            .with_n_batch(EMBED_CTX_TOKENS)
-            .with_n_ubatch(EMBED_CTX_TOKENS)
-            .with_embeddings(true)
-            .with_pooling_type(LlamaPoolingType::Mean);
-        let mut ctx: LlamaContext<'_> = self
-            .model
-            .new_context(self.backend, ctx_params)
-            .context("create embedding context")?;
-        let max_tokens = (EMBED_CTX_TOKENS as usize).saturating_sub(8).max(1);
-        let mut out = Vec::with_capacity(texts.len());
-        for text in texts {
+    /// Embed `texts`, calling `between_groups` after each packed decode
+    /// group that is followed by another, so urgent work can run in between.
+    pub(crate) fn embed_texts(
+        &mut self,
+        texts: &[String],
+        mut between_groups: impl FnMut(&mut Self),
+    ) -> Result<Vec<Vec<f32>>> {
+        let mut out = vec![Vec::new(); texts.len()];
+        let mut sequences = Vec::with_capacity(texts.len());
+        for (index, text) in texts.iter().enumerate() {
             let mut tokens = self
                 .model
                 .str_to_token(text, AddBos::Always)
                 .context("tokenize embedding input")?;
             if tokens.is_empty() {
-                out.push(Vec::new());
                 continue;
             }
-            if tokens.len() > max_tokens {
-                tokens.truncate(max_tokens);
+            tokens.truncate(EMBED_MAX_TEXT_TOKENS);
+            sequences.push((index, tokens));
+        }
+
+        let lengths: Vec<usize> = sequences.iter().map(|(_, tokens)| tokens.len()).collect();
+        let groups = plan_embed_groups(&lengths);
+        let last_group = groups.len().saturating_sub(1);
+        for (group_index, range) in groups.into_iter().enumerate() {
+            let group = &sequences[range];
+            // A model or backend that rejects multi-sequence decodes still
+            // gets embedded, one sequence at a time.
+            let packed = group.len() > 1
+                && match self.embed_packed(group, &mut out) {
+                    Ok(()) => true,
+                    Err(err) => {
+                        eprintln!(
+                            "ghost-llm-helper: packed embed of {} texts failed, \
+                             decoding them one at a time: {err:#}",
+                            group.len()
+                        );
+                        false
+                    }
+                };
+            if !packed {
+                self.embed_each(group, &mut out)?;
             }
-            let mut batch = LlamaBatch::new(tokens.len(), 1);
-            batch
-                .add_sequence(&tokens, 0, false)
+            if group_index < last_group {
+                between_groups(self);
+            }
+        }
+        Ok(out)
+    }
+
+    /// Decode a group in one batch, one sequence id per text.
+    fn embed_packed(
+        &mut self,
+        group: &[(usize, Vec<LlamaToken>)],
+        out: &mut [Vec<f32>],
+    ) -> Result<()> {
+        if self.packed_ctx.is_none() {
+            let params = embedding_context_params(EMBED_BATCH_TOKENS)
+                .with_n_ctx(NonZeroU32::new(packed_ctx_tokens()))
+                .with_n_seq_max(EMBED_MAX_SEQUENCES);
+            self.packed_ctx = Some(self.new_context(params)?);
+        }
+        let ctx = self.packed_ctx.as_mut().context("embedding context")?;
+        self.batch.clear();
+        for (seq_id, (_, tokens)) in group.iter().enumerate() {
+            self.batch
+                .add_sequence(tokens, seq_id as i32, false)
+                .context("add embedding sequence")?;
+        }
+        ctx.clear_kv_cache();
+        ctx.decode(&mut self.batch)
+            .context("decode packed embedding batch")?;
+        for (seq_id, (index, _)) in group.iter().enumerate() {
+            let embedding = ctx
+                .embeddings_seq_ith(seq_id as i32)
+                .context("read pooled embedding")?
+                .to_vec();
+            out[*index] = l2_normalize(embedding);
+        }
+        Ok(())
+    }
+
+    /// Decode each text of a group as its own single-sequence batch.
+    fn embed_each(
+        &mut self,
+        group: &[(usize, Vec<LlamaToken>)],
+        out: &mut [Vec<f32>],
+    ) -> Result<()> {
+        if self.single_ctx.is_none() {
+            let params = embedding_context_params(EMBED_SINGLE_CTX_TOKENS);
+            self.single_ctx = Some(self.new_context(params)?);
+        }
+        let ctx = self.single_ctx.as_mut().context("embedding context")?;
+        for (index, tokens) in group {
+            self.batch.clear();
+            self.batch
+                .add_sequence(tokens, 0, false)
                 .context("add embedding sequence")?;
             ctx.clear_kv_cache();
-            ctx.decode(&mut batch).context("decode embedding batch")?;
+            ctx.decode(&mut self.batch)
+                .context("decode embedding batch")?;
             let embedding = ctx
                 .embeddings_seq_ith(0)
                 .context("read pooled embedding")?
                 .to_vec();
-            out.push(l2_normalize(embedding));
+            out[*index] = l2_normalize(embedding);
         }
-        Ok(out)
+        Ok(())
+    }
+
+    fn new_context(&self, params: LlamaContextParams) -> Result<LlamaContext<'static>> {
+        // SAFETY: the model is boxed, so its address is stable for the life
+        // of `self`, and the contexts holding this reference are fields of
+        // `self` declared before `model`, so they are dropped before it.
+        let model: &'static LlamaModel = unsafe { &*(self.model.as_ref() as *const LlamaModel) };
+        model
+            .new_context(self.backend, params)
+            .context("create embedding context")
+    }
+}
+
+/// Split texts of the given token lengths into packed decode groups, in
+/// order. A group holds at most [`EMBED_MAX_SEQUENCES`] texts and
+/// [`EMBED_BATCH_TOKENS`] tokens; a text longer than [`EMBED_SEQ_TOKENS`]
+/// is a group of its own, decoded on the single-sequence context.
+fn plan_embed_groups(lengths: &[usize]) -> Vec<Range<usize>> {
+    let fits_packed = |len: usize| len <= EMBED_SEQ_TOKENS as usize;
+    let mut groups = Vec::new();
+    let mut start = 0;
+    while start < lengths.len() {
+        let mut end = start + 1;
+        if fits_packed(lengths[start]) {
+            let mut tokens = lengths[start];
+            while end < lengths.len()
+                && end - start < EMBED_MAX_SEQUENCES as usize
+                && fits_packed(lengths[end])
+                && tokens + lengths[end] <= EMBED_BATCH_TOKENS as usize
+            {
+                tokens += lengths[end];
+                end += 1;
+            }
+        }
+        groups.push(start..end);
+        start = end;
     }
+    groups
+}
+
+/// KV cells of the packed context: [`EMBED_SEQ_TOKENS`] per sequence.
+const fn packed_ctx_tokens() -> u32 {
+    EMBED_MAX_SEQUENCES * EMBED_SEQ_TOKENS
+}
+
+fn embedding_context_params(tokens: u32) -> LlamaContextParams {
+    // Non-causal embedding models need a whole decode in one ubatch.
+    LlamaContextParams::default()
+        .with_n_ctx(NonZeroU32::new(tokens))
+        .with_n_batch(tokens)
+        .with_n_ubatch(tokens)
+        .with_embeddings(true)
+        .with_pooling_type(LlamaPoolingType::Mean)
 }
 
 fn l2_normalize(mut v: Vec<f32>) -> Vec<f32> {
@@ -118,11 +264,25 @@ fn backend() -> Result<&'static LlamaBackend> {
     BACKEND.get().context("llama backend not initialized")
 }
 
+/// A ghost completion and how many prompt tokens were decoded to produce it.
+pub(crate) struct GhostGeneration {
+    pub raw_completion: String,
+    pub prefill_tokens: usize,
+}
+
+/// The ghost-text generator. Keeps one context alive across requests and
+/// remembers which tokens its KV cache holds, so a prompt that extends the
+/// previous one (the next keystroke) only decodes the tokens after the first
+/// divergence.
 pub(crate) struct LoadedLocalLlm {
     model_id: String,
     sampling: GhostSamplingParams,
+    // Borrows `model`; declared first so it drops first.
+    ctx: Option<LlamaContext<'static>>,
+    /// Tokens in the KV cache for sequence 0, by position.
+    cached_tokens: Vec<LlamaToken>,
     backend: &'static LlamaBackend,
-    model: LlamaModel,
+    model: Box<LlamaModel>,
 }
 
 impl LoadedLocalLlm {
@@ -140,8 +300,10 @@ impl LoadedLocalLlm {
         Ok(Self {
             model_id: model_id.to_string(),
             sampling,
+            ctx: None,
+            cached_tokens: Vec::new(),
             backend,
-            model: loaded_model,
+            model: Box::new(loaded_model),
         })
     }
 
@@ -155,7 +317,7 @@ impl LoadedLocalLlm {
         prompt: &str,
         cancel: &Arc<AtomicBool>,
         request_id: u64,
-    ) -> Result<String> {
+    ) -> Result<GhostGeneration> {
         if cancel.load(Ordering::Relaxed) {
             anyhow::bail!("ghost_local_llm_cancelled");
         }
@@ -172,18 +334,51 @@ impl LoadedLocalLlm {
         if tokens.len() > max_prompt {
             tokens = tokens.split_off(tokens.len() - max_prompt);
         }
-        let ctx_params = LlamaContextParams::default()
-            .with_n_ctx(NonZeroU32::new(self.sampling.ctx_tokens))
-            .with_n_batch(self.sampling.batch_size)
-            .with_n_ubatch(self.sampling.batch_size);
-        let mut ctx: LlamaContext<'_> = self
-            .model
-            .new_context(self.backend, ctx_params)
-            .context("create llama context")?;
+        if self.ctx.is_none() {
+            let ctx_params = LlamaContextParams::default()
+                .with_n_ctx(NonZeroU32::new(self.sampling.ctx_tokens))
+                .with_n_batch(self.sampling.batch_size)
+                .with_n_ubatch(self.sampling.batch_size);
+            // SAFETY: the model is boxed, so its address is stable for the
+            // life of `self`, and `ctx` is declared before `model`, so it is
+            // dropped first.
+            let model: &'static LlamaModel =
+                unsafe { &*(self.model.as_ref() as *const LlamaModel) };
+            self.ctx = Some(
+                model
+                    .new_context(self.backend, ctx_params)
+                    .context("create llama context")?,
+            );
+            self.cached_tokens.clear();
+        }
+        let ctx = self.ctx.as_mut().context("llama context not created")?;
+
+        // Keep the longest cached prefix, but always decode at least the last
+        // prompt token so its logits are fresh for sampling.
+        let mut reused = self
+            .cached_tokens
+            .iter()
+            .zip(&tokens)
+            .take_while(|(cached, token)| cached == token)
+            .count()
+            .min(tokens.len() - 1);
+        if reused < self.cached_tokens.len() {
+            // Models whose cache cannot be cut mid-sequence start over.
+            let trimmed = ctx
+                .clear_kv_cache_seq(Some(0), Some(reused as u32), None)
+                .unwrap_or(false);
+            if !trimmed {
+                ctx.clear_kv_cache();
+                reused = 0;
+            }
+            self.cached_tokens.truncate(reused);
+        }
+        let prefill_tokens = tokens.len() - reused;
+
         let n_batch = (self.sampling.batch_size as usize).max(1);
         let mut batch = LlamaBatch::new(n_batch, 1);
         let last_index = tokens.len() - 1;
-        let mut chunk_start = 0usize;
+        let mut chunk_start = reused;
         while chunk_start < tokens.len() {
             let chunk_end = (chunk_start + n_batch).min(tokens.len());
             batch.clear();
@@ -192,7 +387,12 @@ impl LoadedLocalLlm {
                     .add(tokens[index], index as i32, &[0], index == last_index)
                     .context("add prompt token")?;
             }
-            ctx.decode(&mut batch).context("decode prompt")?;
+            if let Err(err) = ctx.decode(&mut batch) {
+                forget_kv_cache(ctx, &mut self.cached_tokens);
+                return Err(err).context("decode prompt");
+            }
+            self.cached_tokens
+                .extend_from_slice(&tokens[chunk_start..chunk_end]);
             chunk_start = chunk_end;
         }
         let mut sampler = LlamaSampler::chain_simple([
@@ -214,7 +414,7 @@ impl LoadedLocalLlm {
             if cancel.load(Ordering::Relaxed) {
                 anyhow::bail!("ghost_local_llm_cancelled");
             }
-            let token = sampler.sample(&ctx, batch.n_tokens() - 1);
+            let token = sampler.sample(ctx, batch.n_tokens() - 1);
             sampler.accept(token);
             if self.model.is_eog_token(token) {
                 break;
@@ -239,8 +439,64 @@ impl LoadedLocalLlm {
                 .add(token, n_cur, &[0], true)
                 .context("add sampled token")?;
             n_cur += 1;
-            ctx.decode(&mut batch).context("decode token")?;
+            // Decoded completions stay cached: typing the suggested text reuses them.
+            if let Err(err) = ctx.decode(&mut batch) {
+                forget_kv_cache(ctx, &mut self.cached_tokens);
+                return Err(err).context("decode token");
+            }
+            self.cached_tokens.push(token);
+        }
+        Ok(GhostGeneration {
+            raw_completion: String::from_utf8_lossy(&out_bytes).to_string(),
+            prefill_tokens,
+        })
+    }
+}
+
+/// After a failed decode the cache contents are unknown; start over.
+fn forget_kv_cache(ctx: &mut LlamaContext<'_>, cached_tokens: &mut Vec<LlamaToken>) {
+    ctx.clear_kv_cache();
+    cached_tokens.clear();
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// Token counts of brain chunks: `CHUNK_TARGET_BYTES` (3600) of prose
+    /// is roughly 800-900 tokens.
+    const CHUNK_TOKENS: [usize; 6] = [812, 905, 870, 940, 788, 861];
+
+    #[test]
+    fn chunk_sized_texts_pack_within_each_sequence_slot() {
+        let groups = plan_embed_groups(&CHUNK_TOKENS);
+        assert!(
+            groups.iter().any(|group| group.len() > 1),
+            "chunk-sized texts should share packed decodes: {groups:?}"
+        );
+        let per_sequence = packed_ctx_tokens() / EMBED_MAX_SEQUENCES;
+        for group in groups.iter().filter(|group| group.len() > 1) {
+            let lengths = &CHUNK_TOKENS[group.clone()];
+            assert!(lengths.len() <= EMBED_MAX_SEQUENCES as usize);
+            assert!(lengths.iter().sum::<usize>() <= EMBED_BATCH_TOKENS as usize);
+            assert!(
+                lengths.iter().all(|&len| len <= per_sequence as usize),
+                "packed sequence exceeds its KV slot: {lengths:?}"
+            );
         }
-        Ok(String::from_utf8_lossy(&out_bytes).to_string())
+        let covered: usize = groups.iter().map(|group| group.len()).sum();
+        assert_eq!(covered, CHUNK_TOKENS.len());
+    }
+
+    #[test]
+    fn oversized_texts_decode_alone_and_short_texts_fill_a_group() {
+        let long = EMBED_SEQ_TOKENS as usize + 1;
+        let groups = plan_embed_groups(&[40, 40, long, 40, 40, 40]);
+        assert_eq!(groups, vec![0..2, 2..3, 3..6]);
+
+        let short = vec![12; EMBED_MAX_SEQUENCES as usize + 3];
+        let groups = plan_embed_groups(&short);
+        assert_eq!(groups[0], 0..EMBED_MAX_SEQUENCES as usize);
+        assert_eq!(groups.len(), 2);
     }
 }
@@ -1,14 +1,24 @@
 mod llama_engine;
 
 use anyhow::{anyhow, Context as _, Result};
-use llama_engine::{GhostSamplingParams, LoadedEmbedder, LoadedLocalLlm};
+use base64::Engine as _;
+use llama_engine::{GhostGeneration, GhostSamplingParams, LoadedEmbedder, LoadedLocalLlm};
 use serde::{Deserialize, Serialize};
-use std::collections::{HashMap, HashSet};
+use std::collections::{HashMap, HashSet, VecDeque};
 use std::io::{self, BufRead, Write};
 use std::path::PathBuf;
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{mpsc, Arc, Mutex};
 
+/// Embedding payload encoding a client can negotiate with `hello`: each
+/// vector as base64 of its little-endian `f32` bytes, the same layout the
+/// brain store keeps in its BLOB column.
+const VECTOR_ENCODING_F32LE_BASE64: &str = "f32le_base64";
+
+/// Set once a client's `hello` accepts [`VECTOR_ENCODING_F32LE_BASE64`];
+/// until then embeddings go out as JSON number arrays.
+static PACKED_VECTORS: AtomicBool = AtomicBool::new(false);
+
 #[derive(Debug, Deserialize)]
 #[serde(tag = "type", rename_all = "snake_case")]
 enum WireRequest {
@@ -32,10 +42,20 @@ enum WireRequest {
         texts: Vec<String>,
         #[serde(default)]
         gpu_layers: u32,
+        /// Interactive (query) embeds overtake queued and in-progress batch work.
+        #[serde(default)]
+        priority: bool,
     },
     Cancel {
         id: u64,
     },
+    /// Startup negotiation: the encodings the client can decode, in order of
+    /// preference. Answered with the one the helper will use.
+    Hello {
+        id: u64,
+        #[serde(default)]
+        vector_encodings: Vec<String>,
+    },
     Shutdown {
         id: u64,
     },
@@ -47,8 +67,17 @@ struct WireResponse {
     ok: bool,
     model_id: Option<String>,
     raw_completion: Option<String>,
+    /// Prompt tokens decoded for a generate request (the rest came from the KV cache).
+    #[serde(skip_serializing_if = "Option::is_none")]
+    prefill_tokens: Option<usize>,
     #[serde(skip_serializing_if = "Option::is_none")]
     embeddings: Option<Vec<Vec<f32>>>,
+    /// Embeddings in the negotiated [`VECTOR_ENCODING_F32LE_BASE64`] form.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    embeddings_f32le_base64: Option<Vec<String>>,
+    /// The vector encoding accepted in reply to `hello`.
+    #[serde(skip_serializing_if = "Option::is_none")]
+    vector_encoding: Option<&'static str>,
     error: Option<String>,
 }
 
@@ -73,11 +102,60 @@ enum WorkerRequest {
         texts: Vec<String>,
         gpu_layers: u32,
     },
+    /// Priority embeds are waiting in the [`PriorityEmbeds`] queue.
+    ServePriorityEmbeds,
     Shutdown {
         id: u64,
     },
 }
 
+struct PriorityEmbed {
+    id: u64,
+    model_path: String,
+    model_id: String,
+    texts: Vec<String>,
+    gpu_layers: u32,
+}
+
+/// Priority embed requests. They bypass the worker channel so a batch that is
+/// already running serves them between its packed decode groups.
+type PriorityEmbeds = Arc<Mutex<VecDeque<PriorityEmbed>>>;
+
+/// Remove the queued priority embeds, or only those for `model_id`.
+fn take_priority_embeds(queue: &PriorityEmbeds, model_id: Option<&str>) -> Vec<PriorityEmbed> {
+    let Ok(mut queue) = queue.lock() else {
+        return Vec::new();
+    };
+    match model_id {
+        None => queue.drain(..).collect(),
+        Some(model_id) => {
+            let (matching, rest): (Vec<_>, Vec<_>) = queue
+                .drain(..)
+                .partition(|embed| embed.model_id == model_id);
+            queue.extend(rest);
+            matching
+        }
+    }
+}
+
+fn serve_priority_embeds(engine: &mut HelperEngine, queue: &PriorityEmbeds) -> Result<()> {
+    for query in take_priority_embeds(queue, None) {
+        let response = match engine.embed(
+            &query.model_path,
+            &query.model_id,
+            &query.texts,
+            query.gpu_layers,
+            false,
+            |_| {},
+        ) {
+            Ok(embeddings) => WireResponse::ok_embed(query.id, query.model_id, embeddings),
+            Err(err) => WireResponse::err(query.id, err),
+        };
+        write_response(response)?;
+    }
+    Ok(())
+}
+
 #[derive(Default)]
 struct CancelRegistry {
     active: HashMap<u64, Arc<AtomicBool>>,
@@ -138,7 +216,7 @@ impl HelperEngine {
         sampling: GhostSamplingParams,
         cancel: &Arc<AtomicBool>,
         request_id: u64,
-    ) -> Result<String> {
+    ) -> Result<GhostGeneration> {
         self.load_if_needed(model_path, model_id, sampling)?;
         self.loaded
             .as_mut()
@@ -152,6 +230,7 @@ impl HelperEngine {
         model_id: &str,
         texts: &[String],
         gpu_layers: u32,
+        between_groups: impl FnMut(&mut LoadedEmbedder),
     ) -> Result<Vec<Vec<f32>>> {
         if !self
             .embedder
@@ -161,10 +240,11 @@ impl HelperEngine {
             let path = PathBuf::from(model_path);
             self.embedder = Some(LoadedEmbedder::load(&path, model_id, gpu_layers)?);
         }
-        self.embedder
-            .as_ref()
-            .context("embedding model not loaded")?
-            .embed_texts(texts)
+        let embedder = self
+            .embedder
+            .as_mut()
+            .context("embedding model not loaded")?;
+        embedder.embed_texts(texts, between_groups)
     }
 }
 
@@ -175,29 +255,57 @@ impl WireResponse {
             ok: true,
             model_id: Some(model_id),
             raw_completion: None,
+            prefill_tokens: None,
             embeddings: None,
+            embeddings_f32le_base64: None,
+            vector_encoding: None,
             error: None,
         }
     }
 
-    fn ok_generate(id: u64, model_id: String, raw_completion: String) -> Self {
+    fn ok_generate(id: u64, model_id: String, generation: GhostGeneration) -> Self {
         Self {
             id,
             ok: true,
             model_id: Some(model_id),
-            raw_completion: Some(raw_completion),
+            raw_completion: Some(generation.raw_completion),
+            prefill_tokens: Some(generation.prefill_tokens),
             embeddings: None,
+            embeddings_f32le_base64: None,
+            vector_encoding: None,
             error: None,
         }
     }
 
     fn ok_embed(id: u64, model_id: String, embeddings: Vec<Vec<f32>>) -> Self {
+        let (embeddings, embeddings_f32le_base64) = if PACKED_VECTORS.load(Ordering::Relaxed) {
+            (None, Some(encode_f32le_base64(&embeddings)))
+        } else {
+            (Some(embeddings), None)
+        };
         Self {
             id,
             ok: true,
             model_id: Some(model_id),
             raw_completion: None,
-            embeddings: Some(embeddings),
+            prefill_tokens: None,
+            embeddings,
+            embeddings_f32le_base64,
+            vector_encoding: None,
+            error: None,
+        }
+    }
+
+    fn ok_hello(id: u64, vector_encoding: &'static str) -> Self {
+        Self {
+            id,
+            ok: true,
+            model_id: None,
+            raw_completion: None,
+            prefill_tokens: None,
+            embeddings: None,
+            embeddings_f32le_base64: None,
+            vector_encoding: Some(vector_encoding),
             error: None,
         }
     }
@@ -208,7 +316,10 @@ impl WireResponse {
             ok: true,
             model_id: None,
             raw_completion: None,
+            prefill_tokens: None,
             embeddings: None,
+            embeddings_f32le_base64: None,
+            vector_encoding: None,
             error: None,
         }
     }
@@ -219,12 +330,30 @@ impl WireResponse {
             ok: false,
             model_id: None,
             raw_completion: None,
+            prefill_tokens: None,
             embeddings: None,
+            embeddings_f32le_base64: None,
+            vector_encoding: None,
             error: Some(err.to_string()),
         }
     }
 }
 
+/// Base64 of each vector's little-endian `f32` bytes. A 768-dim vector is
+/// 4 KiB of text instead of ~8-10 KiB of decimal floats, and the client
+/// decodes it without parsing a number per dimension.
+fn encode_f32le_base64(embeddings: &[Vec<f32>]) -> Vec<String> {
+    let mut bytes = Vec::new();
+    embeddings
+        .iter()
+        .map(|vector| {
+            bytes.clear();
+            bytes.extend(vector.iter().flat_map(|value| value.to_le_bytes()));
+            base64::engine::general_purpose::STANDARD.encode(&bytes)
+        })
+        .collect()
+}
+
 fn write_response(response: WireResponse) -> Result<()> {
     let mut stdout = io::stdout().lock();
     serde_json::to_writer(&mut stdout, &response).context("write helper response")?;
@@ -236,6 +365,8 @@ fn main() -> Result<()> {
     let (tx, rx) = mpsc::channel::<WorkerRequest>();
     let cancels = Arc::new(Mutex::new(CancelRegistry::default()));
     let reader_cancels = Arc::clone(&cancels);
+    let priority_embeds = PriorityEmbeds::default();
+    let reader_priority_embeds = Arc::clone(&priority_embeds);
 
     std::thread::Builder::new()
         .name("script-kit-ghost-llm-helper-stdin".to_string())
@@ -290,6 +421,27 @@ fn main() -> Result<()> {
                         model_id,
                         texts,
                         gpu_layers,
+                        priority: true,
+                        ..
+                    } => {
+                        if let Ok(mut queue) = reader_priority_embeds.lock() {
+                            queue.push_back(PriorityEmbed {
+                                id,
+                                model_path,
+                                model_id,
+                                texts,
+                                gpu_layers,
+                            });
+                        }
+                        let _ = tx.send(WorkerRequest::ServePriorityEmbeds);
+                    }
+                    WireRequest::Embed {
+                        id,
+                        model_path,
+                        model_id,
+                        texts,
+                        gpu_layers,
+                        priority: false,
                     } => {
                         let _ = tx.send(WorkerRequest::Embed {
                             id,
@@ -299,6 +451,23 @@ fn main() -> Result<()> {
                             gpu_layers,
                         });
                     }
+                    WireRequest::Hello {
+                        id,
+                        vector_encodings,
+                    } => {
+                        // Answered here rather than on the worker so the
+                        // encoding is settled before any queued embed replies.
+                        let packed = vector_encodings
+                            .iter()
+                            .any(|encoding| encoding == VECTOR_ENCODING_F32LE_BASE64);
+                        PACKED_VECTORS.store(packed, Ordering::Relaxed);
+                        let encoding = if packed {
+                            VECTOR_ENCODING_F32LE_BASE64
+                        } else {
+                            "json"
+                        };
+                        let _ = write_response(WireResponse::ok_hello(id, encoding));
+                    }
                     WireRequest::Shutdown { id } => {
                         let _ = tx.send(WorkerRequest::Shutdown { id });
                         break;
@@ -310,6 +479,8 @@ fn main() -> Result<()> {
 
     let mut engine = HelperEngine::default();
     while let Ok(request) = rx.recv() {
+        // Queued queries go before whatever batch work was received.
+        serve_priority_embeds(&mut engine, &priority_embeds)?;
         match request {
             WorkerRequest::Load {
                 id,
@@ -337,9 +508,7 @@ fn main() -> Result<()> {
                 };
                 let response =
                     match engine.generate(&model_path, &model_id, &prompt, sampling, &cancel, id) {
-                        Ok(raw_completion) => {
-                            WireResponse::ok_generate(id, model_id, raw_completion)
-                        }
+                        Ok(generation) => WireResponse::ok_generate(id, model_id, generation),
                         Err(err) => WireResponse::err(id, err),
                     };
                 if let Ok(mut cancels) = cancels.lock() {
@@ -354,12 +523,27 @@ fn main() -> Result<()> {
                 texts,
                 gpu_layers,
             } => {
-                let response = match engine.embed(&model_path, &model_id, &texts, gpu_layers) {
-                    Ok(embeddings) => WireResponse::ok_embed(id, model_id, embeddings),
-                    Err(err) => WireResponse::err(id, err),
+                let serve_queries = |embedder: &mut LoadedEmbedder| {
+                    let model_id = embedder.model_id().to_string();
+                    for query in take_priority_embeds(&priority_embeds, Some(&model_id)) {
+                        let response = match embedder.embed_texts(&query.texts, |_| {}) {
+                            Ok(embeddings) => {
+                                WireResponse::ok_embed(query.id, query.model_id, embeddings)
+                            }
+                            Err(err) => WireResponse::err(query.id, err),
+                        };
+                        let _ = write_response(response);
+                    }
                 };
+                let response =
+                    match engine.embed(&model_path, &model_id, &texts, gpu_layers, serve_queries) {
+                        Ok(embeddings) => WireResponse::ok_embed(id, model_id, embeddings),
+                        Err(err) => WireResponse::err(id, err),
+                    };
                 write_response(response)?;
             }
+            // Already served at the top of the loop.
+            WorkerRequest::ServePriorityEmbeds => {}
             WorkerRequest::Shutdown { id } => {
                 write_response(WireResponse::ok_shutdown(id))?;
                 break;
@@ -394,6 +394,12 @@ export default {
   //
   //   // How often to check script health (in milliseconds)
   //   healthCheckIntervalMs: 5000,  // 5 seconds
+  //
+  //   // Pre-warmed bun workers kept ready for instant script launch (0 = off)
+  //   warmPoolSize: 1,
+  //
+  //   // Seconds an unused warm worker waits before exiting
+  //   warmPoolIdleSeconds: 600,
   // },
 
   // ===========================================================================
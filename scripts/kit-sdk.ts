@@ -975,6 +975,26 @@ export interface ProcessLimits {
    * @example 10000 // Check every 10 seconds (less overhead)
    */
   healthCheckIntervalMs?: number;
+
+  /**
+   * Number of pre-warmed bun workers (with the SDK already preloaded) kept
+   * ready so TypeScript scripts launch without runtime startup cost.
+   * Set to 0 to disable. Capped at 4.
+   *
+   * @default 1
+   * @example 0 // Always spawn a fresh runtime
+   * @example 2 // Keep two workers ready for back-to-back launches
+   */
+  warmPoolSize?: number;
+
+  /**
+   * Seconds an unused warm worker waits for a script before exiting.
+   * A new worker is warmed on the next script launch.
+   *
+   * @default 600 (10 minutes)
+   * @example 120 // Release idle workers after 2 minutes
+   */
+  warmPoolIdleSeconds?: number;
 }
 
 /**
@@ -4,6 +4,7 @@
 //! - `agent_chat-conversations/{session_id}.json` — Full message history for resume
 
 use serde::{Deserialize, Serialize};
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::{Mutex, OnceLock};
 
 type HistoryFileSignature = Option<(std::path::PathBuf, std::time::SystemTime, u64)>;
@@ -18,6 +19,8 @@ struct AgentChatHistoryIndexCache {
 static AGENT_CHAT_HISTORY_INDEX_CACHE: OnceLock<Mutex<Option<AgentChatHistoryIndexCache>>> =
     OnceLock::new();
 static AGENT_CHAT_HISTORY_REFRESH_IN_FLIGHT: OnceLock<Mutex<bool>> = OnceLock::new();
+/// Bumped whenever the history index cache is replaced or dropped.
+static AGENT_CHAT_HISTORY_GENERATION: AtomicU64 = AtomicU64::new(0);
 
 fn agent_chat_history_index_cache() -> &'static Mutex<Option<AgentChatHistoryIndexCache>> {
     AGENT_CHAT_HISTORY_INDEX_CACHE.get_or_init(|| Mutex::new(None))
@@ -33,6 +36,7 @@ fn invalidate_history_cache() {
             *guard = None;
         }
     }
+    AGENT_CHAT_HISTORY_GENERATION.fetch_add(1, Ordering::Release);
 }
 
 /// A single conversation history entry (summary for the index).
@@ -355,12 +359,24 @@ pub(crate) fn search_history_direct(query: &str, limit: usize) -> Vec<AgentChatH
     search_history(query, limit)
 }
 
-fn cached_history_entries_if_fresh() -> Option<Vec<AgentChatHistoryEntry>> {
-    let path = history_path();
-    let signature = history_file_signature(&path);
-    let guard = agent_chat_history_index_cache().lock().ok()?;
-    let cache = guard.as_ref()?;
-    (cache.signature == signature).then(|| cache.entries.clone())
+/// Change feed for the root search index: the history cache's generation
+/// while it still matches the JSONL file. A cold or stale cache starts a
+/// background load and returns `None`.
+pub(crate) fn root_agent_chat_history_index_generation() -> Option<u64> {
+    let signature = history_file_signature(&history_path());
+    let fresh = agent_chat_history_index_cache()
+        .lock()
+        .ok()
+        .is_some_and(|guard| {
+            guard
+                .as_ref()
+                .is_some_and(|cache| cache.signature == signature)
+        });
+    if !fresh {
+        ensure_history_cache_warm();
+        return None;
+    }
+    Some(AGENT_CHAT_HISTORY_GENERATION.load(Ordering::Acquire))
 }
 
 fn ensure_history_cache_warm() {
@@ -389,36 +405,6 @@ fn ensure_history_cache_warm() {
     }
 }
 
-/// Cache-only Agent Chat history search for root launcher passive rows.
-///
-/// A cold or stale JSONL index starts a background load and returns no hits for
-/// the current frame. Late completion warms a future frame without invalidating
-/// or notifying the active main menu.
-pub(crate) fn search_history_cached(query: &str, limit: usize) -> Vec<AgentChatHistorySearchHit> {
-    let Some(entries) = cached_history_entries_if_fresh() else {
-        ensure_history_cache_warm();
-        tracing::info!(
-            target: "script_kit::tab_ai",
-            event = "root_agent_chat_history_search_cache_miss",
-            query_len = query.trim().chars().count(),
-            limit,
-        );
-        return Vec::new();
-    };
-
-    let hits = rank_history_entries(entries, query, limit);
-    if crate::logging::filter_perf_trace_enabled() {
-        tracing::info!(
-            target: "script_kit::tab_ai",
-            event = "root_agent_chat_history_search_cache_hit",
-            query_len = query.trim().chars().count(),
-            limit,
-            hit_count = hits.len(),
-        );
-    }
-    hits
-}
-
 // ── Persistence paths ────────────────────────────────────────────────
 
 fn history_path() -> std::path::PathBuf {
@@ -516,6 +502,7 @@ pub(crate) fn load_history() -> Vec<AgentChatHistoryEntry> {
             entries: entries.clone(),
         });
     }
+    AGENT_CHAT_HISTORY_GENERATION.fetch_add(1, Ordering::Release);
 
     entries
 }
@@ -1,45 +1,124 @@
 //! Smooth assistant streaming text by buffering RPC chunks and draining on char boundaries.
+//!
+//! Pending text is kept as a queue of the original RPC chunks, each carrying a
+//! consumed-byte offset and its remaining char count. A tick therefore costs
+//! only the chars it reveals: the backlog length is cached, fully revealed
+//! chunks are popped from the front, and a partially revealed chunk just
+//! advances its offset instead of memmoving the rest of the backlog.
+
+use std::collections::VecDeque;
 
 const DEFAULT_TICK_MS: usize = 16;
 const CATCH_UP_WINDOW_MS: usize = 200;
 
-#[derive(Debug, Default, Clone, PartialEq, Eq)]
+#[derive(Debug, Clone)]
+struct PendingChunk {
+    text: String,
+    /// Byte offset of the first unrevealed char in `text`.
+    offset: usize,
+    /// Chars remaining in `text[offset..]`.
+    chars: usize,
+}
+
+impl PendingChunk {
+    fn remaining(&self) -> &str {
+        &self.text[self.offset..]
+    }
+
+    fn into_remaining(self) -> String {
+        if self.offset == 0 {
+            self.text
+        } else {
+            self.text[self.offset..].to_string()
+        }
+    }
+}
+
+#[derive(Debug, Default, Clone)]
 pub(crate) struct StreamingTextBuffer {
-    pending: String,
+    chunks: VecDeque<PendingChunk>,
+    pending_chars: usize,
 }
 
 impl StreamingTextBuffer {
     pub(crate) fn push_chunk(&mut self, chunk: String) {
-        if !chunk.is_empty() {
-            self.pending.push_str(&chunk);
+        if chunk.is_empty() {
+            return;
         }
+        let chars = chunk.chars().count();
+        self.pending_chars += chars;
+        self.chunks.push_back(PendingChunk {
+            text: chunk,
+            offset: 0,
+            chars,
+        });
     }
 
     pub(crate) fn drain_next(&mut self, chars_budget: usize) -> Option<String> {
-        if self.pending.is_empty() || chars_budget == 0 {
+        if self.pending_chars == 0 || chars_budget == 0 {
             return None;
         }
 
-        let take_chars = chars_budget.min(self.pending.chars().count());
-        let byte_end = self
-            .pending
-            .char_indices()
-            .nth(take_chars)
-            .map(|(index, _)| index)
-            .unwrap_or_else(|| self.pending.len());
-        Some(self.pending.drain(..byte_end).collect())
+        let mut remaining = chars_budget.min(self.pending_chars);
+        self.pending_chars -= remaining;
+        let mut out = String::new();
+        while remaining > 0 {
+            let Some(front) = self.chunks.front_mut() else {
+                break;
+            };
+            if front.chars <= remaining {
+                remaining -= front.chars;
+                if let Some(chunk) = self.chunks.pop_front() {
+                    if out.is_empty() {
+                        out = chunk.into_remaining();
+                    } else {
+                        out.push_str(chunk.remaining());
+                    }
+                }
+                continue;
+            }
+
+            let tail = front.remaining();
+            let byte_len = tail
+                .char_indices()
+                .nth(remaining)
+                .map(|(index, _)| index)
+                .unwrap_or(tail.len());
+            out.push_str(&tail[..byte_len]);
+            front.offset += byte_len;
+            front.chars -= remaining;
+            remaining = 0;
+        }
+        Some(out)
     }
 
     pub(crate) fn is_empty(&self) -> bool {
-        self.pending.is_empty()
+        self.pending_chars == 0
     }
 
     pub(crate) fn flush_all(&mut self) -> String {
-        std::mem::take(&mut self.pending)
+        self.pending_chars = 0;
+        if self.chunks.len() == 1 {
+            return self
+                .chunks
+                .pop_front()
+                .map(PendingChunk::into_remaining)
+                .unwrap_or_default();
+        }
+        let byte_len = self
+            .chunks
+            .iter()
+            .map(|chunk| chunk.remaining().len())
+            .sum();
+        let mut out = String::with_capacity(byte_len);
+        for chunk in self.chunks.drain(..) {
+            out.push_str(chunk.remaining());
+        }
+        out
     }
 
     pub(crate) fn drain_budget_for_tick(&self) -> usize {
-        Self::budget_for_backlog_chars(self.pending.chars().count(), DEFAULT_TICK_MS)
+        Self::budget_for_backlog_chars(self.pending_chars, DEFAULT_TICK_MS)
     }
 
     pub(crate) fn budget_for_backlog_chars(backlog_chars: usize, tick_ms: usize) -> usize {
@@ -102,4 +181,74 @@ mod tests {
         assert_eq!(buffer.drain_next(2).as_deref(), Some("b"));
         assert!(buffer.is_empty());
     }
+
+    #[test]
+    fn drain_spans_chunk_boundaries() {
+        let mut buffer = StreamingTextBuffer::default();
+        buffer.push_chunk("ab".to_string());
+        buffer.push_chunk(String::new());
+        buffer.push_chunk("c🦀".to_string());
+        buffer.push_chunk("de".to_string());
+
+        assert_eq!(buffer.drain_next(1).as_deref(), Some("a"));
+        assert_eq!(buffer.drain_budget_for_tick(), 1);
+        assert_eq!(buffer.drain_next(3).as_deref(), Some("bc🦀"));
+        assert_eq!(buffer.flush_all(), "de");
+        assert!(buffer.is_empty());
+        assert_eq!(buffer.flush_all(), "");
+    }
+
+    #[test]
+    fn multi_megabyte_backlog_drains_in_bounded_ticks() {
+        const CHUNK: &str = "streamed é中🦀 token text ";
+        const CHUNKS: usize = 200_000;
+
+        let mut buffer = StreamingTextBuffer::default();
+        let mut expected = String::with_capacity(CHUNK.len() * CHUNKS);
+        for _ in 0..CHUNKS {
+            buffer.push_chunk(CHUNK.to_string());
+            expected.push_str(CHUNK);
+        }
+        assert!(expected.len() > 4 * 1024 * 1024);
+
+        let started = std::time::Instant::now();
+        let mut revealed = String::with_capacity(expected.len());
+        let mut ticks = 0usize;
+        while !buffer.is_empty() {
+            let budget = buffer.drain_budget_for_tick();
+            let delta = buffer
+                .drain_next(budget)
+                .expect("non-empty buffer yields a delta");
+            assert_eq!(delta.chars().count(), budget);
+            revealed.push_str(&delta);
+            ticks += 1;
+        }
+
+        assert_eq!(revealed, expected);
+        // Proportional draining empties even a huge backlog in a few hundred
+        // ticks; each tick only walks the chars it reveals.
+        assert!(ticks < 1_000, "took {ticks} ticks");
+        assert!(
+            started.elapsed() < std::time::Duration::from_secs(5),
+            "draining took {:?}",
+            started.elapsed()
+        );
+    }
+
+    #[test]
+    fn small_ticks_on_large_backlog_do_not_rescan_pending_text() {
+        let mut buffer = StreamingTextBuffer::default();
+        buffer.push_chunk("x".repeat(8 * 1024 * 1024));
+
+        let started = std::time::Instant::now();
+        for _ in 0..10_000 {
+            assert_eq!(buffer.drain_next(1).as_deref(), Some("x"));
+        }
+        assert!(
+            started.elapsed() < std::time::Duration::from_secs(2),
+            "10k single-char ticks took {:?}",
+            started.elapsed()
+        );
+        assert_eq!(buffer.flush_all().len(), 8 * 1024 * 1024 - 10_000);
+    }
 }
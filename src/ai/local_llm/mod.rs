@@ -24,6 +24,10 @@ mod subprocess_backend;
 pub(crate) use download::ensure_ghost_model_in_background;
 pub(crate) use types::{GhostPromptSpec, LocalGhostRequest, LocalGhostResponse};
 
+/// The helper-backed model, driven directly by the ghost prefill benchmark.
+#[cfg(all(test, target_os = "macos", feature = "local-llm"))]
+pub(crate) use subprocess_backend::LoadedLocalLlm;
+
 /// Cache identity of the model that would serve ghost text (or a sentinel when
 /// none is available). Folded into `GhostLlmCacheKey.model_id`.
 pub(crate) fn ghost_model_id_hint(config: &crate::config::Config) -> String {
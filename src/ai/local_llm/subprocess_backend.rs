@@ -71,6 +71,8 @@ struct HelperResponse {
     ok: bool,
     model_id: Option<String>,
     raw_completion: Option<String>,
+    #[serde(default)]
+    prefill_tokens: Option<usize>,
     error: Option<String>,
 }
 
@@ -79,6 +81,8 @@ pub(crate) struct LoadedLocalLlm {
     model_path: PathBuf,
     sampling: GhostSamplingParams,
     client: HelperClient,
+    #[cfg(test)]
+    last_prefill_tokens: Option<usize>,
 }
 
 impl LoadedLocalLlm {
@@ -95,6 +99,8 @@ impl LoadedLocalLlm {
             model_path: model.path.clone(),
             sampling,
             client,
+            #[cfg(test)]
+            last_prefill_tokens: None,
         })
     }
 
@@ -108,16 +114,27 @@ impl LoadedLocalLlm {
         cancel: &Arc<AtomicBool>,
     ) -> Result<String> {
         let started = Instant::now();
-        let raw = self.client.generate(
+        let (raw, prefill_tokens) = self.client.generate(
             &self.model_path,
             &self.model_id,
             prompt,
             WireSamplingParams::from(self.sampling),
             cancel,
         )?;
-        tracing::debug!(target: "script_kit::ghost_text", elapsed_ms = started.elapsed().as_millis(), model_id = %self.model_id, "ghost local llm helper generate");
+        #[cfg(test)]
+        {
+            self.last_prefill_tokens = prefill_tokens;
+        }
+        tracing::debug!(target: "script_kit::ghost_text", elapsed_ms = started.elapsed().as_millis(), prefill_tokens = ?prefill_tokens, model_id = %self.model_id, "ghost local llm helper generate");
         Ok(raw)
     }
+
+    /// Prompt tokens the helper decoded for the last completion; the rest of
+    /// the prompt was served from its KV cache.
+    #[cfg(test)]
+    pub(crate) fn last_prefill_tokens(&self) -> Option<usize> {
+        self.last_prefill_tokens
+    }
 }
 
 struct HelperClient {
@@ -188,7 +205,7 @@ impl HelperClient {
         prompt: &str,
         sampling: WireSamplingParams,
         cancel: &Arc<AtomicBool>,
-    ) -> Result<String> {
+    ) -> Result<(String, Option<usize>)> {
         if cancel.load(Ordering::Relaxed) {
             anyhow::bail!("ghost_local_llm_cancelled");
         }
@@ -214,7 +231,10 @@ impl HelperClient {
             match rx.recv_timeout(Duration::from_millis(10)) {
                 Ok(response) => {
                     return response.into_result().and_then(|response| {
-                        response.raw_completion.context("missing helper completion")
+                        let raw = response
+                            .raw_completion
+                            .context("missing helper completion")?;
+                        Ok((raw, response.prefill_tokens))
                     });
                 }
                 Err(mpsc::RecvTimeoutError::Timeout) => {
@@ -15,7 +15,7 @@ use anyhow::{anyhow, Context, Result};
 use itertools::Itertools;
 use std::collections::HashMap;
 use std::io::{BufRead, BufReader};
-use std::sync::Arc;
+use std::sync::{Arc, OnceLock};
 use std::time::Duration;
 
 use super::config::{default_models, DetectedKeys, ModelInfo, ProviderConfig};
@@ -136,6 +136,13 @@ const GLOBAL_TIMEOUT_SECS: u64 = 180;
 const HTTP_MAX_ATTEMPTS: usize = 3;
 const HTTP_RETRY_BASE_DELAY_MS: u64 = 250;
 
+/// Keep-alive pool shared by every provider: idle connections overall, per
+/// host (a chat stream plus title/summary requests to the same API), and how
+/// long an idle connection is kept warm for the next turn.
+const POOL_MAX_IDLE_CONNECTIONS: usize = 32;
+const POOL_MAX_IDLE_CONNECTIONS_PER_HOST: usize = 4;
+const POOL_MAX_IDLE_AGE_SECS: u64 = 90;
+
 fn should_retry_http_status(status: u16) -> bool {
     matches!(status, 408 | 429 | 500..=599)
 }
@@ -221,19 +228,46 @@ fn send_json_with_retry(
 
 /// Create a ureq::Agent with standard timeouts for API requests.
 fn create_agent() -> ureq::Agent {
+    build_agent(true)
+}
+
+/// Agent with the API timeouts and keep-alive pool. `https_only` is only
+/// relaxed for local test servers.
+pub(crate) fn build_agent(https_only: bool) -> ureq::Agent {
     ureq::Agent::config_builder()
         .http_status_as_error(false)
-        .https_only(true)
+        .https_only(https_only)
         .timeout_global(Some(Duration::from_secs(GLOBAL_TIMEOUT_SECS)))
         .timeout_connect(Some(Duration::from_secs(CONNECT_TIMEOUT_SECS)))
         .timeout_send_request(Some(Duration::from_secs(SEND_TIMEOUT_SECS)))
         .timeout_send_body(Some(Duration::from_secs(SEND_TIMEOUT_SECS)))
         .timeout_recv_response(Some(Duration::from_secs(RESPONSE_TIMEOUT_SECS)))
         .timeout_recv_body(Some(Duration::from_secs(READ_TIMEOUT_SECS)))
+        .max_idle_connections(POOL_MAX_IDLE_CONNECTIONS)
+        .max_idle_connections_per_host(POOL_MAX_IDLE_CONNECTIONS_PER_HOST)
+        .max_idle_age(Duration::from_secs(POOL_MAX_IDLE_AGE_SECS))
         .build()
         .new_agent()
 }
 
+/// The process-wide agent providers clone.
+///
+/// Clones share one connection pool, DNS resolver and rustls config (and with
+/// it the TLS session cache), so re-created providers and different providers
+/// on the same host reuse warm keep-alive connections instead of paying a
+/// fresh TCP + TLS handshake per provider instance.
+fn shared_agent() -> ureq::Agent {
+    static AGENT: OnceLock<ureq::Agent> = OnceLock::new();
+    AGENT.get_or_init(create_agent).clone()
+}
+
+// Maximum size for a single SSE event data buffer (16 MB).
+// Prevents unbounded memory growth from malicious or misbehaving servers.
+const SSE_MAX_EVENT_SIZE: usize = 16 * 1024 * 1024;
+
+/// Bytes read past `[DONE]` so the connection goes back to the pool.
+const SSE_DRAIN_LIMIT: u64 = 64 * 1024;
+
 /// Parse SSE (Server-Sent Events) stream and process data lines.
 ///
 /// This helper handles:
@@ -241,24 +275,28 @@ fn create_agent() -> ureq::Agent {
 /// - Multi-line data accumulation
 /// - [DONE] termination marker
 ///
+/// Lines are framed straight out of the reader's buffer into one reused line
+/// buffer, and event data accumulates in one reused `String`, so steady-state
+/// streaming allocates nothing per line or event. After `[DONE]` the rest of
+/// the body is drained so the keep-alive connection can be reused.
+///
 /// # Arguments
 ///
 /// * `reader` - A BufRead implementation (typically from response body)
 /// * `on_data` - Callback invoked for each complete data payload; returns true to continue, false to stop
-// Maximum size for a single SSE event data buffer (16 MB).
-// Prevents unbounded memory growth from malicious or misbehaving servers.
-const SSE_MAX_EVENT_SIZE: usize = 16 * 1024 * 1024;
-
-fn stream_sse_lines<R: BufRead>(
-    reader: R,
+pub(crate) fn stream_sse_lines<R: BufRead>(
+    mut reader: R,
     mut on_data: impl FnMut(&str) -> Result<bool>,
 ) -> Result<()> {
+    let mut line = Vec::with_capacity(1024);
     let mut data_buf = String::new();
 
-    for line in reader.lines() {
-        let mut line = line.context("Failed to read SSE line")?;
-        // Handle CRLF endings
-        if line.ends_with('\r') {
+    while read_sse_line(&mut reader, &mut line)? {
+        // Handle LF and CRLF endings
+        if line.last() == Some(&b'\n') {
+            line.pop();
+        }
+        if line.last() == Some(&b'\r') {
             line.pop();
         }
 
@@ -268,6 +306,8 @@ fn stream_sse_lines<R: BufRead>(
                 continue;
             }
             if data_buf == "[DONE]" {
+                let mut tail = std::io::Read::take(&mut reader, SSE_DRAIN_LIMIT);
+                let _ = std::io::copy(&mut tail, &mut std::io::sink());
                 break;
             }
 
@@ -280,7 +320,8 @@ fn stream_sse_lines<R: BufRead>(
         }
 
         // Collect data lines
-        if let Some(d) = line.strip_prefix("data: ") {
+        if let Some(d) = line.strip_prefix(b"data: ") {
+            let d = std::str::from_utf8(d).context("Failed to read SSE line")?;
             if data_buf.len().saturating_add(d.len()) > SSE_MAX_EVENT_SIZE {
                 anyhow::bail!(
                     "SSE event exceeded maximum size of {} bytes",
@@ -296,6 +337,23 @@ fn stream_sse_lines<R: BufRead>(
     Ok(())
 }
 
+/// Read one line (including its `\n`) into `line`, reusing its allocation.
+/// Returns false at end of stream. A line may not exceed the event size cap.
+fn read_sse_line<R: BufRead>(reader: &mut R, line: &mut Vec<u8>) -> Result<bool> {
+    line.clear();
+    let limit = SSE_MAX_EVENT_SIZE as u64 + 1;
+    let read = std::io::Read::take(reader, limit)
+        .read_until(b'\n', line)
+        .context("Failed to read SSE line")?;
+    if line.len() > SSE_MAX_EVENT_SIZE {
+        anyhow::bail!(
+            "SSE line exceeded maximum size of {} bytes",
+            SSE_MAX_EVENT_SIZE
+        );
+    }
+    Ok(read > 0)
+}
+
 /// Image data for multimodal API calls
 #[derive(Debug, Clone)]
 pub struct ProviderImage {
@@ -445,7 +503,7 @@ impl OpenAiProvider {
     pub fn new(api_key: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("openai", "OpenAI", api_key),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -453,7 +511,7 @@ impl OpenAiProvider {
     pub fn with_base_url(api_key: impl Into<String>, base_url: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("openai", "OpenAI", api_key).with_base_url(base_url),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -694,7 +752,7 @@ impl AnthropicProvider {
     pub fn new(api_key: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("anthropic", "Anthropic", api_key),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -702,7 +760,7 @@ impl AnthropicProvider {
     pub fn with_base_url(api_key: impl Into<String>, base_url: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("anthropic", "Anthropic", api_key).with_base_url(base_url),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -959,7 +1017,7 @@ impl GoogleProvider {
     pub fn new(api_key: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("google", "Google Gemini", api_key),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -1182,7 +1240,7 @@ impl GroqProvider {
     pub fn new(api_key: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("groq", "Groq", api_key),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -1367,7 +1425,7 @@ impl VercelGatewayProvider {
     pub fn new(api_key: impl Into<String>) -> Self {
         Self {
             config: ProviderConfig::new("vercel", "Vercel AI Gateway", api_key),
-            agent: create_agent(),
+            agent: shared_agent(),
         }
     }
 
@@ -2746,6 +2804,50 @@ mod tests {
         assert_eq!(collected, vec!["first", "second"]);
     }
 
+    #[test]
+    fn test_stream_sse_lines_frames_across_small_reads() {
+        use std::io::{BufReader, Cursor};
+
+        // Lines split across many fill_buf calls still frame correctly
+        let sse_data = "data: multi\ndata: line\n\nevent: ping\n\ndata: {\"a\":1}\r\n\r\n";
+        let reader = BufReader::with_capacity(3, Cursor::new(sse_data));
+
+        let mut collected = Vec::new();
+        stream_sse_lines(reader, |data| {
+            collected.push(data.to_string());
+            Ok(true)
+        })
+        .unwrap();
+
+        assert_eq!(collected, vec!["multi\nline", "{\"a\":1}"]);
+    }
+
+    #[test]
+    fn test_stream_sse_lines_done_drains_body_for_reuse() {
+        use std::io::Cursor;
+
+        let sse_data = "data: first\n\ndata: [DONE]\n\n: trailing comment\n";
+        let mut reader = Cursor::new(sse_data);
+
+        stream_sse_lines(&mut reader, |_| Ok(true)).unwrap();
+
+        assert_eq!(
+            reader.position() as usize,
+            sse_data.len(),
+            "the body should be read to the end so the connection can return to the pool"
+        );
+    }
+
+    #[test]
+    fn test_stream_sse_lines_rejects_invalid_utf8() {
+        use std::io::Cursor;
+
+        let reader = Cursor::new(b"data: \xff\xfe\n\n".to_vec());
+        let error = stream_sse_lines(reader, |_| Ok(true)).unwrap_err();
+
+        assert!(error.to_string().contains("Failed to read SSE line"));
+    }
+
     #[test]
     fn test_vercel_provider() {
         let provider = VercelGatewayProvider::new("test-key");
@@ -2884,6 +2986,19 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_shared_agent_is_https_only_and_pooled() {
+        let agent = shared_agent();
+        let config = agent.config();
+
+        assert!(config.https_only());
+        assert!(!config.http_status_as_error());
+        assert_eq!(
+            config.max_idle_connections_per_host(),
+            POOL_MAX_IDLE_CONNECTIONS_PER_HOST
+        );
+    }
+
     #[test]
     fn test_should_retry_http_status_when_transient() {
         for status in [408, 429, 500, 502, 503, 504] {
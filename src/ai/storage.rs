@@ -8,17 +8,15 @@ use chrono::{DateTime, Utc};
 use rusqlite::{params, params_from_iter, Connection, OptionalExtension};
 use std::collections::HashMap;
 use std::path::PathBuf;
-use std::sync::{Arc, Mutex, OnceLock};
+use std::sync::{Arc, OnceLock};
 use tracing::{debug, info};
 
 use super::model::{Chat, ChatId, ChatSource, ImageAttachment, Message, MessageRole};
 
-/// Global database connection for AI chats
-static AI_DB: OnceLock<Arc<Mutex<Connection>>> = OnceLock::new();
+use crate::utils::sqlite_pool::{SqlitePool, DEFAULT_READ_CONNECTIONS};
 
-fn db_lock_err(e: impl std::fmt::Display) -> anyhow::Error {
-    anyhow::anyhow!("DB lock error: {e}")
-}
+/// Global database pool for AI chats (writer plus read-only WAL connections)
+static AI_DB: OnceLock<Arc<SqlitePool>> = OnceLock::new();
 
 /// Storage-level alias used by bulk chat creation APIs.
 pub type ChatMessage = Message;
@@ -243,7 +241,8 @@ fn init_ai_db_at(db_path: PathBuf) -> Result<()> {
 
     // Try to set the global connection. If another thread beat us to it
     // (race condition), that's fine - just return success (idempotent).
-    if AI_DB.set(Arc::new(Mutex::new(conn))).is_err() {
+    let pool = SqlitePool::new("ai_chats", &db_path, conn, DEFAULT_READ_CONNECTIONS);
+    if AI_DB.set(Arc::new(pool)).is_err() {
         debug!("AI database was initialized by another thread, using existing connection");
     }
 
@@ -258,8 +257,8 @@ pub fn init_ai_db() -> Result<()> {
     init_ai_db_at(get_ai_db_path())
 }
 
-/// Get a reference to the AI database connection
-fn get_db() -> Result<Arc<Mutex<Connection>>> {
+/// Get a reference to the AI database pool
+fn get_db() -> Result<Arc<SqlitePool>> {
     AI_DB
         .get()
         .cloned()
@@ -371,203 +370,194 @@ fn save_message_record(
 
 /// Create a new chat
 pub fn create_chat(chat: &Chat) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    insert_chat_record(&conn, chat)?;
+    get_db()?.with_write("create_chat", |conn| {
+        insert_chat_record(conn, chat)?;
 
-    debug!(chat_id = %chat.id, title = %chat.title, "Chat created");
-    Ok(())
+        debug!(chat_id = %chat.id, title = %chat.title, "Chat created");
+        Ok(())
+    })
 }
 
 /// Create a chat and all of its messages in a single SQLite transaction.
 pub fn create_chat_with_messages_bulk(chat: &Chat, messages: &[ChatMessage]) -> Result<()> {
-    let db = get_db()?;
-    let mut conn = db.lock().map_err(db_lock_err)?;
-
-    let tx = conn
-        .transaction()
-        .context("Failed to start bulk chat transaction")?;
+    get_db()?.with_write("create_chat_with_messages_bulk", |conn| {
+        let tx = conn
+            .transaction()
+            .context("Failed to start bulk chat transaction")?;
 
-    insert_chat_record(&tx, chat).context("Failed to create chat in bulk insert")?;
+        insert_chat_record(&tx, chat).context("Failed to create chat in bulk insert")?;
 
-    for message in messages {
-        save_message_record(&tx, message, true).with_context(|| {
-            format!(
-                "Failed to save message {} while bulk-creating chat {}",
-                message.id, chat.id
-            )
-        })?;
-    }
+        for message in messages {
+            save_message_record(&tx, message, true).with_context(|| {
+                format!(
+                    "Failed to save message {} while bulk-creating chat {}",
+                    message.id, chat.id
+                )
+            })?;
+        }
 
-    tx.commit()
-        .context("Failed to commit bulk chat transaction")?;
+        tx.commit()
+            .context("Failed to commit bulk chat transaction")?;
 
-    debug!(
-        chat_id = %chat.id,
-        title = %chat.title,
-        message_count = messages.len(),
-        "Chat and messages created in bulk transaction"
-    );
-    Ok(())
+        debug!(
+            chat_id = %chat.id,
+            title = %chat.title,
+            message_count = messages.len(),
+            "Chat and messages created in bulk transaction"
+        );
+        Ok(())
+    })
 }
 
 /// Update an existing chat
 pub fn update_chat(chat: &Chat) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    conn.execute(
-        r#"
-        UPDATE chats
-        SET title = ?2, updated_at = ?3, deleted_at = ?4, model_id = ?5, provider = ?6, source = ?7
-        WHERE id = ?1
-        "#,
-        params![
-            chat.id.as_str(),
-            chat.title,
-            chat.updated_at.to_rfc3339(),
-            chat.deleted_at.map(|dt| dt.to_rfc3339()),
-            chat.model_id,
-            chat.provider,
-            chat.source.as_str(),
-        ],
-    )
-    .context("Failed to update chat")?;
+    get_db()?.with_write("update_chat", |conn| {
+        conn.execute(
+            r#"
+            UPDATE chats
+            SET title = ?2, updated_at = ?3, deleted_at = ?4, model_id = ?5, provider = ?6, source = ?7
+            WHERE id = ?1
+            "#,
+            params![
+                chat.id.as_str(),
+                chat.title,
+                chat.updated_at.to_rfc3339(),
+                chat.deleted_at.map(|dt| dt.to_rfc3339()),
+                chat.model_id,
+                chat.provider,
+                chat.source.as_str(),
+            ],
+        )
+        .context("Failed to update chat")?;
 
-    debug!(chat_id = %chat.id, "Chat updated");
-    Ok(())
+        debug!(chat_id = %chat.id, "Chat updated");
+        Ok(())
+    })
 }
 
 /// Update chat title
 pub fn update_chat_title(chat_id: &ChatId, title: &str) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let now = Utc::now().to_rfc3339();
+    get_db()?.with_write("update_chat_title", |conn| {
+        let now = Utc::now().to_rfc3339();
 
-    conn.execute(
-        "UPDATE chats SET title = ?2, updated_at = ?3 WHERE id = ?1",
-        params![chat_id.as_str(), title, now],
-    )
-    .context("Failed to update chat title")?;
+        conn.execute(
+            "UPDATE chats SET title = ?2, updated_at = ?3 WHERE id = ?1",
+            params![chat_id.as_str(), title, now],
+        )
+        .context("Failed to update chat title")?;
 
-    debug!(chat_id = %chat_id, title = %title, "Chat title updated");
-    Ok(())
+        debug!(chat_id = %chat_id, title = %title, "Chat title updated");
+        Ok(())
+    })
 }
 
 /// Get a chat by ID
 #[must_use = "query result should be checked"]
 pub fn get_chat(id: &ChatId) -> Result<Option<Chat>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, title, created_at, updated_at, deleted_at, model_id, provider, source
-            FROM chats
-            WHERE id = ?1
-            "#,
-        )
-        .context("Failed to prepare get_chat query")?;
+    get_db()?.with_read("get_chat", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, title, created_at, updated_at, deleted_at, model_id, provider, source
+                FROM chats
+                WHERE id = ?1
+                "#,
+            )
+            .context("Failed to prepare get_chat query")?;
 
-    let result = stmt
-        .query_row(params![id.as_str()], row_to_chat)
-        .optional()
-        .context("Failed to get chat")?;
+        let result = stmt
+            .query_row(params![id.as_str()], row_to_chat)
+            .optional()
+            .context("Failed to get chat")?;
 
-    Ok(result)
+        Ok(result)
+    })
 }
 
 /// Get all active chats (not deleted), sorted by updated_at desc
 #[must_use = "query result should be checked"]
 pub fn get_all_chats() -> Result<Vec<Chat>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, title, created_at, updated_at, deleted_at, model_id, provider, source
-            FROM chats
-            WHERE deleted_at IS NULL
-            ORDER BY updated_at DESC
-            "#,
-        )
-        .context("Failed to prepare get_all_chats query")?;
+    get_db()?.with_read("get_all_chats", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, title, created_at, updated_at, deleted_at, model_id, provider, source
+                FROM chats
+                WHERE deleted_at IS NULL
+                ORDER BY updated_at DESC
+                "#,
+            )
+            .context("Failed to prepare get_all_chats query")?;
 
-    let chats = stmt
-        .query_map([], row_to_chat)
-        .context("Failed to query chats")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect chats")?;
+        let chats = stmt
+            .query_map([], row_to_chat)
+            .context("Failed to query chats")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect chats")?;
 
-    debug!(count = chats.len(), "Retrieved all chats");
-    Ok(chats)
+        debug!(count = chats.len(), "Retrieved all chats");
+        Ok(chats)
+    })
 }
 
 /// Get chats in trash (soft-deleted)
 #[must_use = "query result should be checked"]
 pub fn get_deleted_chats() -> Result<Vec<Chat>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, title, created_at, updated_at, deleted_at, model_id, provider, source
-            FROM chats
-            WHERE deleted_at IS NOT NULL
-            ORDER BY deleted_at DESC
-            "#,
-        )
-        .context("Failed to prepare get_deleted_chats query")?;
+    get_db()?.with_read("get_deleted_chats", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, title, created_at, updated_at, deleted_at, model_id, provider, source
+                FROM chats
+                WHERE deleted_at IS NOT NULL
+                ORDER BY deleted_at DESC
+                "#,
+            )
+            .context("Failed to prepare get_deleted_chats query")?;
 
-    let chats = stmt
-        .query_map([], row_to_chat)
-        .context("Failed to query deleted chats")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect deleted chats")?;
+        let chats = stmt
+            .query_map([], row_to_chat)
+            .context("Failed to query deleted chats")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect deleted chats")?;
 
-    debug!(count = chats.len(), "Retrieved deleted chats");
-    Ok(chats)
+        debug!(count = chats.len(), "Retrieved deleted chats");
+        Ok(chats)
+    })
 }
 
 /// Soft delete a chat
 pub fn delete_chat(chat_id: &ChatId) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let now = Utc::now().to_rfc3339();
+    get_db()?.with_write("delete_chat", |conn| {
+        let now = Utc::now().to_rfc3339();
 
-    conn.execute(
-        "UPDATE chats SET deleted_at = ?2, updated_at = ?2 WHERE id = ?1",
-        params![chat_id.as_str(), now],
-    )
-    .context("Failed to soft delete chat")?;
+        conn.execute(
+            "UPDATE chats SET deleted_at = ?2, updated_at = ?2 WHERE id = ?1",
+            params![chat_id.as_str(), now],
+        )
+        .context("Failed to soft delete chat")?;
 
-    info!(chat_id = %chat_id, "Chat soft deleted");
-    Ok(())
+        info!(chat_id = %chat_id, "Chat soft deleted");
+        Ok(())
+    })
 }
 
 /// Permanently delete a chat and all its messages
 pub fn delete_chat_permanently(chat_id: &ChatId) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    // Delete messages first (foreign key constraint)
-    conn.execute(
-        "DELETE FROM messages WHERE chat_id = ?1",
-        params![chat_id.as_str()],
-    )
-    .context("Failed to delete chat messages")?;
+    get_db()?.with_write("delete_chat_permanently", |conn| {
+        // Delete messages first (foreign key constraint)
+        conn.execute(
+            "DELETE FROM messages WHERE chat_id = ?1",
+            params![chat_id.as_str()],
+        )
+        .context("Failed to delete chat messages")?;
 
-    conn.execute("DELETE FROM chats WHERE id = ?1", params![chat_id.as_str()])
-        .context("Failed to delete chat")?;
+        conn.execute("DELETE FROM chats WHERE id = ?1", params![chat_id.as_str()])
+            .context("Failed to delete chat")?;
 
-    info!(chat_id = %chat_id, "Chat permanently deleted");
-    Ok(())
+        info!(chat_id = %chat_id, "Chat permanently deleted");
+        Ok(())
+    })
 }
 
 /// Sanitize a query string for FTS5 MATCH.
@@ -610,69 +600,68 @@ pub fn search_chats(query: &str) -> Result<Vec<Chat>> {
         return get_all_chats();
     }
 
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    // Try FTS search first, fall back to LIKE on error
-    let sanitized_query = sanitize_fts_query(query);
-
-    // Attempt FTS search with corrected aliases
-    let fts_result: rusqlite::Result<Vec<Chat>> = (|| {
-        let mut stmt = conn.prepare(
-            r#"
-            SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
-                   c.deleted_at, c.model_id, c.provider, c.source
-            FROM chats c
-            LEFT JOIN chats_fts fts ON c.rowid = fts.rowid
-            LEFT JOIN messages m ON c.id = m.chat_id
-            LEFT JOIN messages_fts mfts ON m.rowid = mfts.rowid
-            WHERE c.deleted_at IS NULL
-              AND (fts MATCH ?1 OR mfts MATCH ?1)
-            ORDER BY c.updated_at DESC
-            "#,
-        )?;
-
-        let chats = stmt
-            .query_map(params![sanitized_query], row_to_chat)?
-            .collect::<Result<Vec<_>, _>>()?;
-        Ok(chats)
-    })();
-
-    match fts_result {
-        Ok(chats) => {
-            debug!(query = %query, count = chats.len(), method = "fts", "Chat search completed");
-            Ok(chats)
-        }
-        Err(e) => {
-            // FTS failed (possibly due to special characters or other issues)
-            // Fall back to simple LIKE search on title
-            debug!(error = %e, query = %query, "FTS search failed, falling back to LIKE");
-
-            let like_pattern = format!("%{}%", query);
-            let mut stmt = conn
-                .prepare(
-                    r#"
-                    SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
-                           c.deleted_at, c.model_id, c.provider, c.source
-                    FROM chats c
-                    LEFT JOIN messages m ON c.id = m.chat_id
-                    WHERE c.deleted_at IS NULL
-                      AND (c.title LIKE ?1 OR m.content LIKE ?1)
-                    ORDER BY c.updated_at DESC
-                    "#,
-                )
-                .context("Failed to prepare LIKE search query")?;
+    get_db()?.with_read("search_chats", |conn| {
+        // Try FTS search first, fall back to LIKE on error
+        let sanitized_query = sanitize_fts_query(query);
+
+        // Attempt FTS search with corrected aliases
+        let fts_result: rusqlite::Result<Vec<Chat>> = (|| {
+            let mut stmt = conn.prepare(
+                r#"
+                SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
+                       c.deleted_at, c.model_id, c.provider, c.source
+                FROM chats c
+                LEFT JOIN chats_fts fts ON c.rowid = fts.rowid
+                LEFT JOIN messages m ON c.id = m.chat_id
+                LEFT JOIN messages_fts mfts ON m.rowid = mfts.rowid
+                WHERE c.deleted_at IS NULL
+                  AND (fts MATCH ?1 OR mfts MATCH ?1)
+                ORDER BY c.updated_at DESC
+                "#,
+            )?;
 
             let chats = stmt
-                .query_map(params![like_pattern], row_to_chat)
-                .context("Failed to execute LIKE search")?
-                .collect::<Result<Vec<_>, _>>()
-                .context("Failed to collect LIKE search results")?;
-
-            debug!(query = %query, count = chats.len(), method = "like", "Chat search completed (fallback)");
+                .query_map(params![sanitized_query], row_to_chat)?
+                .collect::<Result<Vec<_>, _>>()?;
             Ok(chats)
+        })();
+
+        match fts_result {
+            Ok(chats) => {
+                debug!(query = %query, count = chats.len(), method = "fts", "Chat search completed");
+                Ok(chats)
+            }
+            Err(e) => {
+                // FTS failed (possibly due to special characters or other issues)
+                // Fall back to simple LIKE search on title
+                debug!(error = %e, query = %query, "FTS search failed, falling back to LIKE");
+
+                let like_pattern = format!("%{}%", query);
+                let mut stmt = conn
+                    .prepare(
+                        r#"
+                        SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
+                               c.deleted_at, c.model_id, c.provider, c.source
+                        FROM chats c
+                        LEFT JOIN messages m ON c.id = m.chat_id
+                        WHERE c.deleted_at IS NULL
+                          AND (c.title LIKE ?1 OR m.content LIKE ?1)
+                        ORDER BY c.updated_at DESC
+                        "#,
+                    )
+                    .context("Failed to prepare LIKE search query")?;
+
+                let chats = stmt
+                    .query_map(params![like_pattern], row_to_chat)
+                    .context("Failed to execute LIKE search")?
+                    .collect::<Result<Vec<_>, _>>()
+                    .context("Failed to collect LIKE search results")?;
+
+                debug!(query = %query, count = chats.len(), method = "like", "Chat search completed (fallback)");
+                Ok(chats)
+            }
         }
-    }
+    })
 }
 
 /// Result of a full-text search including match context snippets.
@@ -704,88 +693,87 @@ pub fn search_chats_with_snippets(query: &str) -> Result<Vec<ChatSearchResult>>
             .collect());
     }
 
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let sanitized_query = sanitize_fts_query(query);
-    let query_lower = query.trim().to_lowercase();
-
-    // Try FTS search first
-    let fts_result: rusqlite::Result<Vec<ChatSearchResult>> = (|| {
-        let mut stmt = conn.prepare(
-            r#"
-            SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
-                   c.deleted_at, c.model_id, c.provider, c.source,
-                   m.content AS match_content
-            FROM chats c
-            LEFT JOIN chats_fts fts ON c.rowid = fts.rowid
-            LEFT JOIN messages m ON c.id = m.chat_id
-            LEFT JOIN messages_fts mfts ON m.rowid = mfts.rowid
-            WHERE c.deleted_at IS NULL
-              AND (fts MATCH ?1 OR mfts MATCH ?1)
-            ORDER BY c.updated_at DESC
-            "#,
-        )?;
-
-        let results = stmt
-            .query_map(params![sanitized_query], |row| {
-                let chat = row_to_chat(row)?;
-                let match_content: Option<String> = row.get(8)?;
-                Ok((chat, match_content))
-            })?
-            .collect::<Result<Vec<_>, _>>()?;
-
-        Ok(deduplicate_search_results(results, &query_lower))
-    })();
-
-    match fts_result {
-        Ok(results) => {
-            info!(
-                query = %query,
-                count = results.len(),
-                method = "fts_snippets",
-                "Chat search with snippets completed"
-            );
-            Ok(results)
-        }
-        Err(e) => {
-            debug!(error = %e, query = %query, "FTS snippet search failed, falling back to LIKE");
-            let like_pattern = format!("%{}%", query);
-            let mut stmt = conn
-                .prepare(
-                    r#"
-                    SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
-                           c.deleted_at, c.model_id, c.provider, c.source,
-                           m.content AS match_content
-                    FROM chats c
-                    LEFT JOIN messages m ON c.id = m.chat_id
-                    WHERE c.deleted_at IS NULL
-                      AND (c.title LIKE ?1 OR m.content LIKE ?1)
-                    ORDER BY c.updated_at DESC
-                    "#,
-                )
-                .context("Failed to prepare LIKE snippet search")?;
+    get_db()?.with_read("search_chats_with_snippets", |conn| {
+        let sanitized_query = sanitize_fts_query(query);
+        let query_lower = query.trim().to_lowercase();
+
+        // Try FTS search first
+        let fts_result: rusqlite::Result<Vec<ChatSearchResult>> = (|| {
+            let mut stmt = conn.prepare(
+                r#"
+                SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
+                       c.deleted_at, c.model_id, c.provider, c.source,
+                       m.content AS match_content
+                FROM chats c
+                LEFT JOIN chats_fts fts ON c.rowid = fts.rowid
+                LEFT JOIN messages m ON c.id = m.chat_id
+                LEFT JOIN messages_fts mfts ON m.rowid = mfts.rowid
+                WHERE c.deleted_at IS NULL
+                  AND (fts MATCH ?1 OR mfts MATCH ?1)
+                ORDER BY c.updated_at DESC
+                "#,
+            )?;
 
             let results = stmt
-                .query_map(params![like_pattern], |row| {
+                .query_map(params![sanitized_query], |row| {
                     let chat = row_to_chat(row)?;
                     let match_content: Option<String> = row.get(8)?;
                     Ok((chat, match_content))
-                })
-                .context("Failed to execute LIKE snippet search")?
-                .collect::<Result<Vec<_>, _>>()
-                .context("Failed to collect LIKE snippet results")?;
-
-            let deduplicated = deduplicate_search_results(results, &query_lower);
-            info!(
-                query = %query,
-                count = deduplicated.len(),
-                method = "like_snippets",
-                "Chat search with snippets completed (fallback)"
-            );
-            Ok(deduplicated)
+                })?
+                .collect::<Result<Vec<_>, _>>()?;
+
+            Ok(deduplicate_search_results(results, &query_lower))
+        })();
+
+        match fts_result {
+            Ok(results) => {
+                info!(
+                    query = %query,
+                    count = results.len(),
+                    method = "fts_snippets",
+                    "Chat search with snippets completed"
+                );
+                Ok(results)
+            }
+            Err(e) => {
+                debug!(error = %e, query = %query, "FTS snippet search failed, falling back to LIKE");
+                let like_pattern = format!("%{}%", query);
+                let mut stmt = conn
+                    .prepare(
+                        r#"
+                        SELECT DISTINCT c.id, c.title, c.created_at, c.updated_at,
+                               c.deleted_at, c.model_id, c.provider, c.source,
+                               m.content AS match_content
+                        FROM chats c
+                        LEFT JOIN messages m ON c.id = m.chat_id
+                        WHERE c.deleted_at IS NULL
+                          AND (c.title LIKE ?1 OR m.content LIKE ?1)
+                        ORDER BY c.updated_at DESC
+                        "#,
+                    )
+                    .context("Failed to prepare LIKE snippet search")?;
+
+                let results = stmt
+                    .query_map(params![like_pattern], |row| {
+                        let chat = row_to_chat(row)?;
+                        let match_content: Option<String> = row.get(8)?;
+                        Ok((chat, match_content))
+                    })
+                    .context("Failed to execute LIKE snippet search")?
+                    .collect::<Result<Vec<_>, _>>()
+                    .context("Failed to collect LIKE snippet results")?;
+
+                let deduplicated = deduplicate_search_results(results, &query_lower);
+                info!(
+                    query = %query,
+                    count = deduplicated.len(),
+                    method = "like_snippets",
+                    "Chat search with snippets completed (fallback)"
+                );
+                Ok(deduplicated)
+            }
         }
-    }
+    })
 }
 
 /// Deduplicate search results (a chat may match multiple messages) and extract snippets.
@@ -890,39 +878,37 @@ fn save_message_without_update(message: &Message) -> Result<()> {
 /// and chat timestamp update succeed, or both are rolled back.
 /// This also reduces fsync overhead by committing once instead of twice.
 fn save_message_internal(message: &Message, update_chat_timestamp: bool) -> Result<()> {
-    let db = get_db()?;
-    let mut conn = db.lock().map_err(db_lock_err)?;
-
-    // Wrap both operations in a single transaction for:
-    // 1. Atomicity: both succeed or both fail
-    // 2. Performance: one fsync instead of two autocommit fsyncs
-    let tx = conn.transaction().context("Failed to start transaction")?;
-
-    save_message_record(&tx, message, update_chat_timestamp)?;
-
-    tx.commit()
-        .context("Failed to commit message transaction")?;
-
-    debug!(
-        message_id = %message.id,
-        chat_id = %message.chat_id,
-        role = %message.role,
-        image_count = message.images.len(),
-        "Message saved"
-    );
-    Ok(())
+    get_db()?.with_write("save_message_internal", |conn| {
+        // Wrap both operations in a single transaction for:
+        // 1. Atomicity: both succeed or both fail
+        // 2. Performance: one fsync instead of two autocommit fsyncs
+        let tx = conn.transaction().context("Failed to start transaction")?;
+
+        save_message_record(&tx, message, update_chat_timestamp)?;
+
+        tx.commit()
+            .context("Failed to commit message transaction")?;
+
+        debug!(
+            message_id = %message.id,
+            chat_id = %message.chat_id,
+            role = %message.role,
+            image_count = message.images.len(),
+            "Message saved"
+        );
+        Ok(())
+    })
 }
 
 /// Delete a single message by ID
 pub fn delete_message(message_id: &str) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    conn.execute("DELETE FROM messages WHERE id = ?1", params![message_id])
-        .context("Failed to delete message")?;
+    get_db()?.with_write("delete_message", |conn| {
+        conn.execute("DELETE FROM messages WHERE id = ?1", params![message_id])
+            .context("Failed to delete message")?;
 
-    debug!(message_id = %message_id, "Message deleted");
-    Ok(())
+        debug!(message_id = %message_id, "Message deleted");
+        Ok(())
+    })
 }
 
 /// Delete multiple messages atomically.
@@ -934,107 +920,104 @@ pub fn delete_messages_batch(message_ids: &[String]) -> Result<()> {
         return Ok(());
     }
 
-    let db = get_db()?;
-    let mut conn = db.lock().map_err(db_lock_err)?;
-
-    let tx = conn
-        .transaction()
-        .context("Failed to start batch delete transaction")?;
-
-    let mut delete_stmt = tx
-        .prepare("DELETE FROM messages WHERE id = ?1")
-        .context("Failed to prepare batch message delete statement")?;
-
-    for message_id in message_ids {
-        let rows_deleted = delete_stmt
-            .execute(params![message_id])
-            .with_context(|| format!("Failed to delete message {} in batch", message_id))?;
-
-        if rows_deleted != 1 {
-            drop(delete_stmt);
-            tx.rollback()
-                .context("Failed to rollback batch delete after mismatch")?;
-            return Err(anyhow::anyhow!(
-                "Batch delete mismatch for message {}: expected 1 row deleted, got {}",
-                message_id,
-                rows_deleted
-            ));
+    get_db()?.with_write("delete_messages_batch", |conn| {
+        let tx = conn
+            .transaction()
+            .context("Failed to start batch delete transaction")?;
+
+        let mut delete_stmt = tx
+            .prepare("DELETE FROM messages WHERE id = ?1")
+            .context("Failed to prepare batch message delete statement")?;
+
+        for message_id in message_ids {
+            let rows_deleted = delete_stmt
+                .execute(params![message_id])
+                .with_context(|| format!("Failed to delete message {} in batch", message_id))?;
+
+            if rows_deleted != 1 {
+                drop(delete_stmt);
+                tx.rollback()
+                    .context("Failed to rollback batch delete after mismatch")?;
+                return Err(anyhow::anyhow!(
+                    "Batch delete mismatch for message {}: expected 1 row deleted, got {}",
+                    message_id,
+                    rows_deleted
+                ));
+            }
         }
-    }
 
-    drop(delete_stmt);
-    tx.commit()
-        .context("Failed to commit batch message delete transaction")?;
+        drop(delete_stmt);
+        tx.commit()
+            .context("Failed to commit batch message delete transaction")?;
 
-    debug!(count = message_ids.len(), "Batch messages deleted");
-    Ok(())
+        debug!(count = message_ids.len(), "Batch messages deleted");
+        Ok(())
+    })
 }
 
 /// Get all messages for a chat, ordered by creation time
 #[must_use = "query result should be checked"]
 pub fn get_chat_messages(chat_id: &ChatId) -> Result<Vec<Message>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, chat_id, role, content, created_at, tokens_used
-            FROM messages
-            WHERE chat_id = ?1
-            ORDER BY created_at ASC
-            "#,
-        )
-        .context("Failed to prepare get_chat_messages query")?;
+    get_db()?.with_read("get_chat_messages", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, chat_id, role, content, created_at, tokens_used
+                FROM messages
+                WHERE chat_id = ?1
+                ORDER BY created_at ASC
+                "#,
+            )
+            .context("Failed to prepare get_chat_messages query")?;
 
-    let mut messages = stmt
-        .query_map(params![chat_id.as_str()], row_to_message)
-        .context("Failed to query messages")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect messages")?;
+        let mut messages = stmt
+            .query_map(params![chat_id.as_str()], row_to_message)
+            .context("Failed to query messages")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect messages")?;
 
-    populate_message_images(&conn, &mut messages)
-        .with_context(|| format!("Failed to populate images for chat {}", chat_id))?;
+        populate_message_images(conn, &mut messages)
+            .with_context(|| format!("Failed to populate images for chat {}", chat_id))?;
 
-    debug!(chat_id = %chat_id, count = messages.len(), "Retrieved chat messages");
-    Ok(messages)
+        debug!(chat_id = %chat_id, count = messages.len(), "Retrieved chat messages");
+        Ok(messages)
+    })
 }
 
 /// Get the last N messages for a chat
 #[must_use = "query result should be checked"]
 pub fn get_recent_messages(chat_id: &ChatId, limit: usize) -> Result<Vec<Message>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, chat_id, role, content, created_at, tokens_used
-            FROM messages
-            WHERE chat_id = ?1
-            ORDER BY created_at DESC
-            LIMIT ?2
-            "#,
-        )
-        .context("Failed to prepare get_recent_messages query")?;
+    get_db()?.with_read("get_recent_messages", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, chat_id, role, content, created_at, tokens_used
+                FROM messages
+                WHERE chat_id = ?1
+                ORDER BY created_at DESC
+                LIMIT ?2
+                "#,
+            )
+            .context("Failed to prepare get_recent_messages query")?;
 
-    let mut messages: Vec<Message> = stmt
-        .query_map(params![chat_id.as_str(), limit as i64], row_to_message)
-        .context("Failed to query recent messages")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect recent messages")?;
+        let mut messages: Vec<Message> = stmt
+            .query_map(params![chat_id.as_str(), limit as i64], row_to_message)
+            .context("Failed to query recent messages")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect recent messages")?;
 
-    // Reverse to get chronological order
-    messages.reverse();
+        // Reverse to get chronological order
+        messages.reverse();
 
-    populate_message_images(&conn, &mut messages).with_context(|| {
-        format!(
-            "Failed to populate images for recent messages in chat {}",
-            chat_id
-        )
-    })?;
+        populate_message_images(conn, &mut messages).with_context(|| {
+            format!(
+                "Failed to populate images for recent messages in chat {}",
+                chat_id
+            )
+        })?;
 
-    Ok(messages)
+        Ok(messages)
+    })
 }
 
 // ============================================================================
@@ -1753,108 +1736,106 @@ pub fn insert_mock_data() -> Result<()> {
 /// Persist a full message-preparation audit as JSON.
 /// Safe to call multiple times for the same correlation_id; later calls upsert.
 pub fn save_message_preparation_audit(audit: &crate::ai::AiPreflightAudit) -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let audit_json = serde_json::to_string(audit).context("Failed to serialize preflight audit")?;
+    get_db()?.with_write("save_message_preparation_audit", |conn| {
+        let audit_json =
+            serde_json::to_string(audit).context("Failed to serialize preflight audit")?;
 
-    conn.execute(
-        r#"
-        INSERT INTO message_preparation_audits (
-            correlation_id,
-            chat_id,
-            message_id,
-            decision,
-            attempted,
-            resolved,
-            failures_count,
-            raw_content,
-            authored_content,
-            audit_json,
-            created_at
+        conn.execute(
+            r#"
+            INSERT INTO message_preparation_audits (
+                correlation_id,
+                chat_id,
+                message_id,
+                decision,
+                attempted,
+                resolved,
+                failures_count,
+                raw_content,
+                authored_content,
+                audit_json,
+                created_at
+            )
+            VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11)
+            ON CONFLICT(correlation_id) DO UPDATE SET
+                message_id = excluded.message_id,
+                decision = excluded.decision,
+                attempted = excluded.attempted,
+                resolved = excluded.resolved,
+                failures_count = excluded.failures_count,
+                raw_content = excluded.raw_content,
+                authored_content = excluded.authored_content,
+                audit_json = excluded.audit_json,
+                created_at = excluded.created_at
+            "#,
+            params![
+                audit.correlation_id.as_str(),
+                audit.chat_id.as_str(),
+                audit.message_id.as_deref(),
+                format!("{:?}", audit.decision),
+                audit.receipt.context.attempted as i64,
+                audit.receipt.context.resolved as i64,
+                audit.receipt.context.failures.len() as i64,
+                audit.raw_content.as_str(),
+                audit.authored_content.as_str(),
+                audit_json,
+                audit.created_at.as_str(),
+            ],
         )
-        VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11)
-        ON CONFLICT(correlation_id) DO UPDATE SET
-            message_id = excluded.message_id,
-            decision = excluded.decision,
-            attempted = excluded.attempted,
-            resolved = excluded.resolved,
-            failures_count = excluded.failures_count,
-            raw_content = excluded.raw_content,
-            authored_content = excluded.authored_content,
-            audit_json = excluded.audit_json,
-            created_at = excluded.created_at
-        "#,
-        params![
-            audit.correlation_id.as_str(),
-            audit.chat_id.as_str(),
-            audit.message_id.as_deref(),
-            format!("{:?}", audit.decision),
-            audit.receipt.context.attempted as i64,
-            audit.receipt.context.resolved as i64,
-            audit.receipt.context.failures.len() as i64,
-            audit.raw_content.as_str(),
-            audit.authored_content.as_str(),
-            audit_json,
-            audit.created_at.as_str(),
-        ],
-    )
-    .context("Failed to save message preparation audit")?;
-
-    tracing::info!(
-        target: "script_kit::ai_preflight",
-        correlation_id = %audit.correlation_id,
-        chat_id = %audit.chat_id,
-        message_id = ?audit.message_id,
-        decision = ?audit.decision,
-        "message_preparation_audit_saved"
-    );
+        .context("Failed to save message preparation audit")?;
+
+        tracing::info!(
+            target: "script_kit::ai_preflight",
+            correlation_id = %audit.correlation_id,
+            chat_id = %audit.chat_id,
+            message_id = ?audit.message_id,
+            decision = ?audit.decision,
+            "message_preparation_audit_saved"
+        );
 
-    Ok(())
+        Ok(())
+    })
 }
 
 /// Fetch the most recent preflight audit for a chat.
 pub fn get_last_message_preparation_audit(
     chat_id: &ChatId,
 ) -> Result<Option<crate::ai::AiPreflightAudit>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let audit_json = conn
-        .query_row(
-            r#"
-            SELECT audit_json
-            FROM message_preparation_audits
-            WHERE chat_id = ?1
-            ORDER BY created_at DESC
-            LIMIT 1
-            "#,
-            params![chat_id.as_str()],
-            |row| row.get::<_, String>(0),
-        )
-        .optional()
-        .context("Failed to load latest message preparation audit")?;
+    get_db()?.with_read("get_last_message_preparation_audit", |conn| {
+        let audit_json = conn
+            .query_row(
+                r#"
+                SELECT audit_json
+                FROM message_preparation_audits
+                WHERE chat_id = ?1
+                ORDER BY created_at DESC
+                LIMIT 1
+                "#,
+                params![chat_id.as_str()],
+                |row| row.get::<_, String>(0),
+            )
+            .optional()
+            .context("Failed to load latest message preparation audit")?;
 
-    audit_json
-        .map(|json| {
-            serde_json::from_str::<crate::ai::AiPreflightAudit>(&json)
-                .context("Failed to deserialize message preparation audit")
-        })
-        .transpose()
+        audit_json
+            .map(|json| {
+                serde_json::from_str::<crate::ai::AiPreflightAudit>(&json)
+                    .context("Failed to deserialize message preparation audit")
+            })
+            .transpose()
+    })
 }
 
 /// Clear all mock data (for test cleanup)
 pub fn clear_all_chats() -> Result<()> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    conn.execute("DELETE FROM messages", [])
-        .context("Failed to delete all messages")?;
-    conn.execute("DELETE FROM chats", [])
-        .context("Failed to delete all chats")?;
-
-    info!("All chats and messages cleared");
-    Ok(())
+    get_db()?.with_write("clear_all_chats", |conn| {
+        conn.execute("DELETE FROM messages", [])
+            .context("Failed to delete all messages")?;
+        conn.execute("DELETE FROM chats", [])
+            .context("Failed to delete all chats")?;
+
+        info!("All chats and messages cleared");
+        Ok(())
+    })
 }
 
 #[cfg(test)]
@@ -1954,8 +1935,8 @@ mod tests {
         // Ensure DB is initialized
         init_test_db();
 
-        let db = get_db().expect("Should get db connection");
-        let conn = db.lock().expect("Should lock connection");
+        let writer = get_db().expect("Should get db connection").writer();
+        let conn = writer.lock().expect("Should lock connection");
 
         // Query the trigger SQL to verify it uses "UPDATE OF" syntax
         let chat_trigger_sql: String = conn
@@ -1996,8 +1977,8 @@ mod tests {
         // Ensure DB is initialized
         init_test_db();
 
-        let db = get_db().expect("Should get db connection");
-        let conn = db.lock().expect("Should lock connection");
+        let writer = get_db().expect("Should get db connection").writer();
+        let conn = writer.lock().expect("Should lock connection");
 
         // Verify WAL mode is enabled
         let journal_mode: String = conn
@@ -5,7 +5,7 @@ use rusqlite::Connection;
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 use std::fs::File;
-use std::io::{BufRead, BufReader};
+use std::io::{BufRead, BufReader, Read, Seek, SeekFrom};
 use std::path::{Path, PathBuf};
 use std::process::Output;
 use std::sync::atomic::{AtomicU64, Ordering};
@@ -594,95 +594,467 @@ fn warm_ai_vault_index_inflight() -> &'static Mutex<Vec<String>> {
     INFLIGHT.get_or_init(|| Mutex::new(Vec::new()))
 }
 
+const CLAUDE_VAULT_FILE_LIMIT: usize = 300;
+const CLAUDE_VAULT_TERM_SEPARATOR: char = '\u{1e}';
+
 fn read_claude_vault_hits() -> Result<Vec<AiVaultHit>> {
     let root = home_dir().join(".claude").join("projects");
     let mut files = Vec::new();
     collect_jsonl_files(&root, &mut files);
-    files.sort_by(|a, b| b.1.cmp(&a.1));
-    files.truncate(300);
+    files.sort_by(|a, b| b.mtime.cmp(&a.mtime));
 
-    let mut hits = Vec::new();
-    for (path, mtime) in files {
-        if let Some(hit) = read_claude_vault_hit(&path, mtime) {
-            hits.push(hit);
+    let Some(index) = claude_vault_index() else {
+        return Err(anyhow!("AI Vault index unavailable"));
+    };
+    let mut index = index
+        .lock()
+        .map_err(|_| anyhow!("AI Vault index lock poisoned"))?;
+    let started = Instant::now();
+    let (hits, stats) = index.refresh(&files)?;
+    tracing::debug!(
+        target: "script_kit::ai_vault",
+        event = "ai_vault_claude_index_refreshed",
+        files = files.len(),
+        reused = stats.reused,
+        tailed = stats.tailed,
+        bytes_parsed = stats.bytes_parsed,
+        pruned = stats.pruned,
+        elapsed_ms = started.elapsed().as_millis() as u64,
+        "AI Vault Claude index refreshed"
+    );
+    Ok(hits)
+}
+
+#[derive(Debug, Clone)]
+struct ClaudeVaultFile {
+    path: PathBuf,
+    mtime: SystemTime,
+    len: u64,
+}
+
+/// Indexed state for one Claude Code session log.
+///
+/// `byte_offset` is the end of the last JSONL line that was consumed, so a
+/// rescan only reads bytes appended since then. Title, cwd and model are
+/// first-seen values and never change once set.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+struct ClaudeVaultIndexEntry {
+    session_id: String,
+    byte_offset: u64,
+    file_len: u64,
+    mtime_ms: i64,
+    newest_ms: i64,
+    title: Option<String>,
+    cwd: Option<String>,
+    model: Option<String>,
+    search_terms: Vec<String>,
+}
+
+impl ClaudeVaultIndexEntry {
+    fn new(session_id: String) -> Self {
+        Self {
+            session_id,
+            ..Self::default()
         }
     }
-    Ok(hits)
+
+    /// Once title, cwd and model are known, appended lines can only move the
+    /// newest timestamp forward, and the file mtime already covers that.
+    fn metadata_complete(&self) -> bool {
+        self.title.is_some() && self.cwd.is_some() && self.model.is_some()
+    }
 }
 
-fn read_claude_vault_hit(path: &Path, mtime: SystemTime) -> Option<AiVaultHit> {
-    let file = File::open(path).ok()?;
-    let reader = BufReader::new(file);
-    let session_id = path.file_stem()?.to_string_lossy().to_string();
-    let mut title = None;
-    let mut cwd = None;
-    let mut model = None;
-    let mut newest = mtime;
-    let mut search_terms = Vec::new();
-
-    for line in reader.lines().map_while(Result::ok).take(1000) {
-        let Ok(event) = serde_json::from_str::<serde_json::Value>(&line) else {
-            continue;
-        };
-        if let Some(timestamp) = event.get("timestamp").and_then(|value| value.as_str()) {
-            if let Some(parsed) = parse_timestamp(timestamp) {
-                newest = newest.max(parsed);
-            }
+#[derive(Debug, Default, Clone, Copy, PartialEq, Eq)]
+struct ClaudeVaultScanStats {
+    reused: usize,
+    tailed: usize,
+    bytes_parsed: u64,
+    pruned: usize,
+}
+
+/// Persistent tail-following index over `~/.claude/projects/**/*.jsonl`,
+/// stored in `~/.scriptkit/db/ai-vault-index.sqlite`.
+struct ClaudeVaultIndex {
+    conn: Connection,
+}
+
+impl ClaudeVaultIndex {
+    fn open(path: &Path) -> Result<Self> {
+        if let Some(parent) = path.parent() {
+            std::fs::create_dir_all(parent)
+                .with_context(|| format!("create AI Vault index dir: {}", parent.display()))?;
         }
-        if cwd.is_none() {
-            cwd = event
-                .get("cwd")
-                .and_then(|value| value.as_str())
-                .filter(|value| !value.trim().is_empty())
-                .map(ToString::to_string);
+        let conn = Connection::open(path)
+            .with_context(|| format!("open AI Vault index: {}", path.display()))?;
+        conn.execute_batch("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;")
+            .context("configure AI Vault index")?;
+        let index = Self::with_connection(conn)?;
+        // The index stores Claude prompt text as titles and search terms.
+        // Keep it (and its WAL/SHM sidecars) owner-only rather than umask.
+        crate::utils::db_permissions::harden_sqlite_permissions(path);
+        Ok(index)
+    }
+
+    fn open_in_memory() -> Result<Self> {
+        Self::with_connection(
+            Connection::open_in_memory().context("open in-memory AI Vault index")?,
+        )
+    }
+
+    fn with_connection(conn: Connection) -> Result<Self> {
+        conn.execute_batch(
+            r#"
+            CREATE TABLE IF NOT EXISTS claude_sessions (
+                path TEXT PRIMARY KEY,
+                session_id TEXT NOT NULL,
+                byte_offset INTEGER NOT NULL,
+                file_len INTEGER NOT NULL,
+                mtime_ms INTEGER NOT NULL,
+                newest_ms INTEGER NOT NULL,
+                title TEXT,
+                cwd TEXT,
+                model TEXT,
+                search_terms TEXT NOT NULL DEFAULT ''
+            );
+            "#,
+        )
+        .context("create AI Vault index schema")?;
+        Ok(Self { conn })
+    }
+
+    /// Bring the newest `CLAUDE_VAULT_FILE_LIMIT` logs up to date and return
+    /// their hits. Unchanged files are served straight from the table, grown
+    /// files are parsed from their stored offset, and rows for deleted logs are
+    /// pruned.
+    fn refresh(
+        &mut self,
+        files: &[ClaudeVaultFile],
+    ) -> Result<(Vec<AiVaultHit>, ClaudeVaultScanStats)> {
+        let mut stats = ClaudeVaultScanStats::default();
+        let mut hits = Vec::with_capacity(files.len().min(CLAUDE_VAULT_FILE_LIMIT));
+        let tx = self
+            .conn
+            .transaction()
+            .context("begin AI Vault index refresh")?;
+
+        for file in files.iter().take(CLAUDE_VAULT_FILE_LIMIT) {
+            let Some(session_id) = file
+                .path
+                .file_stem()
+                .map(|stem| stem.to_string_lossy().to_string())
+            else {
+                continue;
+            };
+            let key = file.path.to_string_lossy();
+            let mtime_ms = system_time_millis(file.mtime);
+            let entry = match load_claude_vault_entry(&tx, &key)? {
+                Some(entry) if entry.file_len == file.len && entry.mtime_ms == mtime_ms => {
+                    stats.reused += 1;
+                    entry
+                }
+                previous => {
+                    // A log that shrank was rewritten; start it over from byte 0.
+                    let mut entry = previous
+                        .filter(|entry| entry.byte_offset <= file.len)
+                        .unwrap_or_else(|| ClaudeVaultIndexEntry::new(session_id));
+                    match tail_claude_vault_file(&file.path, &mut entry, file.len) {
+                        Ok(parsed) => stats.bytes_parsed += parsed,
+                        Err(_) => continue,
+                    }
+                    entry.file_len = file.len;
+                    entry.mtime_ms = mtime_ms;
+                    store_claude_vault_entry(&tx, &key, &entry)?;
+                    stats.tailed += 1;
+                    entry
+                }
+            };
+            hits.push(claude_hit_from_index_entry(&file.path, file.mtime, entry));
         }
-        if model.is_none() {
-            model = event
-                .pointer("/message/model")
-                .and_then(|value| value.as_str())
-                .filter(|value| !value.trim().is_empty())
-                .map(ToString::to_string);
+
+        let live = files
+            .iter()
+            .map(|file| file.path.to_string_lossy().to_string())
+            .collect::<std::collections::HashSet<_>>();
+        let stale = {
+            let mut stmt = tx
+                .prepare("SELECT path FROM claude_sessions")
+                .context("list AI Vault index rows")?;
+            stmt.query_map([], |row| row.get::<_, String>(0))
+                .context("query AI Vault index rows")?
+                .filter_map(|row| row.ok())
+                .filter(|path| !live.contains(path))
+                .collect::<Vec<_>>()
+        };
+        for path in &stale {
+            tx.execute("DELETE FROM claude_sessions WHERE path = ?1", [path])
+                .context("prune AI Vault index row")?;
         }
-        if title.is_some() || event.get("isMeta").and_then(|value| value.as_bool()) == Some(true) {
-            continue;
+        stats.pruned = stale.len();
+
+        tx.commit().context("commit AI Vault index refresh")?;
+        Ok((hits, stats))
+    }
+}
+
+fn claude_vault_index() -> Option<&'static Mutex<ClaudeVaultIndex>> {
+    static INDEX: OnceLock<Option<Mutex<ClaudeVaultIndex>>> = OnceLock::new();
+    INDEX
+        .get_or_init(|| {
+            let path = ai_vault_index_db_path();
+            ClaudeVaultIndex::open(&path)
+                .or_else(|error| {
+                    tracing::warn!(
+                        target: "script_kit::ai_vault",
+                        event = "ai_vault_index_open_failed",
+                        path = %path.display(),
+                        error = %error,
+                        "AI Vault index unavailable on disk; indexing in memory"
+                    );
+                    ClaudeVaultIndex::open_in_memory()
+                })
+                .ok()
+                .map(Mutex::new)
+        })
+        .as_ref()
+}
+
+fn ai_vault_index_db_path() -> PathBuf {
+    crate::setup::get_kit_path()
+        .join("db")
+        .join("ai-vault-index.sqlite")
+}
+
+fn load_claude_vault_entry(conn: &Connection, path: &str) -> Result<Option<ClaudeVaultIndexEntry>> {
+    let mut stmt = conn
+        .prepare(
+            r#"
+            SELECT session_id, byte_offset, file_len, mtime_ms, newest_ms,
+                   title, cwd, model, search_terms
+            FROM claude_sessions
+            WHERE path = ?1
+            "#,
+        )
+        .context("prepare AI Vault index lookup")?;
+    let mut rows = stmt.query([path]).context("query AI Vault index entry")?;
+    let Some(row) = rows.next().context("read AI Vault index entry")? else {
+        return Ok(None);
+    };
+    let search_terms = row.get::<_, String>(8)?;
+    Ok(Some(ClaudeVaultIndexEntry {
+        session_id: row.get(0)?,
+        byte_offset: row.get::<_, i64>(1)?.max(0) as u64,
+        file_len: row.get::<_, i64>(2)?.max(0) as u64,
+        mtime_ms: row.get(3)?,
+        newest_ms: row.get(4)?,
+        title: row.get(5)?,
+        cwd: row.get(6)?,
+        model: row.get(7)?,
+        search_terms: if search_terms.is_empty() {
+            Vec::new()
+        } else {
+            search_terms
+                .split(CLAUDE_VAULT_TERM_SEPARATOR)
+                .map(ToString::to_string)
+                .collect()
+        },
+    }))
+}
+
+fn store_claude_vault_entry(
+    conn: &Connection,
+    path: &str,
+    entry: &ClaudeVaultIndexEntry,
+) -> Result<()> {
+    let search_terms = entry
+        .search_terms
+        .join(&CLAUDE_VAULT_TERM_SEPARATOR.to_string());
+    conn.prepare(
+        r#"
+        INSERT INTO claude_sessions (
+            path, session_id, byte_offset, file_len, mtime_ms, newest_ms,
+            title, cwd, model, search_terms
+        ) VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10)
+        ON CONFLICT(path) DO UPDATE SET
+            session_id = excluded.session_id,
+            byte_offset = excluded.byte_offset,
+            file_len = excluded.file_len,
+            mtime_ms = excluded.mtime_ms,
+            newest_ms = excluded.newest_ms,
+            title = excluded.title,
+            cwd = excluded.cwd,
+            model = excluded.model,
+            search_terms = excluded.search_terms
+        "#,
+    )
+    .context("prepare AI Vault index upsert")?
+    .execute(rusqlite::params![
+        path,
+        entry.session_id,
+        entry.byte_offset as i64,
+        entry.file_len as i64,
+        entry.mtime_ms,
+        entry.newest_ms,
+        entry.title,
+        entry.cwd,
+        entry.model,
+        search_terms,
+    ])
+    .context("upsert AI Vault index entry")?;
+    Ok(())
+}
+
+/// Parse the bytes of `path` between `entry.byte_offset` and `len`, advancing
+/// the offset past every consumed line. Returns how far the offset moved.
+///
+/// A trailing line without a newline is only consumed when it already parses,
+/// so a log that is mid-write is picked up from the same offset next time.
+fn tail_claude_vault_file(path: &Path, entry: &mut ClaudeVaultIndexEntry, len: u64) -> Result<u64> {
+    if entry.byte_offset >= len {
+        return Ok(0);
+    }
+    if entry.metadata_complete() {
+        entry.byte_offset = len;
+        return Ok(0);
+    }
+
+    let mut file =
+        File::open(path).with_context(|| format!("open Claude session log: {}", path.display()))?;
+    file.seek(SeekFrom::Start(entry.byte_offset))
+        .context("seek Claude session log")?;
+    let mut reader = BufReader::new(file.take(len - entry.byte_offset));
+    let start = entry.byte_offset;
+    let mut line = Vec::new();
+    loop {
+        line.clear();
+        let read = reader
+            .read_until(b'\n', &mut line)
+            .context("read Claude session log")?;
+        if read == 0 {
+            break;
         }
-        let role = event
-            .pointer("/message/role")
-            .or_else(|| event.get("type"))
-            .and_then(|value| value.as_str());
-        if role != Some("user") {
-            continue;
+        let complete = line.last() == Some(&b'\n');
+        let parsed = apply_claude_log_line(entry, &line);
+        if !complete && !parsed {
+            break;
         }
-        let content = event
-            .pointer("/message/content")
-            .or_else(|| event.get("content"));
-        if let Some(content) = content {
-            let mut fragments = Vec::new();
-            collect_text_fragments(content, &mut fragments);
-            if !fragments.is_empty() {
-                search_terms.push(fragments.join("\n"));
-            }
+        entry.byte_offset += read as u64;
+        if entry.metadata_complete() {
+            entry.byte_offset = len;
+            break;
+        }
+    }
+    Ok(entry.byte_offset.min(len) - start)
+}
+
+/// The few fields the vault reads from every Claude Code log line. Serde skips
+/// everything else (tool output, assistant bodies) without building a
+/// `serde_json::Value` for it.
+#[derive(Deserialize)]
+struct ClaudeLogLine {
+    #[serde(default)]
+    timestamp: Option<String>,
+    #[serde(default)]
+    cwd: Option<String>,
+    #[serde(rename = "isMeta", default)]
+    is_meta: Option<bool>,
+    #[serde(rename = "type", default)]
+    kind: Option<String>,
+    #[serde(default)]
+    message: Option<ClaudeLogMessage>,
+}
+
+#[derive(Deserialize)]
+struct ClaudeLogMessage {
+    #[serde(default)]
+    role: Option<String>,
+    #[serde(default)]
+    model: Option<String>,
+}
+
+/// Second pass, only for user lines, that materializes the message content.
+#[derive(Deserialize)]
+struct ClaudeLogUserLine {
+    #[serde(default)]
+    message: Option<ClaudeLogUserMessage>,
+    #[serde(default)]
+    content: Option<serde_json::Value>,
+}
+
+#[derive(Deserialize)]
+struct ClaudeLogUserMessage {
+    #[serde(default)]
+    content: Option<serde_json::Value>,
+}
+
+fn apply_claude_log_line(entry: &mut ClaudeVaultIndexEntry, line: &[u8]) -> bool {
+    let Ok(event) = serde_json::from_slice::<ClaudeLogLine>(line) else {
+        return false;
+    };
+    if let Some(timestamp) = event.timestamp.as_deref().and_then(parse_timestamp) {
+        entry.newest_ms = entry.newest_ms.max(system_time_millis(timestamp));
+    }
+    if entry.cwd.is_none() {
+        entry.cwd = event.cwd.filter(|value| !value.trim().is_empty());
+    }
+    let (role, model) = event
+        .message
+        .map(|message| (message.role, message.model))
+        .unwrap_or_default();
+    if entry.model.is_none() {
+        entry.model = model.filter(|value| !value.trim().is_empty());
+    }
+    if entry.title.is_some() || event.is_meta == Some(true) {
+        return true;
+    }
+    if role.or(event.kind).as_deref() != Some("user") {
+        return true;
+    }
+
+    let Ok(user) = serde_json::from_slice::<ClaudeLogUserLine>(line) else {
+        return true;
+    };
+    let content = user
+        .message
+        .and_then(|message| message.content)
+        .or(user.content);
+    if let Some(content) = content.as_ref() {
+        let mut fragments = Vec::new();
+        collect_text_fragments(content, &mut fragments);
+        if !fragments.is_empty() {
+            entry.search_terms.push(fragments.join("\n"));
         }
-        title = content.and_then(text_from_content_for_title);
     }
+    entry.title = content.as_ref().and_then(text_from_content_for_title);
+    true
+}
 
-    let safe_title =
-        title.unwrap_or_else(|| format!("Claude Code session {}", short_id(&session_id)));
+fn claude_hit_from_index_entry(
+    path: &Path,
+    mtime: SystemTime,
+    entry: ClaudeVaultIndexEntry,
+) -> AiVaultHit {
+    let newest = mtime.max(UNIX_EPOCH + Duration::from_millis(entry.newest_ms.max(0) as u64));
+    let session_id = entry.session_id;
+    let safe_title = entry
+        .title
+        .unwrap_or_else(|| format!("Claude Code session {}", short_id(&session_id)));
+    let mut search_terms = entry.search_terms;
     search_terms.extend([
         safe_title.clone(),
         session_id.clone(),
-        cwd.clone().unwrap_or_default(),
-        model.clone().unwrap_or_default(),
+        entry.cwd.clone().unwrap_or_default(),
+        entry.model.clone().unwrap_or_default(),
     ]);
 
-    Some(AiVaultHit {
+    AiVaultHit {
         provider: "claude".to_string(),
         provider_display_name: "Claude Code".to_string(),
         session_id: session_id.clone(),
         source_kind: Some("cli".to_string()),
         safe_title,
-        workspace_path: cwd,
-        model,
+        workspace_path: entry.cwd,
+        model: entry.model,
         modified_at: Some(system_time_to_rfc3339(newest)),
         matched_field: AiVaultMatchedField::Recent,
         stable_key: format!("ai-vault/claude/cli/{session_id}"),
@@ -690,7 +1062,13 @@ fn read_claude_vault_hit(path: &Path, mtime: SystemTime) -> Option<AiVaultHit> {
         search_terms,
         search_haystack: String::new(),
         rollout_path: Some(path.to_path_buf()),
-    })
+    }
+}
+
+fn system_time_millis(time: SystemTime) -> i64 {
+    time.duration_since(UNIX_EPOCH)
+        .map(|duration| duration.as_millis() as i64)
+        .unwrap_or(0)
 }
 
 fn read_codex_vault_hits(
@@ -729,14 +1107,36 @@ fn read_codex_vault_hits_via_state_db(
     if !db_path.exists() {
         return Err(anyhow!("state_5.sqlite missing"));
     }
+    // Read the live database in place; only fall back to copying a snapshot
+    // when Codex holds it in a state a read-only connection cannot open.
+    match open_codex_state_db(db_path).and_then(|conn| query_codex_thread_hits(&conn, limit)) {
+        Ok(hits) => return Ok(hits),
+        Err(error) => tracing::debug!(
+            target: "script_kit::ai_vault",
+            event = "ai_vault_codex_state_db_direct_read_failed",
+            db_path = %db_path.display(),
+            error = %error,
+            "Codex state DB direct read failed; reading a snapshot copy"
+        ),
+    }
     let temp_dir = tempfile::tempdir().context("create temp dir for codex state snapshot")?;
     let copied_db = copy_sqlite_db_snapshot(db_path, temp_dir.path())?;
+    let conn = open_codex_state_db(&copied_db)?;
+    query_codex_thread_hits(&conn, limit)
+}
+
+fn open_codex_state_db(db_path: &Path) -> Result<Connection> {
     let conn = Connection::open_with_flags(
-        &copied_db,
+        db_path,
         rusqlite::OpenFlags::SQLITE_OPEN_READ_ONLY | rusqlite::OpenFlags::SQLITE_OPEN_URI,
     )
-    .with_context(|| format!("open_codex_state_db_failed: {}", copied_db.display()))?;
+    .with_context(|| format!("open_codex_state_db_failed: {}", db_path.display()))?;
+    conn.busy_timeout(Duration::from_millis(250))
+        .context("set codex state db busy timeout")?;
+    Ok(conn)
+}
 
+fn query_codex_thread_hits(conn: &Connection, limit: usize) -> Result<Vec<AiVaultHit>> {
     let mut stmt = conn
         .prepare(
             r#"
@@ -968,7 +1368,7 @@ fn expand_tilde_path(value: &str) -> PathBuf {
     PathBuf::from(value)
 }
 
-fn collect_jsonl_files(root: &Path, files: &mut Vec<(PathBuf, SystemTime)>) {
+fn collect_jsonl_files(root: &Path, files: &mut Vec<ClaudeVaultFile>) {
     let Ok(entries) = std::fs::read_dir(root) else {
         return;
     };
@@ -982,7 +1382,11 @@ fn collect_jsonl_files(root: &Path, files: &mut Vec<(PathBuf, SystemTime)>) {
         } else if metadata.is_file()
             && path.extension().and_then(|ext| ext.to_str()) == Some("jsonl")
         {
-            files.push((path, metadata.modified().unwrap_or(UNIX_EPOCH)));
+            files.push(ClaudeVaultFile {
+                path,
+                mtime: metadata.modified().unwrap_or(UNIX_EPOCH),
+                len: metadata.len(),
+            });
         }
     }
 }
@@ -1792,4 +2196,123 @@ mod tests {
             .unwrap_err();
         assert!(error.to_string().contains("state_5.sqlite missing"));
     }
+
+    fn claude_vault_file(path: &Path) -> ClaudeVaultFile {
+        let metadata = std::fs::metadata(path).unwrap();
+        ClaudeVaultFile {
+            path: path.to_path_buf(),
+            mtime: metadata.modified().unwrap(),
+            len: metadata.len(),
+        }
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn claude_vault_index_file_is_owner_only() {
+        use std::os::unix::fs::PermissionsExt;
+
+        let temp_dir = tempfile::tempdir().unwrap();
+        let path = temp_dir.path().join("ai-vault-index.sqlite");
+        let _index = ClaudeVaultIndex::open(&path).unwrap();
+
+        for suffix in ["", "-wal", "-shm"] {
+            let file = temp_dir
+                .path()
+                .join(format!("ai-vault-index.sqlite{suffix}"));
+            if let Ok(metadata) = std::fs::metadata(&file) {
+                assert_eq!(metadata.permissions().mode() & 0o777, 0o600, "{file:?}");
+            }
+        }
+    }
+
+    #[test]
+    fn claude_vault_index_parses_only_appended_complete_lines() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let log_path = temp_dir.path().join("claude-session-1.jsonl");
+        let first = concat!(
+            r#"{"type":"user","timestamp":"2026-05-16T00:00:00Z","cwd":"/tmp/vault-project","#,
+            r#""message":{"role":"user","content":[{"type":"text","text":"Investigate vault indexing"}]}}"#,
+            "\n"
+        );
+        std::fs::write(&log_path, first).unwrap();
+
+        let mut index = ClaudeVaultIndex::open_in_memory().unwrap();
+        let (hits, stats) = index.refresh(&[claude_vault_file(&log_path)]).unwrap();
+        assert_eq!(stats.tailed, 1);
+        assert_eq!(stats.bytes_parsed, first.len() as u64);
+        assert_eq!(hits[0].safe_title, "Investigate vault indexing");
+        assert_eq!(
+            hits[0].workspace_path.as_deref(),
+            Some("/tmp/vault-project")
+        );
+        assert_eq!(hits[0].model, None);
+
+        let (_, stats) = index.refresh(&[claude_vault_file(&log_path)]).unwrap();
+        assert_eq!(stats.reused, 1);
+        assert_eq!(stats.bytes_parsed, 0);
+
+        let second = concat!(
+            r#"{"type":"assistant","timestamp":"2099-01-01T00:00:00Z","#,
+            r#""message":{"role":"assistant","content":"POISON_BODY"}}"#,
+            "\n"
+        );
+        let partial = r#"{"type":"user","message":{"#;
+        let mut appended = std::fs::OpenOptions::new()
+            .append(true)
+            .open(&log_path)
+            .unwrap();
+        std::io::Write::write_all(&mut appended, second.as_bytes()).unwrap();
+        std::io::Write::write_all(&mut appended, partial.as_bytes()).unwrap();
+        drop(appended);
+
+        let (hits, stats) = index.refresh(&[claude_vault_file(&log_path)]).unwrap();
+        assert_eq!(stats.tailed, 1);
+        assert_eq!(stats.bytes_parsed, second.len() as u64);
+        assert!(hits[0]
+            .modified_at
+            .as_deref()
+            .is_some_and(|modified| modified.starts_with("2099-01-01")));
+        assert!(!hits[0]
+            .search_terms
+            .iter()
+            .any(|term| term.contains("POISON_BODY")));
+
+        let entry = load_claude_vault_entry(&index.conn, &log_path.to_string_lossy())
+            .unwrap()
+            .unwrap();
+        assert_eq!(entry.byte_offset, (first.len() + second.len()) as u64);
+        assert_eq!(entry.title.as_deref(), Some("Investigate vault indexing"));
+    }
+
+    #[test]
+    fn claude_vault_index_restarts_rewritten_logs_and_prunes_deleted_ones() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let log_path = temp_dir.path().join("claude-session-2.jsonl");
+        std::fs::write(
+            &log_path,
+            concat!(
+                r#"{"type":"user","message":{"role":"user","content":"A much longer original prompt"}}"#,
+                "\n"
+            ),
+        )
+        .unwrap();
+        let mut index = ClaudeVaultIndex::open_in_memory().unwrap();
+        index.refresh(&[claude_vault_file(&log_path)]).unwrap();
+
+        std::fs::write(
+            &log_path,
+            concat!(
+                r#"{"type":"user","message":{"role":"user","content":"Rewritten"}}"#,
+                "\n"
+            ),
+        )
+        .unwrap();
+        let (hits, _) = index.refresh(&[claude_vault_file(&log_path)]).unwrap();
+        assert_eq!(hits[0].safe_title, "Rewritten");
+
+        std::fs::remove_file(&log_path).unwrap();
+        let (hits, stats) = index.refresh(&[]).unwrap();
+        assert!(hits.is_empty());
+        assert_eq!(stats.pruned, 1);
+    }
 }
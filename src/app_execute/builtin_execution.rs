@@ -4179,7 +4179,9 @@ impl ScriptListApp {
                     "{}",
                     action.log_message()
                 );
-                self.apps = app_launcher::scan_applications().clone();
+                let (apps, generation) = app_launcher::get_cached_apps_with_generation();
+                self.apps = apps;
+                self.apps_generation = Some(generation);
                 tracing::info!(
                     category = "BUILTIN",
                     trace_id = %dctx.trace_id,
@@ -2624,8 +2624,9 @@ impl ScriptListApp {
 
         std::thread::spawn(move || {
             let result = std::panic::catch_unwind(|| {
-                // Capture desktop context (text-safe, no screenshots in the blob)
-                let desktop = crate::context_snapshot::capture_context_snapshot(
+                // Capture desktop context (text-safe, no screenshots in the blob),
+                // reusing what the launcher prefetched for the same app.
+                let desktop = crate::context_snapshot::capture_context_snapshot_prefetched(
                     &crate::context_snapshot::CaptureContextOptions::tab_ai_submit(),
                 );
 
@@ -3,31 +3,6 @@ use super::*;
 const INLINE_CALCULATOR_SECTION_LABEL: &str = "Calculator";
 const INLINE_CALCULATOR_RESULT_INDEX: usize = usize::MAX;
 
-fn timed_root_passive_source<T>(
-    source: &'static str,
-    query: &str,
-    explicit: bool,
-    f: impl FnOnce() -> Vec<T>,
-) -> Vec<T> {
-    let start = std::time::Instant::now();
-    let rows = f();
-    let elapsed = start.elapsed();
-    if logging::filter_perf_trace_enabled() || elapsed >= std::time::Duration::from_millis(8) {
-        logging::log(
-            "FILTER_PERF",
-            &format!(
-                "[PASSIVE_SOURCE_DONE] source={} query_len={} explicit={} in {:.2}ms -> {} hits",
-                source,
-                query.chars().count(),
-                explicit,
-                elapsed.as_secs_f64() * 1000.0,
-                rows.len()
-            ),
-        );
-    }
-    rows
-}
-
 fn grouped_selectable_bounds(
     grouped_items: &[GroupedListItem],
     flat_results: &[scripts::SearchResult],
@@ -712,224 +687,251 @@ impl ScriptListApp {
             }
             _ => None,
         };
-        let brain_hits = timed_root_passive_source("brain", search_text, explicit_brain, || {
-            match &brain_plan {
-                crate::brain::RootBrainQueryPlan::Skip => Vec::new(),
-                crate::brain::RootBrainQueryPlan::RecentsOnly => {
-                    crate::brain::recent_root_brain_hits(brain_options.max_results)
-                }
-                crate::brain::RootBrainQueryPlan::Search(brain_query) => {
-                    brain_semantic_hits.unwrap_or_else(|| {
-                        crate::brain::search_root_brain_direct(brain_query, &brain_options)
-                    })
-                }
+        // Every eligible source becomes one job; ineligible sources keep
+        // their empty section and never leave the UI thread. Jobs own their
+        // inputs so stragglers can outlive this frame build.
+        use crate::root_passive_sources::{RootPassiveSection, RootPassiveSourceJob};
+        let query = search_text.to_string();
+        let mut jobs = Vec::new();
+        let mut ready = Vec::new();
+        let mut index_request = crate::root_search_index::RootSearchIndexRequest::default();
+
+        // Brain stays a job rather than a `root_search_index` partition: its
+        // FTS ranks are fused with attention signals (see that module's docs).
+        match brain_plan {
+            crate::brain::RootBrainQueryPlan::Skip => {}
+            crate::brain::RootBrainQueryPlan::RecentsOnly => {
+                let max_results = brain_options.max_results;
+                jobs.push(RootPassiveSourceJob::new("brain", explicit_brain, move || {
+                    RootPassiveSection::Brain(crate::brain::recent_root_brain_hits(max_results))
+                }));
             }
-        });
+            crate::brain::RootBrainQueryPlan::Search(brain_query) => match brain_semantic_hits {
+                Some(hits) => ready.push(RootPassiveSection::Brain(hits)),
+                None => jobs.push(RootPassiveSourceJob::new("brain", explicit_brain, move || {
+                    RootPassiveSection::Brain(crate::brain::search_root_brain_direct(
+                        &brain_query,
+                        &brain_options,
+                    ))
+                })),
+            },
+        }
 
-        let note_hits = timed_root_passive_source("notes", search_text, explicit_notes, || {
-            if !advanced_query_active
-                && allow_notes
-                && crate::notes::root_notes_query_is_eligible(search_text, notes_options)
-            {
-                if explicit_notes {
-                    crate::notes::search_root_notes_meta_direct(search_text, notes_options)
-                } else {
-                    crate::notes::search_root_notes_meta_cached(search_text, notes_options)
-                }
+        if !advanced_query_active
+            && allow_notes
+            && crate::notes::root_notes_query_is_eligible(search_text, notes_options)
+        {
+            if explicit_notes {
+                let query = query.clone();
+                jobs.push(RootPassiveSourceJob::new("notes", explicit_notes, move || {
+                    RootPassiveSection::Notes(crate::notes::search_root_notes_meta_direct(
+                        &query,
+                        notes_options,
+                    ))
+                }));
             } else {
-                Vec::new()
+                index_request.notes = Some(notes_options);
             }
-        });
+        }
 
-        let todo_hits = timed_root_passive_source("todo", search_text, explicit_todos, || {
-            if (!advanced_query_active || explicit_todos)
-                && allow_todos
-                && crate::menu_syntax::root_todo_query_is_eligible(search_text, todo_options)
-            {
-                if explicit_todos {
-                    crate::menu_syntax::search_root_todos_direct(search_text, todo_options)
+        if (!advanced_query_active || explicit_todos)
+            && allow_todos
+            && crate::menu_syntax::root_todo_query_is_eligible(search_text, todo_options)
+        {
+            let query = query.clone();
+            jobs.push(RootPassiveSourceJob::new("todo", explicit_todos, move || {
+                RootPassiveSection::Todo(if explicit_todos {
+                    crate::menu_syntax::search_root_todos_direct(&query, todo_options)
                 } else {
                     // Implicit typing path: nonblocking snapshot filter. The
                     // day-page file scan happens on a detached refresh
                     // thread (self-guarded, at most once per TTL), never on
                     // the keystroke path.
                     crate::menu_syntax::ensure_root_todos_snapshot_refresh();
-                    crate::menu_syntax::search_root_todos_cached(search_text, todo_options)
-                }
-            } else {
-                Vec::new()
-            }
-        });
+                    crate::menu_syntax::search_root_todos_cached(&query, todo_options)
+                })
+            }));
+        }
 
-        let clipboard_history_hits =
-            timed_root_passive_source("clipboard_history", search_text, explicit_clipboard, || {
-                if !advanced_query_active
-                    && allow_clipboard
-                    && crate::clipboard_history::root_clipboard_history_query_is_eligible(
-                        search_text,
-                        clipboard_history_options,
-                    )
-                {
-                    if explicit_clipboard {
+        if !advanced_query_active
+            && allow_clipboard
+            && crate::clipboard_history::root_clipboard_history_query_is_eligible(
+                search_text,
+                clipboard_history_options,
+            )
+        {
+            if explicit_clipboard {
+                let query = query.clone();
+                jobs.push(RootPassiveSourceJob::new("clipboard_history", explicit_clipboard, move || {
+                    RootPassiveSection::ClipboardHistory(
                         crate::clipboard_history::search_root_clipboard_history_meta_direct(
-                            search_text,
-                            clipboard_history_options,
-                        )
-                    } else {
-                        crate::clipboard_history::search_root_clipboard_history_meta_cached(
-                            search_text,
+                            &query,
                             clipboard_history_options,
-                        )
-                    }
-                } else {
-                    Vec::new()
-                }
-            });
-
-        let dictation_history_hits =
-            timed_root_passive_source("dictation_history", search_text, explicit_dictation, || {
-                if !advanced_query_active
-                    && allow_dictation
-                    && crate::dictation::root_dictation_history_query_is_eligible(
-                        search_text,
-                        dictation_history_options,
+                        ),
                     )
-                {
-                    if explicit_dictation {
+                }));
+            } else {
+                index_request.clipboard_history = Some(clipboard_history_options);
+            }
+        }
+
+        if !advanced_query_active
+            && allow_dictation
+            && crate::dictation::root_dictation_history_query_is_eligible(
+                search_text,
+                dictation_history_options,
+            )
+        {
+            if explicit_dictation {
+                let query = query.clone();
+                jobs.push(RootPassiveSourceJob::new("dictation_history", explicit_dictation, move || {
+                    RootPassiveSection::DictationHistory(
                         crate::dictation::search_root_dictation_history_direct(
-                            search_text,
-                            dictation_history_options,
-                        )
-                    } else {
-                        crate::dictation::search_root_dictation_history_cached(
-                            search_text,
+                            &query,
                             dictation_history_options,
-                        )
-                    }
-                } else {
-                    Vec::new()
-                }
-            });
-
-        let agent_chat_history_hits = timed_root_passive_source(
-            "agent_chat_history",
-            search_text,
-            explicit_conversations,
-            || {
-                if !advanced_query_active
-                    && allow_conversations
-                    && crate::ai::agent_chat::ui::history::root_agent_chat_history_query_is_eligible(
-                        search_text,
-                        agent_chat_history_options,
+                        ),
                     )
-                {
-                    if explicit_conversations {
-                        crate::ai::agent_chat::ui::history::search_history_direct(
-                            search_text,
-                            agent_chat_history_options.max_results,
-                        )
-                    } else {
-                        crate::ai::agent_chat::ui::history::search_history_cached(
-                            search_text,
-                            agent_chat_history_options.max_results,
-                        )
-                    }
-                } else {
-                    Vec::new()
-                }
-            },
-        );
+                }));
+            } else {
+                index_request.dictation_history = Some(dictation_history_options);
+            }
+        }
 
-        let ai_vault_hits =
-            timed_root_passive_source("ai_vault", search_text, explicit_ai_vault, || {
-                if explicit_ai_vault
-                    && !advanced_query_active
-                    && allow_ai_vault
-                    && crate::ai_vault::root_ai_vault_query_is_eligible(
-                        search_text,
-                        &ai_vault_options,
+        if !advanced_query_active
+            && allow_conversations
+            && crate::ai::agent_chat::ui::history::root_agent_chat_history_query_is_eligible(
+                search_text,
+                agent_chat_history_options,
+            )
+        {
+            if explicit_conversations {
+                let query = query.clone();
+                let max_results = agent_chat_history_options.max_results;
+                jobs.push(RootPassiveSourceJob::new("agent_chat_history", explicit_conversations, move || {
+                    RootPassiveSection::AgentChatHistory(
+                        crate::ai::agent_chat::ui::history::search_history_direct(&query, max_results),
                     )
-                {
-                    crate::ai_vault::search_root_ai_vault_direct(search_text, ai_vault_options)
-                } else {
-                    Vec::new()
-                }
-            });
+                }));
+            } else {
+                index_request.agent_chat_history = Some(agent_chat_history_options);
+            }
+        }
+
+        // Implicit notes and history sections share one index probe instead
+        // of a cache lookup and rescan per source.
+        if !index_request.is_empty() {
+            let query = query.clone();
+            jobs.push(RootPassiveSourceJob::new("root_search_index", false, move || {
+                RootPassiveSection::Indexed(crate::root_search_index::search_root_passive_sources(
+                    &query,
+                    &index_request,
+                ))
+            }));
+        }
+
+        if explicit_ai_vault
+            && !advanced_query_active
+            && allow_ai_vault
+            && crate::ai_vault::root_ai_vault_query_is_eligible(search_text, &ai_vault_options)
+        {
+            let query = query.clone();
+            let ai_vault_options = ai_vault_options.clone();
+            jobs.push(RootPassiveSourceJob::new("ai_vault", explicit_ai_vault, move || {
+                RootPassiveSection::AiVault(crate::ai_vault::search_root_ai_vault_direct(
+                    &query,
+                    ai_vault_options,
+                ))
+            }));
+        }
 
-        let browser_tab_hits =
-            timed_root_passive_source("browser_tabs", search_text, explicit_browser_tabs, || {
-                if !advanced_query_active
-                    && allow_browser_tabs
-                    && crate::browser_tabs::root_browser_tabs_query_is_eligible(
-                        search_text,
-                        browser_tabs_options.clone(),
+        if !advanced_query_active
+            && allow_browser_tabs
+            && crate::browser_tabs::root_browser_tabs_query_is_eligible(
+                search_text,
+                browser_tabs_options.clone(),
+            )
+        {
+            let query = query.clone();
+            let browser_tabs_options = browser_tabs_options.clone();
+            jobs.push(RootPassiveSourceJob::new("browser_tabs", explicit_browser_tabs, move || {
+                RootPassiveSection::BrowserTabs(if explicit_browser_tabs {
+                    crate::browser_tabs::search_root_browser_tabs_meta_direct(
+                        &query,
+                        browser_tabs_options,
                     )
-                {
-                    if explicit_browser_tabs {
-                        crate::browser_tabs::search_root_browser_tabs_meta_direct(
-                            search_text,
-                            browser_tabs_options.clone(),
-                        )
-                    } else {
-                        crate::browser_tabs::search_root_browser_tabs_meta_cached(
-                            search_text,
-                            browser_tabs_options.clone(),
-                        )
-                    }
                 } else {
-                    Vec::new()
-                }
-            });
+                    crate::browser_tabs::search_root_browser_tabs_meta_cached(
+                        &query,
+                        browser_tabs_options,
+                    )
+                })
+            }));
+        }
 
-        let browser_history_hits = timed_root_passive_source(
-            "browser_history",
-            search_text,
-            explicit_browser_history,
-            || {
-                if !advanced_query_active
-                    && allow_browser_history
-                    && crate::browser_history::root_browser_history_query_is_eligible(
-                        search_text,
-                        browser_history_options.clone(),
+        if !advanced_query_active
+            && allow_browser_history
+            && crate::browser_history::root_browser_history_query_is_eligible(
+                search_text,
+                browser_history_options.clone(),
+            )
+        {
+            let query = query.clone();
+            let browser_history_options = browser_history_options.clone();
+            jobs.push(RootPassiveSourceJob::new("browser_history", explicit_browser_history, move || {
+                RootPassiveSection::BrowserHistory(if explicit_browser_history {
+                    crate::browser_history::search_root_browser_history_meta_direct(
+                        &query,
+                        browser_history_options,
                     )
-                {
-                    if explicit_browser_history {
-                        crate::browser_history::search_root_browser_history_meta_direct(
-                            search_text,
-                            browser_history_options.clone(),
-                        )
-                    } else {
-                        // Implicit typing path mirrors browser tabs: a
-                        // nonblocking snapshot-only lookup. The blocking-risk
-                        // work (SQLite copies) stays on the background
-                        // refresh thread, preserving the 13a417737 latency
-                        // fix while letting history participate passively.
-                        crate::browser_history::search_root_browser_history_meta_cached(
-                            search_text,
-                            browser_history_options.clone(),
-                        )
-                    }
                 } else {
-                    Vec::new()
-                }
-            },
-        );
+                    // Implicit typing path mirrors browser tabs: a
+                    // nonblocking snapshot-only lookup. The blocking-risk
+                    // work (SQLite copies) stays on the background
+                    // refresh thread, preserving the 13a417737 latency
+                    // fix while letting history participate passively.
+                    crate::browser_history::search_root_browser_history_meta_cached(
+                        &query,
+                        browser_history_options,
+                    )
+                })
+            }));
+        }
 
-        let frame = crate::RootPassiveFrame {
+        let job_count = jobs.len();
+        ready.extend(self.fan_out_root_passive_sources_for_frame(&key, jobs));
+        if logging::filter_perf_trace_enabled() {
+            logging::log(
+                "FILTER_PERF",
+                &format!(
+                    "[PASSIVE_FRAME] query_len={} jobs={} ready={} late={}",
+                    search_text.chars().count(),
+                    job_count,
+                    ready.len(),
+                    self.root_passive_late_sections
+                        .as_ref()
+                        .map_or(0, |late| late.pending),
+                ),
+            );
+        }
+
+        let mut frame = crate::RootPassiveFrame {
             key,
-            note_hits,
-            brain_hits,
-            todo_hits,
-            clipboard_history_hits,
-            dictation_history_hits,
-            agent_chat_history_hits,
-            ai_vault_hits,
-            browser_tab_hits,
-            browser_history_hits,
+            note_hits: Vec::new(),
+            brain_hits: Vec::new(),
+            todo_hits: Vec::new(),
+            clipboard_history_hits: Vec::new(),
+            dictation_history_hits: Vec::new(),
+            agent_chat_history_hits: Vec::new(),
+            ai_vault_hits: Vec::new(),
+            browser_tab_hits: Vec::new(),
+            browser_history_hits: Vec::new(),
             ai_vault_snapshot_generation: ai_vault_status.generation,
             browser_tabs_snapshot_generation: browser_tabs_status.generation,
             browser_history_snapshot_generation: browser_history_status.generation,
         };
+        for section in ready {
+            section.apply_to(&mut frame);
+        }
         self.root_passive_frame = Some(frame.clone());
         frame
     }
@@ -2324,6 +2326,10 @@ impl ScriptListApp {
                 let preview: String = window_lines.join("\n");
                 let mut lines = syntax::highlight_code_lines(&preview, lang, is_dark);
                 let highlight_elapsed = highlight_start.elapsed();
+                if !syntax::highlighting_ready() {
+                    // Plain-text fallback while syntect assets load; re-highlight next render.
+                    self.preview_cache_path = None;
+                }
 
                 // Apply match emphasis to the matched line's spans
                 if let Some(cm) = content_match {
@@ -2636,6 +2642,15 @@ impl ScriptListApp {
             return;
         }
 
+        // A multi-word prompt no command claims is likely headed for an AI
+        // handoff: add the expensive sections to this show's context prefetch.
+        if cx.is_some()
+            && query.split_whitespace().nth(1).is_some()
+            && crate::scripts::search::ghost::is_safe_agent_prompt_seed(query.trim())
+        {
+            crate::context_snapshot::upgrade_context_prefetch();
+        }
+
         // 2. A cached LLM result wins over the deterministic starter.
         if let Some(pred) = self.cached_ghost_llm_prediction(&query, cwd.as_ref(), context_rev) {
             self.apply_ghost_prediction(pred, cx.as_deref_mut());
@@ -69,6 +69,8 @@ mod root_brain_inbox;
 mod root_brain_search;
 #[path = "root_file_search.rs"]
 mod root_file_search;
+#[path = "root_passive_sources.rs"]
+pub(crate) mod root_passive_sources;
 #[path = "root_unified_result_actions.rs"]
 pub(crate) mod root_unified_result_actions;
 #[path = "routes.rs"]
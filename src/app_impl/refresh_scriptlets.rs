@@ -464,7 +464,35 @@ impl ScriptListApp {
     /// 2. If user is in AppLauncherView, the list needs updating
     /// 3. The cost of an "unnecessary" notify is near-zero (just marks dirty)
     pub fn refresh_apps(&mut self, cx: &mut Context<Self>) {
-        self.apps = crate::app_launcher::get_cached_apps();
+        let (apps, generation) = crate::app_launcher::get_cached_apps_with_generation();
+        self.apps = apps;
+        self.apps_generation = Some(generation);
+        self.finish_apps_update(cx);
+    }
+
+    /// Patch the app list with an incremental scan delta instead of
+    /// re-cloning the whole cache. An empty delta leaves search caches intact.
+    pub fn apply_app_scan_delta(
+        &mut self,
+        delta: &crate::app_launcher::AppScanDelta,
+        cx: &mut Context<Self>,
+    ) {
+        if !delta.applies_to(self.apps_generation) {
+            // The UI list is not the cache the delta was computed against
+            // (e.g. it was taken before the startup scan finished).
+            self.refresh_apps(cx);
+            return;
+        }
+        self.apps_generation = Some(delta.generation);
+        if delta.is_empty() {
+            logging::log("APP", "App rescan found no changes");
+            return;
+        }
+        delta.apply_to(&mut self.apps);
+        self.finish_apps_update(cx);
+    }
+
+    fn finish_apps_update(&mut self, cx: &mut Context<Self>) {
         self.rebuild_root_windows_after_app_icon_cache_update(
             "refresh_apps_root_windows_icons",
             cx,
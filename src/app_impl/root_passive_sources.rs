@@ -0,0 +1,591 @@
+//! Concurrent, deadline-bounded fan-out for the root launcher passive sources.
+//!
+//! `root_passive_frame_for_current_query` (in `filtering_cache.rs`) used to
+//! run brain, notes, todos, clipboard, dictation, conversations, AI vault,
+//! browser tabs and browser history one after another on the UI thread, so a
+//! single slow `*_direct` SQLite path delayed every section. Eligible sources
+//! are now dispatched together onto a small dedicated pool. The frame
+//! publishes whatever finished within `ROOT_PASSIVE_FRAME_DEADLINE`; the rest
+//! arrive as late sections.
+//!
+//! Late-section contract: each late section is patched into the cached
+//! `RootPassiveFrame` only while its key still matches, and only the grouped
+//! cache is invalidated — sections that already painted are never recomputed.
+//! A new frame key orphans any sections still in flight for the old one, and
+//! its queued jobs are dropped before they run so stale keystrokes never hold
+//! the pool ahead of the current frame. A source that panics degrades to an
+//! empty section.
+//!
+//! Implicit notes, clipboard, dictation and Agent Chat sections arrive as one
+//! `Indexed` section from the shared `root_search_index` probe.
+//!
+//! Per-source latency feeds `LatencyHistogram`s (see
+//! [`root_passive_source_latency`]) instead of ad-hoc slow-source
+//! `FILTER_PERF` lines; the parseable `[PASSIVE_SOURCE_DONE]` line is only
+//! emitted when `SCRIPT_KIT_FILTER_PERF_LOG` tracing is on (the typing
+//! benchmark reads it).
+
+use super::*;
+
+/// Budget the UI thread waits for passive sources before painting the frame.
+/// Cached snapshot paths finish well inside it; explicit `*_direct` paths
+/// that miss it stream in as late sections.
+const ROOT_PASSIVE_FRAME_DEADLINE: std::time::Duration = std::time::Duration::from_millis(12);
+
+/// Worker threads for passive source jobs. Most jobs are blocking SQLite or
+/// snapshot filters, so they get their own pool instead of rayon's global one.
+const ROOT_PASSIVE_WORKERS: usize = 4;
+
+/// Log a per-source latency summary every this many samples.
+const ROOT_PASSIVE_LATENCY_SUMMARY_EVERY: u64 = 256;
+
+static ROOT_PASSIVE_POOL: std::sync::OnceLock<Option<rayon::ThreadPool>> =
+    std::sync::OnceLock::new();
+/// Bumped by every frame fan-out; pooled jobs from older frames are skipped.
+static ROOT_PASSIVE_FRAME_GENERATION: std::sync::atomic::AtomicU64 =
+    std::sync::atomic::AtomicU64::new(0);
+static ROOT_PASSIVE_SOURCE_LATENCY: std::sync::OnceLock<
+    std::sync::Mutex<std::collections::HashMap<&'static str, crate::perf::LatencyHistogram>>,
+> = std::sync::OnceLock::new();
+
+/// One passive source's hits for a frame.
+pub(crate) enum RootPassiveSection {
+    Brain(Vec<crate::brain::RootBrainSearchHit>),
+    Notes(Vec<crate::notes::RootNoteSearchHit>),
+    Todo(Vec<crate::menu_syntax::RootTodoSearchHit>),
+    ClipboardHistory(Vec<crate::clipboard_history::ClipboardEntryMeta>),
+    DictationHistory(Vec<crate::dictation::RootDictationHistorySearchHit>),
+    AgentChatHistory(Vec<crate::ai::agent_chat::ui::history::AgentChatHistorySearchHit>),
+    AiVault(Vec<crate::ai_vault::AiVaultHit>),
+    BrowserTabs(Vec<crate::browser_tabs::RootBrowserTabSearchHit>),
+    BrowserHistory(Vec<crate::browser_history::RootBrowserHistorySearchHit>),
+    /// Notes and history sections answered together by the shared index.
+    Indexed(crate::root_search_index::RootSearchIndexHits),
+}
+
+impl RootPassiveSection {
+    pub(crate) fn source(&self) -> &'static str {
+        match self {
+            Self::Brain(_) => "brain",
+            Self::Notes(_) => "notes",
+            Self::Todo(_) => "todo",
+            Self::ClipboardHistory(_) => "clipboard_history",
+            Self::DictationHistory(_) => "dictation_history",
+            Self::AgentChatHistory(_) => "agent_chat_history",
+            Self::AiVault(_) => "ai_vault",
+            Self::BrowserTabs(_) => "browser_tabs",
+            Self::BrowserHistory(_) => "browser_history",
+            Self::Indexed(_) => "root_search_index",
+        }
+    }
+
+    fn hit_count(&self) -> usize {
+        match self {
+            Self::Brain(hits) => hits.len(),
+            Self::Notes(hits) => hits.len(),
+            Self::Todo(hits) => hits.len(),
+            Self::ClipboardHistory(hits) => hits.len(),
+            Self::DictationHistory(hits) => hits.len(),
+            Self::AgentChatHistory(hits) => hits.len(),
+            Self::AiVault(hits) => hits.len(),
+            Self::BrowserTabs(hits) => hits.len(),
+            Self::BrowserHistory(hits) => hits.len(),
+            Self::Indexed(hits) => hits.hit_count(),
+        }
+    }
+
+    /// Replace this source's section in `frame`, leaving the others alone.
+    pub(crate) fn apply_to(self, frame: &mut crate::RootPassiveFrame) {
+        match self {
+            Self::Brain(hits) => frame.brain_hits = hits,
+            Self::Notes(hits) => frame.note_hits = hits,
+            Self::Todo(hits) => frame.todo_hits = hits,
+            Self::ClipboardHistory(hits) => frame.clipboard_history_hits = hits,
+            Self::DictationHistory(hits) => frame.dictation_history_hits = hits,
+            Self::AgentChatHistory(hits) => frame.agent_chat_history_hits = hits,
+            Self::AiVault(hits) => frame.ai_vault_hits = hits,
+            Self::BrowserTabs(hits) => frame.browser_tab_hits = hits,
+            Self::BrowserHistory(hits) => frame.browser_history_hits = hits,
+            Self::Indexed(hits) => {
+                if let Some(hits) = hits.notes {
+                    frame.note_hits = hits;
+                }
+                if let Some(hits) = hits.clipboard_history {
+                    frame.clipboard_history_hits = hits;
+                }
+                if let Some(hits) = hits.dictation_history {
+                    frame.dictation_history_hits = hits;
+                }
+                if let Some(hits) = hits.agent_chat_history {
+                    frame.agent_chat_history_hits = hits;
+                }
+            }
+        }
+    }
+}
+
+/// A source query to run off the UI thread. Only eligible sources get a job;
+/// ineligible ones keep their empty section without any dispatch.
+pub(crate) struct RootPassiveSourceJob {
+    source: &'static str,
+    explicit: bool,
+    run: Box<dyn FnOnce() -> RootPassiveSection + Send>,
+}
+
+impl RootPassiveSourceJob {
+    pub(crate) fn new(
+        source: &'static str,
+        explicit: bool,
+        run: impl FnOnce() -> RootPassiveSection + Send + 'static,
+    ) -> Self {
+        Self {
+            source,
+            explicit,
+            run: Box::new(run),
+        }
+    }
+
+    /// Run the source query. `None` when it panicked; its section stays empty.
+    fn run(self, query_len: usize) -> Option<RootPassiveSection> {
+        let started = std::time::Instant::now();
+        let section = match std::panic::catch_unwind(std::panic::AssertUnwindSafe(self.run)) {
+            Ok(section) => section,
+            Err(_) => {
+                tracing::warn!(
+                    target: "script_kit::root_passive",
+                    source = self.source,
+                    "root passive source panicked; section left empty"
+                );
+                return None;
+            }
+        };
+        let elapsed = started.elapsed();
+        record_root_passive_source_latency(self.source, elapsed);
+        if logging::filter_perf_trace_enabled() {
+            logging::log(
+                "FILTER_PERF",
+                &format!(
+                    "[PASSIVE_SOURCE_DONE] source={} query_len={} explicit={} in {:.2}ms -> {} hits",
+                    self.source,
+                    query_len,
+                    self.explicit,
+                    elapsed.as_secs_f64() * 1000.0,
+                    section.hit_count()
+                ),
+            );
+        }
+        Some(section)
+    }
+}
+
+/// Sections still running when their frame was published.
+pub(crate) struct RootPassiveLateSections {
+    pub(crate) key: crate::RootPassiveFrameKey,
+    pub(crate) pending: usize,
+    /// `None` for a source that panicked or was skipped as stale.
+    pub(crate) receiver: std::sync::mpsc::Receiver<Option<RootPassiveSection>>,
+}
+
+pub(crate) struct RootPassiveFanOut {
+    pub(crate) ready: Vec<RootPassiveSection>,
+    /// `(pending, receiver)` when some sources missed the deadline.
+    pub(crate) late: Option<(usize, std::sync::mpsc::Receiver<Option<RootPassiveSection>>)>,
+}
+
+fn root_passive_pool() -> Option<&'static rayon::ThreadPool> {
+    ROOT_PASSIVE_POOL
+        .get_or_init(|| {
+            rayon::ThreadPoolBuilder::new()
+                .num_threads(ROOT_PASSIVE_WORKERS)
+                .thread_name(|ix| format!("root-passive-{ix}"))
+                .build()
+                .map_err(|error| {
+                    tracing::warn!(
+                        target: "script_kit::root_passive",
+                        %error,
+                        "root passive pool unavailable; sources run inline"
+                    );
+                })
+                .ok()
+        })
+        .as_ref()
+}
+
+/// Dispatch every job in parallel and wait up to `deadline` for results.
+/// Sections that finish in time are returned as `ready`; the receiver for
+/// the stragglers is handed back so the caller can patch them in later.
+///
+/// Each call starts a new frame on `generation`; a pooled job that only gets
+/// a worker after a newer frame has started is dropped without running.
+pub(crate) fn fan_out_root_passive_sources(
+    jobs: Vec<RootPassiveSourceJob>,
+    query_len: usize,
+    deadline: std::time::Duration,
+    generation: &'static std::sync::atomic::AtomicU64,
+) -> RootPassiveFanOut {
+    use std::sync::atomic::Ordering;
+
+    let frame = generation.fetch_add(1, Ordering::AcqRel) + 1;
+    let total = jobs.len();
+    let Some(pool) = root_passive_pool().filter(|_| total > 1) else {
+        return RootPassiveFanOut {
+            ready: jobs
+                .into_iter()
+                .filter_map(|job| job.run(query_len))
+                .collect(),
+            late: None,
+        };
+    };
+
+    let (tx, rx) = std::sync::mpsc::channel();
+    for job in jobs {
+        let tx = tx.clone();
+        pool.spawn(move || {
+            let section = if generation.load(Ordering::Acquire) == frame {
+                job.run(query_len)
+            } else {
+                tracing::trace!(
+                    target: "script_kit::root_passive",
+                    source = job.source,
+                    "stale root passive source skipped"
+                );
+                None
+            };
+            let _ = tx.send(section);
+        });
+    }
+    drop(tx);
+
+    let deadline_at = std::time::Instant::now() + deadline;
+    let mut ready = Vec::with_capacity(total);
+    let mut finished = 0;
+    while finished < total {
+        let remaining = deadline_at.saturating_duration_since(std::time::Instant::now());
+        match rx.recv_timeout(remaining) {
+            Ok(section) => {
+                finished += 1;
+                ready.extend(section);
+            }
+            // Timeout: publish what we have.
+            Err(_) => break,
+        }
+    }
+
+    let pending = total - finished;
+    RootPassiveFanOut {
+        ready,
+        late: (pending > 0).then_some((pending, rx)),
+    }
+}
+
+fn record_root_passive_source_latency(source: &'static str, elapsed: std::time::Duration) {
+    let histograms = ROOT_PASSIVE_SOURCE_LATENCY.get_or_init(Default::default);
+    let Ok(mut histograms) = histograms.lock() else {
+        return;
+    };
+    let histogram = histograms.entry(source).or_default();
+    histogram.record(elapsed);
+    if histogram.count() % ROOT_PASSIVE_LATENCY_SUMMARY_EVERY == 0 {
+        tracing::debug!(
+            target: "script_kit::root_passive",
+            source,
+            samples = histogram.count(),
+            p50_ms = histogram.percentile(0.5).as_secs_f64() * 1000.0,
+            p95_ms = histogram.percentile(0.95).as_secs_f64() * 1000.0,
+            max_ms = histogram.max().as_secs_f64() * 1000.0,
+            "root passive source latency"
+        );
+    }
+}
+
+/// Snapshot of per-source latency histograms, sorted by source name.
+pub(crate) fn root_passive_source_latency() -> Vec<(&'static str, crate::perf::LatencyHistogram)> {
+    let mut snapshot: Vec<_> = ROOT_PASSIVE_SOURCE_LATENCY
+        .get()
+        .and_then(|histograms| histograms.lock().ok())
+        .map(|histograms| {
+            histograms
+                .iter()
+                .map(|(source, histogram)| (*source, histogram.clone()))
+                .collect()
+        })
+        .unwrap_or_default();
+    snapshot.sort_by_key(|(source, _)| *source);
+    snapshot
+}
+
+impl ScriptListApp {
+    /// Fan out `jobs` for the frame identified by `key`: returns the sections
+    /// that made the deadline and parks the rest for
+    /// [`Self::start_root_passive_late_section_pump`].
+    pub(crate) fn fan_out_root_passive_sources_for_frame(
+        &mut self,
+        key: &crate::RootPassiveFrameKey,
+        jobs: Vec<RootPassiveSourceJob>,
+    ) -> Vec<RootPassiveSection> {
+        let query_len = key.query.chars().count();
+        let fan_out = fan_out_root_passive_sources(
+            jobs,
+            query_len,
+            ROOT_PASSIVE_FRAME_DEADLINE,
+            &ROOT_PASSIVE_FRAME_GENERATION,
+        );
+        self.root_passive_late_sections =
+            fan_out
+                .late
+                .map(|(pending, receiver)| RootPassiveLateSections {
+                    key: key.clone(),
+                    pending,
+                    receiver,
+                });
+        fan_out.ready
+    }
+
+    /// Start delivering late sections parked by the last frame build. Called
+    /// from the script list render (which owns a `Context`); a no-op when
+    /// nothing is pending.
+    pub(crate) fn start_root_passive_late_section_pump(&mut self, cx: &mut Context<Self>) {
+        let Some(late) = self.root_passive_late_sections.take() else {
+            return;
+        };
+        let RootPassiveLateSections {
+            key,
+            mut pending,
+            receiver,
+        } = late;
+
+        cx.spawn(async move |this, cx| {
+            while pending > 0 {
+                let section = match receiver.try_recv() {
+                    Ok(section) => section,
+                    Err(std::sync::mpsc::TryRecvError::Empty) => {
+                        cx.background_executor()
+                            .timer(std::time::Duration::from_millis(16))
+                            .await;
+                        continue;
+                    }
+                    Err(std::sync::mpsc::TryRecvError::Disconnected) => break,
+                };
+                pending -= 1;
+                let Some(section) = section else {
+                    continue;
+                };
+
+                let still_current = this
+                    .update(cx, |app, cx| {
+                        app.apply_root_passive_late_section(&key, section, cx)
+                    })
+                    .unwrap_or(false);
+                if !still_current {
+                    break;
+                }
+            }
+        })
+        .detach();
+    }
+
+    /// Patch one late section into the cached frame. Returns `false` once the
+    /// frame for `key` is gone, which stops the pump.
+    fn apply_root_passive_late_section(
+        &mut self,
+        key: &crate::RootPassiveFrameKey,
+        section: RootPassiveSection,
+        cx: &mut Context<Self>,
+    ) -> bool {
+        let Some(frame) = self
+            .root_passive_frame
+            .as_mut()
+            .filter(|frame| &frame.key == key)
+        else {
+            return false;
+        };
+
+        let source = section.source();
+        let hits = section.hit_count();
+        section.apply_to(frame);
+        tracing::debug!(
+            target: "script_kit::root_passive",
+            source,
+            hits,
+            "late root passive section applied"
+        );
+        if hits == 0 {
+            // The frame already rendered this section as empty.
+            return true;
+        }
+
+        let selection_before = self.main_menu_selection_snapshot();
+        self.invalidate_grouped_cache();
+        self.invalidate_main_window_preflight();
+        self.reconcile_script_list_after_results_refresh(
+            "root_passive_late_section",
+            selection_before,
+            cx,
+        );
+        cx.notify();
+        true
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+
+    // Each test fans out on its own generation so parallel tests never
+    // supersede each other's frames.
+    static TEST_GENERATION_STRAGGLERS: AtomicU64 = AtomicU64::new(0);
+    static TEST_GENERATION_LATENCY: AtomicU64 = AtomicU64::new(0);
+    static TEST_GENERATION_PANIC: AtomicU64 = AtomicU64::new(0);
+    static TEST_GENERATION_STALE: AtomicU64 = AtomicU64::new(0);
+
+    #[test]
+    fn fan_out_publishes_fast_sources_and_hands_back_stragglers() {
+        let (release_tx, release_rx) = std::sync::mpsc::channel::<()>();
+        let jobs = vec![
+            RootPassiveSourceJob::new("notes", false, || RootPassiveSection::Notes(Vec::new())),
+            RootPassiveSourceJob::new("todo", true, move || {
+                let _ = release_rx.recv();
+                RootPassiveSection::Todo(Vec::new())
+            }),
+        ];
+
+        let fan_out = fan_out_root_passive_sources(
+            jobs,
+            3,
+            std::time::Duration::from_millis(50),
+            &TEST_GENERATION_STRAGGLERS,
+        );
+        let ready: Vec<_> = fan_out
+            .ready
+            .iter()
+            .map(RootPassiveSection::source)
+            .collect();
+        assert_eq!(ready, vec!["notes"]);
+
+        let (pending, receiver) = fan_out.late.expect("slow source should be late");
+        assert_eq!(pending, 1);
+        release_tx.send(()).expect("release slow source");
+        let late = receiver
+            .recv_timeout(std::time::Duration::from_secs(5))
+            .expect("late section should arrive")
+            .expect("late section should not be skipped");
+        assert_eq!(late.source(), "todo");
+    }
+
+    #[test]
+    fn fan_out_latency_lands_in_per_source_histogram() {
+        let jobs = vec![
+            RootPassiveSourceJob::new("browser_tabs", false, || {
+                RootPassiveSection::BrowserTabs(Vec::new())
+            }),
+            RootPassiveSourceJob::new("dictation_history", false, || {
+                RootPassiveSection::DictationHistory(Vec::new())
+            }),
+        ];
+        let fan_out = fan_out_root_passive_sources(
+            jobs,
+            0,
+            std::time::Duration::from_secs(5),
+            &TEST_GENERATION_LATENCY,
+        );
+        assert_eq!(fan_out.ready.len(), 2);
+        assert!(fan_out.late.is_none());
+
+        let latency = root_passive_source_latency();
+        for source in ["browser_tabs", "dictation_history"] {
+            assert!(
+                latency
+                    .iter()
+                    .any(|(name, histogram)| *name == source && histogram.count() > 0),
+                "{source} latency should be recorded"
+            );
+        }
+    }
+
+    #[test]
+    fn fan_out_degrades_a_panicking_source_to_an_empty_section() {
+        let jobs = vec![
+            RootPassiveSourceJob::new("notes", false, || RootPassiveSection::Notes(Vec::new())),
+            RootPassiveSourceJob::new("ai_vault", false, || panic!("vault index corrupt")),
+        ];
+        let fan_out = fan_out_root_passive_sources(
+            jobs,
+            0,
+            std::time::Duration::from_secs(5),
+            &TEST_GENERATION_PANIC,
+        );
+        let ready: Vec<_> = fan_out
+            .ready
+            .iter()
+            .map(RootPassiveSection::source)
+            .collect();
+        assert_eq!(ready, vec!["notes"]);
+        assert!(
+            fan_out.late.is_none(),
+            "a panicked source counts as finished, not late"
+        );
+    }
+
+    #[test]
+    fn fan_out_skips_queued_jobs_from_a_superseded_frame() {
+        let (release_tx, release_rx) = std::sync::mpsc::channel::<()>();
+        let release_rx = std::sync::Arc::new(std::sync::Mutex::new(release_rx));
+        let stale_ran = std::sync::Arc::new(AtomicBool::new(false));
+
+        // Occupy every worker, then queue one more job behind them.
+        let mut jobs: Vec<_> = (0..ROOT_PASSIVE_WORKERS)
+            .map(|_| {
+                let release_rx = release_rx.clone();
+                RootPassiveSourceJob::new("notes", false, move || {
+                    let _ = release_rx
+                        .lock()
+                        .unwrap_or_else(|poisoned| poisoned.into_inner())
+                        .recv();
+                    RootPassiveSection::Notes(Vec::new())
+                })
+            })
+            .collect();
+        let ran = stale_ran.clone();
+        jobs.push(RootPassiveSourceJob::new("todo", false, move || {
+            ran.store(true, Ordering::SeqCst);
+            RootPassiveSection::Todo(Vec::new())
+        }));
+        let fan_out = fan_out_root_passive_sources(
+            jobs,
+            1,
+            std::time::Duration::from_millis(10),
+            &TEST_GENERATION_STALE,
+        );
+        let (pending, receiver) = fan_out.late.expect("blocked sources should be late");
+        assert_eq!(pending, ROOT_PASSIVE_WORKERS + 1);
+
+        // The next keystroke starts a newer frame before the workers free up.
+        let newer = fan_out_root_passive_sources(
+            Vec::new(),
+            2,
+            std::time::Duration::ZERO,
+            &TEST_GENERATION_STALE,
+        );
+        assert!(newer.ready.is_empty());
+        for _ in 0..ROOT_PASSIVE_WORKERS {
+            release_tx.send(()).expect("release blocked source");
+        }
+
+        let sections: Vec<_> = (0..pending)
+            .map(|_| {
+                receiver
+                    .recv_timeout(std::time::Duration::from_secs(5))
+                    .expect("every job should report back")
+            })
+            .collect();
+        assert_eq!(
+            sections.iter().filter(|section| section.is_none()).count(),
+            1
+        );
+        assert!(
+            !stale_ran.load(Ordering::SeqCst),
+            "a job queued for a superseded frame must not run"
+        );
+    }
+}
@@ -416,14 +416,14 @@ impl ScriptListApp {
         if app_launcher_enabled {
             // Use an async channel so the UI task can await completion without polling.
             let (tx, rx) =
-                async_channel::bounded::<(Vec<app_launcher::AppInfo>, std::time::Duration)>(1);
+                async_channel::bounded::<(Vec<app_launcher::AppInfo>, u64, std::time::Duration)>(1);
 
             // Spawn background thread for app scanning
             std::thread::spawn(move || {
                 let start = std::time::Instant::now();
-                let apps = app_launcher::scan_applications().clone();
+                let (apps, generation) = app_launcher::get_cached_apps_with_generation();
                 let elapsed = start.elapsed();
-                if tx.send_blocking((apps, elapsed)).is_err() {
+                if tx.send_blocking((apps, generation, elapsed)).is_err() {
                     logging::log(
                         "APP",
                         "Background app loading result dropped: receiver unavailable",
@@ -433,7 +433,7 @@ impl ScriptListApp {
 
             // Event-driven receive: no timer wakeups while waiting for app scan completion.
             cx.spawn(async move |this, cx| {
-                let Ok((apps, elapsed)) = rx.recv().await else {
+                let Ok((apps, generation, elapsed)) = rx.recv().await else {
                     logging::log(
                         "APP",
                         "Background app loading failed to deliver result: channel closed",
@@ -445,6 +445,7 @@ impl ScriptListApp {
                 let _ = cx.update(|cx| {
                     this.update(cx, |app, cx| {
                         app.apps = apps;
+                        app.apps_generation = Some(generation);
                         // Invalidate caches since apps changed
                         app.main_menu_result_caches.mark_apps_loaded();
                         app.rebuild_root_windows_after_app_icon_cache_update(
@@ -916,6 +917,7 @@ impl ScriptListApp {
             script_validation_report,
             builtin_entries,
             apps,
+            apps_generation: None,
             // P0 FIX: Cached data for builtin views (avoids cloning per frame)
             cached_clipboard_entries: Vec::new(),
             paste_sequential_state: None,
@@ -948,6 +950,7 @@ impl ScriptListApp {
             root_file_source_chip_visible_limit:
                 crate::file_search::ROOT_FILE_SOURCE_CHIP_INITIAL_VISIBLE_ROWS,
             root_passive_frame: None,
+            root_passive_late_sections: None,
             root_brain_semantic_results: None,
             root_brain_search_generation: 0,
             root_brain_search_request: None,
@@ -1932,6 +1935,10 @@ impl ScriptListApp {
         // compatible Agent Chat submit can reuse an initialized runtime/session.
         crate::ai::agent_chat::ui::prewarm_agent_config();
 
+        // Load syntect syntaxes/themes off the UI thread so the first code
+        // preview doesn't block on them.
+        crate::syntax::prewarm_highlighting_assets();
+
         // Prewarm Agent Chat and the Tab AI harness asynchronously so AI-entry
         // shortcuts do not pay subprocess/session startup cost on submit.
         let app_entity_for_tab_ai_warm = cx.entity().downgrade();
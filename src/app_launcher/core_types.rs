@@ -2,16 +2,18 @@ use anyhow::{Context, Result};
 use rayon::prelude::*;
 use rusqlite::{params, Connection};
 use std::collections::hash_map::DefaultHasher;
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::fs;
 use std::hash::{Hash, Hasher};
 use std::path::{Path, PathBuf};
 use std::process::Command;
-use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
 use std::sync::{Arc, LazyLock, Mutex, OnceLock};
 use std::time::Instant;
 use tracing::{debug, error, info, info_span, trace, warn};
 
+use crate::utils::sqlite_pool::{SqlitePool, DEFAULT_READ_CONNECTIONS};
+
 /// Stats for icon extraction during a scan (thread-safe)
 static ICONS_EXTRACTED: AtomicUsize = AtomicUsize::new(0);
 static ICONS_FROM_CACHE: AtomicUsize = AtomicUsize::new(0);
@@ -134,6 +136,10 @@ impl AppLoadingState {
     }
 }
 
+/// Bumped, under the `APP_CACHE` lock, each time a scan replaces the cache.
+/// Identifies which list an [`AppScanDelta`] was computed against.
+static APP_CACHE_GENERATION: AtomicU64 = AtomicU64::new(0);
+
 /// Cached list of applications (in-memory, populated from SQLite + directory scan)
 static APP_CACHE: LazyLock<Arc<Mutex<Vec<AppInfo>>>> = LazyLock::new(|| {
     set_loading_state(AppLoadingState::LoadingFromCache);
@@ -151,6 +157,7 @@ static APP_CACHE: LazyLock<Arc<Mutex<Vec<AppInfo>>>> = LazyLock::new(|| {
         );
 
         // Create Arc and spawn background thread to scan for new/changed apps
+        let previous = cached_apps.clone();
         let cache_arc = Arc::new(Mutex::new(cached_apps));
         let cache_for_thread = Arc::clone(&cache_arc);
 
@@ -159,13 +166,14 @@ static APP_CACHE: LazyLock<Arc<Mutex<Vec<AppInfo>>>> = LazyLock::new(|| {
             set_loading_state(AppLoadingState::ScanningDirectories);
 
             let scan_start = Instant::now();
-            let fresh_apps = scan_all_directories_with_db_update();
+            let (fresh_apps, delta) = scan_all_directories_with_db_update(&previous);
             let scan_duration = scan_start.elapsed().as_millis();
             let app_count = fresh_apps.len();
 
             // Update the in-memory cache (this Arc is shared with APP_CACHE)
             if let Ok(mut guard) = cache_for_thread.lock() {
                 *guard = fresh_apps;
+                APP_CACHE_GENERATION.fetch_add(1, Ordering::SeqCst);
             }
 
             let (db_count, db_size) = get_apps_db_stats();
@@ -174,6 +182,9 @@ static APP_CACHE: LazyLock<Arc<Mutex<Vec<AppInfo>>>> = LazyLock::new(|| {
                 duration_ms = scan_duration,
                 db_apps = db_count,
                 db_icon_size_kb = db_size / 1024,
+                added = delta.added.len(),
+                removed = delta.removed.len(),
+                updated = delta.updated.len(),
                 "Background app scan complete"
             );
 
@@ -188,7 +199,7 @@ static APP_CACHE: LazyLock<Arc<Mutex<Vec<AppInfo>>>> = LazyLock::new(|| {
     info!("No SQLite cache found, performing full scan");
     set_loading_state(AppLoadingState::ScanningDirectories);
 
-    let apps = scan_all_directories_with_db_update();
+    let (apps, _) = scan_all_directories_with_db_update(&[]);
     let duration_ms = start.elapsed().as_millis();
 
     let (db_count, db_size) = get_apps_db_stats();
@@ -209,8 +220,8 @@ static APP_CACHE: LazyLock<Arc<Mutex<Vec<AppInfo>>>> = LazyLock::new(|| {
 static APP_LOADING_STATE: LazyLock<Mutex<AppLoadingState>> =
     LazyLock::new(|| Mutex::new(AppLoadingState::LoadingFromCache));
 
-/// Database connection for apps cache
-static APPS_DB: OnceLock<Arc<Mutex<Connection>>> = OnceLock::new();
+/// Database pool for apps cache (writer plus read-only WAL connections)
+static APPS_DB: OnceLock<Arc<SqlitePool>> = OnceLock::new();
 
 /// Directories to scan for .app bundles
 const APP_DIRECTORIES: &[&str] = &[
@@ -6,6 +6,10 @@ fn get_apps_db_path() -> PathBuf {
 
 /// Initialize the apps database schema
 fn init_apps_db(conn: &Connection) -> Result<()> {
+    // WAL so the launcher's startup load reads alongside a rescan's writes.
+    conn.pragma_update(None, "journal_mode", "WAL")
+        .context("Failed to enable WAL for apps database")?;
+
     conn.execute(
         "CREATE TABLE IF NOT EXISTS apps (
             bundle_id TEXT PRIMARY KEY,
@@ -26,8 +30,8 @@ fn init_apps_db(conn: &Connection) -> Result<()> {
     Ok(())
 }
 
-/// Get or initialize the apps database connection
-fn get_apps_db() -> Result<Arc<Mutex<Connection>>> {
+/// Get or initialize the apps database pool
+fn get_apps_db() -> Result<Arc<SqlitePool>> {
     if let Some(db) = APPS_DB.get() {
         return Ok(Arc::clone(db));
     }
@@ -44,7 +48,12 @@ fn get_apps_db() -> Result<Arc<Mutex<Connection>>> {
 
     init_apps_db(&conn)?;
 
-    let db = Arc::new(Mutex::new(conn));
+    let db = Arc::new(SqlitePool::new(
+        "apps",
+        &db_path,
+        conn,
+        DEFAULT_READ_CONNECTIONS,
+    ));
 
     // Try to store it, but another thread might beat us
     match APPS_DB.set(Arc::clone(&db)) {
@@ -94,6 +103,15 @@ pub fn get_cached_apps() -> Vec<AppInfo> {
     APP_CACHE.lock().map(|g| g.clone()).unwrap_or_default()
 }
 
+/// The in-memory app cache and its generation, read under one lock so the
+/// two always match. Pass the generation to [`AppScanDelta::applies_to`].
+pub fn get_cached_apps_with_generation() -> (Vec<AppInfo>, u64) {
+    let guard = APP_CACHE
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner());
+    (guard.clone(), APP_CACHE_GENERATION.load(Ordering::SeqCst))
+}
+
 /// Look up a pre-decoded app icon from the in-memory cache by bundle ID.
 pub fn cached_app_icon_for_bundle(bundle_id: &str) -> Option<DecodedIcon> {
     let bundle_id = bundle_id.trim();
@@ -119,11 +137,21 @@ fn get_mtime(path: &Path) -> Option<i64> {
         .map(|d| d.as_secs() as i64)
 }
 
+/// Modification time used to gate bundle re-parsing: the newer of the
+/// bundle directory and its `Contents/Info.plist`, since in-place updates do
+/// not always touch the bundle root.
+fn bundle_mtime(path: &Path) -> Option<i64> {
+    let bundle = get_mtime(path);
+    let plist = get_mtime(&path.join("Contents/Info.plist"));
+    bundle.max(plist)
+}
+
 // ============================================================================
 // SQLite Cache Operations
 // ============================================================================
 
-fn with_apps_db<T>(default: T, f: impl FnOnce(&Connection) -> T) -> T {
+/// Run `f` on the apps database writer; `default` when it is unavailable.
+fn with_apps_db<T>(label: &'static str, default: T, f: impl FnOnce(&Connection) -> T) -> T {
     let db = match get_apps_db() {
         Ok(db) => db,
         Err(e) => {
@@ -132,15 +160,33 @@ fn with_apps_db<T>(default: T, f: impl FnOnce(&Connection) -> T) -> T {
         }
     };
 
-    let conn = match db.lock() {
-        Ok(c) => c,
+    match db.with_write(label, |conn| Ok(f(conn))) {
+        Ok(value) => value,
         Err(e) => {
             error!(error = %e, "Failed to lock apps database");
+            default
+        }
+    }
+}
+
+/// [`with_apps_db`] for pure SELECTs, on a read-only connection so the
+/// launcher's loads never queue behind a rescan's writes.
+fn with_apps_db_read<T>(label: &'static str, default: T, f: impl FnOnce(&Connection) -> T) -> T {
+    let db = match get_apps_db() {
+        Ok(db) => db,
+        Err(e) => {
+            warn!(error = %e, "Failed to get apps database");
             return default;
         }
     };
 
-    f(&conn)
+    match db.with_read(label, |conn| Ok(f(conn))) {
+        Ok(value) => value,
+        Err(e) => {
+            error!(error = %e, "Failed to lock apps database");
+            default
+        }
+    }
 }
 
 /// Load all apps from the SQLite cache with icons decoded synchronously.
@@ -151,7 +197,7 @@ fn load_apps_from_db() -> Vec<AppInfo> {
     let _span = info_span!("load_apps_from_db").entered();
     let start = Instant::now();
 
-    with_apps_db(Vec::new(), |conn| {
+    with_apps_db_read("load_apps", Vec::new(), |conn| {
         let mut stmt = match conn.prepare(
             "SELECT bundle_id, name, path, icon_blob FROM apps ORDER BY name COLLATE NOCASE",
         ) {
@@ -212,9 +258,36 @@ fn load_apps_from_db() -> Vec<AppInfo> {
     })
 }
 
+/// Load the stored bundle mtime for every cached app path.
+fn load_app_mtimes_from_db() -> HashMap<PathBuf, i64> {
+    with_apps_db_read("load_app_mtimes", HashMap::new(), |conn| {
+        let mut stmt = match conn.prepare("SELECT path, mtime FROM apps") {
+            Ok(s) => s,
+            Err(e) => {
+                warn!(error = %e, "Failed to prepare app mtime query");
+                return HashMap::new();
+            }
+        };
+
+        let rows = stmt.query_map([], |row| {
+            let path: String = row.get(0)?;
+            let mtime: i64 = row.get(1)?;
+            Ok((PathBuf::from(path), mtime))
+        });
+
+        match rows {
+            Ok(rows) => rows.flatten().collect(),
+            Err(e) => {
+                warn!(error = %e, "Failed to query app mtimes");
+                HashMap::new()
+            }
+        }
+    })
+}
+
 /// Save or update an app in the SQLite cache
 fn save_app_to_db(app: &AppInfo, icon_bytes: Option<&[u8]>, mtime: i64) {
-    with_apps_db((), |conn| {
+    with_apps_db("save_app", (), |conn| {
         let now = std::time::SystemTime::now()
             .duration_since(std::time::UNIX_EPOCH)
             .map(|d| d.as_secs() as i64)
@@ -243,7 +316,7 @@ fn save_app_to_db(app: &AppInfo, icon_bytes: Option<&[u8]>, mtime: i64) {
 
 /// Get database statistics for logging
 pub fn get_apps_db_stats() -> (usize, u64) {
-    with_apps_db((0, 0), |conn| {
+    with_apps_db_read("apps_db_stats", (0, 0), |conn| {
         let count: i64 = conn
             .query_row("SELECT COUNT(*) FROM apps", [], |row| row.get(0))
             .unwrap_or(0);
@@ -29,21 +29,95 @@ pub fn scan_applications() -> Vec<AppInfo> {
 /// This is how newly installed/removed apps show up without an app restart:
 /// the app watcher calls this on /Applications changes. Blocking (disk +
 /// sqlite) — run on a background thread/executor, never the UI thread.
+#[allow(dead_code)]
 pub fn scan_applications_fresh() -> Vec<AppInfo> {
+    scan_applications_incremental();
+    get_cached_apps()
+}
+
+/// Rescan application directories against the in-memory cache and return
+/// what changed.
+///
+/// Bundles whose mtime still matches the `apps` table keep their cached
+/// `AppInfo` (no plist or icon work), and the returned delta lets the
+/// launcher patch its list instead of replacing it. Blocking, like
+/// [`scan_applications_fresh`].
+pub fn scan_applications_incremental() -> AppScanDelta {
     let start = Instant::now();
-    let apps = scan_all_directories_with_db_update();
-    if let Ok(mut guard) = APP_CACHE.lock() {
-        *guard = apps.clone();
+    let (previous, previous_generation) = get_cached_apps_with_generation();
+    let (apps, mut delta) = scan_all_directories_with_db_update(&previous);
+    let app_count = apps.len();
+    delta.previous_generation = previous_generation;
+    {
+        let mut guard = APP_CACHE
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        *guard = apps;
+        delta.generation = APP_CACHE_GENERATION.fetch_add(1, Ordering::SeqCst) + 1;
     }
-    let duration_ms = start.elapsed().as_millis();
 
     info!(
-        app_count = apps.len(),
-        duration_ms = duration_ms,
-        "Fresh scan of applications (cache updated)"
+        app_count,
+        added = delta.added.len(),
+        removed = delta.removed.len(),
+        updated = delta.updated.len(),
+        duration_ms = start.elapsed().as_millis(),
+        "Incremental scan of applications (cache updated)"
     );
 
-    apps
+    delta
+}
+
+/// Changes between two application scans, keyed by bundle path.
+#[derive(Debug, Default)]
+pub struct AppScanDelta {
+    /// Bundles that were not in the previous list.
+    pub added: Vec<AppInfo>,
+    /// Bundles that disappeared (or lost a same-name tie to another root).
+    pub removed: Vec<PathBuf>,
+    /// Bundles whose mtime changed and were re-parsed.
+    pub updated: Vec<AppInfo>,
+    /// Cache generation of the app list the delta was computed against.
+    pub previous_generation: u64,
+    /// Cache generation the scan published; the patched list is at this one.
+    pub generation: u64,
+}
+
+impl AppScanDelta {
+    pub fn is_empty(&self) -> bool {
+        self.added.is_empty() && self.removed.is_empty() && self.updated.is_empty()
+    }
+
+    /// Whether this delta patches a list read from the cache at `generation`
+    /// (`None` for a list never read from it).
+    pub fn applies_to(&self, generation: Option<u64>) -> bool {
+        generation == Some(self.previous_generation)
+    }
+
+    /// Patch a scan-ordered app list (sorted case-insensitively by name, one
+    /// entry per name) into the list the delta was computed from.
+    pub fn apply_to(&self, apps: &mut Vec<AppInfo>) {
+        if self.is_empty() {
+            return;
+        }
+
+        let replaced: HashSet<&Path> = self
+            .removed
+            .iter()
+            .map(PathBuf::as_path)
+            .chain(self.updated.iter().map(|app| app.path.as_path()))
+            .collect();
+        apps.retain(|app| !replaced.contains(app.path.as_path()));
+
+        // Lowercase each name once; the binary searches compare cached keys.
+        let mut keys: Vec<String> = apps.iter().map(|app| app.name.to_lowercase()).collect();
+        for app in self.updated.iter().chain(&self.added) {
+            let key = app.name.to_lowercase();
+            let index = keys.partition_point(|existing| *existing < key);
+            keys.insert(index, key);
+            apps.insert(index, app.clone());
+        }
+    }
 }
 
 /// Reset icon extraction stats before a new scan
@@ -83,89 +157,156 @@ fn log_icon_stats_summary() {
     }
 }
 
-/// Scan all configured directories for applications and update SQLite
-fn scan_all_directories_with_db_update() -> Vec<AppInfo> {
+/// Scan all configured directories for applications and update SQLite.
+///
+/// Bundles already in `previous` whose mtime matches the `apps` table are
+/// reused as-is; everything else is parsed and written back.
+fn scan_all_directories_with_db_update(previous: &[AppInfo]) -> (Vec<AppInfo>, AppScanDelta) {
     let _span = info_span!("scan_all_directories_with_db_update").entered();
     let start = Instant::now();
 
     // Reset stats for this scan
     reset_icon_stats();
 
-    let mut apps = Vec::new();
-    let mut dirs_scanned = 0;
+    let roots: Vec<PathBuf> = APP_DIRECTORIES
+        .iter()
+        .map(|dir| PathBuf::from(shellexpand::tilde(dir).as_ref()))
+        .collect();
+    let known_mtimes = load_app_mtimes_from_db();
 
-    for dir in APP_DIRECTORIES {
-        let expanded = shellexpand::tilde(dir);
-        let path = Path::new(expanded.as_ref());
+    let outcome = scan_app_roots(&roots, previous, &known_mtimes, |path, mtime| {
+        let (app_info, icon_bytes) = parse_app_bundle_with_icon(path)?;
+        // Save to SQLite (thread-safe via the pool writer in get_apps_db)
+        save_app_to_db(&app_info, icon_bytes.as_deref(), mtime);
+        Some(app_info)
+    });
 
-        if path.exists() {
+    // Log icon extraction summary (batched instead of per-app)
+    log_icon_stats_summary();
+
+    debug!(
+        total_apps = outcome.apps.len(),
+        bundles_reused = outcome.reused,
+        bundles_parsed = outcome.parsed,
+        total_duration_ms = start.elapsed().as_millis(),
+        "Directory scan complete"
+    );
+
+    (outcome.apps, outcome.delta)
+}
+
+struct AppScanOutcome {
+    apps: Vec<AppInfo>,
+    delta: AppScanDelta,
+    reused: usize,
+    parsed: usize,
+}
+
+/// Walk `roots` concurrently and build the deduplicated, name-sorted app
+/// list plus its delta against `previous`.
+///
+/// `parse` runs only for bundles that are new or whose mtime differs from
+/// `known_mtimes`; it receives the mtime to persist.
+fn scan_app_roots(
+    roots: &[PathBuf],
+    previous: &[AppInfo],
+    known_mtimes: &HashMap<PathBuf, i64>,
+    parse: impl Fn(&Path, i64) -> Option<AppInfo> + Sync,
+) -> AppScanOutcome {
+    // Results keep root order, so "prefer the first directory" dedup holds.
+    let per_root: Vec<Vec<PathBuf>> = roots
+        .par_iter()
+        .map(|root| {
+            if !root.exists() {
+                trace!(directory = %root.display(), "Directory does not exist, skipping");
+                return Vec::new();
+            }
             let dir_start = Instant::now();
-            match scan_directory_with_db_update(path) {
+            match collect_app_paths(root) {
                 Ok(found) => {
-                    let count = found.len();
                     trace!(
-                        directory = %path.display(),
-                        count,
+                        directory = %root.display(),
+                        count = found.len(),
                         duration_ms = dir_start.elapsed().as_millis(),
                         "Scanned directory"
                     );
-                    apps.extend(found);
-                    dirs_scanned += 1;
+                    found
                 }
                 Err(e) => {
                     warn!(
-                        directory = %path.display(),
+                        directory = %root.display(),
                         error = %e,
                         "Failed to scan directory"
                     );
+                    Vec::new()
                 }
             }
-        } else {
-            trace!(directory = %path.display(), "Directory does not exist, skipping");
-        }
-    }
-
-    // Sort by name for consistent ordering
-    apps.sort_by(|a, b| a.name.to_lowercase().cmp(&b.name.to_lowercase()));
-
-    // Remove duplicates (same name from different directories - prefer first)
-    apps.dedup_by(|a, b| a.name.to_lowercase() == b.name.to_lowercase());
-
-    // Log icon extraction summary (batched instead of per-app)
-    log_icon_stats_summary();
-
-    debug!(
-        total_apps = apps.len(),
-        dirs_scanned,
-        total_duration_ms = start.elapsed().as_millis(),
-        "Directory scan complete"
-    );
+        })
+        .collect();
 
-    apps
-}
+    // Nested roots (/Applications and /Applications/Utilities) report the
+    // same bundles; parse each path once.
+    let mut seen_paths = HashSet::new();
+    let app_paths: Vec<PathBuf> = per_root
+        .into_iter()
+        .flatten()
+        .filter(|path| seen_paths.insert(path.clone()))
+        .collect();
 
-/// Scan a single directory for .app bundles and update SQLite
-///
-/// Uses parallel iteration (rayon) for icon extraction which is the bottleneck.
-fn scan_directory_with_db_update(dir: &Path) -> Result<Vec<AppInfo>> {
-    let app_paths = collect_app_paths(dir)?;
+    let previous_by_path: HashMap<&Path, &AppInfo> = previous
+        .iter()
+        .map(|app| (app.path.as_path(), app))
+        .collect();
 
     // Process apps in parallel using rayon (icon extraction is the bottleneck)
-    let apps: Vec<AppInfo> = app_paths
+    let scanned: Vec<(AppInfo, bool)> = app_paths
         .par_iter()
         .filter_map(|path| {
-            if let Some((app_info, icon_bytes)) = parse_app_bundle_with_icon(path) {
-                // Save to SQLite (thread-safe via mutex in get_apps_db)
-                let mtime = get_mtime(path).unwrap_or(0);
-                save_app_to_db(&app_info, icon_bytes.as_deref(), mtime);
-                Some(app_info)
-            } else {
-                None
+            let mtime = bundle_mtime(path).unwrap_or(0);
+            if mtime > 0 && known_mtimes.get(path) == Some(&mtime) {
+                if let Some(app) = previous_by_path.get(path.as_path()) {
+                    return Some(((*app).clone(), false));
+                }
             }
+            parse(path, mtime).map(|app| (app, true))
         })
         .collect();
 
-    Ok(apps)
+    let parsed = scanned.iter().filter(|(_, reparsed)| *reparsed).count();
+    let reused = scanned.len() - parsed;
+
+    // Sort by name for consistent ordering; lowercase each name once.
+    let mut keyed: Vec<(String, AppInfo, bool)> = scanned
+        .into_iter()
+        .map(|(app, reparsed)| (app.name.to_lowercase(), app, reparsed))
+        .collect();
+    keyed.sort_by(|a, b| a.0.cmp(&b.0));
+
+    // Remove duplicates (same name from different directories - prefer first)
+    keyed.dedup_by(|a, b| a.0 == b.0);
+
+    let mut delta = AppScanDelta::default();
+    let current_paths: HashSet<&Path> =
+        keyed.iter().map(|(_, app, _)| app.path.as_path()).collect();
+    delta.removed = previous
+        .iter()
+        .filter(|app| !current_paths.contains(app.path.as_path()))
+        .map(|app| app.path.clone())
+        .collect();
+    for (_, app, reparsed) in &keyed {
+        if !previous_by_path.contains_key(app.path.as_path()) {
+            delta.added.push(app.clone());
+        } else if *reparsed {
+            delta.updated.push(app.clone());
+        }
+    }
+
+    AppScanOutcome {
+        apps: keyed.into_iter().map(|(_, app, _)| app).collect(),
+        delta,
+        reused,
+        parsed,
+    }
 }
 
 /// Parse a .app bundle to extract application information and icon bytes
@@ -174,6 +174,147 @@ mod tests {
         );
     }
 
+    fn make_fixture_bundle(root: &Path, relative: &str) -> PathBuf {
+        let bundle = root.join(relative);
+        std::fs::create_dir_all(bundle.join("Contents")).expect("create bundle");
+        std::fs::write(bundle.join("Contents/Info.plist"), "<plist/>").expect("write plist");
+        bundle
+    }
+
+    fn set_fixture_mtime(path: &Path, secs: u64) {
+        let time = std::time::UNIX_EPOCH + std::time::Duration::from_secs(secs);
+        std::fs::File::open(path)
+            .and_then(|file| file.set_modified(time))
+            .expect("set mtime");
+    }
+
+    /// Runs `scan_app_roots` with a parser that records each bundle it was
+    /// asked to parse instead of touching plists, icons, or SQLite.
+    fn scan_fixture_roots(
+        roots: &[PathBuf],
+        previous: &[AppInfo],
+        known_mtimes: &HashMap<PathBuf, i64>,
+    ) -> (AppScanOutcome, Vec<PathBuf>) {
+        let parsed = Mutex::new(Vec::new());
+        let outcome = scan_app_roots(roots, previous, known_mtimes, |path, _mtime| {
+            parsed.lock().unwrap().push(path.to_path_buf());
+            Some(AppInfo {
+                name: path.file_stem()?.to_str()?.to_string(),
+                path: path.to_path_buf(),
+                bundle_id: None,
+                icon: None,
+            })
+        });
+        (outcome, parsed.into_inner().unwrap())
+    }
+
+    fn fixture_mtimes(apps: &[AppInfo]) -> HashMap<PathBuf, i64> {
+        apps.iter()
+            .map(|app| (app.path.clone(), bundle_mtime(&app.path).unwrap()))
+            .collect()
+    }
+
+    fn app_paths(apps: &[AppInfo]) -> Vec<PathBuf> {
+        apps.iter().map(|app| app.path.clone()).collect()
+    }
+
+    #[test]
+    fn test_scan_app_roots_skips_bundles_with_unchanged_mtime() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let roots = vec![temp.path().to_path_buf()];
+        let alpha = make_fixture_bundle(temp.path(), "Alpha.app");
+        let beta = make_fixture_bundle(temp.path(), "beta.app");
+
+        let (first, parsed) = scan_fixture_roots(&roots, &[], &HashMap::new());
+        assert_eq!(parsed.len(), 2);
+        assert_eq!(app_paths(&first.apps), vec![alpha.clone(), beta.clone()]);
+        assert_eq!(app_paths(&first.delta.added), app_paths(&first.apps));
+
+        let known = fixture_mtimes(&first.apps);
+        let (second, parsed) = scan_fixture_roots(&roots, &first.apps, &known);
+        assert!(parsed.is_empty(), "unchanged bundles must not be re-parsed");
+        assert_eq!(second.reused, 2);
+        assert!(second.delta.is_empty());
+
+        // An in-place update that only touches Info.plist still counts.
+        set_fixture_mtime(&beta.join("Contents/Info.plist"), 4_000_000_000);
+        let (third, parsed) = scan_fixture_roots(&roots, &second.apps, &known);
+        assert_eq!(parsed, vec![beta.clone()]);
+        assert_eq!(app_paths(&third.delta.updated), vec![beta]);
+        assert!(third.delta.added.is_empty() && third.delta.removed.is_empty());
+    }
+
+    #[test]
+    fn test_scan_app_roots_delta_patches_previous_list() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let roots = vec![temp.path().to_path_buf()];
+        make_fixture_bundle(temp.path(), "Mango.app");
+        let removed = make_fixture_bundle(temp.path(), "Zebra.app");
+        make_fixture_bundle(temp.path(), "apple.app");
+
+        let (first, _) = scan_fixture_roots(&roots, &[], &HashMap::new());
+        let known = fixture_mtimes(&first.apps);
+
+        std::fs::remove_dir_all(&removed).expect("remove bundle");
+        let added = make_fixture_bundle(temp.path(), "Nested/banana.app");
+        let (second, parsed) = scan_fixture_roots(&roots, &first.apps, &known);
+
+        assert_eq!(parsed, vec![added.clone()]);
+        assert_eq!(app_paths(&second.delta.added), vec![added]);
+        assert_eq!(second.delta.removed, vec![removed]);
+
+        let mut patched = first.apps.clone();
+        second.delta.apply_to(&mut patched);
+        assert_eq!(app_paths(&patched), app_paths(&second.apps));
+    }
+
+    #[test]
+    fn test_delta_applies_only_to_its_generation_and_keeps_name_order() {
+        let app = |name: &str| AppInfo {
+            name: name.to_string(),
+            path: PathBuf::from(format!("/Applications/{name}.app")),
+            bundle_id: None,
+            icon: None,
+        };
+        let delta = AppScanDelta {
+            added: vec![app("banana"), app("Cherry")],
+            removed: vec![PathBuf::from("/Applications/Zebra.app")],
+            updated: vec![app("apple")],
+            previous_generation: 3,
+            generation: 4,
+        };
+        assert!(delta.applies_to(Some(3)));
+        assert!(!delta.applies_to(Some(4)), "list already past the delta");
+        assert!(!delta.applies_to(None), "list never read from the cache");
+
+        let mut apps = vec![app("apple"), app("Mango"), app("Zebra")];
+        delta.apply_to(&mut apps);
+        let names: Vec<&str> = apps.iter().map(|app| app.name.as_str()).collect();
+        assert_eq!(names, vec!["apple", "banana", "Cherry", "Mango"]);
+    }
+
+    #[test]
+    fn test_scan_app_roots_parses_nested_roots_once_and_prefers_first_root() {
+        let temp = tempfile::tempdir().expect("tempdir");
+        let first_root = temp.path().join("Applications");
+        let nested_root = first_root.join("Utilities");
+        let second_root = temp.path().join("User Applications");
+        let shared = make_fixture_bundle(&nested_root, "Console.app");
+        let preferred = make_fixture_bundle(&first_root, "Notes.app");
+        make_fixture_bundle(&second_root, "notes.app");
+        let missing_root = temp.path().join("Missing");
+
+        let roots = vec![first_root, nested_root, missing_root, second_root];
+        let (outcome, parsed) = scan_fixture_roots(&roots, &[], &HashMap::new());
+
+        assert_eq!(
+            parsed.iter().filter(|path| **path == shared).count(),
+            1,
+            "bundles reachable from nested roots should be parsed once"
+        );
+        assert_eq!(app_paths(&outcome.apps), vec![shared, preferred]);
+    }
+
     #[cfg(feature = "slow-tests")]
     #[test]
     fn test_no_duplicate_apps() {
@@ -338,7 +338,10 @@ impl ScriptListApp {
                                 _ => &scriptlet.tool,
                             };
                             let highlighted = highlight_code_lines(&code_preview, lang, is_dark);
-                            self.scriptlet_preview_cache_key = Some(cache_key);
+                            // Don't pin the plain-text fallback served while
+                            // syntect assets are still loading.
+                            self.scriptlet_preview_cache_key =
+                                crate::syntax::highlighting_ready().then_some(cache_key);
                             self.scriptlet_preview_cache_lines = highlighted.clone();
                             highlighted
                         };
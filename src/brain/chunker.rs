@@ -7,6 +7,10 @@
 //!
 //! There is no tokenizer on this side of the embedder boundary, so sizes are
 //! byte budgets at ~4 bytes/token: 900 tokens ≈ 3600 bytes, 15% ≈ 540 bytes.
+//!
+//! Chunks are borrowed slices of the source, and each break is found by one
+//! backward scan of the window's back third, so bulk reindexing neither
+//! copies chunk text nor allocates per document.
 
 /// ~900 tokens at ~4 bytes/token.
 pub const CHUNK_TARGET_BYTES: usize = 3_600;
@@ -16,101 +20,179 @@ pub const CHUNK_OVERLAP_BYTES: usize = 540;
 /// 64 chunks ≈ 230 KB of text — far beyond any real note or day page.
 pub const MAX_CHUNKS_PER_DOC: usize = 64;
 
-#[derive(Debug, Clone, PartialEq)]
-pub struct Chunk {
+/// One chunk, borrowed from the source text — chunking copies nothing, and
+/// embed requests reference these slices directly.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct Chunk<'a> {
     /// Byte offset of the chunk start within the source text.
     pub start: usize,
-    pub text: String,
+    pub text: &'a str,
+}
+
+impl Chunk<'_> {
+    /// Byte range of the chunk within the source text.
+    pub fn range(&self) -> std::ops::Range<usize> {
+        self.start..self.start + self.text.len()
+    }
 }
 
 /// Split `text` into embed-ready chunks. Short inputs (≤ target) come back as
-/// a single chunk — the common fast path allocates once and never scans.
-pub fn chunk_markdown(text: &str) -> Vec<Chunk> {
+/// a single chunk — the common fast path never scans.
+pub fn chunk_markdown(text: &str) -> Vec<Chunk<'_>> {
     chunk_markdown_with(text, CHUNK_TARGET_BYTES, CHUNK_OVERLAP_BYTES)
 }
 
-pub fn chunk_markdown_with(text: &str, target: usize, overlap: usize) -> Vec<Chunk> {
-    let trimmed = text.trim_end();
-    if trimmed.is_empty() {
-        return Vec::new();
-    }
-    if trimmed.len() <= target {
-        return vec![Chunk {
-            start: 0,
-            text: trimmed.to_string(),
-        }];
-    }
-
-    let target = target.max(256);
-    let overlap = overlap.min(target / 2);
-    let mut chunks = Vec::new();
-    let mut start = 0usize;
-    while start < trimmed.len() && chunks.len() < MAX_CHUNKS_PER_DOC {
-        start = floor_char_boundary(trimmed, start);
-        let hard_end = floor_char_boundary(trimmed, (start + target).min(trimmed.len()));
-        let end = if hard_end == trimmed.len() {
-            hard_end
+pub fn chunk_markdown_with(text: &str, target: usize, overlap: usize) -> Vec<Chunk<'_>> {
+    MarkdownChunks::new(text, target, overlap).collect()
+}
+
+/// Streaming form of [`chunk_markdown_with`]: yields chunks one at a time.
+pub struct MarkdownChunks<'a> {
+    text: &'a str,
+    target: usize,
+    overlap: usize,
+    start: usize,
+    emitted: usize,
+    done: bool,
+}
+
+impl<'a> MarkdownChunks<'a> {
+    pub fn new(text: &'a str, target: usize, overlap: usize) -> Self {
+        let text = text.trim_end();
+        let target = if text.len() <= target {
+            target
         } else {
-            best_break(trimmed, start, hard_end)
+            target.max(256)
         };
-        if end <= start {
-            let next = next_char_boundary_after(trimmed, start);
-            if next <= start || next >= trimmed.len() {
-                break;
-            }
-            start = next;
-            continue;
-        }
-        let piece = trimmed[start..end].trim_end();
-        if !piece.is_empty() {
-            chunks.push(Chunk {
-                start,
-                text: piece.to_string(),
-            });
+        Self {
+            text,
+            target,
+            overlap: overlap.min(target / 2),
+            start: 0,
+            emitted: 0,
+            done: text.is_empty(),
         }
-        if end >= trimmed.len() {
-            break;
+    }
+
+    /// Pick the best break point in the back third of `(start, hard_end]`:
+    /// heading line > blank line > newline > sentence end > space > hard cap.
+    /// Only breaks in the back third are considered so chunks stay near the
+    /// target size.
+    fn best_break(&self, start: usize, hard_end: usize) -> usize {
+        let window_start = start + (hard_end - start) * 2 / 3;
+        let bytes = &self.text.as_bytes()[..hard_end];
+        // Scanning back from the hard cap, the first candidate of each kind
+        // is the last one in the window, so only a stronger kind replaces it.
+        // All break bytes are ASCII, so every break lands on a char boundary.
+        let mut best: Option<BreakCandidate> = None;
+        for pos in (window_start..hard_end).rev() {
+            let Some(kind) = break_kind_at(bytes, pos) else {
+                continue;
+            };
+            if best.is_none_or(|best| kind > best.kind) {
+                best = Some(BreakCandidate { pos, kind });
+                if kind == BreakKind::Heading {
+                    break;
+                }
+            }
         }
-        // Step back `overlap` bytes from the break so context spans the seam,
-        // but always advance past the previous start to guarantee progress.
-        let overlap_start = floor_char_boundary(trimmed, end.saturating_sub(overlap));
-        let min_next = next_char_boundary_after(trimmed, start);
-        start = overlap_start.max(min_next);
+        best.map_or(hard_end, |best| best.break_at())
     }
-    chunks
 }
 
-/// Pick the best break point in `(min_end, hard_end]`, searching backward
-/// from the hard cap: heading line > blank line > newline > sentence end >
-/// space > hard cap. Only breaks in the back third are considered so chunks
-/// stay near the target size.
-fn best_break(text: &str, start: usize, hard_end: usize) -> usize {
-    let start = floor_char_boundary(text, start);
-    let hard_end = floor_char_boundary(text, hard_end);
-    let window_start = start + (hard_end - start) * 2 / 3;
-    let window = &text[..hard_end];
+impl<'a> Iterator for MarkdownChunks<'a> {
+    type Item = Chunk<'a>;
 
-    // A heading begins a new section — break BEFORE the `#` line.
-    if let Some(pos) = rfind_in(window, window_start, "\n#") {
-        return pos + 1; // keep the `\n` with the previous chunk
-    }
-    if let Some(pos) = rfind_in(window, window_start, "\n\n") {
-        return pos + 2;
-    }
-    if let Some(pos) = rfind_in(window, window_start, "\n") {
-        return pos + 1;
+    fn next(&mut self) -> Option<Chunk<'a>> {
+        let text = self.text;
+        while !self.done && self.start < text.len() && self.emitted < MAX_CHUNKS_PER_DOC {
+            let start = floor_char_boundary(text, self.start);
+            let hard_end = floor_char_boundary(text, (start + self.target).min(text.len()));
+            let end = if hard_end == text.len() {
+                hard_end
+            } else {
+                self.best_break(start, hard_end)
+            };
+            if end <= start {
+                let next = next_char_boundary_after(text, start);
+                if next <= start || next >= text.len() {
+                    self.done = true;
+                    break;
+                }
+                self.start = next;
+                continue;
+            }
+            if end >= text.len() {
+                self.done = true;
+            } else {
+                // Step back `overlap` bytes from the break so context spans the
+                // seam, but always advance past the previous start to
+                // guarantee progress.
+                let overlap_start = floor_char_boundary(text, end.saturating_sub(self.overlap));
+                self.start = overlap_start.max(next_char_boundary_after(text, start));
+            }
+            let piece = text[start..end].trim_end();
+            if !piece.is_empty() {
+                self.emitted += 1;
+                return Some(Chunk { start, text: piece });
+            }
+        }
+        None
     }
-    if let Some(pos) = rfind_in(window, window_start, ". ") {
-        return pos + 2;
+}
+
+/// Break kinds, weakest first so the derived order ranks them.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord)]
+enum BreakKind {
+    /// `" "` — break after the space.
+    Space,
+    /// `". "` — break after the sentence end.
+    Sentence,
+    /// `"\n"` — break after the newline.
+    Line,
+    /// `"\n\n"` — break after the blank line.
+    Blank,
+    /// `"\n#"` — break BEFORE the heading line, keeping the `\n` with the
+    /// previous chunk.
+    Heading,
+}
+
+impl BreakKind {
+    fn match_len(self) -> usize {
+        match self {
+            Self::Space | Self::Line => 1,
+            Self::Sentence | Self::Blank | Self::Heading => 2,
+        }
     }
-    if let Some(pos) = rfind_in(window, window_start, " ") {
-        return pos + 1;
+}
+
+/// A place a chunk may end: `pos` is where the matched pattern starts.
+#[derive(Debug, Clone, Copy)]
+struct BreakCandidate {
+    pos: usize,
+    kind: BreakKind,
+}
+
+impl BreakCandidate {
+    fn break_at(&self) -> usize {
+        match self.kind {
+            BreakKind::Heading => self.pos + 1,
+            kind => self.pos + kind.match_len(),
+        }
     }
-    floor_char_boundary(text, hard_end)
 }
 
-fn rfind_in(window: &str, min_pos: usize, needle: &str) -> Option<usize> {
-    window.rfind(needle).filter(|pos| *pos >= min_pos)
+/// The strongest break whose pattern starts at `pos` and ends within
+/// `bytes`, the text up to the hard cap.
+fn break_kind_at(bytes: &[u8], pos: usize) -> Option<BreakKind> {
+    match (bytes[pos], bytes.get(pos + 1)) {
+        (b'\n', Some(b'#')) => Some(BreakKind::Heading),
+        (b'\n', Some(b'\n')) => Some(BreakKind::Blank),
+        (b'\n', _) => Some(BreakKind::Line),
+        (b'.', Some(b' ')) => Some(BreakKind::Sentence),
+        (b' ', _) => Some(BreakKind::Space),
+        _ => None,
+    }
 }
 
 fn floor_char_boundary(text: &str, mut pos: usize) -> usize {
@@ -233,6 +315,140 @@ mod chunker_tests {
         }
     }
 
+    #[test]
+    fn chunks_borrow_their_source_range() {
+        let para = "A sentence in a long note. ".repeat(40);
+        let doc = (0..6)
+            .map(|i| format!("# Part {i}\n\n{para}"))
+            .collect::<Vec<_>>()
+            .join("\n");
+        let streamed: Vec<Chunk<'_>> = MarkdownChunks::new(&doc, 1_000, 150).collect();
+        assert_eq!(streamed, chunk_markdown_with(&doc, 1_000, 150));
+        for chunk in &streamed {
+            assert_eq!(&doc[chunk.range()], chunk.text);
+            assert!(std::ptr::eq(doc[chunk.range()].as_ptr(), chunk.text.as_ptr()));
+        }
+    }
+
+    /// The pre-table chunker: `rfind` for each break kind in turn.
+    fn reference_chunks(text: &str, target: usize, overlap: usize) -> Vec<(usize, String)> {
+        let trimmed = text.trim_end();
+        if trimmed.is_empty() {
+            return Vec::new();
+        }
+        if trimmed.len() <= target {
+            return vec![(0, trimmed.to_string())];
+        }
+        let target = target.max(256);
+        let overlap = overlap.min(target / 2);
+        let mut chunks = Vec::new();
+        let mut start = 0usize;
+        while start < trimmed.len() && chunks.len() < MAX_CHUNKS_PER_DOC {
+            start = floor_char_boundary(trimmed, start);
+            let hard_end = floor_char_boundary(trimmed, (start + target).min(trimmed.len()));
+            let end = if hard_end == trimmed.len() {
+                hard_end
+            } else {
+                reference_best_break(trimmed, start, hard_end)
+            };
+            if end <= start {
+                let next = next_char_boundary_after(trimmed, start);
+                if next <= start || next >= trimmed.len() {
+                    break;
+                }
+                start = next;
+                continue;
+            }
+            let piece = trimmed[start..end].trim_end();
+            if !piece.is_empty() {
+                chunks.push((start, piece.to_string()));
+            }
+            if end >= trimmed.len() {
+                break;
+            }
+            let overlap_start = floor_char_boundary(trimmed, end.saturating_sub(overlap));
+            start = overlap_start.max(next_char_boundary_after(trimmed, start));
+        }
+        chunks
+    }
+
+    fn reference_best_break(text: &str, start: usize, hard_end: usize) -> usize {
+        let window_start = start + (hard_end - start) * 2 / 3;
+        let window = &text[..hard_end];
+        let rfind_in = |needle: &str| window.rfind(needle).filter(|pos| *pos >= window_start);
+        if let Some(pos) = rfind_in("\n#") {
+            return pos + 1;
+        }
+        if let Some(pos) = rfind_in("\n\n") {
+            return pos + 2;
+        }
+        if let Some(pos) = rfind_in("\n") {
+            return pos + 1;
+        }
+        if let Some(pos) = rfind_in(". ") {
+            return pos + 2;
+        }
+        if let Some(pos) = rfind_in(" ") {
+            return pos + 1;
+        }
+        hard_end
+    }
+
+    #[test]
+    fn matches_reference_chunker_on_random_markdown() {
+        const PIECES: &[&str] = &[
+            "word",
+            "note",
+            "héllo",
+            "wörld",
+            "🎉",
+            "—",
+            "日本語",
+            " ",
+            " ",
+            " ",
+            ". ",
+            ".",
+            "\n",
+            "\n\n",
+            "\n# ",
+            "\n## ",
+            "#",
+            "- [ ] ",
+            "`code`",
+            "\n\n\n",
+        ];
+        // SplitMix64: a fixed seed keeps failures reproducible.
+        let mut state = 0x5EED_C0DE_u64;
+        let mut next = move || {
+            state = state.wrapping_add(0x9E37_79B9_7F4A_7C15);
+            let mut z = state;
+            z = (z ^ (z >> 30)).wrapping_mul(0xBF58_476D_1CE4_E5B9);
+            z = (z ^ (z >> 27)).wrapping_mul(0x94D0_49BB_1331_11EB);
+            (z ^ (z >> 31)) as usize
+        };
+        for case in 0..300 {
+            let len = next() % 12_000;
+            let mut doc = String::with_capacity(len + 16);
+            while doc.len() < len {
+                doc.push_str(PIECES[next() % PIECES.len()]);
+            }
+            let target = 64 + next() % 2_000;
+            let overlap = next() % 600;
+            let expected = reference_chunks(&doc, target, overlap);
+            let actual: Vec<(usize, String)> = chunk_markdown_with(&doc, target, overlap)
+                .into_iter()
+                .map(|chunk| (chunk.start, chunk.text.to_string()))
+                .collect();
+            assert_eq!(
+                actual,
+                expected,
+                "case {case}: target {target}, overlap {overlap}, {} bytes",
+                doc.len()
+            );
+        }
+    }
+
     #[test]
     fn pathological_doc_is_capped() {
         let doc = "x".repeat(CHUNK_TARGET_BYTES * (MAX_CHUNKS_PER_DOC + 10));
@@ -0,0 +1,336 @@
+//! Dirty queue feeding the event-driven brain indexer.
+//!
+//! The indexer used to rescan every source on a fixed two-minute timer, so a
+//! new capture could stay unsearchable for minutes while an idle machine kept
+//! paying for full directory scans. Now changes are recorded as they happen:
+//!
+//! - a watcher on the brain substrate (`notes/`, `days/`, `fragments/`) and
+//!   the `;` capture stores (`links.md`, `snippets.md`) queues each changed
+//!   file, or the whole source when a file was removed or renamed;
+//! - write hooks (clipboard pin/unpin) mark their source directly.
+//!
+//! The indexer drains the queue after a short settle: queued brain files are
+//! upserted one by one, marked sources are resynced, and nothing else is
+//! touched. A slow full reconcile still runs as a safety net for missed
+//! events, and is the only mode when the watcher could not start.
+
+use notify::event::ModifyKind;
+use notify::{recommended_watcher, EventKind, RecommendedWatcher, RecursiveMode, Watcher};
+use std::collections::BTreeSet;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Mutex, MutexGuard};
+use std::time::Instant;
+
+use super::substrate::BrainPaths;
+
+/// A brain source the indexer can resync on its own.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub enum IndexSource {
+    Notes,
+    DayPages,
+    Fragments,
+    Clipboard,
+    Captures,
+}
+
+/// Sources the watcher covers; all of them resync after a watcher error.
+const WATCHED_SOURCES: [IndexSource; 4] = [
+    IndexSource::Notes,
+    IndexSource::DayPages,
+    IndexSource::Fragments,
+    IndexSource::Captures,
+];
+
+/// Pending work for the next incremental pass.
+#[derive(Debug, Default)]
+pub(crate) struct DirtyQueue {
+    /// Brain markdown files created or written since the last pass.
+    pub files: BTreeSet<PathBuf>,
+    /// Sources needing a resync (removals, renames, store-backed sources).
+    pub sources: BTreeSet<IndexSource>,
+    /// When the oldest queued change arrived; the capture-to-searchable clock.
+    pub since: Option<Instant>,
+}
+
+impl DirtyQueue {
+    fn push(&mut self, change: Change) {
+        self.since.get_or_insert_with(Instant::now);
+        match change {
+            Change::File(path) => {
+                self.files.insert(path);
+            }
+            Change::Source(source) => {
+                self.sources.insert(source);
+            }
+        }
+    }
+}
+
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub(crate) enum Change {
+    File(PathBuf),
+    Source(IndexSource),
+}
+
+static QUEUE: Mutex<DirtyQueue> = Mutex::new(DirtyQueue {
+    files: BTreeSet::new(),
+    sources: BTreeSet::new(),
+    since: None,
+});
+static WATCHING: AtomicBool = AtomicBool::new(false);
+
+fn queue() -> MutexGuard<'static, DirtyQueue> {
+    QUEUE
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+/// Write hook: `source` changed outside the watched files. Queues a resync
+/// and wakes the indexer.
+pub fn mark_source_dirty(source: IndexSource) {
+    queue().push(Change::Source(source));
+    super::indexer::wake_indexer();
+}
+
+/// Take everything queued so far.
+pub(crate) fn take_dirty() -> DirtyQueue {
+    std::mem::take(&mut *queue())
+}
+
+/// Whether the source watcher is delivering changes. When it is not, a wake
+/// has to fall back to a full reconcile.
+pub(crate) fn is_watching() -> bool {
+    WATCHING.load(Ordering::Acquire)
+}
+
+/// The paths the watcher maps back to sources.
+#[derive(Debug, Clone)]
+pub(crate) struct WatchTargets {
+    brain: BrainPaths,
+    links: PathBuf,
+    snippets: PathBuf,
+}
+
+impl WatchTargets {
+    pub(crate) fn new(brain: BrainPaths, sk_path: &Path) -> Self {
+        Self {
+            brain,
+            links: crate::scriptlets::link_markdown_store::links_markdown_path(sk_path),
+            snippets: crate::scriptlets::snippet_markdown_store::snippets_markdown_path(sk_path),
+        }
+    }
+
+    fn source_for_dir(&self, dir: &Path) -> Option<IndexSource> {
+        if dir == self.brain.notes_dir() {
+            Some(IndexSource::Notes)
+        } else if dir == self.brain.days_dir() {
+            Some(IndexSource::DayPages)
+        } else if dir == self.brain.fragments_dir() {
+            Some(IndexSource::Fragments)
+        } else {
+            None
+        }
+    }
+
+    /// What a change of `kind` at `path` makes dirty, if anything.
+    pub(crate) fn classify(&self, path: &Path, kind: &EventKind) -> Option<Change> {
+        if matches!(
+            kind,
+            EventKind::Access(_) | EventKind::Modify(ModifyKind::Metadata(_))
+        ) {
+            return None;
+        }
+        if path == self.links || path == self.snippets {
+            return Some(Change::Source(IndexSource::Captures));
+        }
+        // A source directory itself appeared or went away.
+        if let Some(source) = self.source_for_dir(path) {
+            return Some(Change::Source(source));
+        }
+        let source = self.source_for_dir(path.parent()?)?;
+        if path.extension().and_then(|ext| ext.to_str()) != Some("md") {
+            return None;
+        }
+        let written = matches!(
+            kind,
+            EventKind::Create(_) | EventKind::Modify(ModifyKind::Data(_) | ModifyKind::Any)
+        );
+        if written && path.is_file() {
+            Some(Change::File(path.to_path_buf()))
+        } else {
+            // Removals and renames: only a resync knows which doc went away.
+            Some(Change::Source(source))
+        }
+    }
+
+    fn record(&self, event: notify::Result<notify::Event>) -> bool {
+        let mut queue = queue();
+        match event {
+            Ok(event) => {
+                let mut marked = false;
+                for change in event
+                    .paths
+                    .iter()
+                    .filter_map(|path| self.classify(path, &event.kind))
+                {
+                    queue.push(change);
+                    marked = true;
+                }
+                marked
+            }
+            // A lost event may hide any change; resync everything watched.
+            Err(error) => {
+                tracing::warn!(target: "script_kit::brain", error = %error, "brain source watcher error");
+                for source in WATCHED_SOURCES {
+                    queue.push(Change::Source(source));
+                }
+                true
+            }
+        }
+    }
+}
+
+/// Start watching the brain sources. The returned watcher must be kept alive
+/// for as long as events should flow; `None` leaves the indexer on full
+/// reconciles.
+pub(crate) fn start_source_watcher(targets: WatchTargets) -> Option<RecommendedWatcher> {
+    let brain_base = targets.brain.base().to_path_buf();
+    let store_dir = targets.links.parent().map(Path::to_path_buf);
+    let mut watcher = match recommended_watcher(move |event| {
+        if targets.record(event) {
+            super::indexer::wake_indexer();
+        }
+    }) {
+        Ok(watcher) => watcher,
+        Err(error) => {
+            tracing::warn!(target: "script_kit::brain", error = %error, "brain source watcher unavailable");
+            return None;
+        }
+    };
+    if let Err(error) = watcher.watch(&brain_base, RecursiveMode::Recursive) {
+        tracing::warn!(
+            target: "script_kit::brain",
+            error = %error,
+            path = %brain_base.display(),
+            "brain source watcher could not watch the substrate"
+        );
+        return None;
+    }
+    // The capture stores are optional; without them links and snippets are
+    // only picked up by the reconcile.
+    if let Some(store_dir) = store_dir.filter(|dir| dir.is_dir()) {
+        if let Err(error) = watcher.watch(&store_dir, RecursiveMode::NonRecursive) {
+            tracing::debug!(
+                target: "script_kit::brain",
+                error = %error,
+                path = %store_dir.display(),
+                "capture store watch skipped"
+            );
+        }
+    }
+    WATCHING.store(true, Ordering::Release);
+    Some(watcher)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use notify::event::{CreateKind, DataChange, ModifyKind, RemoveKind, RenameMode};
+
+    fn targets(base: &Path) -> WatchTargets {
+        WatchTargets::new(BrainPaths::new(base.join("brain")), base)
+    }
+
+    #[test]
+    fn test_written_brain_files_queue_the_file_itself() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let targets = targets(temp_dir.path());
+        let days = temp_dir.path().join("brain/days");
+        std::fs::create_dir_all(&days).unwrap();
+        let page = days.join("2026-10-17.md");
+        std::fs::write(&page, "hello").unwrap();
+
+        assert_eq!(
+            targets.classify(&page, &EventKind::Create(CreateKind::File)),
+            Some(Change::File(page.clone()))
+        );
+        assert_eq!(
+            targets.classify(
+                &page,
+                &EventKind::Modify(ModifyKind::Data(DataChange::Content))
+            ),
+            Some(Change::File(page.clone()))
+        );
+        assert_eq!(
+            targets.classify(
+                &days.join("scratch.tmp"),
+                &EventKind::Create(CreateKind::File)
+            ),
+            None,
+            "non-markdown files are ignored"
+        );
+    }
+
+    #[test]
+    fn test_removals_and_renames_resync_their_source() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let targets = targets(temp_dir.path());
+        let note = temp_dir.path().join("brain/notes/gone.md");
+
+        assert_eq!(
+            targets.classify(&note, &EventKind::Remove(RemoveKind::File)),
+            Some(Change::Source(IndexSource::Notes))
+        );
+        assert_eq!(
+            targets.classify(
+                &note,
+                &EventKind::Modify(ModifyKind::Name(RenameMode::From))
+            ),
+            Some(Change::Source(IndexSource::Notes))
+        );
+        assert_eq!(
+            targets.classify(
+                &temp_dir.path().join("brain/fragments"),
+                &EventKind::Remove(RemoveKind::Folder)
+            ),
+            Some(Change::Source(IndexSource::Fragments))
+        );
+    }
+
+    #[test]
+    fn test_capture_stores_and_unrelated_paths() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let targets = targets(temp_dir.path());
+        let links = temp_dir.path().join("plugins/main/scriptlets/links.md");
+
+        assert_eq!(
+            targets.classify(&links, &EventKind::Modify(ModifyKind::Any)),
+            Some(Change::Source(IndexSource::Captures))
+        );
+        assert_eq!(
+            targets.classify(
+                &temp_dir.path().join("brain/trash/old.md"),
+                &EventKind::Create(CreateKind::File)
+            ),
+            None,
+            "trash is not a source"
+        );
+        assert_eq!(
+            targets.classify(&links, &EventKind::Access(notify::event::AccessKind::Any)),
+            None
+        );
+    }
+
+    #[test]
+    fn test_queue_keeps_the_oldest_change_time() {
+        let mut queue = DirtyQueue::default();
+        assert_eq!(queue.since, None);
+        queue.push(Change::Source(IndexSource::Clipboard));
+        let first = queue.since.expect("first change starts the clock");
+        queue.push(Change::File(PathBuf::from("/brain/days/a.md")));
+        assert_eq!(queue.since, Some(first));
+        assert_eq!(queue.files.len(), 1);
+        assert_eq!(queue.sources.len(), 1);
+    }
+}
@@ -4,14 +4,20 @@
 //! Deliberately independent from `ai::local_llm::subprocess_backend`:
 //! - it is NOT gated behind the `local-llm` feature (the helper is a separate
 //!   process, so the app never links ggml for this path);
-//! - it speaks only `embed`/`shutdown`, with blocking request semantics and
-//!   no cancellation (embedding batches are short).
+//! - it speaks only `hello`/`embed`/`shutdown`, with blocking request
+//!   semantics and no cancellation (embedding batches are short).
+//!
+//! Vectors: on spawn the client offers [`VECTOR_ENCODING_F32LE_BASE64`] in a
+//! `hello`. A helper that accepts answers every embed with base64 of the
+//! little-endian `f32` bytes, which is the store's BLOB layout; older helpers
+//! reject the `hello` and keep sending JSON number arrays, which still decode.
 //!
 //! Model resolution: `SCRIPT_KIT_BRAIN_EMBED_MODEL_PATH` env override, then
 //! any `*.gguf` under `~/.scriptkit/models/brain/`. When no model is present
 //! the brain degrades gracefully to FTS-only search.
 
-use anyhow::{anyhow, Context as _, Result};
+use anyhow::{anyhow, ensure, Context as _, Result};
+use base64::Engine as _;
 use serde::{Deserialize, Serialize};
 use std::collections::HashMap;
 use std::io::{BufRead, BufReader, Read, Write};
@@ -30,31 +36,109 @@ const MODEL_ENV: &str = "SCRIPT_KIT_BRAIN_EMBED_MODEL_PATH";
 /// below 60s. A wedged helper must never stall the indexer thread for minutes.
 const EMBED_BATCH_TIMEOUT: Duration = Duration::from_secs(60);
 
+/// Packed vector payload offered in the startup `hello`.
+pub(crate) const VECTOR_ENCODING_F32LE_BASE64: &str = "f32le_base64";
+
+/// Request id of the startup `hello`. Embed ids start at 1, and an older
+/// helper's "malformed request" reply also carries id 0, so either answer is
+/// dropped by the reader without touching a pending embed.
+const HELLO_ID: u64 = 0;
+
 #[derive(Debug, Serialize)]
 #[serde(tag = "type", rename_all = "snake_case")]
-enum EmbedRequest {
+enum EmbedRequest<'a> {
     Embed {
         id: u64,
         model_path: String,
         model_id: String,
-        texts: Vec<String>,
+        texts: &'a [&'a str],
         gpu_layers: u32,
+        priority: bool,
+    },
+    Hello {
+        id: u64,
+        vector_encodings: &'a [&'a str],
     },
     Shutdown {
         id: u64,
     },
 }
 
+/// One helper stdout line. Packed vectors borrow from the line: the base64
+/// alphabet never needs a JSON escape.
 #[derive(Debug, Deserialize)]
-struct EmbedResponse {
+struct EmbedWireResponse<'a> {
     id: u64,
     ok: bool,
     #[serde(default)]
     embeddings: Option<Vec<Vec<f32>>>,
+    #[serde(default, borrow)]
+    embeddings_f32le_base64: Option<Vec<&'a str>>,
     #[serde(default)]
     error: Option<String>,
 }
 
+#[derive(Debug)]
+pub(crate) struct EmbedResponse {
+    id: u64,
+    ok: bool,
+    pub(crate) embeddings: Option<Vec<Vec<f32>>>,
+    error: Option<String>,
+}
+
+impl EmbedWireResponse<'_> {
+    /// Decode whichever vector form the helper sent. A corrupt packed payload
+    /// fails only this request.
+    fn decode(self, scratch: &mut Vec<u8>) -> EmbedResponse {
+        let embeddings = match self.embeddings_f32le_base64 {
+            Some(packed) => match packed
+                .iter()
+                .map(|vector| decode_f32le_base64(vector, scratch))
+                .collect::<Result<Vec<_>>>()
+            {
+                Ok(embeddings) => Some(embeddings),
+                Err(err) => {
+                    return EmbedResponse {
+                        id: self.id,
+                        ok: false,
+                        embeddings: None,
+                        error: Some(format!("{err:#}")),
+                    }
+                }
+            },
+            None => self.embeddings,
+        };
+        EmbedResponse {
+            id: self.id,
+            ok: self.ok,
+            embeddings,
+            error: self.error,
+        }
+    }
+}
+
+/// Parse one helper stdout line; `None` for lines that are not a response.
+pub(crate) fn parse_response_line(line: &str, scratch: &mut Vec<u8>) -> Option<EmbedResponse> {
+    let wire = serde_json::from_str::<EmbedWireResponse>(line).ok()?;
+    Some(wire.decode(scratch))
+}
+
+/// Decode one [`VECTOR_ENCODING_F32LE_BASE64`] vector. The bytes land in
+/// `scratch` (reused across a response) in the store's BLOB layout and are
+/// read out by the same decoder the store uses.
+pub(crate) fn decode_f32le_base64(encoded: &str, scratch: &mut Vec<u8>) -> Result<Vec<f32>> {
+    scratch.clear();
+    base64::engine::general_purpose::STANDARD
+        .decode_vec(encoded, scratch)
+        .context("decode packed brain embedding")?;
+    ensure!(
+        scratch.len() % 4 == 0,
+        "packed brain embedding is {} bytes, not a whole number of f32s",
+        scratch.len()
+    );
+    Ok(super::store::decode_vec(scratch))
+}
+
 #[derive(Debug, Clone)]
 pub struct ResolvedEmbedModel {
     pub path: PathBuf,
@@ -153,7 +237,7 @@ impl BrainEmbedder {
         let mut child = Command::new(helper_path)
             .stdin(Stdio::piped())
             .stdout(Stdio::piped())
-            .stderr(Stdio::null())
+            .stderr(Stdio::inherit())
             .spawn()
             .with_context(|| format!("spawn brain embed helper {}", helper_path.display()))?;
         let stdin = child.stdin.take().context("brain embed helper stdin")?;
@@ -164,10 +248,16 @@ impl BrainEmbedder {
         std::thread::Builder::new()
             .name("script-kit-brain-embed-reader".to_string())
             .spawn(move || {
-                let reader = BufReader::new(stdout);
-                for line in reader.lines() {
-                    let Ok(line) = line else { break };
-                    let Ok(response) = serde_json::from_str::<EmbedResponse>(&line) else {
+                let mut reader = BufReader::new(stdout);
+                let mut line = String::new();
+                let mut scratch = Vec::new();
+                loop {
+                    line.clear();
+                    match reader.read_line(&mut line) {
+                        Ok(0) | Err(_) => break,
+                        Ok(_) => {}
+                    }
+                    let Some(response) = parse_response_line(&line, &mut scratch) else {
                         continue;
                     };
                     let sender = reader_pending
@@ -180,13 +270,21 @@ impl BrainEmbedder {
                 }
             })
             .context("spawn brain embed reader thread")?;
-        Ok(Self {
+        let embedder = Self {
             model,
             child: Mutex::new(child),
             stdin: Mutex::new(Some(stdin)),
             pending,
             next_id: AtomicU64::new(1),
-        })
+        };
+        // Not awaited: the helper settles the encoding before reading the
+        // next line, and responses decode in either form. A helper that died
+        // already surfaces on the first embed.
+        let _ = embedder.write_request(&EmbedRequest::Hello {
+            id: HELLO_ID,
+            vector_encodings: &[VECTOR_ENCODING_F32LE_BASE64],
+        });
+        Ok(embedder)
     }
 
     pub fn model_id(&self) -> &str {
@@ -205,7 +303,7 @@ impl BrainEmbedder {
     /// Embed a batch of texts. Blocking; returns unit-normalized vectors in
     /// input order (empty vec for empty inputs). Bounded by
     /// [`EMBED_BATCH_TIMEOUT`] so a wedged helper cannot stall the caller.
-    pub fn embed(&self, texts: Vec<String>) -> Result<Vec<Vec<f32>>> {
+    pub fn embed(&self, texts: &[&str]) -> Result<Vec<Vec<f32>>> {
         self.embed_with_timeout(texts, EMBED_BATCH_TIMEOUT)
     }
 
@@ -214,8 +312,27 @@ impl BrainEmbedder {
     /// production ceiling.
     pub(crate) fn embed_with_timeout(
         &self,
-        texts: Vec<String>,
+        texts: &[&str],
+        timeout: Duration,
+    ) -> Result<Vec<Vec<f32>>> {
+        self.request_embeddings(texts, timeout, false)
+    }
+
+    /// Embed one interactive query. The helper serves it ahead of queued
+    /// batch work and between the decode groups of a batch in progress, so
+    /// it is not stuck behind the indexer.
+    pub fn embed_query(&self, text: String, timeout: Duration) -> Result<Vec<f32>> {
+        self.request_embeddings(&[text.as_str()], timeout, true)?
+            .pop()
+            .filter(|vector| !vector.is_empty())
+            .context("empty query embedding")
+    }
+
+    fn request_embeddings(
+        &self,
+        texts: &[&str],
         timeout: Duration,
+        priority: bool,
     ) -> Result<Vec<Vec<f32>>> {
         if texts.is_empty() {
             return Ok(Vec::new());
@@ -232,14 +349,20 @@ impl BrainEmbedder {
             model_id: self.model.model_id.clone(),
             texts,
             gpu_layers: 99,
+            priority,
         };
         if let Err(err) = self.write_request(&request) {
             let _ = self.pending.lock().map(|mut pending| pending.remove(&id));
             return Err(err);
         }
-        let response = rx
-            .recv_timeout(timeout)
-            .context("brain embed helper timed out")?;
+        let response = match rx.recv_timeout(timeout) {
+            Ok(response) => response,
+            Err(err) => {
+                // Nobody is waiting any more; don't let a late reply linger.
+                let _ = self.pending.lock().map(|mut pending| pending.remove(&id));
+                return Err(err).context("brain embed helper timed out");
+            }
+        };
         if !response.ok {
             return Err(anyhow!(response
                 .error
@@ -248,7 +371,7 @@ impl BrainEmbedder {
         response.embeddings.context("missing brain embeddings")
     }
 
-    fn write_request(&self, request: &EmbedRequest) -> Result<()> {
+    fn write_request(&self, request: &EmbedRequest<'_>) -> Result<()> {
         let mut guard = self
             .stdin
             .lock()
@@ -315,6 +438,7 @@ fn resolve_helper_path() -> Result<PathBuf> {
 #[cfg(test)]
 mod tests {
     use super::*;
+    use base64::Engine as _;
     use std::io::Write as _;
     use std::os::unix::fs::PermissionsExt as _;
 
@@ -368,7 +492,7 @@ mod tests {
         // its closed stdin fails immediately (and the reader saw EOF), well
         // inside the short test timeout.
         let started = std::time::Instant::now();
-        let result = embedder.embed_with_timeout(vec!["x".to_string()], Duration::from_secs(2));
+        let result = embedder.embed_with_timeout(&["x"], Duration::from_secs(2));
         let elapsed = started.elapsed();
         assert!(
             result.is_err(),
@@ -380,6 +504,106 @@ mod tests {
         );
     }
 
+    /// Query embeds are flagged `priority` on the wire so the helper can
+    /// serve them ahead of the indexer's batch work.
+    #[test]
+    fn embed_query_sends_a_priority_request() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let request_log = dir.path().join("request.json");
+        let helper = write_fake_helper(
+            dir.path(),
+            &format!(
+                "#!/bin/sh\nread hello\nread line\nprintf '%s\\n' \"$line\" > '{}'\necho '{{\"id\":1,\"ok\":true,\"embeddings\":[[0.6,0.8]]}}'\ncat > /dev/null\n",
+                request_log.display()
+            ),
+        );
+        let embedder =
+            BrainEmbedder::spawn_with_helper(&helper, fake_model()).expect("spawn fake helper");
+
+        let vector = embedder
+            .embed_query(
+                "what did I note about caching".to_string(),
+                Duration::from_secs(5),
+            )
+            .expect("query embedding");
+
+        assert_eq!(vector, vec![0.6, 0.8]);
+        let request: serde_json::Value =
+            serde_json::from_str(&std::fs::read_to_string(&request_log).expect("request log"))
+                .expect("request json");
+        assert_eq!(request["type"], "embed");
+        assert_eq!(request["priority"], true);
+    }
+
+    /// Spawning offers the packed encoding, and a helper that answers with
+    /// base64 little-endian f32s decodes to the same vectors as JSON arrays.
+    #[test]
+    fn packed_embeddings_negotiated_at_spawn_decode_to_vectors() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let hello_log = dir.path().join("hello.json");
+        let packed = [[0.6f32, 0.8], [1.0, -0.25]].map(|vector| {
+            let bytes: Vec<u8> = vector
+                .iter()
+                .flat_map(|value| value.to_le_bytes())
+                .collect();
+            base64::engine::general_purpose::STANDARD.encode(bytes)
+        });
+        let helper = write_fake_helper(
+            dir.path(),
+            &format!(
+                "#!/bin/sh\nread hello\nprintf '%s\\n' \"$hello\" > '{}'\necho '{{\"id\":0,\"ok\":true,\"vector_encoding\":\"f32le_base64\"}}'\nread line\necho '{{\"id\":1,\"ok\":true,\"embeddings_f32le_base64\":[\"{}\",\"{}\"]}}'\ncat > /dev/null\n",
+                hello_log.display(),
+                packed[0],
+                packed[1]
+            ),
+        );
+        let embedder =
+            BrainEmbedder::spawn_with_helper(&helper, fake_model()).expect("spawn fake helper");
+
+        let vectors = embedder
+            .embed_with_timeout(&["first", "second"], Duration::from_secs(5))
+            .expect("packed embeddings");
+
+        assert_eq!(vectors, vec![vec![0.6, 0.8], vec![1.0, -0.25]]);
+        let hello: serde_json::Value =
+            serde_json::from_str(&std::fs::read_to_string(&hello_log).expect("hello log"))
+                .expect("hello json");
+        assert_eq!(hello["type"], "hello");
+        assert_eq!(hello["id"], HELLO_ID);
+        assert_eq!(
+            hello["vector_encodings"],
+            serde_json::json!([VECTOR_ENCODING_F32LE_BASE64])
+        );
+    }
+
+    #[test]
+    fn packed_vector_round_trips_bit_exact_and_rejects_torn_payloads() {
+        let vector = vec![0.0f32, -0.0, 1.5e-7, f32::MAX, -3.25, f32::MIN_POSITIVE];
+        let bytes: Vec<u8> = vector
+            .iter()
+            .flat_map(|value| value.to_le_bytes())
+            .collect();
+        let encoded = base64::engine::general_purpose::STANDARD.encode(&bytes);
+        let mut scratch = Vec::new();
+
+        let decoded = decode_f32le_base64(&encoded, &mut scratch).expect("decode");
+
+        assert_eq!(
+            decoded
+                .iter()
+                .map(|value| value.to_bits())
+                .collect::<Vec<_>>(),
+            vector
+                .iter()
+                .map(|value| value.to_bits())
+                .collect::<Vec<_>>()
+        );
+        assert_eq!(scratch, bytes, "scratch holds the store BLOB bytes");
+        let torn = base64::engine::general_purpose::STANDARD.encode(&bytes[..bytes.len() - 1]);
+        assert!(decode_f32le_base64(&torn, &mut scratch).is_err());
+        assert!(decode_f32le_base64("not base64!", &mut scratch).is_err());
+    }
+
     /// The model fingerprint must be keyed on file CONTENT, not mtime. Rewriting
     /// the identical bytes (which bumps mtime) must NOT change the fingerprint —
     /// that stability is the whole point of the fix (mtime churn triggered
@@ -20,6 +20,28 @@ pub struct BrainHealth {
     pub docs_pending_embedding: i64,
     pub recall_mode: String, // "semantic" | "lexical-only"
     pub embedder_alive: bool,
+    /// Query embeddings served within the launcher's latency budget since
+    /// app start; misses fell back to lexical recall.
+    #[serde(default)]
+    pub query_embeds_within_budget: u64,
+    #[serde(default)]
+    pub query_embeds_over_budget: u64,
+    /// Chunks served from the embedding cache (unchanged text, any doc)
+    /// versus sent to the helper, since app start.
+    #[serde(default)]
+    pub chunk_embed_cache_hits: u64,
+    #[serde(default)]
+    pub chunk_embed_cache_misses: u64,
+    /// Event-driven passes versus full reconciles since app start; an idle
+    /// machine should only accumulate reconciles.
+    #[serde(default)]
+    pub incremental_passes: u64,
+    #[serde(default)]
+    pub reconcile_passes: u64,
+    /// Capture-to-searchable latency of the latest incremental pass: from the
+    /// oldest queued change to its doc being lexically indexed.
+    #[serde(default)]
+    pub last_dirty_to_indexed_ms: Option<u64>,
 }
 
 /// Persist the latest health snapshot into the brain meta KV. Best-effort:
@@ -1,26 +1,40 @@
 //! Brain indexer: the background metabolism.
 //!
-//! A single low-priority thread that, on a timer and on demand:
+//! A single low-priority thread that, as sources change:
 //! 1. syncs notes into `brain_docs` (the librarian's raw material),
 //! 2. embeds docs whose vectors are missing or stale,
 //! 3. keeps everything incremental — content hashes mean unchanged docs are
 //!    never re-embedded.
 //!
+//! Changes arrive through the [`dirty`](super::dirty) queue (a source watcher
+//! plus write hooks), so a pass only touches what changed. A full reconcile
+//! of every source runs at startup and then every [`RECONCILE_INTERVAL`] as a
+//! safety net for missed events.
+//!
 //! The indexer NEVER blocks UI: all work happens on its own thread, the
 //! embedder is a subprocess, and each cycle processes a bounded batch.
 
+use super::dirty::{DirtyQueue, IndexSource};
 use super::embedder::{resolve_embed_model, BrainEmbedder};
 use super::store::{self, DocSource};
 use super::substrate::{BrainFrontmatter, BrainSubstrate};
 use anyhow::{Context as _, Result};
 use std::fs;
 use std::path::{Path, PathBuf};
-use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
 use std::sync::mpsc::{self, RecvTimeoutError, Sender};
-use std::sync::OnceLock;
-use std::time::{Duration, SystemTime, UNIX_EPOCH};
-
-const CYCLE_INTERVAL: Duration = Duration::from_secs(120);
+use std::sync::{Arc, Mutex, OnceLock};
+use std::time::{Duration, Instant, SystemTime, UNIX_EPOCH};
+
+/// Full rescan of every source. Changes normally arrive through the dirty
+/// queue; this only catches what the watcher missed.
+const RECONCILE_INTERVAL: Duration = Duration::from_secs(15 * 60);
+/// Reconcile cadence when the source watcher could not start — the old fixed
+/// cycle, since nothing else notices edits made outside the app.
+const UNWATCHED_RECONCILE_INTERVAL: Duration = Duration::from_secs(120);
+/// Coalesces a burst of wakes (an editor save, a capture handler writing
+/// several files) into one incremental pass.
+const DIRTY_SETTLE: Duration = Duration::from_millis(200);
 const EMBED_BATCH: usize = 16;
 const MAX_EMBED_PER_CYCLE: usize = 256;
 /// Hard latency budget for query embedding on the submit path. When the
@@ -29,14 +43,29 @@ const QUERY_EMBED_BUDGET: Duration = Duration::from_millis(200);
 
 enum IndexerRequest {
     Wake,
-    EmbedQuery {
-        text: String,
-        reply: Sender<Option<(String, Vec<f32>)>>,
-    },
 }
 
 static WAKE: OnceLock<Sender<IndexerRequest>> = OnceLock::new();
 static STARTED: AtomicBool = AtomicBool::new(false);
+/// The indexer's live helper, shared with the query path so a query is sent
+/// straight to the helper instead of waiting for the indexer thread.
+static QUERY_EMBEDDER: Mutex<Option<Arc<BrainEmbedder>>> = Mutex::new(None);
+static QUERY_EMBEDS_WITHIN_BUDGET: AtomicU64 = AtomicU64::new(0);
+static QUERY_EMBEDS_OVER_BUDGET: AtomicU64 = AtomicU64::new(0);
+static CHUNK_CACHE_HITS: AtomicU64 = AtomicU64::new(0);
+static CHUNK_CACHE_MISSES: AtomicU64 = AtomicU64::new(0);
+static INCREMENTAL_PASSES: AtomicU64 = AtomicU64::new(0);
+static RECONCILE_PASSES: AtomicU64 = AtomicU64::new(0);
+/// Milliseconds from the oldest queued change to it being searchable, for the
+/// latest incremental pass; `u64::MAX` until one has run.
+static LAST_DIRTY_TO_INDEXED_MS: AtomicU64 = AtomicU64::new(u64::MAX);
+
+/// Which kind of pass the indexer thread runs next.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum IndexPass {
+    Reconcile,
+    Incremental,
+}
 
 #[derive(Debug, Clone, Default, PartialEq, Eq)]
 pub(crate) struct BrainFileSourceSyncReceipt {
@@ -46,8 +75,10 @@ pub(crate) struct BrainFileSourceSyncReceipt {
     pub failed_sources: Vec<&'static str>,
 }
 
-/// Ask the indexer to run a cycle soon (e.g. after a chat turn ingests new
-/// docs). Cheap; coalesces with pending wakes.
+/// Ask the indexer to run a pass soon (e.g. after a chat turn ingests new
+/// docs). Cheap; coalesces with pending wakes. With the source watcher
+/// running this is an incremental pass over the dirty queue plus pending
+/// embeddings; without it, a full reconcile.
 pub fn wake_indexer() {
     if let Some(tx) = WAKE.get() {
         let _ = tx.send(IndexerRequest::Wake);
@@ -55,18 +86,38 @@ pub fn wake_indexer() {
 }
 
 /// Embed a query using the indexer's warm model, within a hard latency
-/// budget. Returns `(model_id, vector)`, or `None` when no model is on disk,
-/// the model isn't warm yet, or the indexer is mid-cycle — callers fall back
-/// to lexical recall. Never blocks longer than [`QUERY_EMBED_BUDGET`].
+/// budget. Returns `(model_id, vector)`, or `None` when no model is on disk
+/// or the model isn't warm yet — callers fall back to lexical recall. Never
+/// blocks longer than [`QUERY_EMBED_BUDGET`].
+///
+/// The request goes straight to the helper on the caller's thread as a
+/// priority embed, which the helper serves ahead of (and in between the
+/// decode groups of) the indexer's batch work. Hits and misses are counted
+/// into the brain health snapshot.
 pub fn embed_query_within_budget(text: &str) -> Option<(String, Vec<f32>)> {
-    let tx = WAKE.get()?;
-    let (reply_tx, reply_rx) = mpsc::channel();
-    tx.send(IndexerRequest::EmbedQuery {
-        text: text.to_string(),
-        reply: reply_tx,
-    })
-    .ok()?;
-    reply_rx.recv_timeout(QUERY_EMBED_BUDGET).ok().flatten()
+    let embedder = QUERY_EMBEDDER
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+        .clone()?;
+    match embedder.embed_query(text.to_string(), QUERY_EMBED_BUDGET) {
+        Ok(vector) => {
+            QUERY_EMBEDS_WITHIN_BUDGET.fetch_add(1, Ordering::Relaxed);
+            Some((embedder.model_id().to_string(), vector))
+        }
+        Err(err) => {
+            QUERY_EMBEDS_OVER_BUDGET.fetch_add(1, Ordering::Relaxed);
+            tracing::debug!(target: "script_kit::brain", error = %err, "query embedding missed its budget; using lexical recall");
+            None
+        }
+    }
+}
+
+/// Replace the indexer's embedder and publish it to the query path.
+fn set_embedder(slot: &mut Option<Arc<BrainEmbedder>>, embedder: Option<Arc<BrainEmbedder>>) {
+    *QUERY_EMBEDDER
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner()) = embedder.clone();
+    *slot = embedder;
 }
 
 /// Start the background indexer thread. Idempotent.
@@ -79,19 +130,35 @@ pub fn start_brain_indexer() {
     let _ = std::thread::Builder::new()
         .name("script-kit-brain-indexer".to_string())
         .spawn(move || {
+            // Watch before the settle so changes made during startup queue up.
+            let _source_watcher = super::dirty::start_source_watcher(
+                super::dirty::WatchTargets::new(brain_substrate().paths().clone(), &capture_sk_path()),
+            );
             // Let app startup settle before the first cycle.
             std::thread::sleep(Duration::from_secs(20));
-            let mut embedder: Option<BrainEmbedder> = None;
+            let mut embedder: Option<Arc<BrainEmbedder>> = None;
             let mut backoff = EmbedBackoff::default();
+            let mut pass = IndexPass::Reconcile;
+            let mut last_reconcile = Instant::now();
             loop {
                 let started_unix = unix_now();
+                if pass == IndexPass::Reconcile {
+                    last_reconcile = Instant::now();
+                }
                 // Supervise the cycle: an unexpected panic here would otherwise
                 // unwind the whole indexer thread and silently stop ALL
                 // indexing/embedding/curation for the rest of the process. Catch
                 // it, surface it via health, reset the embedder in case it was
                 // left mid-operation, and keep the metabolism alive.
                 let result = match std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| {
-                    run_cycle(&mut embedder, &mut backoff)
+                    match pass {
+                        IndexPass::Reconcile => run_cycle(&mut embedder, &mut backoff),
+                        IndexPass::Incremental => run_incremental(
+                            super::dirty::take_dirty(),
+                            &mut embedder,
+                            &mut backoff,
+                        ),
+                    }
                 })) {
                     Ok(result) => result,
                     Err(panic) => {
@@ -101,7 +168,7 @@ pub fn start_brain_indexer() {
                             .or_else(|| panic.downcast_ref::<String>().cloned())
                             .unwrap_or_else(|| "unknown panic".to_string());
                         tracing::error!(target: "script_kit::brain", panic = %msg, "brain index cycle PANICKED; recovering");
-                        embedder = None;
+                        set_embedder(&mut embedder, None);
                         Err(anyhow::anyhow!("brain index cycle panicked: {msg}"))
                     }
                 };
@@ -109,68 +176,49 @@ pub fn start_brain_indexer() {
                     tracing::warn!(target: "script_kit::brain", error = %err, "brain index cycle failed");
                 }
                 record_cycle_health(started_unix, result.as_ref().err(), &embedder, &backoff);
-                // Serve wake/embed requests until the next cycle is due.
-                let deadline = std::time::Instant::now() + CYCLE_INTERVAL;
-                loop {
-                    let remaining = deadline.saturating_duration_since(std::time::Instant::now());
-                    if remaining.is_zero() {
-                        break;
-                    }
-                    match rx.recv_timeout(remaining) {
-                        Ok(IndexerRequest::Wake) => break,
-                        Ok(IndexerRequest::EmbedQuery { text, reply }) => {
-                            let result = embedder.as_ref().and_then(|embedder| {
-                                embedder
-                                    .embed(vec![text])
-                                    .ok()
-                                    .and_then(|mut vectors| vectors.pop())
-                                    .filter(|vector| !vector.is_empty())
-                                    .map(|vector| (embedder.model_id().to_string(), vector))
-                            });
-                            let _ = reply.send(result);
+                // Sleep until something changes or the reconcile is due.
+                let deadline = last_reconcile
+                    + if super::dirty::is_watching() {
+                        RECONCILE_INTERVAL
+                    } else {
+                        UNWATCHED_RECONCILE_INTERVAL
+                    };
+                pass = match rx.recv_timeout(deadline.saturating_duration_since(Instant::now())) {
+                    Ok(IndexerRequest::Wake) => {
+                        let settle_until = Instant::now() + DIRTY_SETTLE;
+                        while rx
+                            .recv_timeout(settle_until.saturating_duration_since(Instant::now()))
+                            .is_ok()
+                        {}
+                        if super::dirty::is_watching() {
+                            IndexPass::Incremental
+                        } else {
+                            IndexPass::Reconcile
                         }
-                        Err(RecvTimeoutError::Timeout) => break,
-                        Err(RecvTimeoutError::Disconnected) => return,
                     }
-                }
+                    Err(RecvTimeoutError::Timeout) => IndexPass::Reconcile,
+                    Err(RecvTimeoutError::Disconnected) => return,
+                };
             }
         });
 }
 
-/// One full cycle: sync sources, then embed what's missing.
+/// One full cycle: sync every source, then embed what's missing. Runs at
+/// startup and as the periodic reconcile; it covers anything still queued.
 pub(crate) fn run_cycle(
-    embedder: &mut Option<BrainEmbedder>,
+    embedder: &mut Option<Arc<BrainEmbedder>>,
     backoff: &mut EmbedBackoff,
 ) -> Result<()> {
     store::init_brain_db()?;
-    let synced = sync_notes().unwrap_or_else(|err| {
-        tracing::debug!(target: "script_kit::brain", error = %err, "notes sync skipped");
-        0
-    });
-    let day_pages = sync_day_pages().unwrap_or_else(|err| {
-        tracing::debug!(target: "script_kit::brain", error = %err, "day page sync skipped");
-        0
-    });
-    let fragments = sync_fragments().unwrap_or_else(|err| {
-        tracing::debug!(target: "script_kit::brain", error = %err, "fragment sync skipped");
-        0
-    });
-    let promoted = sync_pinned_clipboard().unwrap_or_else(|err| {
-        tracing::debug!(target: "script_kit::brain", error = %err, "clipboard sync skipped");
-        0
-    });
-    let captured = sync_capture_stores().unwrap_or_else(|err| {
-        tracing::debug!(target: "script_kit::brain", error = %err, "capture sync skipped");
-        0
-    });
+    let _ = super::dirty::take_dirty();
+    RECONCILE_PASSES.fetch_add(1, Ordering::Relaxed);
+    let synced = sync_source(IndexSource::Notes);
+    let day_pages = sync_source(IndexSource::DayPages);
+    let fragments = sync_source(IndexSource::Fragments);
+    let promoted = sync_source(IndexSource::Clipboard);
+    let captured = sync_source(IndexSource::Captures);
     sync_browser_attention();
-    // Embedding trouble (missing helper binary, model load failure) must
-    // never take down the rest of the metabolism — lexical search, journal,
-    // and the curator all work without vectors.
-    let embedded = embed_pending(embedder, backoff).unwrap_or_else(|err| {
-        tracing::warn!(target: "script_kit::brain", error = %err, "embedding pass skipped");
-        0
-    });
+    let embedded = embed_phase(embedder, backoff);
     if synced > 0 || day_pages > 0 || fragments > 0 || promoted > 0 || captured > 0 || embedded > 0
     {
         tracing::info!(
@@ -187,12 +235,95 @@ pub(crate) fn run_cycle(
     // Daily distillation pass (no-op until due; silently skips without pi).
     super::curator::run_if_due();
     prune_ambient_if_due();
-    // Heartbeat for the kit://brain health surface.
+    record_heartbeat();
+    Ok(())
+}
+
+/// One event-driven pass: upsert the queued files, resync the marked
+/// sources, then embed what's missing. Untouched sources are not scanned.
+pub(crate) fn run_incremental(
+    dirty: DirtyQueue,
+    embedder: &mut Option<Arc<BrainEmbedder>>,
+    backoff: &mut EmbedBackoff,
+) -> Result<()> {
+    store::init_brain_db()?;
+    INCREMENTAL_PASSES.fetch_add(1, Ordering::Relaxed);
+    let mut indexed = 0usize;
+    for path in &dirty.files {
+        match index_brain_file(path) {
+            Ok(true) => indexed += 1,
+            Ok(false) => {}
+            Err(error) => {
+                tracing::debug!(
+                    target: "script_kit::brain",
+                    path = %path.display(),
+                    error = %error,
+                    "dirty brain file skipped"
+                );
+            }
+        }
+    }
+    let resynced: usize = dirty
+        .sources
+        .iter()
+        .map(|source| sync_source(*source))
+        .sum();
+    // Lexically searchable from here; embeddings follow below.
+    if let Some(since) = dirty.since {
+        LAST_DIRTY_TO_INDEXED_MS.store(since.elapsed().as_millis() as u64, Ordering::Relaxed);
+    }
+    let embedded = embed_phase(embedder, backoff);
+    if indexed > 0 || resynced > 0 || embedded > 0 {
+        tracing::info!(
+            target: "script_kit::brain",
+            indexed,
+            resynced,
+            sources = dirty.sources.len(),
+            embedded,
+            "brain incremental pass"
+        );
+    }
+    record_heartbeat();
+    Ok(())
+}
+
+/// Resync one source in full. Failures are logged and count as nothing
+/// synced — one broken source must not stop the others.
+fn sync_source(source: IndexSource) -> usize {
+    let (result, label) = match source {
+        IndexSource::Notes => (sync_notes(), "notes"),
+        IndexSource::DayPages => (sync_day_pages(), "day pages"),
+        IndexSource::Fragments => (sync_fragments(), "fragments"),
+        IndexSource::Clipboard => (sync_pinned_clipboard(), "clipboard"),
+        IndexSource::Captures => (sync_capture_stores(), "captures"),
+    };
+    result.unwrap_or_else(|err| {
+        tracing::debug!(target: "script_kit::brain", error = %err, source = label, "brain source sync skipped");
+        0
+    })
+}
+
+/// Embedding trouble (missing helper binary, model load failure) must never
+/// take down the rest of the metabolism — lexical search, journal, and the
+/// curator all work without vectors. A full batch means more is pending, so
+/// the indexer is woken again instead of waiting for the next change.
+fn embed_phase(embedder: &mut Option<Arc<BrainEmbedder>>, backoff: &mut EmbedBackoff) -> usize {
+    let embedded = embed_pending(embedder, backoff).unwrap_or_else(|err| {
+        tracing::warn!(target: "script_kit::brain", error = %err, "embedding pass skipped");
+        0
+    });
+    if embedded >= MAX_EMBED_PER_CYCLE {
+        wake_indexer();
+    }
+    embedded
+}
+
+/// Heartbeat for the kit://brain health surface.
+fn record_heartbeat() {
     let _ = store::meta_set(
         "last_index_cycle",
         &chrono::Utc::now().timestamp().to_string(),
     );
-    Ok(())
 }
 
 /// Wall-clock seconds since the Unix epoch, or `None` if the clock is before
@@ -210,7 +341,7 @@ fn unix_now() -> Option<u64> {
 fn record_cycle_health(
     started_unix: Option<u64>,
     err: Option<&anyhow::Error>,
-    embedder: &Option<BrainEmbedder>,
+    embedder: &Option<Arc<BrainEmbedder>>,
     backoff: &EmbedBackoff,
 ) {
     let (docs_total, docs_pending_embedding) = match store::doc_stats() {
@@ -218,7 +349,9 @@ fn record_cycle_health(
         Ok((docs, embedded, _signals)) => (docs, (docs - embedded).max(0)),
         Err(_) => (0, 0),
     };
-    let embedder_alive = embedder.as_ref().is_some_and(BrainEmbedder::is_alive);
+    let embedder_alive = embedder
+        .as_ref()
+        .is_some_and(|embedder| embedder.is_alive());
     let recall_mode = if resolve_embed_model().is_some() && embedder_alive {
         "semantic"
     } else {
@@ -244,6 +377,16 @@ fn record_cycle_health(
         docs_pending_embedding,
         recall_mode: recall_mode.to_string(),
         embedder_alive,
+        query_embeds_within_budget: QUERY_EMBEDS_WITHIN_BUDGET.load(Ordering::Relaxed),
+        query_embeds_over_budget: QUERY_EMBEDS_OVER_BUDGET.load(Ordering::Relaxed),
+        chunk_embed_cache_hits: CHUNK_CACHE_HITS.load(Ordering::Relaxed),
+        chunk_embed_cache_misses: CHUNK_CACHE_MISSES.load(Ordering::Relaxed),
+        incremental_passes: INCREMENTAL_PASSES.load(Ordering::Relaxed),
+        reconcile_passes: RECONCILE_PASSES.load(Ordering::Relaxed),
+        last_dirty_to_indexed_ms: match LAST_DIRTY_TO_INDEXED_MS.load(Ordering::Relaxed) {
+            u64::MAX => None,
+            ms => Some(ms),
+        },
     };
     let _ = super::health::record_health(&health);
 }
@@ -757,15 +900,44 @@ pub fn index_capture_now(path: &Path) {
 }
 
 fn try_index_capture(path: &Path) -> Result<()> {
+    store::init_brain_db()?;
+    if index_brain_file(path)? {
+        // Embeddings stay async; nudge the indexer to vectorize the new row.
+        // This only sends a channel message — no model work runs on the
+        // caller thread.
+        wake_indexer();
+    }
+    Ok(())
+}
+
+/// Upsert one brain markdown file. `Ok(false)` for paths that are not brain
+/// sources (see [`derive_capture_doc`]).
+pub(crate) fn index_brain_file(path: &Path) -> Result<bool> {
     let Some(doc) = derive_capture_doc(path)? else {
-        return Ok(());
+        return Ok(false);
     };
-    store::init_brain_db()?;
     doc.upsert()?;
-    // Embeddings stay async; nudge the indexer to vectorize the new row. This
-    // only sends a channel message — no model work runs on the caller thread.
-    wake_indexer();
-    Ok(())
+    remember_file_doc(&doc, path)?;
+    Ok(true)
+}
+
+/// Add a singly indexed file's doc to its source's last-sync id set, so
+/// deleting the file before the next full sync is still forgotten by
+/// [`forget_missing_file_docs`].
+fn remember_file_doc(doc: &DerivedDoc, path: &Path) -> Result<()> {
+    let Some(base) = path.parent().and_then(Path::parent) else {
+        return Ok(());
+    };
+    let key = file_sync_meta_key(doc.source, base);
+    let mut ids = store::meta_get(&key)?.unwrap_or_default();
+    if ids.lines().any(|id| id == doc.source_id) {
+        return Ok(());
+    }
+    if !ids.is_empty() {
+        ids.push('\n');
+    }
+    ids.push_str(&doc.source_id);
+    store::meta_set(&key, &ids)
 }
 
 /// Classify a brain file by its parent directory and derive its doc identity
@@ -964,7 +1136,7 @@ pub(crate) fn should_skip_embed(consecutive_failures: u32, cycles_since_failure:
 /// respawned, an embed error drops the slot so the next cycle gets a fresh
 /// pipe, and repeated failures trip [`EmbedBackoff`] to skip the phase.
 fn embed_pending(
-    embedder: &mut Option<BrainEmbedder>,
+    embedder: &mut Option<Arc<BrainEmbedder>>,
     backoff: &mut EmbedBackoff,
 ) -> Result<usize> {
     if backoff.is_backing_off() {
@@ -983,7 +1155,7 @@ fn embed_pending(
             // Broken pipe, timeout, or a crashed helper: drop the slot so the
             // next cycle respawns instead of reusing a dead process, and step
             // the backoff so we stop respawning-and-failing on every cycle.
-            *embedder = None;
+            set_embedder(embedder, None);
             backoff.record_failure();
         }
     }
@@ -994,7 +1166,7 @@ fn embed_pending(
 /// chunk/batch/split bookkeeping. Split from [`embed_pending`] so the borrow of
 /// the embedder inside the embed closure ends before the caller can null the
 /// slot on error.
-fn embed_pending_once(embedder: &mut Option<BrainEmbedder>) -> Result<usize> {
+fn embed_pending_once(embedder: &mut Option<Arc<BrainEmbedder>>) -> Result<usize> {
     if resolve_embed_model().is_none() {
         // Zero-setup semantic search: fetch the model once the brain has
         // content worth embedding (politeness rules in brain::download).
@@ -1012,10 +1184,10 @@ fn embed_pending_once(embedder: &mut Option<BrainEmbedder>) -> Result<usize> {
         .as_ref()
         .is_some_and(|e| e.model_id() != model.model_id || !e.is_alive())
     {
-        *embedder = None;
+        set_embedder(embedder, None);
     }
     if embedder.is_none() {
-        *embedder = Some(BrainEmbedder::spawn(model)?);
+        set_embedder(embedder, Some(Arc::new(BrainEmbedder::spawn(model)?)));
     }
     let Some(e) = embedder.as_ref() else {
         // Unreachable: set to `Some` directly above. Fail soft instead of
@@ -1028,11 +1200,12 @@ fn embed_pending_once(embedder: &mut Option<BrainEmbedder>) -> Result<usize> {
     embed_pending_with(&model_id, |texts| e.embed(texts))
 }
 
-/// The embed cycle with the embedder injected — the chunk → one-batch-call →
-/// split-back-per-doc bookkeeping is testable without the helper subprocess.
+/// The embed cycle with the embedder injected — the chunk → cache lookup →
+/// one-batch-call → split-back-per-doc bookkeeping is testable without the
+/// helper subprocess.
 pub(crate) fn embed_pending_with(
     model_id: &str,
-    mut embed: impl FnMut(Vec<String>) -> Result<Vec<Vec<f32>>>,
+    mut embed: impl FnMut(&[&str]) -> Result<Vec<Vec<f32>>>,
 ) -> Result<usize> {
     let mut total = 0usize;
     while total < MAX_EMBED_PER_CYCLE {
@@ -1043,15 +1216,25 @@ pub(crate) fn embed_pending_with(
         // qmd-style chunking: long docs embed as ~900-token pieces with
         // overlap so nothing past a truncation cap goes semantically dark.
         // All chunks of the batch ride one embed call, then split back out.
-        let doc_chunks: Vec<Vec<super::chunker::Chunk>> = pending
+        // Chunks borrow from `doc_texts`; the embed request references the
+        // same slices, so no chunk text is copied on the way to the helper.
+        let doc_texts: Vec<String> = pending
+            .iter()
+            .map(|doc| format!("{}\n{}", doc.title, doc.content))
+            .collect();
+        let doc_chunks: Vec<Vec<super::chunker::Chunk<'_>>> = doc_texts
             .iter()
-            .map(|doc| super::chunker::chunk_markdown(&format!("{}\n{}", doc.title, doc.content)))
+            .map(|text| super::chunker::chunk_markdown(text))
             .collect();
-        let texts: Vec<String> = doc_chunks
+        let mut hashes: Vec<String> = doc_chunks
             .iter()
-            .flat_map(|chunks| chunks.iter().map(|chunk| chunk.text.clone()))
+            .flat_map(|chunks| {
+                chunks
+                    .iter()
+                    .map(|chunk| store::chunk_text_hash(chunk.text))
+            })
             .collect();
-        if texts.is_empty() {
+        if hashes.is_empty() {
             // Whitespace-only docs produce zero chunks; store an empty set so
             // they stop reporting as pending.
             for doc in &pending {
@@ -1060,21 +1243,43 @@ pub(crate) fn embed_pending_with(
             }
             continue;
         }
-        let vectors = embed(texts)?;
+        // Chunks whose text is unchanged (an edit elsewhere in the note) or
+        // shared with another doc reuse their stored vector; only the rest
+        // go to the helper.
+        let mut vectors = store::cached_chunk_embeddings(model_id, &hashes)?;
+        let misses: Vec<usize> = (0..vectors.len())
+            .filter(|&slot| vectors[slot].is_none())
+            .collect();
+        CHUNK_CACHE_HITS.fetch_add((hashes.len() - misses.len()) as u64, Ordering::Relaxed);
+        CHUNK_CACHE_MISSES.fetch_add(misses.len() as u64, Ordering::Relaxed);
+        if !misses.is_empty() {
+            let all_chunks: Vec<&super::chunker::Chunk<'_>> = doc_chunks.iter().flatten().collect();
+            let texts: Vec<&str> = misses.iter().map(|&slot| all_chunks[slot].text).collect();
+            // A short batch leaves trailing slots `None`; those docs retry
+            // next cycle.
+            for (&slot, vec) in misses.iter().zip(embed(&texts)?) {
+                vectors[slot] = Some(vec);
+            }
+        }
         let mut cursor = 0usize;
         let mut stored_this_round = 0usize;
         for (doc, chunks) in pending.iter().zip(doc_chunks.iter()) {
             let end = cursor + chunks.len();
-            if end > vectors.len() {
-                break; // embedder returned a short batch; retry next cycle
+            let slots = cursor..end;
+            cursor = end;
+            if vectors[slots.clone()].iter().any(Option::is_none) {
+                continue; // embedder returned a short batch; retry next cycle
             }
-            let chunk_vecs: Vec<(usize, Vec<f32>)> = chunks
+            let chunk_vecs: Vec<store::ChunkEmbedding> = chunks
                 .iter()
-                .zip(vectors[cursor..end].iter())
-                .map(|(chunk, vec)| (chunk.start, vec.clone()))
+                .zip(slots)
+                .map(|(chunk, slot)| store::ChunkEmbedding {
+                    start: chunk.start,
+                    text_hash: std::mem::take(&mut hashes[slot]),
+                    vec: vectors[slot].take().unwrap_or_default(),
+                })
                 .collect();
-            cursor = end;
-            if chunk_vecs.iter().all(|(_, vec)| vec.is_empty()) && !chunks.is_empty() {
+            if chunk_vecs.iter().all(|chunk| chunk.vec.is_empty()) && !chunks.is_empty() {
                 continue; // embedder returned nothing usable; retry next cycle
             }
             store::store_chunk_embeddings(doc.id, model_id, &doc.title, &doc.content, &chunk_vecs)?;
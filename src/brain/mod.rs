@@ -13,7 +13,8 @@
 //! - **Search** ([`search`]): hybrid BM25 + cosine fused with RRF, boosted by
 //!   recent attention signals — the qmd retrieval recipe, native.
 //! - **Indexer** ([`indexer`]): a background thread that keeps the store and
-//!   vectors current without ever blocking the UI.
+//!   vectors current without ever blocking the UI, driven by the [`dirty`]
+//!   queue of changed sources.
 //!
 //! Privacy invariants: everything lives under `~/.scriptkit/`; nothing leaves
 //! the machine except through Agent Chat sessions the user already runs; the
@@ -22,6 +23,7 @@
 pub mod chunker;
 pub mod curator;
 pub mod day_trace;
+pub mod dirty;
 pub mod download;
 pub mod embedder;
 pub mod health;
@@ -232,10 +234,13 @@ pub fn record_capture_signals(target: &str, body: &str, tags: &[String]) {
             indexer::wake_indexer();
             // Plain `;todo`-style captures are written by a DETACHED handler
             // process spawned just before this signal fires, so the first
-            // wake usually races the file write and the cycle misses the new
-            // capture — leaving the doc to the next 120s timer (audit F11).
-            // Re-wake after the handler has had time to land the file; cycles
-            // are cheap and idempotent.
+            // wake usually races the file write (audit F11). The source
+            // watcher queues the file when it lands; without a watcher, re-wake
+            // after the handler has had time to land it — cycles are cheap
+            // and idempotent.
+            if dirty::is_watching() {
+                return;
+            }
             for delay_secs in [2, 8] {
                 std::thread::sleep(std::time::Duration::from_secs(delay_secs));
                 indexer::wake_indexer();
@@ -16,19 +16,19 @@
 //!   milliseconds and avoids shipping a vector-extension dependency.
 
 use anyhow::{anyhow, Context as _, Result};
-use rusqlite::{params, Connection, OpenFlags, OptionalExtension, Row};
+use rusqlite::{params, Connection, OptionalExtension, Row};
 use std::path::{Path, PathBuf};
 use std::sync::{Arc, Mutex, OnceLock};
 
-static BRAIN_DB: OnceLock<Arc<Mutex<Connection>>> = OnceLock::new();
+use crate::utils::sqlite_pool::{SqlitePool, DEFAULT_READ_CONNECTIONS};
 
-/// A SEPARATE read-only connection for recall queries. All writes share the one
-/// `BRAIN_DB` `Mutex<Connection>`, so a long indexer write (embedding batch
+/// Writer plus read-only WAL connections for the brain index. All writes share
+/// the one writer `Mutex<Connection>`, so a long indexer write (embedding batch
 /// upserts) would otherwise queue submit-path recall SELECTs behind it — WAL
-/// permits concurrent readers ONLY through a distinct connection. `Some(None)`
-/// records that the read connection could not be opened (fall back to the write
-/// connection); the outer `OnceLock` avoids retrying the open on every call.
-static BRAIN_DB_READ: OnceLock<Option<Arc<Mutex<Connection>>>> = OnceLock::new();
+/// permits concurrent readers ONLY through distinct connections, which
+/// [`SqlitePool::with_read`] hands out (falling back to the writer when none
+/// could be opened).
+static BRAIN_DB: OnceLock<Arc<SqlitePool>> = OnceLock::new();
 
 /// A document source. Stable string keys — stored in sqlite.
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -298,6 +298,7 @@ fn ensure_brain_schema(conn: &Connection) -> Result<()> {
             dim INTEGER NOT NULL,
             vec BLOB NOT NULL,
             embedded_at INTEGER NOT NULL DEFAULT (unixepoch()),
+            chunk_hash TEXT NOT NULL DEFAULT '',
             PRIMARY KEY (doc_id, model_id, chunk_index)
         );
         CREATE INDEX IF NOT EXISTS idx_brain_chunk_embeddings_model
@@ -335,6 +336,7 @@ fn ensure_brain_schema(conn: &Connection) -> Result<()> {
     migrate_brain_docs_canonical_path(conn)?;
     migrate_chunk_embeddings_pk(conn)?;
     migrate_whole_doc_embeddings(conn)?;
+    migrate_chunk_hash(conn)?;
     migrate_fts_tokenizer(conn)
 }
 
@@ -353,6 +355,33 @@ fn migrate_brain_docs_canonical_path(conn: &Connection) -> Result<()> {
     Ok(())
 }
 
+/// Adds the per-chunk text hash backing the embedding cache. Rows from
+/// before it keep `''` and are simply never cache hits.
+fn migrate_chunk_hash(conn: &Connection) -> Result<()> {
+    let exists: i64 = conn
+        .query_row(
+            "SELECT COUNT(*) FROM pragma_table_info('brain_chunk_embeddings')
+             WHERE name = 'chunk_hash'",
+            [],
+            |row| row.get(0),
+        )
+        .unwrap_or(0);
+    if exists == 0 {
+        conn.execute(
+            "ALTER TABLE brain_chunk_embeddings ADD COLUMN chunk_hash TEXT NOT NULL DEFAULT ''",
+            [],
+        )
+        .context("add brain_chunk_embeddings.chunk_hash")?;
+    }
+    conn.execute(
+        "CREATE INDEX IF NOT EXISTS idx_brain_chunk_embeddings_hash
+            ON brain_chunk_embeddings(model_id, chunk_hash)",
+        [],
+    )
+    .context("index chunk embedding hashes")?;
+    Ok(())
+}
+
 /// FTS schema version. v2 = porter stemming ("search" matches "searched").
 /// Bump + extend the match arm below when the tokenizer changes again.
 const FTS_VERSION: &str = "2";
@@ -493,7 +522,12 @@ pub fn init_brain_db() -> Result<()> {
         std::fs::create_dir_all(parent).context("create brain db dir")?;
     }
     let (conn, recovered) = open_or_recover_brain_db(&path)?;
-    let _ = BRAIN_DB.set(Arc::new(Mutex::new(conn)));
+    let _ = BRAIN_DB.set(Arc::new(SqlitePool::new(
+        "brain",
+        &path,
+        conn,
+        DEFAULT_READ_CONNECTIONS,
+    )));
     if recovered {
         // The fresh index is empty; nudge the indexer to repopulate it from
         // canonical markdown now instead of waiting for the next cycle. This is
@@ -505,7 +539,7 @@ pub fn init_brain_db() -> Result<()> {
     Ok(())
 }
 
-fn get_db() -> Result<Arc<Mutex<Connection>>> {
+fn get_pool() -> Result<Arc<SqlitePool>> {
     init_brain_db()?;
     BRAIN_DB
         .get()
@@ -513,6 +547,10 @@ fn get_db() -> Result<Arc<Mutex<Connection>>> {
         .ok_or_else(|| anyhow!("brain db not initialized"))
 }
 
+fn get_db() -> Result<Arc<Mutex<Connection>>> {
+    get_pool().map(|pool| pool.writer())
+}
+
 /// Run a closure against the shared brain connection (one lock acquisition).
 /// Sibling modules that own their own table (e.g. [`super::inbox`]) use this
 /// instead of reimplementing connection management.
@@ -522,52 +560,12 @@ pub(crate) fn with_conn<T>(f: impl FnOnce(&Connection) -> Result<T>) -> Result<T
     f(&conn)
 }
 
-/// Open the dedicated read-only connection. Requires the primary db (file +
-/// schema) to already exist — `init_brain_db()` guarantees that. Applies the
-/// same `busy_timeout` as the write connection; no schema/WAL pragmas because a
-/// read-only connection follows the WAL created by the write connection.
-fn open_read_conn() -> Result<Connection> {
-    let path = brain_db_path();
-    let conn = Connection::open_with_flags(
-        &path,
-        OpenFlags::SQLITE_OPEN_READ_ONLY
-            | OpenFlags::SQLITE_OPEN_URI
-            | OpenFlags::SQLITE_OPEN_NO_MUTEX,
-    )
-    .context("open brain read-only connection")?;
-    conn.pragma_update(None, "busy_timeout", 5000)
-        .context("brain read busy_timeout")?;
-    Ok(conn)
-}
-
-/// Lazily initialize (or return) the read-only connection. `None` when it could
-/// not be opened (e.g. first-launch ordering) — callers fall back to the write
-/// connection so recall never fails just because the read path is unavailable.
-fn read_db() -> Option<Arc<Mutex<Connection>>> {
-    // Ensure the file and schema exist before opening a READ_ONLY handle.
-    if init_brain_db().is_err() {
-        return None;
-    }
-    BRAIN_DB_READ
-        .get_or_init(|| open_read_conn().ok().map(|conn| Arc::new(Mutex::new(conn))))
-        .clone()
-}
-
-/// Run a pure-SELECT closure against the read-only connection so it never queues
-/// behind an in-flight indexer write on the shared write `Mutex`. Falls back to
-/// [`with_conn`] when the read connection is unavailable. MUST NOT be used for
-/// anything that writes (upserts, `meta_set`, signal inserts) — the connection
-/// is READ_ONLY and will error on writes.
+/// Run a pure-SELECT closure on a brain read connection so it never queues
+/// behind an in-flight indexer write on the writer `Mutex`. MUST NOT be used for
+/// anything that writes (upserts, `meta_set`, signal inserts) — read
+/// connections are READ_ONLY and will error on writes.
 pub(crate) fn with_read_conn<T>(f: impl FnOnce(&Connection) -> Result<T>) -> Result<T> {
-    match read_db() {
-        Some(db) => {
-            let conn = db
-                .lock()
-                .map_err(|_| anyhow!("brain read db lock poisoned"))?;
-            f(&conn)
-        }
-        None => with_conn(f),
-    }
+    get_pool()?.with_read("brain_recall", f)
 }
 
 /// Reset mutable brain rows between unit tests while preserving the process
@@ -621,6 +619,7 @@ fn migrate_chunk_embeddings_pk(conn: &Connection) -> Result<()> {
             dim INTEGER NOT NULL,
             vec BLOB NOT NULL,
             embedded_at INTEGER NOT NULL DEFAULT (unixepoch()),
+            chunk_hash TEXT NOT NULL DEFAULT '',
             PRIMARY KEY (doc_id, model_id, chunk_index)
         );
         CREATE INDEX IF NOT EXISTS idx_brain_chunk_embeddings_model
@@ -883,18 +882,44 @@ pub fn store_embedding(
     content: &str,
     vec: &[f32],
 ) -> Result<()> {
-    store_chunk_embeddings(doc_id, model_id, title, content, &[(0, vec.to_vec())])
+    let chunk = ChunkEmbedding {
+        start: 0,
+        text_hash: chunk_text_hash(&format!("{title}\n{content}")),
+        vec: vec.to_vec(),
+    };
+    store_chunk_embeddings(doc_id, model_id, title, content, &[chunk])
+}
+
+/// One embedded chunk of a doc, as handed to [`store_chunk_embeddings`].
+#[derive(Debug, Clone, PartialEq)]
+pub struct ChunkEmbedding {
+    /// Byte offset of the chunk in the embed text.
+    pub start: usize,
+    /// [`chunk_text_hash`] of the chunk text; the embedding cache key.
+    pub text_hash: String,
+    pub vec: Vec<f32>,
+}
+
+/// Content address of one chunk's embed text. SHA-256 rather than the FNV
+/// [`content_hash`]: a collision here would hand one chunk another chunk's
+/// vector instead of merely re-embedding.
+pub(crate) fn chunk_text_hash(text: &str) -> String {
+    use sha2::{Digest, Sha256};
+
+    let digest = Sha256::digest(text.as_bytes());
+    digest[..16].iter().map(|b| format!("{b:02x}")).collect()
 }
 
 /// Replace all chunk vectors for `doc_id` atomically. Every chunk row carries
 /// the doc-level content hash, so staleness stays a single comparison in
-/// [`docs_needing_embedding`]. `chunks` is (chunk_start_byte, vector).
+/// [`docs_needing_embedding`], plus its own text hash so unchanged chunks can
+/// be served by [`cached_chunk_embeddings`] on the next edit.
 pub fn store_chunk_embeddings(
     doc_id: i64,
     model_id: &str,
     title: &str,
     content: &str,
-    chunks: &[(usize, Vec<f32>)],
+    chunks: &[ChunkEmbedding],
 ) -> Result<()> {
     let db = get_db()?;
     let mut conn_guard = db.lock().map_err(|_| anyhow!("brain db lock poisoned"))?;
@@ -905,23 +930,23 @@ pub fn store_chunk_embeddings(
         params![doc_id, model_id],
     )
     .context("clear stale chunk embeddings")?;
-    for (index, (chunk_start, vec)) in chunks.iter().enumerate() {
-        if vec.is_empty() {
+    for (index, chunk) in chunks.iter().enumerate() {
+        if chunk.vec.is_empty() {
             continue;
         }
-        let bytes: Vec<u8> = vec.iter().flat_map(|f| f.to_le_bytes()).collect();
         tx.execute(
             "INSERT INTO brain_chunk_embeddings
-                (doc_id, chunk_index, model_id, content_hash, chunk_start, dim, vec)
-             VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)",
+                (doc_id, chunk_index, model_id, content_hash, chunk_start, dim, vec, chunk_hash)
+             VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8)",
             params![
                 doc_id,
                 index as i64,
                 model_id,
                 hash,
-                *chunk_start as i64,
-                vec.len() as i64,
-                bytes
+                chunk.start as i64,
+                chunk.vec.len() as i64,
+                encode_vec(&chunk.vec),
+                chunk.text_hash
             ],
         )
         .context("store brain chunk embedding")?;
@@ -930,6 +955,47 @@ pub fn store_chunk_embeddings(
     Ok(())
 }
 
+/// Embedding cache lookup: for each chunk text hash, a stored vector from
+/// any doc embedded with `model_id`, or `None`. Identical text embeds to an
+/// identical vector, so editing one section of a long note only re-embeds
+/// that section, and boilerplate shared across docs is embedded once.
+pub fn cached_chunk_embeddings(model_id: &str, hashes: &[String]) -> Result<Vec<Option<Vec<f32>>>> {
+    if hashes.is_empty() {
+        return Ok(Vec::new());
+    }
+    with_read_conn(|conn| {
+        let mut stmt = conn.prepare(
+            "SELECT vec FROM brain_chunk_embeddings
+             WHERE model_id = ?1 AND chunk_hash = ?2 LIMIT 1",
+        )?;
+        hashes
+            .iter()
+            .map(|hash| -> Result<Option<Vec<f32>>> {
+                if hash.is_empty() {
+                    return Ok(None);
+                }
+                let bytes = stmt
+                    .query_row(params![model_id, hash], |row| row.get::<_, Vec<u8>>(0))
+                    .optional()?;
+                Ok(bytes.map(|bytes| decode_vec(&bytes)))
+            })
+            .collect()
+    })
+}
+
+fn encode_vec(vec: &[f32]) -> Vec<u8> {
+    vec.iter().flat_map(|f| f.to_le_bytes()).collect()
+}
+
+/// Vectors from a BLOB (little-endian `f32`s). The embed helper's packed
+/// wire encoding is the same bytes, so the embedder decodes through here too.
+pub(crate) fn decode_vec(bytes: &[u8]) -> Vec<f32> {
+    bytes
+        .chunks_exact(4)
+        .map(|c| f32::from_le_bytes([c[0], c[1], c[2], c[3]]))
+        .collect()
+}
+
 /// All chunk embeddings for the given model: (doc_id, vector). A doc appears
 /// once per chunk; cosine ranking dedupes to best-chunk-per-doc. Loaded into
 /// memory for brute-force cosine — see module docs for why this is fine.
@@ -946,13 +1012,7 @@ pub fn load_embeddings(model_id: &str) -> Result<Vec<(i64, Vec<f32>)>> {
             .collect::<std::result::Result<Vec<_>, _>>()?;
         Ok(rows
             .into_iter()
-            .map(|(id, bytes)| {
-                let vec = bytes
-                    .chunks_exact(4)
-                    .map(|c| f32::from_le_bytes([c[0], c[1], c[2], c[3]]))
-                    .collect();
-                (id, vec)
-            })
+            .map(|(id, bytes)| (id, decode_vec(&bytes)))
             .collect())
     })
 }
@@ -379,7 +379,18 @@ fn chunked_embeddings_roundtrip_and_staleness() {
     let _db = init_test_db();
     let long_content = "alpha section about rust gpui internals. ".repeat(40);
     let id = store::upsert_doc(DocSource::Note, "n-chunked", "T", &long_content, 100).unwrap();
-    let chunk_vecs = vec![(0usize, vec![1.0, 0.0]), (1800usize, vec![0.0, 1.0])];
+    let chunk_vecs = vec![
+        store::ChunkEmbedding {
+            start: 0,
+            text_hash: "chunk-a".to_string(),
+            vec: vec![1.0, 0.0],
+        },
+        store::ChunkEmbedding {
+            start: 1800,
+            text_hash: "chunk-b".to_string(),
+            vec: vec![0.0, 1.0],
+        },
+    ];
     store::store_chunk_embeddings(id, "model-a", "T", &long_content, &chunk_vecs).unwrap();
 
     // Both chunks load for cosine; doc no longer pending.
@@ -398,7 +409,12 @@ fn chunked_embeddings_roundtrip_and_staleness() {
     assert!(pending.iter().any(|d| d.id == id), "stale chunks re-embed");
 
     // Re-storing replaces the old chunk set atomically.
-    store::store_chunk_embeddings(id, "model-a", "T", "changed", &[(0, vec![0.5, 0.5])]).unwrap();
+    let changed = store::ChunkEmbedding {
+        start: 0,
+        text_hash: "chunk-changed".to_string(),
+        vec: vec![0.5, 0.5],
+    };
+    store::store_chunk_embeddings(id, "model-a", "T", "changed", &[changed]).unwrap();
     let loaded = store::load_embeddings("model-a").unwrap();
     let mine: Vec<_> = loaded.iter().filter(|(i, _)| *i == id).collect();
     assert_eq!(mine.len(), 1, "stale chunk rows are deleted on re-store");
@@ -673,6 +689,13 @@ fn brain_status_resource_reports_health() {
         docs_pending_embedding: 3,
         recall_mode: "lexical-only".to_string(),
         embedder_alive: false,
+        query_embeds_within_budget: 0,
+        query_embeds_over_budget: 0,
+        chunk_embed_cache_hits: 0,
+        chunk_embed_cache_misses: 0,
+        incremental_passes: 0,
+        reconcile_passes: 0,
+        last_dirty_to_indexed_ms: None,
     })
     .expect("record status health snapshot");
 
@@ -720,6 +743,13 @@ fn health_snapshot_round_trips_all_fields() {
         docs_pending_embedding: 7,
         recall_mode: "lexical-only".to_string(),
         embedder_alive: false,
+        query_embeds_within_budget: 0,
+        query_embeds_over_budget: 0,
+        chunk_embed_cache_hits: 0,
+        chunk_embed_cache_misses: 0,
+        incremental_passes: 0,
+        reconcile_passes: 0,
+        last_dirty_to_indexed_ms: None,
     };
     super::health::record_health(&health).expect("record health");
     let read = super::health::read_health().expect("health snapshot present");
@@ -738,6 +768,13 @@ fn health_error_snapshot_is_replaced_by_later_ok() {
         docs_pending_embedding: 3,
         recall_mode: "lexical-only".to_string(),
         embedder_alive: false,
+        query_embeds_within_budget: 0,
+        query_embeds_over_budget: 0,
+        chunk_embed_cache_hits: 0,
+        chunk_embed_cache_misses: 0,
+        incremental_passes: 0,
+        reconcile_passes: 0,
+        last_dirty_to_indexed_ms: None,
     };
     super::health::record_health(&failed).expect("record failing snapshot");
     let recovered = super::health::BrainHealth {
@@ -749,6 +786,13 @@ fn health_error_snapshot_is_replaced_by_later_ok() {
         docs_pending_embedding: 0,
         recall_mode: "semantic".to_string(),
         embedder_alive: true,
+        query_embeds_within_budget: 12,
+        query_embeds_over_budget: 1,
+        chunk_embed_cache_hits: 30,
+        chunk_embed_cache_misses: 4,
+        incremental_passes: 9,
+        reconcile_passes: 2,
+        last_dirty_to_indexed_ms: Some(240),
     };
     super::health::record_health(&recovered).expect("record ok snapshot");
     let read = super::health::read_health().expect("health snapshot present");
@@ -1723,6 +1767,38 @@ fn file_sources_sync_day_page_fragment_and_forget_trashed_note() {
     );
 }
 
+/// The event-driven indexer upserts queued files one at a time, without a
+/// directory sync ever listing them. Deleting such a file must still be
+/// forgotten by the source resync its removal event triggers.
+#[test]
+fn dirty_file_index_is_forgotten_by_the_removal_resync() {
+    let _db = init_test_db();
+    let tmp = tempfile::TempDir::new().expect("tempdir");
+    let substrate = test_substrate(&tmp.path().join("brain"));
+    let days = substrate.paths().days_dir();
+    std::fs::create_dir_all(&days).expect("days dir");
+    let marker = "okapidirtyqueuerecall";
+    let page = days.join("2026-10-17.md");
+    std::fs::write(&page, format!("planning notes about {marker}")).expect("write day page");
+
+    assert!(super::indexer::index_brain_file(&page).expect("index dirty file"));
+    assert!(
+        super::indexer::index_brain_file(&tmp.path().join("elsewhere.md"))
+            .is_ok_and(|indexed| !indexed),
+        "non-brain paths are ignored"
+    );
+    assert_eq!(store::fts_search(marker, 10).unwrap().len(), 1);
+
+    std::fs::remove_file(&page).expect("delete day page");
+    sync_day_pages_with_substrate(&substrate).expect("resync day pages");
+    assert!(
+        store::get_doc(DocSource::DayPage, "2026-10-17")
+            .unwrap()
+            .is_none(),
+        "deleted file is forgotten"
+    );
+}
+
 #[test]
 fn index_capture_now_makes_day_capture_recallable_without_a_cycle() {
     let _db = init_test_db();
@@ -2082,6 +2158,72 @@ fn embed_cycle_chunks_long_docs_and_clears_pending() {
     assert_eq!(embedded, 0, "all-empty vectors store nothing and terminate");
 }
 
+/// Editing one section of a long note re-embeds only the chunks whose text
+/// changed; the rest come from the chunk-hash embedding cache.
+#[test]
+fn embed_cycle_reuses_cached_vectors_for_unchanged_chunks() {
+    let _db = init_test_db();
+    let model = "model-embed-cache";
+    let sections: Vec<String> = (0..8)
+        .map(|i| {
+            format!(
+                "## Section {i}\n\n{}",
+                format!("topic {i} detail text. ").repeat(80)
+            )
+        })
+        .collect();
+    let original = sections.join("\n\n");
+    let id = store::upsert_doc(DocSource::Note, "n-embed-cache", "Cache", &original, 100).unwrap();
+
+    let mut first_sent = 0usize;
+    super::indexer::embed_pending_with(model, |texts| {
+        first_sent += texts.len();
+        Ok(texts.iter().map(|_| vec![1.0f32, 0.0]).collect())
+    })
+    .unwrap();
+    let chunk_count = store::load_embeddings(model)
+        .unwrap()
+        .iter()
+        .filter(|(doc_id, _)| *doc_id == id)
+        .count();
+    assert!(
+        chunk_count > 2,
+        "fixture must span several chunks: {chunk_count}"
+    );
+    assert_eq!(first_sent, chunk_count, "a cold cache embeds every chunk");
+
+    let edited = format!("{original}\n\nAppended closing thought.");
+    store::upsert_doc(DocSource::Note, "n-embed-cache", "Cache", &edited, 200).unwrap();
+    let mut resent: Vec<String> = Vec::new();
+    let embedded = super::indexer::embed_pending_with(model, |texts| {
+        resent.extend(texts.iter().map(|text| text.to_string()));
+        Ok(texts.iter().map(|_| vec![0.0f32, 1.0]).collect())
+    })
+    .unwrap();
+    assert_eq!(embedded, 1, "the edited doc is re-stored");
+    assert!(
+        !resent.is_empty() && resent.len() < chunk_count,
+        "only changed chunks re-embed: {} of {chunk_count}",
+        resent.len()
+    );
+    assert!(resent
+        .iter()
+        .any(|text| text.contains("Appended closing thought.")));
+    let vectors: Vec<Vec<f32>> = store::load_embeddings(model)
+        .unwrap()
+        .into_iter()
+        .filter(|(doc_id, _)| *doc_id == id)
+        .map(|(_, vec)| vec)
+        .collect();
+    assert_eq!(
+        vectors.first(),
+        Some(&vec![1.0, 0.0]),
+        "cached vector reused"
+    );
+    let pending = store::docs_needing_embedding(model, 500).unwrap();
+    assert!(!pending.iter().any(|d| d.id == id), "edited doc is current");
+}
+
 /// Embed backoff policy: no skipping until 3 consecutive failures, then a
 /// linear cool-down window (3 failures skips 1 cycle, 4 skips 2, ...), and any
 /// success (cycles_since_failure reset with failures back to 0) resumes embeds.
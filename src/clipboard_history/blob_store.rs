@@ -5,6 +5,10 @@
 //!
 //! Storage location: ~/.scriptkit/clipboard/blobs/<hash>.png
 //! Content format in DB: "blob:<hash>" (replaces "png:<base64>")
+//!
+//! List thumbnails are derived from a blob once and stored next to it at
+//! ~/.scriptkit/clipboard/blobs/thumbs/<hash>.png, so scrolling history never
+//! needs to decode the full-resolution PNG again.
 
 use anyhow::{Context, Result};
 use sha2::{Digest, Sha256};
@@ -156,6 +160,7 @@ pub fn delete_blob(content: &str) -> bool {
     };
 
     let blob_path = blob_dir.join(format!("{}.png", hash));
+    let _ = fs::remove_file(thumbnail_path_in_dir(hash, &blob_dir));
 
     match fs::remove_file(&blob_path) {
         Ok(_) => {
@@ -173,6 +178,77 @@ pub fn delete_blob(content: &str) -> bool {
     }
 }
 
+/// Thumbnail directory inside a blob directory.
+fn thumbnail_dir_in(blob_dir: &Path) -> PathBuf {
+    blob_dir.join("thumbs")
+}
+
+fn thumbnail_path_in_dir(hash: &str, blob_dir: &Path) -> PathBuf {
+    thumbnail_dir_in(blob_dir).join(format!("{}.png", hash))
+}
+
+/// Load the stored thumbnail PNG for a blob, if one was generated before.
+///
+/// Input: "blob:<hash>" content reference
+/// Returns: thumbnail PNG bytes, or None when absent (not an error)
+pub fn load_thumbnail_blob(content: &str) -> Option<Vec<u8>> {
+    let hash = content.strip_prefix("blob:")?;
+    let blob_dir = get_blob_dir().ok()?;
+    load_thumbnail_in_dir(hash, &blob_dir)
+}
+
+fn load_thumbnail_in_dir(hash: &str, blob_dir: &Path) -> Option<Vec<u8>> {
+    match fs::read(thumbnail_path_in_dir(hash, blob_dir)) {
+        Ok(bytes) => Some(bytes),
+        Err(e) if e.kind() == std::io::ErrorKind::NotFound => None,
+        Err(e) => {
+            warn!(hash = %hash, error = %e, "Failed to read thumbnail file");
+            None
+        }
+    }
+}
+
+/// Store a thumbnail PNG next to its source blob.
+///
+/// Input: "blob:<hash>" content reference of the full-resolution blob
+pub fn store_thumbnail_blob(content: &str, png_bytes: &[u8]) -> Result<()> {
+    let hash = content
+        .strip_prefix("blob:")
+        .context("Thumbnail source is not a blob reference")?;
+    let blob_dir = get_blob_dir()?;
+    store_thumbnail_in_dir(hash, png_bytes, &blob_dir)
+}
+
+fn store_thumbnail_in_dir(hash: &str, png_bytes: &[u8], blob_dir: &Path) -> Result<()> {
+    let thumb_dir = thumbnail_dir_in(blob_dir);
+    fs::create_dir_all(&thumb_dir).context("Failed to create thumbnail directory")?;
+
+    let mut temp_file = tempfile::Builder::new()
+        .prefix(&format!("{}.tmp.", hash))
+        .suffix(".png")
+        .tempfile_in(&thumb_dir)
+        .with_context(|| format!("Failed to create temporary thumbnail for hash {}", hash))?;
+    temp_file
+        .write_all(png_bytes)
+        .with_context(|| format!("Failed to write thumbnail for hash {}", hash))?;
+
+    // Thumbnails are derived data: a concurrent writer producing the same file
+    // is harmless, so a plain replacing rename is enough.
+    let thumb_path = thumbnail_path_in_dir(hash, blob_dir);
+    temp_file
+        .persist(&thumb_path)
+        .map_err(|e| e.error)
+        .with_context(|| {
+            format!(
+                "Failed to move thumbnail into place at {}",
+                thumb_path.display()
+            )
+        })?;
+
+    debug!(hash = %hash, size = png_bytes.len(), "Stored blob thumbnail");
+    Ok(())
+}
+
 /// Check if a content string is a blob reference
 #[inline]
 pub fn is_blob_content(content: &str) -> bool {
@@ -202,6 +278,17 @@ pub fn gc_orphaned_blobs(valid_hashes: &std::collections::HashSet<String>) -> Re
         }
     }
 
+    if let Ok(thumbs) = fs::read_dir(thumbnail_dir_in(&blob_dir)) {
+        for entry in thumbs.flatten() {
+            let path = entry.path();
+            if let Some(stem) = path.file_stem().and_then(|s| s.to_str()) {
+                if !valid_hashes.contains(stem) && fs::remove_file(&path).is_ok() {
+                    debug!(hash = %stem, "GC'd orphaned thumbnail");
+                }
+            }
+        }
+    }
+
     if deleted > 0 {
         debug!(deleted, "Garbage collected orphaned blobs");
     }
@@ -273,4 +360,32 @@ mod tests {
             .count();
         assert_eq!(file_count, 1, "Temporary files should be cleaned up");
     }
+
+    #[test]
+    fn test_thumbnail_round_trips_beside_blob_without_touching_blob_listing() {
+        let temp_dir = tempfile::tempdir().expect("Should create temp dir");
+        let blob_ref = store_blob_in_dir(b"full png", temp_dir.path()).expect("Store blob");
+        let hash = blob_ref
+            .strip_prefix("blob:")
+            .expect("Expected blob prefix");
+
+        assert!(load_thumbnail_in_dir(hash, temp_dir.path()).is_none());
+        store_thumbnail_in_dir(hash, b"thumb png", temp_dir.path()).expect("Store thumbnail");
+        store_thumbnail_in_dir(hash, b"thumb png v2", temp_dir.path())
+            .expect("Re-storing a thumbnail replaces it");
+        assert_eq!(
+            load_thumbnail_in_dir(hash, temp_dir.path()).as_deref(),
+            Some(&b"thumb png v2"[..])
+        );
+
+        let top_level_pngs = fs::read_dir(temp_dir.path())
+            .expect("Should read temp dir")
+            .flatten()
+            .filter(|entry| entry.path().extension().is_some_and(|ext| ext == "png"))
+            .count();
+        assert_eq!(
+            top_level_pngs, 1,
+            "Thumbnails live in their own subdirectory"
+        );
+    }
 }
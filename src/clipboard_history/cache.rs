@@ -1,31 +1,117 @@
 //! Clipboard history caching
 //!
-//! LRU caching for decoded images and entry metadata.
+//! Byte-budgeted LRU caching for decoded images and entry metadata.
+//!
+//! Decoded images live in two tiers, each evicted by decoded (BGRA) byte size
+//! rather than entry count — one 5K screenshot decodes to ~60MB, so an
+//! entry-count cap either wastes hundreds of megabytes or evicts every small
+//! image:
+//! - thumbnails: small, downscaled once per blob and persisted on disk (see
+//!   `image::decode_to_thumbnail_render_image`); the only tier list rows use.
+//! - full images: decoded lazily when the preview panel needs one.
 
 use gpui::RenderImage;
 use lru::LruCache;
 use parking_lot::Mutex;
-use std::num::NonZeroUsize;
+use std::collections::HashSet;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
 use std::sync::{Arc, OnceLock};
 use tracing::debug;
 
-use super::database::get_clipboard_history_meta;
-use super::types::{
-    root_clipboard_entry_is_eligible, root_clipboard_history_query_is_eligible, ClipboardEntryMeta,
-    RootClipboardHistorySectionOptions,
-};
+use super::database::{get_clipboard_history_meta, get_entry_content};
+use super::image::decode_to_render_image;
+use super::types::ClipboardEntryMeta;
+
+/// Decoded-byte budget for list thumbnails (~700 thumbnails at 96x96 BGRA).
+pub const THUMBNAIL_CACHE_BUDGET_BYTES: usize = 24 * 1024 * 1024;
 
-/// Maximum number of decoded images to keep in memory (LRU eviction)
-/// Each image can be 1-4MB, so 100 images = ~100-400MB max memory
-pub const MAX_IMAGE_CACHE_ENTRIES: usize = 100;
+/// Decoded-byte budget for full-resolution preview images. Large enough for a
+/// few 5K screenshots; a single image never exceeds it because decoding is
+/// capped at 20M pixels (80MB).
+pub const FULL_IMAGE_CACHE_BUDGET_BYTES: usize = 192 * 1024 * 1024;
 
 /// Maximum entries to cache in memory for fast access
 pub const MAX_CACHED_ENTRIES: usize = 500;
 
-/// Global image cache for decoded RenderImages (thread-safe)
-/// Key: entry ID, Value: decoded RenderImage
-/// Uses LRU eviction to cap memory usage at ~100-400MB (100 images max)
-static IMAGE_CACHE: OnceLock<Mutex<LruCache<String, Arc<RenderImage>>>> = OnceLock::new();
+/// LRU cache evicted by total value size in bytes instead of entry count.
+pub(crate) struct ByteBudgetLru<V> {
+    entries: LruCache<String, (V, usize)>,
+    total_bytes: usize,
+    budget_bytes: usize,
+}
+
+impl<V: Clone> ByteBudgetLru<V> {
+    pub(crate) fn new(budget_bytes: usize) -> Self {
+        Self {
+            entries: LruCache::unbounded(),
+            total_bytes: 0,
+            budget_bytes,
+        }
+    }
+
+    /// Look up a value, marking it most recently used.
+    pub(crate) fn get(&mut self, key: &str) -> Option<V> {
+        self.entries.get(key).map(|(value, _)| value.clone())
+    }
+
+    /// Insert a value of `bytes` size, evicting least recently used entries
+    /// until the cache fits its budget. Returns how many entries were evicted.
+    /// A value larger than the whole budget is not cached.
+    pub(crate) fn put(&mut self, key: &str, value: V, bytes: usize) -> usize {
+        self.remove(key);
+        if bytes > self.budget_bytes {
+            return 0;
+        }
+
+        let mut evicted = 0;
+        while self.total_bytes + bytes > self.budget_bytes {
+            let Some((_, (_, evicted_bytes))) = self.entries.pop_lru() else {
+                break;
+            };
+            self.total_bytes -= evicted_bytes;
+            evicted += 1;
+        }
+
+        self.entries.put(key.to_string(), (value, bytes));
+        self.total_bytes += bytes;
+        evicted
+    }
+
+    pub(crate) fn remove(&mut self, key: &str) -> bool {
+        match self.entries.pop(key) {
+            Some((_, bytes)) => {
+                self.total_bytes -= bytes;
+                true
+            }
+            None => false,
+        }
+    }
+
+    pub(crate) fn clear(&mut self) {
+        self.entries.clear();
+        self.total_bytes = 0;
+    }
+
+    pub(crate) fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    pub(crate) fn total_bytes(&self) -> usize {
+        self.total_bytes
+    }
+}
+
+type ImageTier = Mutex<ByteBudgetLru<Arc<RenderImage>>>;
+
+/// Downscaled list thumbnails (entry ID -> RenderImage)
+static THUMBNAIL_CACHE: OnceLock<ImageTier> = OnceLock::new();
+
+/// Full-resolution preview images (entry ID -> RenderImage)
+static FULL_IMAGE_CACHE: OnceLock<ImageTier> = OnceLock::new();
+
+/// Entry IDs with a full-resolution decode currently running, so repeated
+/// renders of the same preview don't start duplicate decodes.
+static FULL_IMAGE_DECODES_IN_FLIGHT: OnceLock<Mutex<HashSet<String>>> = OnceLock::new();
 
 /// Cached clipboard entry metadata (NO content payload) for list views
 /// Updated whenever a new entry is added. This is memory-efficient because
@@ -36,13 +122,30 @@ static ENTRY_CACHE: OnceLock<Mutex<Arc<Vec<ClipboardEntryMeta>>>> = OnceLock::ne
 /// Timestamp of last cache update
 static CACHE_UPDATED: OnceLock<Mutex<i64>> = OnceLock::new();
 static ENTRY_CACHE_REFRESH_IN_FLIGHT: OnceLock<Mutex<bool>> = OnceLock::new();
+/// Bumped whenever the entry cache changes.
+static ENTRY_CACHE_GENERATION: AtomicU64 = AtomicU64::new(0);
+/// Whether the entry cache holds a completed database load, so an empty
+/// history is not mistaken for a cold cache. Cleared by invalidation.
+static ENTRY_CACHE_LOADED: AtomicBool = AtomicBool::new(false);
+
+fn thumbnail_cache() -> &'static ImageTier {
+    THUMBNAIL_CACHE.get_or_init(|| Mutex::new(ByteBudgetLru::new(THUMBNAIL_CACHE_BUDGET_BYTES)))
+}
 
-/// Get the global image cache, initializing if needed
-pub fn get_image_cache() -> &'static Mutex<LruCache<String, Arc<RenderImage>>> {
-    IMAGE_CACHE.get_or_init(|| {
-        let cap = NonZeroUsize::new(MAX_IMAGE_CACHE_ENTRIES).unwrap_or(NonZeroUsize::MIN);
-        Mutex::new(LruCache::new(cap))
-    })
+fn full_image_cache() -> &'static ImageTier {
+    FULL_IMAGE_CACHE.get_or_init(|| Mutex::new(ByteBudgetLru::new(FULL_IMAGE_CACHE_BUDGET_BYTES)))
+}
+
+fn full_image_decodes_in_flight() -> &'static Mutex<HashSet<String>> {
+    FULL_IMAGE_DECODES_IN_FLIGHT.get_or_init(|| Mutex::new(HashSet::new()))
+}
+
+/// Decoded size of a RenderImage: the BGRA bytes of every frame.
+fn decoded_image_bytes(image: &RenderImage) -> usize {
+    (0..image.frame_count())
+        .filter_map(|frame| image.as_bytes(frame))
+        .map(<[u8]>::len)
+        .sum()
 }
 
 /// Get the global entry cache, initializing if needed
@@ -59,27 +162,62 @@ pub fn init_cache_timestamp() {
     let _ = CACHE_UPDATED.set(Mutex::new(0));
 }
 
-/// Get cached image by entry ID (updates LRU order)
+fn cache_in_tier(tier: &ImageTier, tier_name: &'static str, id: &str, image: Arc<RenderImage>) {
+    let bytes = decoded_image_bytes(&image);
+    let mut cache = tier.lock();
+    let evicted = cache.put(id, image, bytes);
+    debug!(
+        id = %id,
+        tier = tier_name,
+        bytes,
+        evicted,
+        cache_size = cache.len(),
+        cache_bytes = cache.total_bytes(),
+        "Cached decoded image"
+    );
+}
+
+/// Get a cached list thumbnail by entry ID (updates LRU order)
+pub fn get_cached_thumbnail(id: &str) -> Option<Arc<RenderImage>> {
+    thumbnail_cache().lock().get(id)
+}
+
+/// Cache a decoded list thumbnail (evicts by THUMBNAIL_CACHE_BUDGET_BYTES)
+pub fn cache_thumbnail(id: &str, image: Arc<RenderImage>) {
+    cache_in_tier(thumbnail_cache(), "thumbnail", id, image);
+}
+
+/// Get a cached full-resolution image by entry ID (updates LRU order)
 pub fn get_cached_image(id: &str) -> Option<Arc<RenderImage>> {
-    get_image_cache().lock().get(id).cloned()
+    full_image_cache().lock().get(id)
 }
 
-/// Cache a decoded image (with LRU eviction at MAX_IMAGE_CACHE_ENTRIES limit)
+/// Cache a decoded full-resolution image (evicts by FULL_IMAGE_CACHE_BUDGET_BYTES)
 pub fn cache_image(id: &str, image: Arc<RenderImage>) {
-    let mut cache = get_image_cache().lock();
-    // LruCache automatically evicts oldest entry when capacity is exceeded
-    let evicted = cache.len() >= cache.cap().get();
-    cache.put(id.to_string(), image);
-    if evicted {
-        debug!(
-            id = %id,
-            cache_size = cache.len(),
-            max_size = MAX_IMAGE_CACHE_ENTRIES,
-            "Cached decoded image (evicted oldest)"
-        );
-    } else {
-        debug!(id = %id, cache_size = cache.len(), "Cached decoded image");
+    cache_in_tier(full_image_cache(), "full", id, image);
+}
+
+/// Claim the full-resolution decode for an entry. Returns `false` when the
+/// image is already cached or another decode for it is running; otherwise the
+/// caller must follow up with [`load_full_image`] off the UI thread.
+pub fn begin_full_image_load(id: &str) -> bool {
+    if get_cached_image(id).is_some() {
+        return false;
     }
+    full_image_decodes_in_flight().lock().insert(id.to_string())
+}
+
+/// Fetch and decode an entry's full-resolution image into the full tier.
+/// Blocking (SQLite + PNG decode) — never call from render.
+pub fn load_full_image(id: &str) -> Option<Arc<RenderImage>> {
+    let image = get_cached_image(id).or_else(|| {
+        let content = get_entry_content(id)?;
+        let image = decode_to_render_image(&content)?;
+        cache_image(id, image.clone());
+        Some(image)
+    });
+    full_image_decodes_in_flight().lock().remove(id);
+    image
 }
 
 /// Get cached clipboard entry metadata (faster than querying SQLite)
@@ -106,6 +244,9 @@ pub fn get_cached_entries(limit: usize) -> Vec<ClipboardEntryMeta> {
 pub fn invalidate_entry_cache() {
     let mut cache = get_entry_cache().lock();
     *cache = Arc::new(Vec::new());
+    drop(cache);
+    ENTRY_CACHE_LOADED.store(false, Ordering::Release);
+    ENTRY_CACHE_GENERATION.fetch_add(1, Ordering::Release);
 }
 
 /// Refresh the entry cache from database (metadata only, no content payload)
@@ -117,10 +258,8 @@ pub fn refresh_entry_cache() {
     *cache = Arc::new(entries);
     debug!(count = cache.len(), "Refreshed entry metadata cache");
     drop(cache);
-    if let Some(updated) = CACHE_UPDATED.get() {
-        let mut ts = updated.lock();
-        *ts = chrono::Utc::now().timestamp_millis();
-    }
+    ENTRY_CACHE_LOADED.store(true, Ordering::Release);
+    update_cache_timestamp();
 }
 
 fn ensure_entry_cache_refresh() {
@@ -149,53 +288,30 @@ fn ensure_entry_cache_refresh() {
     }
 }
 
-/// Cache-only root clipboard search used by foreground launcher grouping.
+/// Change feed for the root search index: the entry cache's generation, or
+/// `None` while the cache is cold (a background refresh is started). A loaded
+/// but empty cache (history just cleared) still reports its generation so
+/// the index drops the entries it held.
 ///
-/// When the metadata cache is cold, this starts a background refresh and returns
-/// no hits for the active frame so late SQLite work cannot repaint the current
-/// root-search rows.
-pub fn search_root_clipboard_history_meta_cached(
-    query: &str,
-    options: RootClipboardHistorySectionOptions,
-) -> Vec<ClipboardEntryMeta> {
-    if !root_clipboard_history_query_is_eligible(query, options) {
-        return Vec::new();
-    }
-
-    let entries = {
-        let cache = get_entry_cache().lock();
-        if cache.is_empty() {
-            None
-        } else {
-            Some(
-                cache
-                    .iter()
-                    .take(options.scan_limit)
-                    .cloned()
-                    .collect::<Vec<_>>(),
-            )
-        }
-    };
-
-    let Some(entries) = entries else {
+/// Read the generation before snapshotting [`get_entry_cache`]; every cache
+/// mutation bumps it after swapping the entries in.
+pub(crate) fn root_clipboard_history_index_generation() -> Option<u64> {
+    if !ENTRY_CACHE_LOADED.load(Ordering::Acquire) && get_entry_cache().lock().is_empty() {
         ensure_entry_cache_refresh();
-        return Vec::new();
-    };
-
-    let query = query.trim().to_lowercase();
-    entries
-        .into_iter()
-        .filter(root_clipboard_entry_is_eligible)
-        .filter(|entry| entry.text_preview.to_lowercase().contains(&query))
-        .take(options.max_results)
-        .collect()
+        return None;
+    }
+    Some(ENTRY_CACHE_GENERATION.load(Ordering::Acquire))
 }
 
-/// Evict a single entry from the image cache
+/// Evict a single entry from both image tiers
 pub fn evict_image_cache(id: &str) {
-    if let Some(cache) = IMAGE_CACHE.get() {
-        let mut cache = cache.lock();
-        cache.pop(id);
+    let mut evicted = false;
+    for tier in [&THUMBNAIL_CACHE, &FULL_IMAGE_CACHE] {
+        if let Some(cache) = tier.get() {
+            evicted |= cache.lock().remove(id);
+        }
+    }
+    if evicted {
         debug!(id = %id, "Evicted image from cache");
     }
 }
@@ -299,28 +415,33 @@ pub(crate) fn update_ocr_text_in_cache(id: &str, text: String) {
     }
 }
 
-/// Update the cache timestamp (internal helper)
+/// Update the cache timestamp and generation (internal helper)
 fn update_cache_timestamp() {
+    ENTRY_CACHE_GENERATION.fetch_add(1, Ordering::Release);
     if let Some(updated) = CACHE_UPDATED.get() {
         let mut ts = updated.lock();
         *ts = chrono::Utc::now().timestamp_millis();
     }
 }
 
-/// Clear all caches (entry + image)
+/// Clear all caches (entry + both image tiers)
 pub fn clear_all_caches() {
     invalidate_entry_cache();
-    if let Some(cache) = IMAGE_CACHE.get() {
-        let mut cache = cache.lock();
-        cache.clear();
-        debug!("Cleared image cache");
+    for tier in [&THUMBNAIL_CACHE, &FULL_IMAGE_CACHE] {
+        if let Some(cache) = tier.get() {
+            cache.lock().clear();
+        }
     }
+    debug!("Cleared image caches");
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
-    use crate::clipboard_history::types::ContentType;
+    use crate::clipboard_history::database::{
+        add_entry, clear_history, init_test_clipboard_db, pin_entry, remove_entry,
+    };
+    use crate::clipboard_history::types::{ContentType, RootClipboardHistorySectionOptions};
     use parking_lot::Mutex as ParkingMutex;
 
     /// All cache tests must hold this lock to prevent interference
@@ -431,4 +552,119 @@ mod tests {
         let cached = get_cached_entries(10);
         assert_eq!(cached[0].ocr_text.as_deref(), Some("recognized text"));
     }
+
+    /// Poll the root search index until the clipboard hits for `query`
+    /// satisfy `done`; partitions rebuild on a background thread.
+    fn wait_for_root_clipboard_hits(
+        query: &str,
+        done: impl Fn(&[ClipboardEntryMeta]) -> bool,
+    ) -> bool {
+        let request = crate::root_search_index::RootSearchIndexRequest {
+            clipboard_history: Some(RootClipboardHistorySectionOptions {
+                enabled: true,
+                ..Default::default()
+            }),
+            ..Default::default()
+        };
+        let deadline = std::time::Instant::now() + std::time::Duration::from_secs(5);
+        loop {
+            let hits = crate::root_search_index::search_root_passive_sources(query, &request)
+                .clipboard_history
+                .unwrap_or_default();
+            if done(&hits) {
+                return true;
+            }
+            if std::time::Instant::now() >= deadline {
+                return false;
+            }
+            std::thread::sleep(std::time::Duration::from_millis(10));
+        }
+    }
+
+    #[test]
+    fn test_cleared_history_drops_out_of_root_search_index() {
+        let _guard = TEST_LOCK.lock();
+        let dir = tempfile::tempdir().expect("tempdir");
+        init_test_clipboard_db(&dir.path().join("clipboard.sqlite")).expect("test db");
+
+        let id = add_entry("zebracorn ledger", ContentType::Text).expect("add");
+        refresh_entry_cache();
+        assert!(
+            wait_for_root_clipboard_hits("zebracorn", |hits| hits.iter().any(|hit| hit.id == id)),
+            "new entry should become searchable"
+        );
+
+        clear_history().expect("clear");
+        assert!(
+            wait_for_root_clipboard_hits("zebracorn", |hits| hits.is_empty()),
+            "cleared entries must not stay searchable from the root index"
+        );
+    }
+
+    #[test]
+    fn test_erasing_pinned_entries_marks_brain_clipboard_dirty() {
+        use crate::brain::dirty::{take_dirty, IndexSource};
+
+        let _guard = TEST_LOCK.lock();
+        let dir = tempfile::tempdir().expect("tempdir");
+        init_test_clipboard_db(&dir.path().join("clipboard.sqlite")).expect("test db");
+
+        let pinned = add_entry("pinned recipe", ContentType::Text).expect("add");
+        pin_entry(&pinned).expect("pin");
+        let _ = take_dirty();
+        remove_entry(&pinned).expect("remove");
+        assert!(
+            take_dirty().sources.contains(&IndexSource::Clipboard),
+            "removing a pinned entry must resync the brain's clipboard docs"
+        );
+
+        let pinned = add_entry("pinned address", ContentType::Text).expect("add");
+        pin_entry(&pinned).expect("pin");
+        let _ = take_dirty();
+        clear_history().expect("clear");
+        assert!(
+            take_dirty().sources.contains(&IndexSource::Clipboard),
+            "clearing history must resync the brain's clipboard docs"
+        );
+    }
+
+    #[test]
+    fn test_byte_budget_lru_evicts_least_recent_until_within_budget() {
+        let mut cache = ByteBudgetLru::new(100);
+        assert_eq!(cache.put("a", 1, 40), 0);
+        assert_eq!(cache.put("b", 2, 40), 0);
+        // Touch "a" so "b" becomes least recently used.
+        assert_eq!(cache.get("a"), Some(1));
+
+        assert_eq!(cache.put("c", 3, 50), 1);
+        assert_eq!(cache.get("b"), None);
+        assert_eq!(cache.get("a"), Some(1));
+        assert_eq!(cache.total_bytes(), 90);
+    }
+
+    #[test]
+    fn test_byte_budget_lru_many_small_entries_survive_one_large() {
+        let mut cache = ByteBudgetLru::new(1_000);
+        for ix in 0..20 {
+            cache.put(&format!("thumb-{ix}"), ix, 10);
+        }
+        // A huge value alone would evict everything; it is refused instead.
+        assert_eq!(cache.put("huge", 99, 5_000), 0);
+        assert_eq!(cache.len(), 20);
+        assert_eq!(cache.total_bytes(), 200);
+    }
+
+    #[test]
+    fn test_byte_budget_lru_replace_and_remove_track_bytes() {
+        let mut cache = ByteBudgetLru::new(100);
+        cache.put("a", 1, 30);
+        cache.put("a", 2, 60);
+        assert_eq!(cache.len(), 1);
+        assert_eq!(cache.total_bytes(), 60);
+        assert_eq!(cache.get("a"), Some(2));
+
+        assert!(cache.remove("a"));
+        assert!(!cache.remove("a"));
+        assert_eq!(cache.total_bytes(), 0);
+    }
 }
@@ -11,6 +11,8 @@ use std::sync::{Arc, Mutex, OnceLock};
 use tracing::{debug, error, info};
 use uuid::Uuid;
 
+use crate::utils::sqlite_pool::{SqlitePool, DEFAULT_READ_CONNECTIONS};
+
 use super::cache::{
     clear_all_caches, evict_image_cache, refresh_entry_cache, remove_entry_from_cache,
     update_ocr_text_in_cache, update_pin_status_in_cache, upsert_entry_in_cache,
@@ -22,12 +24,12 @@ use super::types::{
     ClipboardEntryMeta, ContentType, RootClipboardHistorySectionOptions,
 };
 
-/// Global database connection (thread-safe)
-static DB_CONNECTION: OnceLock<Arc<Mutex<Connection>>> = OnceLock::new();
+/// Global database pool: one writer plus read-only WAL connections, so the
+/// history list never waits behind monitor/maintenance writes.
+static DB_POOL: OnceLock<Arc<SqlitePool>> = OnceLock::new();
 
 #[cfg(test)]
-static TEST_DB_CONNECTION: std::sync::Mutex<Option<Arc<Mutex<Connection>>>> =
-    std::sync::Mutex::new(None);
+static TEST_DB_POOL: std::sync::Mutex<Option<Arc<SqlitePool>>> = std::sync::Mutex::new(None);
 
 fn db_lock_err(e: impl std::fmt::Display) -> anyhow::Error {
     anyhow::anyhow!("DB lock error: {e}")
@@ -254,32 +256,52 @@ fn harden_clipboard_db_permissions(db_path: &std::path::Path) {
     let _ = db_path;
 }
 
-/// Get or create the database connection
-pub fn get_connection() -> Result<Arc<Mutex<Connection>>> {
+fn open_pool(db_path: &PathBuf) -> Result<SqlitePool> {
+    let conn = open_and_init_connection(db_path)?;
+    Ok(SqlitePool::new(
+        "clipboard",
+        db_path,
+        conn,
+        DEFAULT_READ_CONNECTIONS,
+    ))
+}
+
+/// Get or create the database pool
+fn get_pool() -> Result<Arc<SqlitePool>> {
     #[cfg(test)]
     {
-        if let Ok(guard) = TEST_DB_CONNECTION.lock() {
-            if let Some(conn) = guard.as_ref() {
-                return Ok(conn.clone());
+        if let Ok(guard) = TEST_DB_POOL.lock() {
+            if let Some(pool) = guard.as_ref() {
+                return Ok(pool.clone());
             }
         }
     }
 
-    if let Some(conn) = DB_CONNECTION.get() {
-        return Ok(conn.clone());
+    if let Some(pool) = DB_POOL.get() {
+        return Ok(pool.clone());
     }
 
     let db_path = get_db_path()?;
-    let conn = Arc::new(Mutex::new(open_and_init_connection(&db_path)?));
+    let pool = Arc::new(open_pool(&db_path)?);
 
-    if DB_CONNECTION.set(conn.clone()).is_err() {
-        return DB_CONNECTION
+    if DB_POOL.set(pool.clone()).is_err() {
+        return DB_POOL
             .get()
             .cloned()
-            .ok_or_else(|| anyhow::anyhow!("DB_CONNECTION set failed but get() returned None"));
+            .ok_or_else(|| anyhow::anyhow!("DB_POOL set failed but get() returned None"));
     }
 
-    Ok(conn)
+    Ok(pool)
+}
+
+/// Get or create the shared writer connection
+pub fn get_connection() -> Result<Arc<Mutex<Connection>>> {
+    Ok(get_pool()?.writer())
+}
+
+/// Run a pure-SELECT closure on a read connection (never the writer).
+fn with_read_conn<T>(label: &'static str, f: impl FnOnce(&Connection) -> Result<T>) -> Result<T> {
+    get_pool()?.with_read(label, f)
 }
 
 /// Populate metadata for existing entries (migration helper)
@@ -498,6 +520,10 @@ pub fn trim_oversize_text_entries() -> Result<usize> {
 
     drop(conn);
     refresh_entry_cache();
+    if deleted > 0 {
+        // Pinned text can exceed the limit too; let the brain drop it.
+        crate::brain::dirty::mark_source_dirty(crate::brain::dirty::IndexSource::Clipboard);
+    }
 
     Ok(deleted)
 }
@@ -506,53 +532,37 @@ pub fn trim_oversize_text_entries() -> Result<usize> {
 ///
 /// Returns entries ordered by pinned status (pinned first) then by timestamp descending.
 pub fn get_clipboard_history_page(limit: usize, offset: usize) -> Vec<ClipboardEntry> {
-    let conn = match get_connection() {
-        Ok(c) => c,
-        Err(e) => {
-            error!(error = %e, "Failed to get database connection");
-            return Vec::new();
-        }
-    };
-
-    let conn = match conn.lock() {
-        Ok(c) => c,
-        Err(e) => {
-            error!(error = %e, "Failed to lock database connection");
-            return Vec::new();
-        }
-    };
-
-    let mut stmt = match conn.prepare(
-        "SELECT id, content, content_type, timestamp, pinned, ocr_text 
-         FROM history 
-         ORDER BY pinned DESC, timestamp DESC 
-         LIMIT ? OFFSET ?",
-    ) {
-        Ok(s) => s,
-        Err(e) => {
-            error!(error = %e, "Failed to prepare query");
-            return Vec::new();
-        }
-    };
-
-    let entries = stmt
-        .query_map(params![limit as i64, offset as i64], |row| {
-            Ok(ClipboardEntry {
-                id: row.get(0)?,
-                content: row.get(1)?,
-                content_type: ContentType::from_str(&row.get::<_, String>(2)?),
-                timestamp: row.get(3)?,
-                pinned: row.get::<_, i64>(4)? != 0,
-                ocr_text: row.get(5)?,
-                source_app_name: None,
-                source_app_bundle_id: None,
+    let entries = with_read_conn("clipboard_history_page", |conn| {
+        let mut stmt = conn
+            .prepare(
+                "SELECT id, content, content_type, timestamp, pinned, ocr_text 
+                 FROM history 
+                 ORDER BY pinned DESC, timestamp DESC 
+                 LIMIT ? OFFSET ?",
+            )
+            .context("Failed to prepare query")?;
+        let entries = stmt
+            .query_map(params![limit as i64, offset as i64], |row| {
+                Ok(ClipboardEntry {
+                    id: row.get(0)?,
+                    content: row.get(1)?,
+                    content_type: ContentType::from_str(&row.get::<_, String>(2)?),
+                    timestamp: row.get(3)?,
+                    pinned: row.get::<_, i64>(4)? != 0,
+                    ocr_text: row.get(5)?,
+                    source_app_name: None,
+                    source_app_bundle_id: None,
+                })
             })
-        })
-        .map(|rows| rows.filter_map(|r| r.ok()).collect())
-        .unwrap_or_else(|e| {
-            error!(error = %e, "Failed to query clipboard history");
-            Vec::new()
-        });
+            .context("Failed to query clipboard history")?
+            .filter_map(|r| r.ok())
+            .collect::<Vec<_>>();
+        Ok(entries)
+    })
+    .unwrap_or_else(|e| {
+        error!(error = %e, "Failed to read clipboard history page");
+        Vec::new()
+    });
 
     debug!(
         count = entries.len(),
@@ -564,24 +574,11 @@ pub fn get_clipboard_history_page(limit: usize, offset: usize) -> Vec<ClipboardE
 /// Get total number of entries in clipboard history
 #[allow(dead_code)] // Used by downstream subtasks (UI)
 pub fn get_total_entry_count() -> usize {
-    let conn = match get_connection() {
-        Ok(c) => c,
-        Err(e) => {
-            error!(error = %e, "Failed to get database connection");
-            return 0;
-        }
-    };
-
-    let conn = match conn.lock() {
-        Ok(c) => c,
-        Err(e) => {
-            error!(error = %e, "Failed to lock database connection");
-            return 0;
-        }
-    };
-
-    conn.query_row("SELECT COUNT(*) FROM history", [], |row| {
-        row.get::<_, i64>(0)
+    with_read_conn("clipboard_entry_count", |conn| {
+        conn.query_row("SELECT COUNT(*) FROM history", [], |row| {
+            row.get::<_, i64>(0)
+        })
+        .context("Failed to count clipboard entries")
     })
     .map(|c| c as usize)
     .unwrap_or_else(|e| {
@@ -600,55 +597,39 @@ pub fn get_clipboard_history(limit: usize) -> Vec<ClipboardEntry> {
 /// This is memory-efficient for list views - doesn't load full content.
 /// Use `get_entry_content()` to fetch content when needed.
 pub fn get_clipboard_history_meta(limit: usize, offset: usize) -> Vec<ClipboardEntryMeta> {
-    let conn = match get_connection() {
-        Ok(c) => c,
-        Err(e) => {
-            error!(error = %e, "Failed to get database connection");
-            return Vec::new();
-        }
-    };
-
-    let conn = match conn.lock() {
-        Ok(c) => c,
-        Err(e) => {
-            error!(error = %e, "Failed to lock database connection");
-            return Vec::new();
-        }
-    };
-
-    // Query only metadata columns - NO content column
-    let mut stmt = match conn.prepare(
-        "SELECT id, content_type, timestamp, pinned, text_preview, image_width, image_height, byte_size, ocr_text
-         FROM history
-         ORDER BY pinned DESC, timestamp DESC
-         LIMIT ? OFFSET ?",
-    ) {
-        Ok(s) => s,
-        Err(e) => {
-            error!(error = %e, "Failed to prepare metadata query");
-            return Vec::new();
-        }
-    };
-
-    let entries = stmt
-        .query_map(params![limit as i64, offset as i64], |row| {
-            Ok(ClipboardEntryMeta {
-                id: row.get(0)?,
-                content_type: ContentType::from_str(&row.get::<_, String>(1)?),
-                timestamp: row.get(2)?,
-                pinned: row.get::<_, i64>(3)? != 0,
-                text_preview: row.get::<_, Option<String>>(4)?.unwrap_or_default(),
-                image_width: parse_optional_dimension(row.get::<_, Option<i64>>(5)?),
-                image_height: parse_optional_dimension(row.get::<_, Option<i64>>(6)?),
-                byte_size: row.get::<_, Option<i64>>(7)?.unwrap_or(0) as usize,
-                ocr_text: row.get(8)?,
+    let entries = with_read_conn("clipboard_history_meta", |conn| {
+        // Query only metadata columns - NO content column
+        let mut stmt = conn
+            .prepare(
+                "SELECT id, content_type, timestamp, pinned, text_preview, image_width, image_height, byte_size, ocr_text
+                 FROM history
+                 ORDER BY pinned DESC, timestamp DESC
+                 LIMIT ? OFFSET ?",
+            )
+            .context("Failed to prepare metadata query")?;
+        let entries = stmt
+            .query_map(params![limit as i64, offset as i64], |row| {
+                Ok(ClipboardEntryMeta {
+                    id: row.get(0)?,
+                    content_type: ContentType::from_str(&row.get::<_, String>(1)?),
+                    timestamp: row.get(2)?,
+                    pinned: row.get::<_, i64>(3)? != 0,
+                    text_preview: row.get::<_, Option<String>>(4)?.unwrap_or_default(),
+                    image_width: parse_optional_dimension(row.get::<_, Option<i64>>(5)?),
+                    image_height: parse_optional_dimension(row.get::<_, Option<i64>>(6)?),
+                    byte_size: row.get::<_, Option<i64>>(7)?.unwrap_or(0) as usize,
+                    ocr_text: row.get(8)?,
+                })
             })
-        })
-        .map(|rows| rows.filter_map(|r| r.ok()).collect())
-        .unwrap_or_else(|e| {
-            error!(error = %e, "Failed to query clipboard history metadata");
-            Vec::new()
-        });
+            .context("Failed to query clipboard history metadata")?
+            .filter_map(|r| r.ok())
+            .collect::<Vec<_>>();
+        Ok(entries)
+    })
+    .unwrap_or_else(|e| {
+        error!(error = %e, "Failed to read clipboard history metadata");
+        Vec::new()
+    });
 
     debug!(
         count = entries.len(),
@@ -686,14 +667,13 @@ pub fn search_root_clipboard_history_meta_direct(
 ///
 /// Returns None if entry doesn't exist.
 pub fn get_entry_content(id: &str) -> Option<String> {
-    let conn = get_connection().ok()?;
-    let conn = conn.lock().ok()?;
-
-    conn.query_row(
-        "SELECT content FROM history WHERE id = ?",
-        params![id],
-        |row| row.get(0),
-    )
+    with_read_conn("clipboard_entry_content", |conn| {
+        Ok(conn.query_row(
+            "SELECT content FROM history WHERE id = ?",
+            params![id],
+            |row| row.get(0),
+        )?)
+    })
     .ok()
 }
 
@@ -716,6 +696,8 @@ pub fn pin_entry(id: &str) -> Result<()> {
 
     // Incremental cache update instead of full refresh
     update_pin_status_in_cache(id, true);
+    // Pinned entries are brain docs; let the brain indexer resync them.
+    crate::brain::dirty::mark_source_dirty(crate::brain::dirty::IndexSource::Clipboard);
 
     Ok(())
 }
@@ -739,6 +721,8 @@ pub fn unpin_entry(id: &str) -> Result<()> {
 
     // Incremental cache update instead of full refresh
     update_pin_status_in_cache(id, false);
+    // Pinned entries are brain docs; let the brain indexer resync them.
+    crate::brain::dirty::mark_source_dirty(crate::brain::dirty::IndexSource::Clipboard);
 
     Ok(())
 }
@@ -750,14 +734,15 @@ pub fn remove_entry(id: &str) -> Result<()> {
     let conn = get_connection()?;
     let conn = conn.lock().map_err(db_lock_err)?;
 
-    // Get content first to check if it's a blob (for cleanup)
-    let content: Option<String> = conn
+    // Get content first to check if it's a blob (for cleanup), and whether
+    // the row is pinned (and therefore a brain doc)
+    let (content, pinned): (Option<String>, bool) = conn
         .query_row(
-            "SELECT content FROM history WHERE id = ?",
+            "SELECT content, pinned FROM history WHERE id = ?",
             params![id],
-            |row| row.get(0),
+            |row| Ok((Some(row.get(0)?), row.get(1)?)),
         )
-        .ok();
+        .unwrap_or((None, false));
 
     let affected = conn
         .execute("DELETE FROM history WHERE id = ?", params![id])
@@ -781,6 +766,11 @@ pub fn remove_entry(id: &str) -> Result<()> {
     evict_image_cache(id);
     // Incremental cache update instead of full refresh
     remove_entry_from_cache(id);
+    if pinned {
+        // Erase means forget: drop the pinned doc from the brain now rather
+        // than at the next reconcile.
+        crate::brain::dirty::mark_source_dirty(crate::brain::dirty::IndexSource::Clipboard);
+    }
 
     Ok(())
 }
@@ -821,6 +811,8 @@ pub fn clear_history() -> Result<()> {
     }
 
     clear_all_caches();
+    // Pinned entries are brain docs; forget them now, not at the next reconcile.
+    crate::brain::dirty::mark_source_dirty(crate::brain::dirty::IndexSource::Clipboard);
 
     Ok(())
 }
@@ -904,25 +896,24 @@ pub fn update_ocr_text(id: &str, text: &str) -> Result<()> {
 /// Get entry by ID
 #[allow(dead_code)] // Used by downstream subtasks (UI, OCR)
 pub fn get_entry_by_id(id: &str) -> Option<ClipboardEntry> {
-    let conn = get_connection().ok()?;
-    let conn = conn.lock().ok()?;
-
-    conn.query_row(
-        "SELECT id, content, content_type, timestamp, pinned, ocr_text FROM history WHERE id = ?",
-        params![id],
-        |row| {
-            Ok(ClipboardEntry {
-                id: row.get(0)?,
-                content: row.get(1)?,
-                content_type: ContentType::from_str(&row.get::<_, String>(2)?),
-                timestamp: row.get(3)?,
-                pinned: row.get::<_, i64>(4)? != 0,
-                ocr_text: row.get(5)?,
-                source_app_name: None,
-                source_app_bundle_id: None,
-            })
-        },
-    )
+    with_read_conn("clipboard_entry_by_id", |conn| {
+        Ok(conn.query_row(
+            "SELECT id, content, content_type, timestamp, pinned, ocr_text FROM history WHERE id = ?",
+            params![id],
+            |row| {
+                Ok(ClipboardEntry {
+                    id: row.get(0)?,
+                    content: row.get(1)?,
+                    content_type: ContentType::from_str(&row.get::<_, String>(2)?),
+                    timestamp: row.get(3)?,
+                    pinned: row.get::<_, i64>(4)? != 0,
+                    ocr_text: row.get(5)?,
+                    source_app_name: None,
+                    source_app_bundle_id: None,
+                })
+            },
+        )?)
+    })
     .ok()
 }
 
@@ -940,20 +931,20 @@ pub fn run_incremental_vacuum() -> Result<()> {
 
 /// Read sediment columns for a clipboard entry.
 pub fn get_entry_sediment_state(id: &str) -> Option<SedimentState> {
-    let conn = get_connection().ok()?;
-    let conn = conn.lock().ok()?;
-    conn.query_row(
-        "SELECT brain_kept, brain_tier, copy_count, kept_url_day FROM history WHERE id = ?1",
-        params![id],
-        |row| {
-            Ok(SedimentState {
-                brain_kept: row.get::<_, i64>(0)? != 0,
-                brain_tier: row.get(1)?,
-                copy_count: row.get(2)?,
-                kept_url_day: row.get(3)?,
-            })
-        },
-    )
+    with_read_conn("clipboard_sediment_state", |conn| {
+        Ok(conn.query_row(
+            "SELECT brain_kept, brain_tier, copy_count, kept_url_day FROM history WHERE id = ?1",
+            params![id],
+            |row| {
+                Ok(SedimentState {
+                    brain_kept: row.get::<_, i64>(0)? != 0,
+                    brain_tier: row.get(1)?,
+                    copy_count: row.get(2)?,
+                    kept_url_day: row.get(3)?,
+                })
+            },
+        )?)
+    })
     .ok()
 }
 
@@ -1009,9 +1000,9 @@ pub(crate) fn get_test_db_path() -> Option<PathBuf> {
 #[cfg(test)]
 pub fn init_test_clipboard_db(path: &std::path::Path) -> Result<()> {
     set_test_db_path(Some(path.to_path_buf()));
-    let conn = Arc::new(Mutex::new(open_and_init_connection(&path.to_path_buf())?));
-    if let Ok(mut guard) = TEST_DB_CONNECTION.lock() {
-        *guard = Some(conn);
+    let pool = Arc::new(open_pool(&path.to_path_buf())?);
+    if let Ok(mut guard) = TEST_DB_POOL.lock() {
+        *guard = Some(pool);
     }
     Ok(())
 }
@@ -1033,7 +1024,7 @@ mod tests {
 
     fn reset_test_db() {
         set_test_db_path(None);
-        if let Ok(mut guard) = TEST_DB_CONNECTION.lock() {
+        if let Ok(mut guard) = TEST_DB_POOL.lock() {
             *guard = None;
         }
     }
@@ -252,6 +252,12 @@ fn db_worker_loop(conn: Connection, rx: Receiver<DbRequest>) {
     info!("DB worker loop ended");
 }
 
+/// Pinned entries are brain docs, so pin changes and deletions that can
+/// reach pinned rows resync the brain's clipboard source.
+fn mark_brain_clipboard_dirty() {
+    crate::brain::dirty::mark_source_dirty(crate::brain::dirty::IndexSource::Clipboard);
+}
+
 fn handle_request(conn: &Connection, req: DbRequest) -> bool {
     match req {
         DbRequest::AddOrTouch {
@@ -312,22 +318,38 @@ fn handle_request(conn: &Connection, req: DbRequest) -> bool {
             }
         }
         DbRequest::Pin { id, reply } => {
-            if reply.send(pin_impl(conn, &id)).is_err() {
+            let result = pin_impl(conn, &id);
+            if result.is_ok() {
+                mark_brain_clipboard_dirty();
+            }
+            if reply.send(result).is_err() {
                 warn!("DbRequest::Pin reply dropped");
             }
         }
         DbRequest::Unpin { id, reply } => {
-            if reply.send(unpin_impl(conn, &id)).is_err() {
+            let result = unpin_impl(conn, &id);
+            if result.is_ok() {
+                mark_brain_clipboard_dirty();
+            }
+            if reply.send(result).is_err() {
                 warn!("DbRequest::Unpin reply dropped");
             }
         }
         DbRequest::Remove { id, reply } => {
-            if reply.send(remove_impl(conn, &id)).is_err() {
+            let result = remove_impl(conn, &id);
+            if result.is_ok() {
+                mark_brain_clipboard_dirty();
+            }
+            if reply.send(result).is_err() {
                 warn!("DbRequest::Remove reply dropped");
             }
         }
         DbRequest::Clear { reply } => {
-            if reply.send(clear_impl(conn)).is_err() {
+            let result = clear_impl(conn);
+            if result.is_ok() {
+                mark_brain_clipboard_dirty();
+            }
+            if reply.send(result).is_err() {
                 warn!("DbRequest::Clear reply dropped");
             }
         }
@@ -340,7 +362,11 @@ fn handle_request(conn: &Connection, req: DbRequest) -> bool {
             }
         }
         DbRequest::TrimOversized { max_len, reply } => {
-            if reply.send(trim_oversized_impl(conn, max_len)).is_err() {
+            let result = trim_oversized_impl(conn, max_len);
+            if matches!(result, Ok(deleted) if deleted > 0) {
+                mark_brain_clipboard_dirty();
+            }
+            if reply.send(result).is_err() {
                 warn!("DbRequest::TrimOversized reply dropped");
             }
         }
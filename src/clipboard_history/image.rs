@@ -10,10 +10,17 @@ use smallvec::smallvec;
 use std::sync::Arc;
 use tracing::{debug, warn};
 
-use super::blob_store::{is_blob_content, load_blob, store_blob};
+use super::blob_store::{
+    is_blob_content, load_blob, load_thumbnail_blob, store_blob, store_thumbnail_blob,
+};
 
 const MAX_RENDER_IMAGE_PIXELS: u64 = 20_000_000;
 
+/// Longest edge, in pixels, of clipboard history list thumbnails. Rows show
+/// images as small icons; 96px stays sharp at 2x scale while decoding to
+/// ~36KB instead of tens of megabytes for a full-resolution screenshot.
+pub const THUMBNAIL_MAX_EDGE: u32 = 96;
+
 /// Encode image data as a blob file (PNG stored on disk)
 ///
 /// Format: "blob:{hash}" where hash is SHA-256 of PNG bytes
@@ -323,6 +330,72 @@ fn decode_rgba_to_render_image(content: &str) -> Option<Arc<RenderImage>> {
     Some(Arc::new(render_image))
 }
 
+/// Decode a downscaled thumbnail of a clipboard image to GPUI RenderImage
+///
+/// For blob content the thumbnail PNG is generated once and stored next to
+/// the blob (see `blob_store`), so later calls only decode a tiny PNG. Inline
+/// `png:`/`rgba:` entries are downscaled in memory on every call.
+///
+/// This is what list rows should display; full-resolution decoding via
+/// [`decode_to_render_image`] is reserved for the preview panel.
+pub fn decode_to_thumbnail_render_image(content: &str) -> Option<Arc<RenderImage>> {
+    let thumbnail_png = thumbnail_png_bytes(content)?;
+    decode_png_bytes_to_render_image_with_format(&thumbnail_png, "thumbnail")
+}
+
+fn thumbnail_png_bytes(content: &str) -> Option<Vec<u8>> {
+    if !is_blob_content(content) {
+        let png_bytes = content_to_png_bytes(content)?;
+        return render_thumbnail_png(&png_bytes, "inline");
+    }
+
+    if let Some(stored) = load_thumbnail_blob(content) {
+        return Some(stored);
+    }
+
+    let png_bytes = load_blob(content)?;
+    let thumbnail_png = render_thumbnail_png(&png_bytes, "blob")?;
+    if let Err(e) = store_thumbnail_blob(content, &thumbnail_png) {
+        // Still usable for this session; it is regenerated on the next miss.
+        warn!(error = %e, "Failed to persist clipboard thumbnail");
+    }
+    Some(thumbnail_png)
+}
+
+/// Downscale PNG bytes so the longest edge is at most [`THUMBNAIL_MAX_EDGE`]
+/// (aspect ratio preserved, never upscaled) and re-encode as PNG.
+fn render_thumbnail_png(png: &[u8], format: &'static str) -> Option<Vec<u8>> {
+    use std::io::Cursor;
+
+    let (width, height) = png_dims_from_bytes(png)?;
+    ensure_dimensions_within_limit(width, height, format)?;
+
+    let img = image::load_from_memory_with_format(png, image::ImageFormat::Png).ok()?;
+    let thumbnail = if width.max(height) > THUMBNAIL_MAX_EDGE {
+        img.thumbnail(THUMBNAIL_MAX_EDGE, THUMBNAIL_MAX_EDGE)
+    } else {
+        img
+    };
+
+    let mut thumbnail_png = Vec::new();
+    thumbnail
+        .write_to(
+            &mut Cursor::new(&mut thumbnail_png),
+            image::ImageFormat::Png,
+        )
+        .ok()?;
+
+    debug!(
+        width,
+        height,
+        thumb_width = thumbnail.width(),
+        thumb_height = thumbnail.height(),
+        format,
+        "Generated clipboard image thumbnail"
+    );
+    Some(thumbnail_png)
+}
+
 /// Get image dimensions from content string without fully decoding
 ///
 /// Returns (width, height) if the content is a valid image format.
@@ -723,6 +796,35 @@ mod tests {
         !crc
     }
 
+    #[test]
+    fn test_render_thumbnail_png_caps_longest_edge_and_keeps_aspect() {
+        let original = arboard::ImageData {
+            width: 400,
+            height: 200,
+            bytes: vec![128; 400 * 200 * 4].into(),
+        };
+        let png_bytes = encode_image_to_png_bytes(&original).expect("Should encode PNG bytes");
+
+        let thumbnail = render_thumbnail_png(&png_bytes, "test").expect("Should downscale");
+        assert_eq!(
+            png_dims_from_bytes(&thumbnail),
+            Some((THUMBNAIL_MAX_EDGE, THUMBNAIL_MAX_EDGE / 2))
+        );
+    }
+
+    #[test]
+    fn test_render_thumbnail_png_does_not_upscale_small_images() {
+        let original = arboard::ImageData {
+            width: 10,
+            height: 20,
+            bytes: vec![64; 10 * 20 * 4].into(),
+        };
+        let png_bytes = encode_image_to_png_bytes(&original).expect("Should encode PNG bytes");
+
+        let thumbnail = render_thumbnail_png(&png_bytes, "test").expect("Should re-encode");
+        assert_eq!(png_dims_from_bytes(&thumbnail), Some((10, 20)));
+    }
+
     #[test]
     fn test_decode_to_render_image_rejects_png_above_pixel_limit() {
         let original = arboard::ImageData {
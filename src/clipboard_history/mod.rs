@@ -70,7 +70,9 @@ pub use config::{
 // Cache
 #[allow(unused_imports)]
 pub use cache::{
-    cache_image, get_cached_entries, get_cached_image, search_root_clipboard_history_meta_cached,
+    begin_full_image_load, cache_image, cache_thumbnail, get_cached_entries, get_cached_image,
+    get_cached_thumbnail, get_entry_cache, load_full_image,
+    root_clipboard_history_index_generation,
 };
 
 // Database operations
@@ -86,7 +88,8 @@ pub use database::{
 // Image operations
 #[allow(unused_imports)]
 pub use image::{
-    content_to_png_bytes, decode_to_render_image, decode_to_rgba_bytes, encode_image_as_png,
+    content_to_png_bytes, decode_to_render_image, decode_to_rgba_bytes,
+    decode_to_thumbnail_render_image, encode_image_as_png,
 };
 #[allow(unused_imports)]
 pub use quick_look::quick_look_entry;
@@ -12,7 +12,8 @@ use tracing::{debug, error, info, warn};
 use uuid::Uuid;
 
 use super::cache::{
-    cache_image, get_cached_entries, get_cached_image, init_cache_timestamp, refresh_entry_cache,
+    cache_thumbnail, get_cached_entries, get_cached_thumbnail, init_cache_timestamp,
+    refresh_entry_cache,
 };
 use super::change_detection::ClipboardChangeDetector;
 use super::config::{get_max_text_content_len, get_retention_days, is_text_over_limit};
@@ -20,7 +21,7 @@ use super::database::{
     add_entry, get_connection, get_entry_content, prune_old_entries, run_incremental_vacuum,
     run_wal_checkpoint, trim_oversize_text_entries,
 };
-use super::image::{compute_image_hash, decode_to_render_image, encode_image_as_blob};
+use super::image::{compute_image_hash, decode_to_thumbnail_render_image, encode_image_as_blob};
 use super::ocr;
 use super::rejection::{
     evaluate_text_capture_rejection, record_rejection, reject_before_reading_payload,
@@ -111,9 +112,9 @@ pub fn init_clipboard_history() -> Result<()> {
     // Pre-warm the entry cache from database
     refresh_entry_cache();
 
-    // Pre-decode images in a background thread
+    // Pre-decode list thumbnails in a background thread
     thread::spawn(|| {
-        prewarm_image_cache();
+        prewarm_thumbnail_cache();
     });
 
     // Initialize the stop flag (AtomicBool for lock-free polling)
@@ -348,10 +349,12 @@ fn capture_clipboard_content(
                         Ok(entry_id) => {
                             let _ = ocr::enqueue_ocr(entry_id.clone(), blob_key.clone());
 
-                            // Pre-decode the image immediately so it's ready for display
-                            if let Some(render_image) = decode_to_render_image(&blob_key) {
-                                cache_image(&entry_id, render_image);
-                                debug!(entry_id = %entry_id, "Pre-cached new image during monitoring");
+                            // Generate (and persist) the list thumbnail now so the new
+                            // row never decodes the full image; the preview decodes
+                            // full resolution lazily.
+                            if let Some(thumbnail) = decode_to_thumbnail_render_image(&blob_key) {
+                                cache_thumbnail(&entry_id, thumbnail);
+                                debug!(entry_id = %entry_id, "Pre-cached new image thumbnail during monitoring");
                             }
 
                             *last_image_state = Some(LastImageState::with_blob_key(hash, blob_key));
@@ -517,32 +520,33 @@ fn background_prune_loop(stop_flag: Arc<AtomicBool>) {
     }
 }
 
-/// Pre-warm the image cache by decoding cached image entries
+/// Pre-warm the thumbnail cache for recent image entries
 ///
-/// This fetches content on-demand for each image entry to avoid
-/// keeping all image payloads in memory during normal list views.
-fn prewarm_image_cache() {
+/// Only thumbnails are decoded here: stored thumbnails are tiny PNGs, and a
+/// missing one is generated once from the blob and persisted. Content is
+/// fetched on-demand per entry to avoid keeping image payloads in memory.
+fn prewarm_thumbnail_cache() {
     let entries = get_cached_entries(100);
     let mut decoded_count = 0;
 
     for entry in entries {
         if entry.content_type == ContentType::Image {
             // Skip if already cached
-            if get_cached_image(&entry.id).is_some() {
+            if get_cached_thumbnail(&entry.id).is_some() {
                 continue;
             }
 
             // Fetch content on-demand and decode
             if let Some(content) = get_entry_content(&entry.id) {
-                if let Some(render_image) = decode_to_render_image(&content) {
-                    cache_image(&entry.id, render_image);
+                if let Some(thumbnail) = decode_to_thumbnail_render_image(&content) {
+                    cache_thumbnail(&entry.id, thumbnail);
                     decoded_count += 1;
                 }
             }
         }
     }
 
-    info!(decoded_count, "Pre-warmed image cache");
+    info!(decoded_count, "Pre-warmed thumbnail cache");
 }
 
 #[cfg(test)]
@@ -1700,6 +1700,8 @@ fn test_process_limits_serialization_camel_case() {
         max_memory_mb: Some(512),
         max_runtime_seconds: Some(300),
         health_check_interval_ms: 3000,
+        warm_pool_size: None,
+        warm_pool_idle_seconds: None,
     };
 
     let json = serde_json::to_string(&limits).unwrap();
@@ -1767,6 +1769,34 @@ fn test_process_limits_serialization_skips_none() {
     assert!(!json.contains("maxRuntimeSeconds"));
     // But healthCheckIntervalMs always appears (has value)
     assert!(json.contains("healthCheckIntervalMs"));
+    assert!(!json.contains("warmPoolSize"));
+}
+
+#[test]
+fn test_process_limits_warm_pool_settings() {
+    let defaults = ProcessLimits::default();
+    assert_eq!(defaults.warm_pool_size(), 1);
+    assert_eq!(
+        defaults.warm_pool_idle_timeout(),
+        std::time::Duration::from_secs(600)
+    );
+
+    let json = r#"{"warmPoolSize": 0, "warmPoolIdleSeconds": 30}"#;
+    let limits: ProcessLimits = serde_json::from_str(json).unwrap();
+    assert_eq!(limits.warm_pool_size(), 0);
+    assert_eq!(
+        limits.warm_pool_idle_timeout(),
+        std::time::Duration::from_secs(30)
+    );
+
+    // Oversized pools are capped; a zero timeout falls back to the default.
+    let json = r#"{"warmPoolSize": 64, "warmPoolIdleSeconds": 0}"#;
+    let limits: ProcessLimits = serde_json::from_str(json).unwrap();
+    assert_eq!(limits.warm_pool_size(), 4);
+    assert_eq!(
+        limits.warm_pool_idle_timeout(),
+        std::time::Duration::from_secs(600)
+    );
 }
 
 // --- merged from part_04.rs ---
@@ -1788,6 +1818,8 @@ fn test_config_with_process_limits() {
             max_memory_mb: Some(512),
             max_runtime_seconds: Some(300),
             health_check_interval_ms: 3000,
+            warm_pool_size: None,
+            warm_pool_idle_seconds: None,
         }),
         clipboard_history_max_text_length: None,
         clipboard_history_secret_rejection: None,
@@ -1850,6 +1882,8 @@ fn test_config_get_process_limits_uses_default_interval_when_zero() {
             max_memory_mb: Some(1024),
             max_runtime_seconds: Some(60),
             health_check_interval_ms: 0,
+            warm_pool_size: None,
+            warm_pool_idle_seconds: None,
         }),
         ..Config::default()
     };
@@ -1982,6 +2016,8 @@ fn test_process_limits_roundtrip() {
         max_memory_mb: Some(256),
         max_runtime_seconds: Some(120),
         health_check_interval_ms: 10000,
+        warm_pool_size: None,
+        warm_pool_idle_seconds: None,
     };
 
     let json = serde_json::to_string(&original).unwrap();
@@ -2001,6 +2037,8 @@ fn test_process_limits_clone() {
         max_memory_mb: Some(512),
         max_runtime_seconds: Some(300),
         health_check_interval_ms: 5000,
+        warm_pool_size: None,
+        warm_pool_idle_seconds: None,
     };
     let cloned = original.clone();
 
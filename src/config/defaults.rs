@@ -86,6 +86,9 @@ pub const DEFAULT_CLIPBOARD_HISTORY_MAX_TEXT_LENGTH: usize = 100_000;
 
 /// Default process limits
 pub const DEFAULT_HEALTH_CHECK_INTERVAL_MS: u64 = 5000;
+pub const DEFAULT_WARM_RUNTIME_POOL_SIZE: usize = 1;
+pub const MAX_WARM_RUNTIME_POOL_SIZE: usize = 4;
+pub const DEFAULT_WARM_RUNTIME_IDLE_SECONDS: u64 = 600;
 
 /// Default watcher tuning values
 pub const DEFAULT_WATCHER_DEBOUNCE_MS: u64 = 500;
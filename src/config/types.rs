@@ -672,6 +672,13 @@ pub struct ProcessLimits {
     /// Health check interval in milliseconds (default: 5000)
     #[serde(default = "default_health_check_interval_ms")]
     pub health_check_interval_ms: u64,
+    /// Number of pre-warmed bun workers kept ready for script launches
+    /// (None = default of 1, 0 = disabled)
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub warm_pool_size: Option<usize>,
+    /// Seconds an unused warm worker stays alive before exiting (None = default)
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub warm_pool_idle_seconds: Option<u64>,
 }
 
 fn default_health_check_interval_ms() -> u64 {
@@ -684,10 +691,30 @@ impl Default for ProcessLimits {
             max_memory_mb: None,
             max_runtime_seconds: None,
             health_check_interval_ms: DEFAULT_HEALTH_CHECK_INTERVAL_MS,
+            warm_pool_size: None,
+            warm_pool_idle_seconds: None,
         }
     }
 }
 
+impl ProcessLimits {
+    /// Warm runtime pool size, capped at [`MAX_WARM_RUNTIME_POOL_SIZE`].
+    pub fn warm_pool_size(&self) -> usize {
+        self.warm_pool_size
+            .unwrap_or(DEFAULT_WARM_RUNTIME_POOL_SIZE)
+            .min(MAX_WARM_RUNTIME_POOL_SIZE)
+    }
+
+    /// How long a parked warm worker waits for a script before exiting.
+    pub fn warm_pool_idle_timeout(&self) -> std::time::Duration {
+        let seconds = self
+            .warm_pool_idle_seconds
+            .filter(|seconds| *seconds > 0)
+            .unwrap_or(DEFAULT_WARM_RUNTIME_IDLE_SECONDS);
+        std::time::Duration::from_secs(seconds)
+    }
+}
+
 // ============================================
 // SUGGESTED CONFIG
 // ============================================
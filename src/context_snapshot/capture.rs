@@ -18,6 +18,12 @@ pub fn enable_deterministic_context_capture() {
     DETERMINISTIC_CONTEXT.store(true, Ordering::SeqCst);
 }
 
+/// Whether live providers are disabled for this process (see
+/// `enable_deterministic_context_capture`).
+pub(super) fn deterministic_context_capture_enabled() -> bool {
+    DETERMINISTIC_CONTEXT.load(Ordering::SeqCst)
+}
+
 #[cfg(target_os = "macos")]
 fn summarize_menu_item(item: &crate::menu_bar::MenuBarItem) -> MenuBarItemSummary {
     MenuBarItemSummary {
@@ -318,6 +324,67 @@ fn capture_script_kit_panel_image_live() -> Result<Option<Base64PngContext>, Str
     }
 }
 
+/// Run the live providers for the sections `options` asks for.
+pub(super) fn capture_live_seed(options: &CaptureContextOptions) -> CaptureContextSeed {
+    // When both focused_window and screenshot are requested, capture once
+    // and split metadata from image bytes to avoid a double capture.
+    let (focused_window, focused_window_image) =
+        if options.include_focused_window || options.include_screenshot {
+            match capture_focused_window_with_image_live(options.include_screenshot) {
+                Ok((window, image)) => (Ok(window), Ok(image)),
+                Err(error) => {
+                    let err_str = error.to_string();
+                    (
+                        if options.include_focused_window {
+                            Err(err_str.clone())
+                        } else {
+                            Ok(None)
+                        },
+                        if options.include_screenshot {
+                            Err(err_str)
+                        } else {
+                            Ok(None)
+                        },
+                    )
+                }
+            }
+        } else {
+            (Ok(None), Ok(None))
+        };
+
+    let script_kit_panel_image = if options.include_panel_screenshot {
+        capture_script_kit_panel_image_live()
+    } else {
+        Ok(None)
+    };
+
+    CaptureContextSeed {
+        selected_text: if options.include_selected_text {
+            capture_selected_text_live()
+        } else {
+            Ok(None)
+        },
+        frontmost_app: if options.include_frontmost_app {
+            capture_frontmost_app_live()
+        } else {
+            Ok(None)
+        },
+        menu_bar_items: if options.include_menu_bar {
+            capture_menu_bar_live()
+        } else {
+            Ok(Vec::new())
+        },
+        browser: if options.include_browser_url {
+            capture_browser_live()
+        } else {
+            Ok(None)
+        },
+        focused_window,
+        focused_window_image,
+        script_kit_panel_image,
+    }
+}
+
 /// Capture a deterministic snapshot of AI-relevant desktop context.
 ///
 /// Individual providers that fail produce a warning string rather than
@@ -327,63 +394,7 @@ pub fn capture_context_snapshot(options: &CaptureContextOptions) -> AiContextSna
         tracing::info!("context_snapshot: using deterministic seed (test mode)");
         CaptureContextSeed::default()
     } else {
-        // When both focused_window and screenshot are requested, capture once
-        // and split metadata from image bytes to avoid a double capture.
-        let (focused_window, focused_window_image) =
-            if options.include_focused_window || options.include_screenshot {
-                match capture_focused_window_with_image_live(options.include_screenshot) {
-                    Ok((window, image)) => (Ok(window), Ok(image)),
-                    Err(error) => {
-                        let err_str = error.to_string();
-                        (
-                            if options.include_focused_window {
-                                Err(err_str.clone())
-                            } else {
-                                Ok(None)
-                            },
-                            if options.include_screenshot {
-                                Err(err_str)
-                            } else {
-                                Ok(None)
-                            },
-                        )
-                    }
-                }
-            } else {
-                (Ok(None), Ok(None))
-            };
-
-        let script_kit_panel_image = if options.include_panel_screenshot {
-            capture_script_kit_panel_image_live()
-        } else {
-            Ok(None)
-        };
-
-        CaptureContextSeed {
-            selected_text: if options.include_selected_text {
-                capture_selected_text_live()
-            } else {
-                Ok(None)
-            },
-            frontmost_app: if options.include_frontmost_app {
-                capture_frontmost_app_live()
-            } else {
-                Ok(None)
-            },
-            menu_bar_items: if options.include_menu_bar {
-                capture_menu_bar_live()
-            } else {
-                Ok(Vec::new())
-            },
-            browser: if options.include_browser_url {
-                capture_browser_live()
-            } else {
-                Ok(None)
-            },
-            focused_window,
-            focused_window_image,
-            script_kit_panel_image,
-        }
+        capture_live_seed(options)
     };
 
     let snapshot = capture_context_snapshot_from_seed(options, seed);
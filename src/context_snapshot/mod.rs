@@ -3,10 +3,12 @@
 //! Gathers selected text, frontmost app, menu bar, browser URL, and focused
 //! window metadata into a single schema-versioned `AiContextSnapshot`.
 //! Individual providers that fail produce warning strings rather than
-//! failing the entire snapshot.
+//! failing the entire snapshot. Launcher opens prefetch the cheap providers so
+//! agent handoff can reuse them (see `prefetch`).
 
 mod capture;
 mod inspection;
+mod prefetch;
 mod types;
 
 #[allow(unused_imports)] // Used via lib crate; binary only needs capture_context_snapshot_json
@@ -17,6 +19,11 @@ pub use capture::{
 pub use inspection::{
     build_inspection_hud_message, build_inspection_receipt, ContextSnapshotInspectionReceipt,
 };
+#[allow(unused_imports)] // Used by the launcher and agent handoff in the binary
+pub use prefetch::{
+    capture_context_snapshot_prefetched, prefetch_context_on_launcher_open,
+    upgrade_context_prefetch,
+};
 #[allow(unused_imports)] // Public API surface for lib consumers and MCP
 pub use types::{
     AiContextSnapshot, Base64PngContext, BrowserContext, CaptureContextOptions,
@@ -0,0 +1,479 @@
+//! Speculative context capture while the launcher is open.
+//!
+//! Agent handoff used to run every provider (selected text, frontmost app,
+//! menu bar, browser URL, focused window) synchronously after the user had
+//! already committed to an AI route. Instead:
+//!
+//! - opening the launcher starts the cheap providers in parallel and keeps
+//!   their results in a short-lived seed cache. The menu bar is one of them:
+//!   it is read from the frontmost-app tracker's cache;
+//! - once the query looks like an AI prompt, the browser URL is added to the
+//!   same cache. It runs AppleScript against the browser, which can raise
+//!   the macOS Automation permission prompt, so a plain launcher open never
+//!   triggers it (no screenshots either: the Tab AI submit profile never
+//!   asks for pixels, so speculative captures don't);
+//! - handoff builds its snapshot from the cached seed and only runs providers
+//!   live for sections that are missing, failed, or stale.
+//!
+//! Speculative selected text is read through Accessibility only: a launcher
+//! open may never post Cmd+C. An empty AX read is therefore not trusted and
+//! handoff still runs the full selected-text provider.
+
+use super::capture::{
+    capture_context_snapshot, capture_context_snapshot_from_seed, capture_live_seed,
+    deterministic_context_capture_enabled, CaptureContextSeed,
+};
+use super::types::*;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Mutex, MutexGuard};
+use std::time::{Duration, Instant};
+
+/// How long a speculative capture may stand in for a live one.
+const PREFETCH_TTL: Duration = Duration::from_secs(20);
+
+const NO_SECTIONS: CaptureContextOptions = CaptureContextOptions {
+    include_selected_text: false,
+    include_frontmost_app: false,
+    include_menu_bar: false,
+    include_browser_url: false,
+    include_focused_window: false,
+    include_screenshot: false,
+    include_panel_screenshot: false,
+};
+
+/// Sections added once an AI route is likely: the one `tab_ai_submit()`
+/// section the cheap pass leaves out, because its AppleScript may prompt.
+/// Screenshots are never captured speculatively.
+const UPGRADE_SECTIONS: CaptureContextOptions = CaptureContextOptions {
+    include_browser_url: true,
+    ..NO_SECTIONS
+};
+
+/// Provider results captured ahead of a handoff.
+#[derive(Debug, Clone)]
+pub(crate) struct PrefetchedSeed {
+    pub(crate) seed: CaptureContextSeed,
+    /// Which seed sections hold a reusable result.
+    pub(crate) captured: CaptureContextOptions,
+    /// The app the capture describes; a different frontmost app voids it.
+    pub(crate) source_pid: Option<i32>,
+    pub(crate) captured_at: Instant,
+}
+
+impl PrefetchedSeed {
+    fn is_usable(&self, source_pid: Option<i32>, now: Instant) -> bool {
+        self.source_pid == source_pid
+            && now.saturating_duration_since(self.captured_at) <= PREFETCH_TTL
+    }
+}
+
+static PREFETCH: Mutex<Option<PrefetchedSeed>> = Mutex::new(None);
+/// Bumped per launcher open so late captures from an earlier open are dropped.
+static PREFETCH_GENERATION: AtomicU64 = AtomicU64::new(0);
+/// The generation whose expensive sections were already requested.
+static UPGRADED_GENERATION: AtomicU64 = AtomicU64::new(0);
+
+fn prefetch_cache() -> MutexGuard<'static, Option<PrefetchedSeed>> {
+    PREFETCH
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+fn current_source_pid() -> Option<i32> {
+    crate::frontmost_app_tracker::get_last_real_app().map(|app| app.pid)
+}
+
+/// Start the cheap providers for a fresh launcher open. Replaces whatever an
+/// earlier open left behind.
+pub fn prefetch_context_on_launcher_open() {
+    if deterministic_context_capture_enabled() {
+        return;
+    }
+    let generation = PREFETCH_GENERATION.fetch_add(1, Ordering::SeqCst) + 1;
+    *prefetch_cache() = None;
+    let source_pid = current_source_pid();
+    let spawned = std::thread::Builder::new()
+        .name("context-prefetch".to_string())
+        .spawn(move || {
+            let started = Instant::now();
+            let seed = capture_cheap_seed(source_pid);
+            let captured = captured_sections(&seed, &cheap_sections());
+            tracing::info!(
+                event = "context_prefetch_cheap_complete",
+                generation,
+                elapsed_ms = started.elapsed().as_millis() as u64,
+                has_selected_text = captured.include_selected_text,
+            );
+            store_prefetched(generation, source_pid, seed, captured);
+        });
+    if let Err(error) = spawned {
+        tracing::warn!(%error, "context_snapshot: failed to spawn context prefetch");
+    }
+}
+
+/// Add the expensive sections to the current launcher open's prefetch. Runs
+/// at most once per open.
+pub fn upgrade_context_prefetch() {
+    let generation = PREFETCH_GENERATION.load(Ordering::SeqCst);
+    if generation == 0 || UPGRADED_GENERATION.swap(generation, Ordering::SeqCst) == generation {
+        return;
+    }
+    let source_pid = current_source_pid();
+    let spawned = std::thread::Builder::new()
+        .name("context-prefetch-upgrade".to_string())
+        .spawn(move || {
+            let started = Instant::now();
+            let seed = capture_live_seed(&UPGRADE_SECTIONS);
+            let captured = captured_sections(&seed, &UPGRADE_SECTIONS);
+            tracing::info!(
+                event = "context_prefetch_upgrade_complete",
+                generation,
+                elapsed_ms = started.elapsed().as_millis() as u64,
+                has_browser_url = captured.include_browser_url,
+            );
+            store_prefetched(generation, source_pid, seed, captured);
+        });
+    if let Err(error) = spawned {
+        tracing::warn!(%error, "context_snapshot: failed to spawn context prefetch upgrade");
+    }
+}
+
+/// Like `capture_context_snapshot`, but sections the launcher already
+/// captured for the same frontmost app within the TTL are reused instead of
+/// captured again.
+pub fn capture_context_snapshot_prefetched(options: &CaptureContextOptions) -> AiContextSnapshot {
+    if deterministic_context_capture_enabled() {
+        return capture_context_snapshot(options);
+    }
+    let source_pid = current_source_pid();
+    let cached = prefetch_cache()
+        .as_ref()
+        .filter(|cached| cached.is_usable(source_pid, Instant::now()))
+        .cloned();
+    let seed = resolve_prefetched_seed(options, cached.as_ref(), capture_live_seed);
+    capture_context_snapshot_from_seed(options, seed)
+}
+
+/// Combine a prefetched seed with live captures for whatever it lacks.
+/// `capture_live` is only called when some requested section is missing.
+pub(crate) fn resolve_prefetched_seed(
+    options: &CaptureContextOptions,
+    cached: Option<&PrefetchedSeed>,
+    capture_live: impl FnOnce(&CaptureContextOptions) -> CaptureContextSeed,
+) -> CaptureContextSeed {
+    let reused = cached.map_or(NO_SECTIONS, |cached| {
+        combine_sections(options, &cached.captured, |wanted, have| wanted && have)
+    });
+    let missing = combine_sections(options, &reused, |wanted, have| wanted && !have);
+    tracing::info!(
+        event = "context_prefetch_resolved",
+        reused_any = reused != NO_SECTIONS,
+        live_any = missing != NO_SECTIONS,
+    );
+    let mut seed = if missing == NO_SECTIONS {
+        CaptureContextSeed::default()
+    } else {
+        capture_live(&missing)
+    };
+    if let Some(cached) = cached {
+        copy_sections(&mut seed, &reused, &cached.seed);
+    }
+    seed
+}
+
+fn cheap_sections() -> CaptureContextOptions {
+    CaptureContextOptions {
+        include_selected_text: true,
+        include_frontmost_app: true,
+        include_menu_bar: true,
+        include_focused_window: true,
+        ..NO_SECTIONS
+    }
+}
+
+/// Run the cheap providers side by side. The AX selection read and window
+/// metadata may each block on the frontmost app, so neither should wait on
+/// the other; the frontmost app and menu bar come from tracker caches.
+fn capture_cheap_seed(source_pid: Option<i32>) -> CaptureContextSeed {
+    std::thread::scope(|scope| {
+        let selected_text = scope.spawn(move || {
+            crate::platform::accessibility::focused_text::selected_text_for_app_ax_only(source_pid)
+                .map_err(|error| error.to_string())
+        });
+        let focused_window = scope.spawn(|| {
+            capture_live_seed(&CaptureContextOptions {
+                include_focused_window: true,
+                ..NO_SECTIONS
+            })
+            .focused_window
+        });
+        let tracked = capture_live_seed(&CaptureContextOptions {
+            include_frontmost_app: true,
+            include_menu_bar: true,
+            ..NO_SECTIONS
+        });
+
+        CaptureContextSeed {
+            selected_text: selected_text.join().unwrap_or_else(provider_panicked),
+            frontmost_app: tracked.frontmost_app,
+            menu_bar_items: tracked.menu_bar_items,
+            focused_window: focused_window.join().unwrap_or_else(provider_panicked),
+            ..Default::default()
+        }
+    })
+}
+
+fn provider_panicked<T>(_: Box<dyn std::any::Any + Send>) -> Result<T, String> {
+    Err("prefetch provider panicked".to_string())
+}
+
+/// Sections of `seed` worth reusing: requested and successful. An empty
+/// speculative selection is not trusted (see module docs).
+fn captured_sections(
+    seed: &CaptureContextSeed,
+    requested: &CaptureContextOptions,
+) -> CaptureContextOptions {
+    CaptureContextOptions {
+        include_selected_text: requested.include_selected_text
+            && matches!(seed.selected_text, Ok(Some(_))),
+        include_frontmost_app: requested.include_frontmost_app && seed.frontmost_app.is_ok(),
+        include_menu_bar: requested.include_menu_bar && seed.menu_bar_items.is_ok(),
+        include_browser_url: requested.include_browser_url && seed.browser.is_ok(),
+        include_focused_window: requested.include_focused_window && seed.focused_window.is_ok(),
+        include_screenshot: requested.include_screenshot
+            && matches!(seed.focused_window_image, Ok(Some(_))),
+        include_panel_screenshot: requested.include_panel_screenshot
+            && matches!(seed.script_kit_panel_image, Ok(Some(_))),
+    }
+}
+
+fn store_prefetched(
+    generation: u64,
+    source_pid: Option<i32>,
+    seed: CaptureContextSeed,
+    captured: CaptureContextOptions,
+) {
+    if PREFETCH_GENERATION.load(Ordering::SeqCst) != generation {
+        return;
+    }
+    let mut cache = prefetch_cache();
+    let entry = cache.get_or_insert_with(|| PrefetchedSeed {
+        seed: CaptureContextSeed::default(),
+        captured: NO_SECTIONS,
+        source_pid,
+        captured_at: Instant::now(),
+    });
+    // Whichever capture landed first keeps its sections; both are valid.
+    let added = combine_sections(&captured, &entry.captured, |new, have| new && !have);
+    copy_sections(&mut entry.seed, &added, &seed);
+    entry.captured = combine_sections(&entry.captured, &added, |have, new| have || new);
+}
+
+fn combine_sections(
+    a: &CaptureContextOptions,
+    b: &CaptureContextOptions,
+    op: impl Fn(bool, bool) -> bool,
+) -> CaptureContextOptions {
+    CaptureContextOptions {
+        include_selected_text: op(a.include_selected_text, b.include_selected_text),
+        include_frontmost_app: op(a.include_frontmost_app, b.include_frontmost_app),
+        include_menu_bar: op(a.include_menu_bar, b.include_menu_bar),
+        include_browser_url: op(a.include_browser_url, b.include_browser_url),
+        include_focused_window: op(a.include_focused_window, b.include_focused_window),
+        include_screenshot: op(a.include_screenshot, b.include_screenshot),
+        include_panel_screenshot: op(a.include_panel_screenshot, b.include_panel_screenshot),
+    }
+}
+
+fn copy_sections(
+    target: &mut CaptureContextSeed,
+    sections: &CaptureContextOptions,
+    source: &CaptureContextSeed,
+) {
+    if sections.include_selected_text {
+        target.selected_text = source.selected_text.clone();
+    }
+    if sections.include_frontmost_app {
+        target.frontmost_app = source.frontmost_app.clone();
+    }
+    if sections.include_menu_bar {
+        target.menu_bar_items = source.menu_bar_items.clone();
+    }
+    if sections.include_browser_url {
+        target.browser = source.browser.clone();
+    }
+    if sections.include_focused_window {
+        target.focused_window = source.focused_window.clone();
+    }
+    if sections.include_screenshot {
+        target.focused_window_image = source.focused_window_image.clone();
+    }
+    if sections.include_panel_screenshot {
+        target.script_kit_panel_image = source.script_kit_panel_image.clone();
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn prefetched(seed: CaptureContextSeed, captured: CaptureContextOptions) -> PrefetchedSeed {
+        PrefetchedSeed {
+            seed,
+            captured,
+            source_pid: Some(42),
+            captured_at: Instant::now(),
+        }
+    }
+
+    fn cheap_seed() -> CaptureContextSeed {
+        CaptureContextSeed {
+            selected_text: Ok(Some("let x = 42;".to_string())),
+            frontmost_app: Ok(Some(FrontmostAppContext {
+                pid: 42,
+                bundle_id: "com.microsoft.VSCode".to_string(),
+                name: "Code".to_string(),
+            })),
+            menu_bar_items: Ok(vec![MenuBarItemSummary {
+                title: "File".to_string(),
+                enabled: true,
+                shortcut: None,
+                children: Vec::new(),
+            }]),
+            focused_window: Ok(Some(FocusedWindowContext {
+                title: "VS Code - main.rs".to_string(),
+                width: 0,
+                height: 0,
+                used_fallback: false,
+            })),
+            ..Default::default()
+        }
+    }
+
+    #[test]
+    fn cheap_prefetch_leaves_only_browser_url_for_tab_ai_submit() {
+        let seed = cheap_seed();
+        let cached = prefetched(seed.clone(), captured_sections(&seed, &cheap_sections()));
+        let mut live_requests = Vec::new();
+
+        let resolved = resolve_prefetched_seed(
+            &CaptureContextOptions::tab_ai_submit(),
+            Some(&cached),
+            |missing| {
+                live_requests.push(missing.clone());
+                CaptureContextSeed {
+                    browser: Ok(Some(BrowserContext::from_url(
+                        "https://example.com/docs".to_string(),
+                    ))),
+                    ..Default::default()
+                }
+            },
+        );
+
+        assert_eq!(
+            live_requests,
+            vec![CaptureContextOptions {
+                include_browser_url: true,
+                ..NO_SECTIONS
+            }]
+        );
+        let snapshot =
+            capture_context_snapshot_from_seed(&CaptureContextOptions::tab_ai_submit(), resolved);
+        assert_eq!(snapshot.selected_text.as_deref(), Some("let x = 42;"));
+        assert_eq!(snapshot.frontmost_app.expect("frontmost app").pid, 42);
+        assert_eq!(snapshot.menu_bar_items.len(), 1);
+        assert!(snapshot.browser.is_some());
+        assert!(snapshot.warnings.is_empty());
+    }
+
+    #[test]
+    fn speculative_sections_never_capture_pixels() {
+        let speculative = combine_sections(&cheap_sections(), &UPGRADE_SECTIONS, |a, b| a || b);
+        assert!(!speculative.include_screenshot);
+        assert!(!speculative.include_panel_screenshot);
+    }
+
+    #[test]
+    fn launcher_open_never_runs_browser_applescript() {
+        assert!(!cheap_sections().include_browser_url);
+        assert!(UPGRADE_SECTIONS.include_browser_url);
+        assert!(cheap_sections().include_menu_bar);
+    }
+
+    #[test]
+    fn upgraded_prefetch_needs_no_live_capture() {
+        let mut seed = cheap_seed();
+        seed.browser = Ok(None);
+        let all_cheap_and_upgrade =
+            combine_sections(&cheap_sections(), &UPGRADE_SECTIONS, |a, b| a || b);
+        let cached = prefetched(
+            seed.clone(),
+            captured_sections(&seed, &all_cheap_and_upgrade),
+        );
+
+        let resolved = resolve_prefetched_seed(
+            &CaptureContextOptions::tab_ai_submit(),
+            Some(&cached),
+            |_| panic!("every tab_ai_submit section was prefetched"),
+        );
+        assert_eq!(resolved.selected_text, seed.selected_text);
+        assert_eq!(resolved.focused_window, seed.focused_window);
+    }
+
+    #[test]
+    fn empty_or_failed_speculative_sections_are_captured_live() {
+        let seed = CaptureContextSeed {
+            selected_text: Ok(None),
+            browser: Err("AppleScript timed out".to_string()),
+            ..cheap_seed()
+        };
+        let captured = captured_sections(
+            &seed,
+            &combine_sections(&cheap_sections(), &UPGRADE_SECTIONS, |a, b| a || b),
+        );
+        assert!(
+            !captured.include_selected_text,
+            "AX-only miss is not trusted"
+        );
+        assert!(!captured.include_browser_url);
+        assert!(captured.include_frontmost_app);
+
+        let mut live_requests = Vec::new();
+        resolve_prefetched_seed(
+            &CaptureContextOptions::recommendation(),
+            Some(&prefetched(seed, captured)),
+            |missing| {
+                live_requests.push(missing.clone());
+                CaptureContextSeed::default()
+            },
+        );
+        assert_eq!(
+            live_requests,
+            vec![CaptureContextOptions {
+                include_selected_text: true,
+                include_browser_url: true,
+                ..NO_SECTIONS
+            }]
+        );
+    }
+
+    #[test]
+    fn stale_or_foreign_prefetch_is_not_usable() {
+        let cached = prefetched(cheap_seed(), cheap_sections());
+        let now = cached.captured_at;
+        assert!(cached.is_usable(Some(42), now));
+        assert!(!cached.is_usable(Some(7), now), "frontmost app changed");
+        assert!(!cached.is_usable(Some(42), now + PREFETCH_TTL + Duration::from_secs(1)));
+    }
+
+    #[test]
+    fn no_prefetch_captures_everything_live() {
+        let options = CaptureContextOptions::tab_ai_submit();
+        let mut live_requests = Vec::new();
+        resolve_prefetched_seed(&options, None, |missing| {
+            live_requests.push(missing.clone());
+            CaptureContextSeed::default()
+        });
+        assert_eq!(live_requests, vec![options]);
+    }
+}
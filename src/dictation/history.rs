@@ -3,6 +3,7 @@
 use crate::dictation::DictationTarget;
 use chrono::{Datelike, Local};
 use serde::{Deserialize, Serialize};
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::{Mutex, OnceLock};
 use std::time::Duration;
 
@@ -20,6 +21,8 @@ struct DictationHistoryIndexCache {
 static DICTATION_HISTORY_INDEX_CACHE: OnceLock<Mutex<Option<DictationHistoryIndexCache>>> =
     OnceLock::new();
 static DICTATION_HISTORY_REFRESH_IN_FLIGHT: OnceLock<Mutex<bool>> = OnceLock::new();
+/// Bumped whenever the history index cache is replaced or dropped.
+static DICTATION_HISTORY_GENERATION: AtomicU64 = AtomicU64::new(0);
 
 fn dictation_history_index_cache() -> &'static Mutex<Option<DictationHistoryIndexCache>> {
     DICTATION_HISTORY_INDEX_CACHE.get_or_init(|| Mutex::new(None))
@@ -35,6 +38,7 @@ fn invalidate_history_cache() {
             *guard = None;
         }
     }
+    DICTATION_HISTORY_GENERATION.fetch_add(1, Ordering::Release);
 }
 
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq, Eq)]
@@ -263,6 +267,7 @@ pub fn load_history() -> Vec<DictationHistoryEntry> {
             entries: entries.clone(),
         });
     }
+    DICTATION_HISTORY_GENERATION.fetch_add(1, Ordering::Release);
 
     entries
 }
@@ -394,12 +399,24 @@ pub fn search_history(query: &str, limit: usize) -> Vec<DictationHistorySearchHi
     hits
 }
 
-fn cached_history_entries_if_fresh() -> Option<Vec<DictationHistoryEntry>> {
-    let path = history_path();
-    let signature = history_file_signature(&path);
-    let guard = dictation_history_index_cache().lock().ok()?;
-    let cache = guard.as_ref()?;
-    (cache.signature == signature).then(|| cache.entries.clone())
+/// Change feed for the root search index: the history cache's generation
+/// while it still matches the JSONL file. A cold or stale cache starts a
+/// background load and returns `None`.
+pub fn root_dictation_history_index_generation() -> Option<u64> {
+    let signature = history_file_signature(&history_path());
+    let fresh = dictation_history_index_cache()
+        .lock()
+        .ok()
+        .is_some_and(|guard| {
+            guard
+                .as_ref()
+                .is_some_and(|cache| cache.signature == signature)
+        });
+    if !fresh {
+        ensure_history_cache_warm();
+        return None;
+    }
+    Some(DICTATION_HISTORY_GENERATION.load(Ordering::Acquire))
 }
 
 fn ensure_history_cache_warm() {
@@ -477,59 +494,6 @@ pub fn search_root_dictation_history_direct(
     search_root_dictation_history(query, options)
 }
 
-/// Cache-only dictation history search for root launcher passive rows.
-///
-/// Cold JSONL reads warm a background index and return no hits for the current
-/// frame, preserving the active search result projection while the user types.
-pub fn search_root_dictation_history_cached(
-    query: &str,
-    options: RootDictationHistorySectionOptions,
-) -> Vec<RootDictationHistorySearchHit> {
-    if !root_dictation_history_query_is_eligible(query, options) {
-        return Vec::new();
-    }
-
-    let Some(entries) = cached_history_entries_if_fresh() else {
-        ensure_history_cache_warm();
-        tracing::info!(
-            category = "DICTATION",
-            event = "root_dictation_history_search_cache_miss",
-            query_len = query.trim().chars().count(),
-            scan_limit = options.scan_limit,
-            max_results = options.max_results,
-        );
-        return Vec::new();
-    };
-
-    let hits = rank_history_entries(
-        entries.into_iter().take(options.scan_limit).collect(),
-        query,
-        options.max_results,
-    )
-    .into_iter()
-    .map(|hit| RootDictationHistorySearchHit {
-        id: hit.entry.id,
-        preview: hit.entry.preview,
-        target: hit.entry.target,
-        timestamp: hit.entry.timestamp,
-        audio_duration_ms: hit.entry.audio_duration_ms,
-        score: hit.score,
-        matched_field: hit.matched_field,
-    })
-    .collect::<Vec<_>>();
-    if crate::logging::filter_perf_trace_enabled() {
-        tracing::info!(
-            category = "DICTATION",
-            event = "root_dictation_history_search_cache_hit",
-            query_len = query.trim().chars().count(),
-            scan_limit = options.scan_limit,
-            max_results = options.max_results,
-            hit_count = hits.len(),
-        );
-    }
-    hits
-}
-
 fn resource_payload(entries: &[DictationHistoryEntry]) -> String {
     if entries.is_empty() {
         return serde_json::json!({
@@ -45,8 +45,8 @@ pub use device::{
 pub use history::{
     build_history_entry, delete_history_entry, format_history_duration_ms,
     format_history_timestamp, get_history_entry, hydrate_dictation_resource_from_history,
-    load_history, record_dictation_history, root_dictation_history_query_is_eligible,
-    search_history, search_root_dictation_history, search_root_dictation_history_cached,
+    load_history, record_dictation_history, root_dictation_history_index_generation,
+    root_dictation_history_query_is_eligible, search_history, search_root_dictation_history,
     search_root_dictation_history_direct, DictationHistoryEntry, DictationHistorySearchField,
     DictationHistorySearchHit, RootDictationHistorySearchHit, RootDictationHistorySectionOptions,
 };
@@ -1,5 +1,10 @@
 //! Emoji data, search, and picker for the built-in emoji surface.
 
+mod search_index;
+
+use search_index::search_index;
+use std::borrow::Cow;
+
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub struct Emoji {
     pub emoji: &'static str,
@@ -1206,9 +1211,10 @@ pub const EMOJIS: &[Emoji] = &[
 ];
 
 pub fn emojis_by_category(category: EmojiCategory) -> Vec<&'static Emoji> {
-    EMOJIS
+    search_index()
+        .ordered_indices(Some(category))
         .iter()
-        .filter(|emoji| emoji.category == category)
+        .map(|&index| &EMOJIS[index as usize])
         .collect()
 }
 
@@ -1243,28 +1249,28 @@ pub fn filtered_ordered_emojis(
     filter: &str,
     selected_category: Option<EmojiCategory>,
 ) -> Vec<Emoji> {
-    let mut filtered: Vec<Emoji> = search_emojis(filter).into_iter().copied().collect();
-    if let Some(cat) = selected_category {
-        filtered.retain(|e| e.category == cat);
-    }
-    let mut ordered: Vec<Emoji> = Vec::with_capacity(filtered.len());
-    for cat in all_categories() {
-        ordered.extend(filtered.iter().copied().filter(|e| e.category == cat));
-    }
-    ordered
+    let index = search_index();
+    let query = normalize_search_query(filter);
+    index
+        .ordered_indices(selected_category)
+        .iter()
+        .map(|&ix| ix as usize)
+        .filter(|&ix| index.matches(ix, &query))
+        .map(|ix| EMOJIS[ix])
+        .collect()
 }
 
 /// Return the canonical EMOJIS slice index for an emoji string, used as the
 /// final stable tie-break when ranking frequent emojis. `None` for unknown
 /// strings so callers can sort them last.
 pub fn dataset_order_of(emoji: &str) -> Option<usize> {
-    EMOJIS.iter().position(|e| e.emoji == emoji)
+    search_index().position(emoji)
 }
 
 /// Look up the canonical Emoji record for a given string, or `None` if not in
 /// the dataset (e.g. a usage entry left over from a prior dataset).
 pub fn emoji_by_value(emoji: &str) -> Option<Emoji> {
-    EMOJIS.iter().find(|e| e.emoji == emoji).copied()
+    search_index().position(emoji).map(|ix| EMOJIS[ix])
 }
 
 /// Composite display order used by render + navigation + Enter commit. When
@@ -1304,10 +1310,10 @@ pub fn display_ordered_emojis(
         };
     }
 
-    let mut seen = std::collections::HashSet::new();
+    let mut seen = std::collections::HashSet::with_capacity(frequent.len());
     let mut frequent_emojis: Vec<Emoji> = Vec::with_capacity(frequent.len());
     for value in frequent {
-        if !seen.insert(value.clone()) {
+        if !seen.insert(value.as_str()) {
             continue;
         }
         if let Some(emoji) = emoji_by_value(value) {
@@ -1626,23 +1632,31 @@ impl EmojiGridLayout {
 }
 
 pub fn search_emojis(query: &str) -> Vec<&Emoji> {
-    let query = query.trim().to_ascii_lowercase();
+    let query = normalize_search_query(query);
     if query.is_empty() {
         return EMOJIS.iter().collect();
     }
 
+    let index = search_index();
     EMOJIS
         .iter()
-        .filter(|emoji| {
-            emoji.name.to_ascii_lowercase().contains(&query)
-                || emoji
-                    .keywords
-                    .iter()
-                    .any(|keyword| keyword.to_ascii_lowercase().contains(&query))
-        })
+        .enumerate()
+        .filter(|(ix, _)| index.matches(*ix, &query))
+        .map(|(_, emoji)| emoji)
         .collect()
 }
 
+/// Trim and ASCII-lowercase a picker query, borrowing when it is already
+/// lowercase (the common case while typing).
+fn normalize_search_query(query: &str) -> Cow<'_, str> {
+    let query = query.trim();
+    if query.bytes().any(|byte| byte.is_ascii_uppercase()) {
+        Cow::Owned(query.to_ascii_lowercase())
+    } else {
+        Cow::Borrowed(query)
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -1744,6 +1758,66 @@ mod tests {
         assert_eq!(matches.len(), EMOJIS.len());
     }
 
+    /// The pre-index implementation: lowercase and scan every field.
+    fn naive_search(query: &str) -> Vec<&'static str> {
+        let query = query.trim().to_ascii_lowercase();
+        EMOJIS
+            .iter()
+            .filter(|emoji| {
+                query.is_empty()
+                    || emoji.name.to_ascii_lowercase().contains(&query)
+                    || emoji
+                        .keywords
+                        .iter()
+                        .any(|keyword| keyword.to_ascii_lowercase().contains(&query))
+            })
+            .map(|emoji| emoji.emoji)
+            .collect()
+    }
+
+    #[test]
+    fn test_search_index_matches_naive_scan() {
+        for query in ["", "a", "face", "HEART", " flag: u", "ok b", "zzz", "o"] {
+            let indexed: Vec<&str> = search_emojis(query).iter().map(|e| e.emoji).collect();
+            assert_eq!(indexed, naive_search(query), "query {query:?}");
+
+            for category in all_categories().map(Some).chain([None]) {
+                let mut expected: Vec<&str> = Vec::new();
+                for cat in all_categories() {
+                    expected.extend(naive_search(query).into_iter().filter(|value| {
+                        let emoji = emoji_by_value(value).unwrap();
+                        emoji.category == cat && category.is_none_or(|c| c == cat)
+                    }));
+                }
+                let ordered: Vec<&str> = filtered_ordered_emojis(query, category)
+                    .iter()
+                    .map(|e| e.emoji)
+                    .collect();
+                assert_eq!(ordered, expected, "query {query:?} category {category:?}");
+            }
+        }
+    }
+
+    #[test]
+    fn test_search_index_does_not_match_across_fields() {
+        // "face" ends the name of 😀 and "happy" is its first keyword.
+        assert!(!search_emojis("facehappy")
+            .iter()
+            .any(|emoji| emoji.emoji == "😀"));
+    }
+
+    #[test]
+    fn test_dataset_order_of_matches_first_position() {
+        for emoji in EMOJIS {
+            assert_eq!(
+                dataset_order_of(emoji.emoji),
+                EMOJIS.iter().position(|e| e.emoji == emoji.emoji)
+            );
+        }
+        assert_eq!(dataset_order_of("not-an-emoji"), None);
+        assert_eq!(emoji_by_value("not-an-emoji"), None);
+    }
+
     #[test]
     fn test_filtered_grid_row_count_matches_current_dataset() {
         // Unfiltered: 9 category headers + cell rows for all 296 emojis
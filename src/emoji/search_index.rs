@@ -0,0 +1,90 @@
+//! Precomputed lookup tables for the emoji picker.
+//!
+//! Built once from [`EMOJIS`] on first use so per-keystroke filtering and
+//! display ordering never rescan or re-lowercase the dataset:
+//!
+//! - `by_value` maps an emoji string to its dataset index (first occurrence),
+//!   replacing `EMOJIS.iter().position(..)` in frequent-emoji ranking.
+//! - `haystacks` holds each entry's name and keywords, ASCII-lowercased once
+//!   and joined with U+001F so a query cannot match across fields.
+//! - `category_order` lists dataset indices grouped by category in
+//!   [`all_categories`] order, with `category_ranges` marking each block, so
+//!   category-ordered output is a single pass instead of one pass per
+//!   category.
+
+use super::{all_categories, EmojiCategory, EMOJIS};
+use std::collections::HashMap;
+use std::ops::Range;
+use std::sync::OnceLock;
+
+const FIELD_SEPARATOR: char = '\u{1f}';
+
+pub(super) struct EmojiSearchIndex {
+    by_value: HashMap<&'static str, u16>,
+    haystacks: Box<[Box<str>]>,
+    category_order: Box<[u16]>,
+    category_ranges: Box<[Range<usize>]>,
+}
+
+pub(super) fn search_index() -> &'static EmojiSearchIndex {
+    static INDEX: OnceLock<EmojiSearchIndex> = OnceLock::new();
+    INDEX.get_or_init(EmojiSearchIndex::build)
+}
+
+impl EmojiSearchIndex {
+    fn build() -> Self {
+        let mut by_value = HashMap::with_capacity(EMOJIS.len());
+        let mut haystacks = Vec::with_capacity(EMOJIS.len());
+        for (index, emoji) in EMOJIS.iter().enumerate() {
+            by_value.entry(emoji.emoji).or_insert(index as u16);
+
+            let mut haystack = emoji.name.to_ascii_lowercase();
+            for keyword in emoji.keywords {
+                haystack.push(FIELD_SEPARATOR);
+                haystack.push_str(&keyword.to_ascii_lowercase());
+            }
+            haystacks.push(haystack.into_boxed_str());
+        }
+
+        let mut category_order = Vec::with_capacity(EMOJIS.len());
+        let mut category_ranges = Vec::new();
+        for category in all_categories() {
+            let start = category_order.len();
+            category_order.extend(
+                EMOJIS
+                    .iter()
+                    .enumerate()
+                    .filter(|(_, emoji)| emoji.category == category)
+                    .map(|(index, _)| index as u16),
+            );
+            category_ranges.push(start..category_order.len());
+        }
+
+        Self {
+            by_value,
+            haystacks: haystacks.into_boxed_slice(),
+            category_order: category_order.into_boxed_slice(),
+            category_ranges: category_ranges.into_boxed_slice(),
+        }
+    }
+
+    /// Dataset index of `emoji`, or `None` when it is not in [`EMOJIS`].
+    pub(super) fn position(&self, emoji: &str) -> Option<usize> {
+        self.by_value.get(emoji).map(|&index| index as usize)
+    }
+
+    /// Whether dataset entry `index` matches an already trimmed and
+    /// ASCII-lowercased query. An empty query matches everything.
+    pub(super) fn matches(&self, index: usize, query: &str) -> bool {
+        query.is_empty() || self.haystacks[index].contains(query)
+    }
+
+    /// Dataset indices in category display order, limited to `category` when
+    /// one is selected.
+    pub(super) fn ordered_indices(&self, category: Option<EmojiCategory>) -> &[u16] {
+        match category {
+            Some(category) => &self.category_order[self.category_ranges[category as usize].clone()],
+            None => &self.category_order,
+        }
+    }
+}
@@ -685,12 +685,14 @@ impl ScriptListApp {
                     // FIX: Previously we consumed stderr in a thread but passed None to reader,
                     // which meant stderr was never available for error messages. Now we use
                     // spawn_stderr_reader which returns a StderrCapture containing both the buffer
-                    // AND a JoinHandle so we can wait for stderr to fully drain before reading.
+                    // AND a drain signal so we can wait for stderr to fully drain before reading.
+                    // Sessions already register stderr with the shared pipe reactor at spawn
+                    // time, in which case the existing capture is reused.
                     let stderr_capture = stderr_handle.map(|stderr| {
                         executor::spawn_stderr_reader(stderr, script_path_for_errors.clone())
                     });
 
-                    // Move the capture into the reader thread - it owns both buffer and join handle
+                    // Move the capture into the reader thread - it owns both buffer and drain signal
                     // The reader thread will wait for stderr to drain before reading contents
 
                     // Channel for sending responses from UI to writer thread
@@ -705,7 +707,9 @@ impl ScriptListApp {
                     let subscription_owner_id = format!("script:{}", uuid::Uuid::new_v4());
 
                     // Writer thread - handles sending responses to script
-                    std::thread::spawn(move || {
+                    let writer =
+                        std::thread::Builder::new().name("script-stdin-writer".to_string());
+                    if let Err(error) = writer.spawn(move || {
                         use std::io::Write;
                         use std::os::unix::io::AsRawFd;
 
@@ -802,7 +806,9 @@ impl ScriptListApp {
                             }
                         }
                         tracing::info!(category = "EXEC", "Writer thread exiting");
-                    });
+                    }) {
+                        tracing::warn!(category = "EXEC", %error, "Failed to spawn script stdin writer");
+                    }
 
                     // Reader thread - handles receiving messages from script (blocking is OK here)
                     // CRITICAL: Move _process_handle and _child into this thread to keep them alive!
@@ -811,7 +817,9 @@ impl ScriptListApp {
                     // CRITICAL: Move _process_handle and _child into this thread to keep them alive!
                     // When the reader thread exits, they'll be dropped and the process killed.
                     let script_path_clone = script_path_for_errors.clone();
-                    std::thread::spawn(move || {
+                    let reader =
+                        std::thread::Builder::new().name("script-stdout-reader".to_string());
+                    if let Err(error) = reader.spawn(move || {
                         // These variables keep the process alive - they're dropped when the thread exits
                         let _keep_alive_handle = _process_handle;
                         let mut keep_alive_child = _child;
@@ -2763,9 +2771,16 @@ impl ScriptListApp {
                                                 .filter(|s| !s.is_empty());
 
                                             if let Some(ref stderr_text) = stderr_output {
+                                                let stream = stderr_capture
+                                                    .as_ref()
+                                                    .map(|cap| cap.stats())
+                                                    .unwrap_or_default();
                                                 tracing::info!(
                                                     category = "EXEC",
                                                     bytes = stderr_text.len(),
+                                                    stream_bytes = stream.bytes,
+                                                    stream_lines = stream.lines,
+                                                    dropped_bytes = stream.dropped_bytes,
                                                     "Captured stderr from buffer"
                                                 );
 
@@ -2865,7 +2880,9 @@ impl ScriptListApp {
                             category = "EXEC",
                             "Reader thread exited, process handle will now be dropped"
                         );
-                    });
+                    }) {
+                        tracing::warn!(category = "EXEC", %error, "Failed to spawn script stdout reader");
+                    }
 
                     // Store the response sender for the UI to use
                     self.response_sender = Some(response_tx);
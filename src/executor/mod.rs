@@ -9,11 +9,15 @@
 
 mod auto_submit;
 mod errors;
+mod path_cache;
+#[cfg(unix)]
+mod pipe_reactor;
 pub(crate) mod runner;
 mod scriptlet;
 mod selected_text;
 mod stderr_buffer;
 pub(crate) mod telemetry;
+pub(crate) mod warm_pool;
 
 // Re-export public items for external use
 // Allow unused imports - these are public API exports that may be used by external code
@@ -28,6 +32,9 @@ pub use errors::{extract_error_message, generate_suggestions, parse_stack_trace}
 
 pub use runner::{execute_script_interactive_with_env_and_args, ScriptSession};
 
+pub use path_cache::start_runtime_path_validator;
+pub use warm_pool::configure_warm_runtime_pool;
+
 #[cfg(test)]
 pub(crate) use runner::{
     find_executable, find_sdk_path, is_javascript, is_typescript, spawn_script, ProcessHandle,
@@ -0,0 +1,378 @@
+//! Memoized executable and SDK path resolution
+//!
+//! [`find_executable`](super::runner::find_executable) and
+//! [`find_sdk_path`](super::runner::find_sdk_path) probe up to ten
+//! directories with `stat` calls, and every script, scriptlet and scheduled
+//! run asks again. Once [`start_runtime_path_validator`] is running, answers
+//! (including misses) are cached and the spawn path does no filesystem work.
+//!
+//! The validator thread owns the invalidation story:
+//! - it watches every probed directory that exists, non-recursively. Missing
+//!   directories are never stood in for by an ancestor: on macOS a
+//!   non-recursive FSEvents watch on `$HOME` still streams every event
+//!   under it;
+//! - any create/remove/rename touching a watched directory clears the cache
+//!   and re-resolves `bun`, `node` and the SDK in the background;
+//! - PATH is compared by value on each lookup (no syscalls), so a changed
+//!   process environment also resets the cache;
+//! - a PATH change or a failed script spawn ([`request_reprobe`]) makes the
+//!   validator re-list the probed directories and watch any that appeared
+//!   since, such as a fresh `~/.bun/bin`.
+//!
+//! Until the validator is running (tests, early startup, watcher failure)
+//! every lookup probes the filesystem exactly as before.
+
+use super::runner::{executable_search_dirs, find_executable, find_sdk_path, sdk_search_dirs};
+use notify::{recommended_watcher, RecursiveMode, Watcher};
+use std::collections::{HashMap, HashSet};
+use std::ffi::OsString;
+use std::path::{Path, PathBuf};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{mpsc, Mutex, OnceLock};
+use std::time::Duration;
+use tracing::{debug, info, warn};
+
+/// Executables resolved ahead of the first launch.
+const PRERESOLVED_EXECUTABLES: &[&str] = &["bun", "node"];
+
+/// Window for coalescing a burst of directory events (e.g. a bun upgrade).
+const INVALIDATION_DEBOUNCE: Duration = Duration::from_millis(250);
+
+static VALIDATOR_RUNNING: AtomicBool = AtomicBool::new(false);
+static VALIDATOR_STARTED: AtomicBool = AtomicBool::new(false);
+/// Wakes the validator for a re-probe; set while it is running.
+static VALIDATOR_WAKE: Mutex<Option<mpsc::Sender<ValidatorEvent>>> = Mutex::new(None);
+
+enum ValidatorEvent {
+    Fs(notify::Result<notify::Event>),
+    /// Re-list the probed directories and re-resolve.
+    Reprobe,
+}
+
+#[derive(Debug, Default)]
+struct ResolutionCache {
+    /// PATH the current entries were resolved under.
+    path_env: Option<OsString>,
+    /// Bumped on every invalidation so a probe that raced one is not stored.
+    generation: u64,
+    executables: HashMap<String, Option<PathBuf>>,
+    sdk: Option<Option<PathBuf>>,
+}
+
+impl ResolutionCache {
+    fn invalidate(&mut self) {
+        self.executables.clear();
+        self.sdk = None;
+        self.generation += 1;
+    }
+
+    /// Invalidate if PATH differs from the one the entries were resolved
+    /// under. Returns whether it did.
+    fn sync_path_env(&mut self, path_env: Option<OsString>) -> bool {
+        if self.path_env == path_env {
+            return false;
+        }
+        let first = self.path_env.is_none() && self.executables.is_empty() && self.sdk.is_none();
+        self.invalidate();
+        self.path_env = path_env;
+        !first
+    }
+}
+
+fn cache() -> std::sync::MutexGuard<'static, ResolutionCache> {
+    static CACHE: OnceLock<Mutex<ResolutionCache>> = OnceLock::new();
+    CACHE
+        .get_or_init(|| Mutex::new(ResolutionCache::default()))
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+/// Look up `name` in the cache, probing (and remembering the answer) on a miss.
+pub(super) fn cached_executable(
+    name: &str,
+    probe: impl FnOnce(&str) -> Option<PathBuf>,
+) -> Option<PathBuf> {
+    if !VALIDATOR_RUNNING.load(Ordering::Acquire) {
+        return probe(name);
+    }
+
+    let generation = {
+        let mut cache = cache();
+        if cache.sync_path_env(std::env::var_os("PATH")) {
+            wake_validator();
+        }
+        if let Some(resolved) = cache.executables.get(name) {
+            return resolved.clone();
+        }
+        cache.generation
+    };
+
+    let resolved = probe(name);
+    let mut cache = cache();
+    if cache.generation == generation {
+        cache.executables.insert(name.to_string(), resolved.clone());
+    }
+    resolved
+}
+
+/// Cached SDK path, probing (and remembering the answer) on a miss.
+pub(super) fn cached_sdk_path(probe: impl FnOnce() -> Option<PathBuf>) -> Option<PathBuf> {
+    if !VALIDATOR_RUNNING.load(Ordering::Acquire) {
+        return probe();
+    }
+
+    let generation = {
+        let mut cache = cache();
+        if cache.sync_path_env(std::env::var_os("PATH")) {
+            wake_validator();
+        }
+        if let Some(resolved) = &cache.sdk {
+            return resolved.clone();
+        }
+        cache.generation
+    };
+
+    let resolved = probe();
+    let mut cache = cache();
+    if cache.generation == generation {
+        cache.sdk = Some(resolved.clone());
+    }
+    resolved
+}
+
+/// Forget every cached answer and have the validator re-list the probed
+/// directories. Called when a spawn fails, since the runtime may have been
+/// installed into a directory that did not exist when watches were set up.
+pub(super) fn request_reprobe(reason: &'static str) {
+    if !VALIDATOR_RUNNING.load(Ordering::Acquire) {
+        return;
+    }
+    debug!(category = "EXEC", reason, "Runtime path re-probe requested");
+    cache().invalidate();
+    wake_validator();
+}
+
+fn wake_validator() {
+    if let Some(tx) = VALIDATOR_WAKE
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+        .as_ref()
+    {
+        let _ = tx.send(ValidatorEvent::Reprobe);
+    }
+}
+
+/// Pre-resolve runtime paths and keep them valid from a background watcher.
+///
+/// Idempotent; resolution happens on the validator thread so startup never
+/// waits on it.
+pub fn start_runtime_path_validator() {
+    if VALIDATOR_STARTED.swap(true, Ordering::SeqCst) {
+        return;
+    }
+    let spawned = std::thread::Builder::new()
+        .name("runtime-path-validator".to_string())
+        .spawn(validator_loop);
+    if let Err(error) = spawned {
+        warn!(category = "EXEC", %error, "Failed to start runtime path validator");
+        VALIDATOR_STARTED.store(false, Ordering::SeqCst);
+    }
+}
+
+fn validator_loop() {
+    let (tx, rx) = mpsc::channel();
+    let fs_tx = tx.clone();
+    let mut watcher = match recommended_watcher(move |res| {
+        let _ = fs_tx.send(ValidatorEvent::Fs(res));
+    }) {
+        Ok(watcher) => watcher,
+        Err(error) => {
+            warn!(category = "EXEC", %error, "Failed to create runtime path watcher");
+            VALIDATOR_STARTED.store(false, Ordering::SeqCst);
+            return;
+        }
+    };
+
+    let mut targets = search_dirs();
+    let mut watched = HashSet::new();
+    sync_watches(&mut watcher, &targets, &mut watched);
+
+    *VALIDATOR_WAKE
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner()) = Some(tx);
+    VALIDATOR_RUNNING.store(true, Ordering::Release);
+    preresolve();
+    info!(
+        category = "EXEC",
+        watched_dirs = watched.len(),
+        "Runtime path validator started"
+    );
+
+    while let Ok(first) = rx.recv() {
+        let mut relevant = event_is_relevant(first, &targets);
+        while let Ok(next) = rx.recv_timeout(INVALIDATION_DEBOUNCE) {
+            relevant |= event_is_relevant(next, &targets);
+        }
+        if !relevant {
+            continue;
+        }
+
+        debug!(category = "EXEC", "Runtime paths changed; re-resolving");
+        cache().invalidate();
+        targets = search_dirs();
+        sync_watches(&mut watcher, &targets, &mut watched);
+        preresolve();
+    }
+
+    VALIDATOR_RUNNING.store(false, Ordering::Release);
+    VALIDATOR_WAKE
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+        .take();
+    VALIDATOR_STARTED.store(false, Ordering::SeqCst);
+}
+
+/// Every directory whose contents decide an executable or SDK lookup.
+fn search_dirs() -> Vec<PathBuf> {
+    executable_search_dirs()
+        .into_iter()
+        .chain(sdk_search_dirs())
+        .collect()
+}
+
+fn preresolve() {
+    for name in PRERESOLVED_EXECUTABLES {
+        let _ = find_executable(name);
+    }
+    let _ = find_sdk_path();
+}
+
+fn event_is_relevant(event: ValidatorEvent, targets: &[PathBuf]) -> bool {
+    let event = match event {
+        ValidatorEvent::Reprobe => return true,
+        ValidatorEvent::Fs(event) => event,
+    };
+    match event {
+        Ok(event) => {
+            !matches!(event.kind, notify::EventKind::Access(_))
+                && event
+                    .paths
+                    .iter()
+                    .any(|path| is_relevant_change(path, targets))
+        }
+        // A lost or failed event may hide a change; re-resolve to be safe.
+        Err(error) => {
+            warn!(category = "EXEC", %error, "Runtime path watcher error");
+            true
+        }
+    }
+}
+
+/// Whether a change at `path` can affect resolution: it is a probed
+/// directory or an entry directly inside one.
+fn is_relevant_change(path: &Path, targets: &[PathBuf]) -> bool {
+    targets
+        .iter()
+        .any(|target| path == target || path.parent() == Some(target.as_path()))
+}
+
+/// The probed directories that exist right now; only these are watched.
+fn watch_points(targets: &[PathBuf]) -> HashSet<PathBuf> {
+    targets
+        .iter()
+        .filter(|target| target.is_dir())
+        .cloned()
+        .collect()
+}
+
+/// Move the non-recursive watches onto the probed directories that exist,
+/// dropping any that have since been removed.
+fn sync_watches(watcher: &mut impl Watcher, targets: &[PathBuf], watched: &mut HashSet<PathBuf>) {
+    let wanted = watch_points(targets);
+    watched.retain(|dir| {
+        if wanted.contains(dir) {
+            return true;
+        }
+        let _ = watcher.unwatch(dir);
+        false
+    });
+    for dir in wanted {
+        if watched.contains(&dir) {
+            continue;
+        }
+        match watcher.watch(&dir, RecursiveMode::NonRecursive) {
+            Ok(()) => {
+                watched.insert(dir);
+            }
+            Err(error) => {
+                debug!(
+                    category = "EXEC",
+                    %error,
+                    dir = %dir.display(),
+                    "Failed to watch runtime path directory"
+                );
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_path_change_invalidates_cached_entries() {
+        let mut cache = ResolutionCache::default();
+        assert!(
+            !cache.sync_path_env(Some("/usr/bin".into())),
+            "the first PATH seen is not a change"
+        );
+        cache
+            .executables
+            .insert("bun".to_string(), Some(PathBuf::from("/usr/bin/bun")));
+        cache.sdk = Some(None);
+        let generation = cache.generation;
+
+        assert!(!cache.sync_path_env(Some("/usr/bin".into())));
+        assert_eq!(cache.executables.len(), 1);
+        assert_eq!(cache.generation, generation);
+
+        assert!(cache.sync_path_env(Some("/opt/bin:/usr/bin".into())));
+        assert!(cache.executables.is_empty());
+        assert!(cache.sdk.is_none());
+        assert!(cache.generation > generation);
+    }
+
+    #[test]
+    fn test_relevant_changes_cover_targets_and_their_entries() {
+        let targets = vec![PathBuf::from("/home/me/.bun/bin")];
+
+        assert!(is_relevant_change(
+            Path::new("/home/me/.bun/bin/bun"),
+            &targets
+        ));
+        assert!(is_relevant_change(Path::new("/home/me/.bun/bin"), &targets));
+        assert!(!is_relevant_change(Path::new("/home/me/.bun"), &targets));
+        assert!(!is_relevant_change(
+            Path::new("/home/me/.zsh_history"),
+            &targets
+        ));
+        assert!(!is_relevant_change(
+            Path::new("/home/me/.bun/install/cache/x"),
+            &targets
+        ));
+    }
+
+    #[test]
+    fn test_watch_points_never_stand_in_an_ancestor_for_a_missing_target() {
+        let temp_dir = tempfile::tempdir().unwrap();
+        let existing = temp_dir.path().join("bin");
+        std::fs::create_dir(&existing).unwrap();
+        let missing = temp_dir.path().join(".bun/bin");
+        let targets = vec![existing.clone(), missing.clone()];
+        assert_eq!(watch_points(&targets), HashSet::from([existing.clone()]));
+
+        std::fs::create_dir_all(&missing).unwrap();
+        assert_eq!(watch_points(&targets), HashSet::from([existing, missing]));
+    }
+}
@@ -0,0 +1,289 @@
+//! Shared poll reactor for script stderr pipes
+//!
+//! Every script session used to park a dedicated thread in a blocking
+//! stderr read for the lifetime of the script. With dozens of scripts alive
+//! (background scripts, scheduled runs, watchers) those threads dominate the
+//! thread count while doing nothing.
+//!
+//! Instead, session stderr pipes are switched to non-blocking mode and
+//! handed to a single `script-pipe-reactor` thread which `poll(2)`s all of
+//! them. Each readable pipe is drained up to a per-wakeup budget so one noisy
+//! script cannot starve the rest, and the bytes go through the same bounded
+//! [`StderrLineSink`] the thread reader uses. Memory per stream is therefore
+//! capped by the ring buffer plus one partial line, no matter how much a
+//! script writes.
+//!
+//! If the reactor cannot start (or a pipe cannot be made non-blocking) the
+//! stream falls back to a dedicated reader thread.
+//!
+//! Scope: only stderr is multiplexed, so a session costs two threads
+//! rather than three. Each session still runs a `script-stdout-reader`
+//! thread and a `script-stdin-writer` thread:
+//!
+//! - The reader is the protocol loop. It parses messages and blocks on the
+//!   bounded UI channel, and that block is the backpressure on the script.
+//! - The writer drains the session's `SyncSender<Message>` response
+//!   channel. A std channel cannot wake `poll(2)`.
+//!
+//! Moving either one here means turning the protocol loop into a
+//! non-blocking state machine. It also means replacing the response sender
+//! the UI holds with a type that wakes the reactor. Neither is done yet.
+
+use super::stderr_buffer::{spawn_stderr_reader_thread, StderrCapture, StderrLineSink};
+use std::os::fd::{AsRawFd, OwnedFd, RawFd};
+use std::process::ChildStderr;
+use std::sync::{Mutex, OnceLock};
+use std::time::Duration;
+use tracing::{debug, warn};
+
+/// Bytes read per `read(2)` call.
+const READ_CHUNK_BYTES: usize = 16 * 1024;
+
+/// Bytes drained from one pipe per wakeup before moving to the next.
+const READ_BUDGET_PER_WAKEUP: usize = 64 * 1024;
+
+struct Stream {
+    fd: OwnedFd,
+    sink: StderrLineSink,
+}
+
+struct Reactor {
+    pending: Mutex<Vec<Stream>>,
+    wake_write: OwnedFd,
+}
+
+/// Start capturing a child's stderr on the shared reactor.
+pub(super) fn capture_stderr(stderr: ChildStderr, script_path: String) -> StderrCapture {
+    let Some(reactor) = reactor() else {
+        return spawn_stderr_reader_thread(stderr, script_path);
+    };
+
+    let fd = OwnedFd::from(stderr);
+    if let Err(error) = set_nonblocking(fd.as_raw_fd()) {
+        debug!(category = "EXEC", %error, "Falling back to stderr reader thread");
+        return spawn_stderr_reader_thread(ChildStderr::from(fd), script_path);
+    }
+
+    let (capture, sink) = StderrCapture::with_sink(script_path);
+    reactor
+        .pending
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+        .push(Stream { fd, sink });
+    reactor.wake();
+    capture
+}
+
+fn reactor() -> Option<&'static Reactor> {
+    static REACTOR: OnceLock<Option<Reactor>> = OnceLock::new();
+    REACTOR
+        .get_or_init(|| match start_reactor() {
+            Ok(reactor) => Some(reactor),
+            Err(error) => {
+                warn!(category = "EXEC", %error, "Failed to start script pipe reactor");
+                None
+            }
+        })
+        .as_ref()
+}
+
+fn start_reactor() -> std::io::Result<Reactor> {
+    let (wake_read, wake_write) = pipe()?;
+    set_nonblocking(wake_read.as_raw_fd())?;
+    set_nonblocking(wake_write.as_raw_fd())?;
+    std::thread::Builder::new()
+        .name("script-pipe-reactor".to_string())
+        .spawn(move || run(wake_read))?;
+    Ok(Reactor {
+        pending: Mutex::new(Vec::new()),
+        wake_write,
+    })
+}
+
+impl Reactor {
+    fn wake(&self) {
+        let byte = 1u8;
+        // A full wake pipe already guarantees a pending wakeup.
+        // SAFETY: writing one byte from a valid stack buffer to an owned fd.
+        unsafe {
+            libc::write(self.wake_write.as_raw_fd(), (&byte as *const u8).cast(), 1);
+        }
+    }
+}
+
+fn run(wake_read: OwnedFd) {
+    let mut streams: Vec<Stream> = Vec::new();
+    let mut poll_fds: Vec<libc::pollfd> = Vec::new();
+    let mut chunk = vec![0u8; READ_CHUNK_BYTES];
+
+    loop {
+        // The reactor is created before this thread first polls, and a
+        // registration always writes to the wake pipe after pushing.
+        if let Some(reactor) = reactor() {
+            streams.append(
+                &mut reactor
+                    .pending
+                    .lock()
+                    .unwrap_or_else(|poisoned| poisoned.into_inner()),
+            );
+        }
+
+        poll_fds.clear();
+        poll_fds.push(poll_fd(wake_read.as_raw_fd()));
+        poll_fds.extend(streams.iter().map(|stream| poll_fd(stream.fd.as_raw_fd())));
+
+        // SAFETY: `poll_fds` is a valid, initialised array of `len` pollfds.
+        let ready =
+            unsafe { libc::poll(poll_fds.as_mut_ptr(), poll_fds.len() as libc::nfds_t, -1) };
+        if ready < 0 {
+            let error = std::io::Error::last_os_error();
+            if error.kind() != std::io::ErrorKind::Interrupted {
+                warn!(category = "EXEC", %error, "Script pipe reactor poll failed");
+                std::thread::sleep(Duration::from_millis(10));
+            }
+            continue;
+        }
+
+        if poll_fds[0].revents != 0 {
+            drain_wake_pipe(wake_read.as_raw_fd(), &mut chunk);
+        }
+
+        // `retain_mut` visits streams in order, matching `poll_fds[1..]`.
+        let mut ready_events = poll_fds[1..].iter().map(|poll_fd| poll_fd.revents);
+        streams.retain_mut(|stream| {
+            let revents = ready_events.next().unwrap_or(0);
+            if revents == 0 || read_available(stream, &mut chunk) {
+                return true;
+            }
+            stream.sink.finish();
+            false
+        });
+    }
+}
+
+/// Drain up to the per-wakeup budget. Returns false once the stream is closed.
+fn read_available(stream: &mut Stream, chunk: &mut [u8]) -> bool {
+    let mut budget = READ_BUDGET_PER_WAKEUP;
+    while budget > 0 {
+        let want = chunk.len().min(budget);
+        // SAFETY: reading into a valid buffer of at least `want` bytes.
+        let read = unsafe { libc::read(stream.fd.as_raw_fd(), chunk.as_mut_ptr().cast(), want) };
+        match read {
+            0 => return false,
+            read if read > 0 => {
+                let read = read as usize;
+                stream.sink.feed(&chunk[..read]);
+                budget -= read;
+            }
+            _ => {
+                let error = std::io::Error::last_os_error();
+                match error.kind() {
+                    std::io::ErrorKind::WouldBlock => return true,
+                    std::io::ErrorKind::Interrupted => {}
+                    _ => {
+                        warn!(category = "EXEC", %error, "stderr read error");
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    // Budget spent; poll is level-triggered so the rest is read next round.
+    true
+}
+
+fn drain_wake_pipe(fd: RawFd, chunk: &mut [u8]) {
+    // SAFETY: reading into a valid buffer of `chunk.len()` bytes.
+    while unsafe { libc::read(fd, chunk.as_mut_ptr().cast(), chunk.len()) } > 0 {}
+}
+
+fn poll_fd(fd: RawFd) -> libc::pollfd {
+    libc::pollfd {
+        fd,
+        events: libc::POLLIN,
+        revents: 0,
+    }
+}
+
+fn pipe() -> std::io::Result<(OwnedFd, OwnedFd)> {
+    use std::os::fd::FromRawFd;
+
+    let mut fds = [0 as libc::c_int; 2];
+    // SAFETY: `fds` has room for the two descriptors pipe(2) writes.
+    if unsafe { libc::pipe(fds.as_mut_ptr()) } != 0 {
+        return Err(std::io::Error::last_os_error());
+    }
+    // SAFETY: pipe(2) succeeded, so both descriptors are open and ours.
+    unsafe {
+        for fd in fds {
+            libc::fcntl(fd, libc::F_SETFD, libc::FD_CLOEXEC);
+        }
+        Ok((OwnedFd::from_raw_fd(fds[0]), OwnedFd::from_raw_fd(fds[1])))
+    }
+}
+
+fn set_nonblocking(fd: RawFd) -> std::io::Result<()> {
+    // SAFETY: fcntl on a descriptor we own; no pointers involved.
+    unsafe {
+        let flags = libc::fcntl(fd, libc::F_GETFL);
+        if flags < 0 || libc::fcntl(fd, libc::F_SETFL, flags | libc::O_NONBLOCK) < 0 {
+            return Err(std::io::Error::last_os_error());
+        }
+    }
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::super::stderr_buffer::DEFAULT_MAX_BYTES;
+    use super::*;
+    use std::process::{Command, Stdio};
+
+    fn spawn_stderr_writer(script: &str) -> std::process::Child {
+        Command::new("sh")
+            .args(["-c", script])
+            .stdin(Stdio::null())
+            .stdout(Stdio::null())
+            .stderr(Stdio::piped())
+            .spawn()
+            .expect("spawn sh")
+    }
+
+    #[test]
+    fn test_reactor_captures_many_concurrent_streams() {
+        let mut children = Vec::new();
+        let mut captures = Vec::new();
+        for index in 0..24 {
+            let mut child = spawn_stderr_writer(&format!(
+                "i=0; while [ $i -lt 200 ]; do echo \"stream {index} line $i\" >&2; i=$((i+1)); done"
+            ));
+            let stderr = child.stderr.take().unwrap();
+            captures.push(capture_stderr(stderr, format!("/test/{index}.ts")));
+            children.push(child);
+        }
+
+        for (index, (mut child, capture)) in children.into_iter().zip(captures).enumerate() {
+            child.wait().unwrap();
+            let contents = capture.get_contents_with_timeout(Duration::from_secs(5));
+            assert!(
+                contents.ends_with(&format!("stream {index} line 199")),
+                "stream {index} should be fully drained"
+            );
+            assert_eq!(capture.stats().lines, 200);
+        }
+    }
+
+    #[test]
+    fn test_reactor_bounds_unterminated_output() {
+        let mut child = spawn_stderr_writer("head -c 1048576 /dev/zero | tr '\\0' x >&2");
+        let capture = capture_stderr(child.stderr.take().unwrap(), "/test/noisy.ts".into());
+
+        child.wait().unwrap();
+        assert!(capture.wait_with_timeout(Duration::from_secs(5)));
+        let stats = capture.stats();
+        assert_eq!(stats.bytes, 1024 * 1024);
+        assert_eq!(stats.lines, 1);
+        assert!(stats.dropped_bytes > 0);
+        assert!(capture.buffer.byte_count() <= DEFAULT_MAX_BYTES);
+    }
+}
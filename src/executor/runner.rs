@@ -6,13 +6,15 @@
 //! - SDK path management
 //! - File type detection
 
-use super::stderr_buffer::{spawn_stderr_reader, StderrCapture};
+#[cfg(not(unix))]
+use super::stderr_buffer::spawn_stderr_reader;
+use super::stderr_buffer::StderrCapture;
 use crate::logging;
 use crate::process_manager::PROCESS_MANAGER;
 use crate::protocol::JsonlReader;
 use std::io::BufReader;
 use std::path::{Path, PathBuf};
-use std::process::{Child, ChildStdin, ChildStdout, Command, Stdio};
+use std::process::{Child, ChildStderr, ChildStdin, ChildStdout, Command, Stdio};
 use std::time::Instant;
 use tracing::{debug, error, info, instrument};
 
@@ -92,27 +94,40 @@ const SAFE_SCRIPT_ENV_VARS: &[&str] = &[
 static SDK_EXTRACTED: std::sync::OnceLock<Option<PathBuf>> = std::sync::OnceLock::new();
 
 /// Find an executable, checking common locations that GUI apps might miss
+///
+/// Memoized once the runtime path validator is running; see [`super::path_cache`].
 pub fn find_executable(name: &str) -> Option<PathBuf> {
-    info!(category = "EXEC", executable = %name, "Looking for executable");
+    super::path_cache::cached_executable(name, probe_executable)
+}
 
-    // Common paths where executables might be installed
-    let common_paths = [
+/// Directories probed by [`find_executable`], in priority order.
+pub(super) fn executable_search_dirs() -> Vec<PathBuf> {
+    let home = dirs::home_dir();
+    let home_dir = |relative: &str| home.as_ref().map(|h| h.join(relative));
+    [
         // User-specific paths
-        dirs::home_dir().map(|h| h.join(".bun/bin")),
-        dirs::home_dir().map(|h| h.join("Library/pnpm")), // pnpm on macOS
-        dirs::home_dir().map(|h| h.join(".nvm/current/bin")),
-        dirs::home_dir().map(|h| h.join(".volta/bin")),
-        dirs::home_dir().map(|h| h.join(".local/bin")),
-        dirs::home_dir().map(|h| h.join("bin")),
+        home_dir(".bun/bin"),
+        home_dir("Library/pnpm"), // pnpm on macOS
+        home_dir(".nvm/current/bin"),
+        home_dir(".volta/bin"),
+        home_dir(".local/bin"),
+        home_dir("bin"),
         // Homebrew paths
         Some(PathBuf::from("/opt/homebrew/bin")),
         Some(PathBuf::from("/usr/local/bin")),
         // System paths
         Some(PathBuf::from("/usr/bin")),
         Some(PathBuf::from("/bin")),
-    ];
+    ]
+    .into_iter()
+    .flatten()
+    .collect()
+}
 
-    for path in common_paths.iter().flatten() {
+fn probe_executable(name: &str) -> Option<PathBuf> {
+    info!(category = "EXEC", executable = %name, "Looking for executable");
+
+    for path in executable_search_dirs() {
         let exe_path = path.join(name);
         info!(
             category = "EXEC",
@@ -183,7 +198,32 @@ fn ensure_sdk_extracted() -> Option<PathBuf> {
 }
 
 /// Find the SDK path, checking standard locations
+///
+/// Memoized once the runtime path validator is running; see [`super::path_cache`].
 pub fn find_sdk_path() -> Option<PathBuf> {
+    super::path_cache::cached_sdk_path(probe_sdk_path)
+}
+
+/// Directories whose contents decide [`find_sdk_path`]'s answer.
+pub(super) fn sdk_search_dirs() -> Vec<PathBuf> {
+    let mut dirs = Vec::with_capacity(3);
+    if let Some(home) = dirs::home_dir() {
+        dirs.push(home.join(".scriptkit/sdk"));
+    }
+    if let Some(exe_dir) = std::env::current_exe()
+        .ok()
+        .and_then(|exe| exe.parent().map(Path::to_path_buf))
+    {
+        dirs.push(exe_dir);
+    }
+    // The checkout the binary was built from only matters to dev builds; in a
+    // release build it names a directory on the build machine.
+    #[cfg(debug_assertions)]
+    dirs.push(PathBuf::from(env!("CARGO_MANIFEST_DIR")).join("scripts"));
+    dirs
+}
+
+fn probe_sdk_path() -> Option<PathBuf> {
     info!(category = "EXEC", "Looking for SDK");
 
     // 1. Check ~/.scriptkit/sdk/kit-sdk.ts (primary location)
@@ -645,6 +685,19 @@ fn execute_script_interactive_impl(
     // Find SDK for preloading
     let sdk_path = find_sdk_path();
 
+    // Fast path: a pre-warmed bun worker has already paid startup + preload.
+    if is_typescript(path) && extra_env.is_empty() {
+        if let Some(sdk) = sdk_path.as_deref() {
+            if let Some(session) = super::warm_pool::take_warm_session(sdk, path_str, &argv) {
+                logging::bench_log(&format!(
+                    "warm runtime handoff in {}ms",
+                    start.elapsed().as_millis()
+                ));
+                return Ok(session);
+            }
+        }
+    }
+
     let bun_path = "bun".to_string();
     let node_path = "node".to_string();
 
@@ -728,6 +781,17 @@ pub fn spawn_script_with_extra_env(
     script_path: &str,
     extra_env: &[(String, String)],
 ) -> Result<ScriptSession, String> {
+    let child = spawn_script_process(cmd, args, extra_env)?;
+    session_from_child(child, script_path, "executor::spawn_script_with_extra_env")
+}
+
+/// Spawn `cmd` with the scrubbed script environment, piped stdio and (on
+/// Unix) its own process group. Shared by direct launches and warm workers.
+pub(super) fn spawn_script_process(
+    cmd: &str,
+    args: &[&str],
+    extra_env: &[(String, String)],
+) -> Result<Child, String> {
     // Try to find the executable in common locations
     let executable = find_executable(cmd)
         .map(|p| p.to_string_lossy().into_owned())
@@ -770,8 +834,11 @@ pub fn spawn_script_with_extra_env(
         info!(category = "EXEC", "Using process group for child process");
     }
 
-    let mut child = command.spawn().map_err(|e| {
+    let child = command.spawn().map_err(|e| {
         error!(error = %e, executable = %executable, "Process spawn failed");
+        // The cached path may predate an install or removal in a directory
+        // the validator was not watching; look again on the next launch.
+        super::path_cache::request_reprobe("spawn_failed");
         let err = format!("Failed to spawn '{}': {}", executable, e);
         info!(category = "EXEC", error = %err, "Script spawn failed");
         err
@@ -780,7 +847,28 @@ pub fn spawn_script_with_extra_env(
     let pid = child.id();
     info!(pid = pid, pgid = pid, executable = %executable, "Process spawned");
     info!(category = "EXEC", pid, pgid = pid, "Process spawned");
+    Ok(child)
+}
 
+/// Wrap a spawned script process in a [`ScriptSession`]: take its pipes,
+/// start the stderr drain and register it for cleanup under `script_path`.
+/// Drain a child's stderr on the shared pipe reactor where available.
+#[cfg(unix)]
+fn capture_child_stderr(stderr: ChildStderr, script_path: String) -> StderrCapture {
+    super::pipe_reactor::capture_stderr(stderr, script_path)
+}
+
+#[cfg(not(unix))]
+fn capture_child_stderr(stderr: ChildStderr, script_path: String) -> StderrCapture {
+    spawn_stderr_reader(stderr, script_path)
+}
+
+pub(super) fn session_from_child(
+    mut child: Child,
+    script_path: &str,
+    telemetry_source: &'static str,
+) -> Result<ScriptSession, String> {
+    let pid = child.id();
     let stdin = child
         .stdin
         .take()
@@ -795,7 +883,7 @@ pub fn spawn_script_with_extra_env(
     let stderr = child
         .stderr
         .take()
-        .map(|stderr| spawn_stderr_reader(stderr, script_path.to_string()));
+        .map(|stderr| capture_child_stderr(stderr, script_path.to_string()));
     info!(
         category = "EXEC",
         stderr_capture_started = stderr.is_some(),
@@ -804,7 +892,7 @@ pub fn spawn_script_with_extra_env(
 
     let process_handle = ProcessHandle::new(pid, script_path.to_string());
     info!(category = "EXEC", pid, "ScriptSession created");
-    super::telemetry::log_script_spawned("executor::spawn_script_with_extra_env", script_path, pid);
+    super::telemetry::log_script_spawned(telemetry_source, script_path, pid);
 
     Ok(ScriptSession {
         stdin,
@@ -10,18 +10,24 @@
 //! while simultaneously forwarding to the logging system. This "tee" approach
 //! allows real-time debugging while preserving error context for exit handling.
 //!
+//! Incoming bytes go through [`StderrLineSink`], which splits lines with a
+//! bounded partial-line buffer (a script printing one endless line cannot
+//! grow memory), rate-limits the per-line debug logging, and counts bytes,
+//! lines and dropped bytes per stream.
+//!
 //! ## Thread Safety
 //!
 //! The buffer uses `Arc<Mutex<VecDeque<String>>>` for thread-safe access from:
-//! - The stderr reader thread (writes)
+//! - The stderr reader: the shared pipe reactor or a reader thread (writes)
 //! - The main reader thread on script exit (reads)
 
 use itertools::Itertools;
 use std::collections::VecDeque;
-use std::io::{BufRead, BufReader, Read};
-use std::sync::{Arc, Mutex};
-use std::thread::{self, JoinHandle};
-use std::time::Duration;
+use std::io::Read;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Condvar, Mutex};
+use std::thread;
+use std::time::{Duration, Instant};
 use tracing::{debug, warn};
 
 /// Default maximum number of lines to buffer
@@ -30,6 +36,14 @@ pub const DEFAULT_MAX_LINES: usize = 500;
 /// Default maximum total bytes to buffer (4KB)
 pub const DEFAULT_MAX_BYTES: usize = 4 * 1024;
 
+/// Longest partial line held while waiting for its newline; the rest of the
+/// line is dropped. The ring would truncate a longer line on push anyway.
+const MAX_LINE_BYTES: usize = DEFAULT_MAX_BYTES;
+
+/// Stderr lines forwarded to the debug log per stream per second; the rest
+/// are counted and summarised so a noisy script cannot flood the log.
+const MAX_LOGGED_LINES_PER_SECOND: u32 = 100;
+
 /// A thread-safe ring buffer for stderr lines
 #[derive(Debug, Clone)]
 pub struct StderrBuffer {
@@ -152,39 +166,100 @@ fn truncate_line_to_max_bytes(line: &mut String, max_bytes: usize) {
     line.truncate(truncate_at);
 }
 
-/// Stderr capture handle containing both buffer and thread handle
+/// Byte and line counters for one stderr stream.
+#[derive(Debug, Default)]
+pub struct StderrStats {
+    bytes: AtomicU64,
+    lines: AtomicU64,
+    dropped_bytes: AtomicU64,
+}
+
+/// Point-in-time copy of [`StderrStats`].
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct StderrStatsSnapshot {
+    /// Bytes read from the pipe.
+    pub bytes: u64,
+    /// Complete lines pushed into the ring buffer.
+    pub lines: u64,
+    /// Bytes discarded from over-long lines.
+    pub dropped_bytes: u64,
+}
+
+impl StderrStats {
+    pub fn snapshot(&self) -> StderrStatsSnapshot {
+        StderrStatsSnapshot {
+            bytes: self.bytes.load(Ordering::Relaxed),
+            lines: self.lines.load(Ordering::Relaxed),
+            dropped_bytes: self.dropped_bytes.load(Ordering::Relaxed),
+        }
+    }
+}
+
+/// Set once the stream has been fully drained.
+#[derive(Debug, Default)]
+struct DrainLatch {
+    finished: Mutex<bool>,
+    changed: Condvar,
+}
+
+impl DrainLatch {
+    fn set(&self) {
+        *self.finished.lock().unwrap_or_else(|e| e.into_inner()) = true;
+        self.changed.notify_all();
+    }
+
+    fn wait(&self, timeout: Duration) -> bool {
+        let finished = self.finished.lock().unwrap_or_else(|e| e.into_inner());
+        let (finished, _) = self
+            .changed
+            .wait_timeout_while(finished, timeout, |finished| !*finished)
+            .unwrap_or_else(|e| e.into_inner());
+        *finished
+    }
+}
+
+/// Stderr capture handle: the ring buffer plus a drain signal
 ///
-/// This struct bundles the stderr buffer with the thread's JoinHandle,
-/// allowing callers to wait for the stderr reader to complete before
-/// snapshotting the buffer contents. This prevents the race condition
-/// where stderr is read before all error output has been buffered.
+/// Callers wait for the reader to finish draining before snapshotting the
+/// buffer contents. This prevents the race condition where stderr is read
+/// before all error output has been buffered.
 #[derive(Debug)]
 pub struct StderrCapture {
     /// The stderr ring buffer
     pub buffer: StderrBuffer,
-    /// Handle to wait for the reader thread to complete
-    pub join_handle: JoinHandle<()>,
+    stats: Arc<StderrStats>,
+    drained: Arc<DrainLatch>,
 }
 
 impl StderrCapture {
-    /// Wait for the stderr reader thread to complete, with timeout
+    /// Create a capture and the sink that feeds it.
+    pub(super) fn with_sink(script_path: String) -> (Self, StderrLineSink) {
+        let capture = Self {
+            buffer: StderrBuffer::default(),
+            stats: Arc::new(StderrStats::default()),
+            drained: Arc::new(DrainLatch::default()),
+        };
+        let sink = StderrLineSink {
+            buffer: capture.buffer.clone(),
+            stats: Arc::clone(&capture.stats),
+            drained: Arc::clone(&capture.drained),
+            script_path,
+            partial: Vec::new(),
+            started: Instant::now(),
+            log_window_start: Instant::now(),
+            logged_in_window: 0,
+            suppressed_log_lines: 0,
+        };
+        (capture, sink)
+    }
+
+    /// Wait for the stderr reader to drain the stream, with timeout
     ///
-    /// Returns true if the thread completed within the timeout, false otherwise.
+    /// Returns true if the stream was drained within the timeout, false otherwise.
     /// This should be called before reading the buffer to ensure all stderr
     /// has been captured.
     pub fn wait_with_timeout(&self, timeout: Duration) -> bool {
-        // We can't join without consuming, so we poll is_finished
-        let start = std::time::Instant::now();
-        let poll_interval = Duration::from_millis(10);
-
-        while start.elapsed() < timeout {
-            if self.join_handle.is_finished() {
-                return true;
-            }
-            std::thread::sleep(poll_interval);
-        }
-
-        self.join_handle.is_finished()
+        self.drained.wait(timeout)
     }
 
     /// Get buffer contents after waiting for reader to complete
@@ -196,16 +271,113 @@ impl StderrCapture {
         self.wait_with_timeout(timeout);
         self.buffer.get_contents()
     }
+
+    /// Bytes and lines seen on this stream so far.
+    pub fn stats(&self) -> StderrStatsSnapshot {
+        self.stats.snapshot()
+    }
+}
+
+/// Write side of a [`StderrCapture`]: turns raw pipe bytes into buffered,
+/// logged lines.
+pub(super) struct StderrLineSink {
+    buffer: StderrBuffer,
+    stats: Arc<StderrStats>,
+    drained: Arc<DrainLatch>,
+    script_path: String,
+    partial: Vec<u8>,
+    started: Instant,
+    log_window_start: Instant,
+    logged_in_window: u32,
+    suppressed_log_lines: u64,
 }
 
-/// Spawn a stderr reader thread that tees output to both logging and a buffer
+impl StderrLineSink {
+    /// Consume a chunk of raw stderr bytes.
+    pub(super) fn feed(&mut self, chunk: &[u8]) {
+        self.stats
+            .bytes
+            .fetch_add(chunk.len() as u64, Ordering::Relaxed);
+        let mut rest = chunk;
+        while let Some(newline) = rest.iter().position(|byte| *byte == b'\n') {
+            self.append(&rest[..newline]);
+            self.finish_line();
+            rest = &rest[newline + 1..];
+        }
+        self.append(rest);
+    }
+
+    /// Flush any unterminated last line and signal that the stream is drained.
+    pub(super) fn finish(&mut self) {
+        if !self.partial.is_empty() {
+            self.finish_line();
+        }
+        if self.suppressed_log_lines > 0 {
+            debug!(
+                target: "SCRIPT",
+                script_path = %self.script_path,
+                suppressed_lines = self.suppressed_log_lines,
+                "Suppressed noisy stderr lines from log"
+            );
+        }
+        let stats = self.stats.snapshot();
+        debug!(
+            target: "SCRIPT",
+            script_path = %self.script_path,
+            bytes = stats.bytes,
+            lines = stats.lines,
+            dropped_bytes = stats.dropped_bytes,
+            duration_ms = self.started.elapsed().as_millis() as u64,
+            "stderr stream drained"
+        );
+        self.drained.set();
+    }
+
+    fn append(&mut self, bytes: &[u8]) {
+        let room = MAX_LINE_BYTES.saturating_sub(self.partial.len());
+        let kept = room.min(bytes.len());
+        self.partial.extend_from_slice(&bytes[..kept]);
+        if kept < bytes.len() {
+            self.stats
+                .dropped_bytes
+                .fetch_add((bytes.len() - kept) as u64, Ordering::Relaxed);
+        }
+    }
+
+    fn finish_line(&mut self) {
+        if self.partial.last() == Some(&b'\r') {
+            self.partial.pop();
+        }
+        let line = String::from_utf8_lossy(&self.partial).into_owned();
+        self.partial.clear();
+
+        if self.log_window_start.elapsed() >= Duration::from_secs(1) {
+            self.log_window_start = Instant::now();
+            self.logged_in_window = 0;
+        }
+        if self.logged_in_window < MAX_LOGGED_LINES_PER_SECOND {
+            self.logged_in_window += 1;
+            // Log in real-time
+            debug!(target: "SCRIPT", script_path = %self.script_path, "{}", line);
+        } else {
+            self.suppressed_log_lines += 1;
+        }
+
+        // Buffer for post-mortem
+        self.stats.lines.fetch_add(1, Ordering::Relaxed);
+        self.buffer.push_line(line);
+    }
+}
+
+/// Spawn a stderr reader that tees output to both logging and a buffer
 ///
-/// Returns a StderrCapture containing both the buffer handle and thread JoinHandle.
-/// The JoinHandle allows callers to wait for the reader to complete before
-/// snapshotting the buffer, preventing partial error captures.
+/// Returns a StderrCapture containing the buffer handle and a drain signal,
+/// which lets callers wait for the reader to complete before snapshotting
+/// the buffer, preventing partial error captures.
 ///
 /// Passing an existing StderrCapture returns it unchanged. This keeps call sites
-/// compatible when stderr is already being drained upstream.
+/// compatible when stderr is already being drained upstream (script sessions
+/// register their stderr pipe with the shared pipe reactor at spawn time).
 ///
 /// # Example
 /// ```ignore
@@ -239,36 +411,31 @@ impl IntoStderrCapture for StderrCapture {
     }
 }
 
-fn spawn_stderr_reader_thread<R: Read + Send + 'static>(
-    stderr: R,
+/// Dedicated-thread reader, for sources the pipe reactor cannot poll.
+pub(super) fn spawn_stderr_reader_thread<R: Read + Send + 'static>(
+    mut stderr: R,
     script_path: String,
 ) -> StderrCapture {
-    let buffer = StderrBuffer::default();
-    let buffer_clone = buffer.clone();
-
-    let join_handle = thread::spawn(move || {
-        let reader = BufReader::new(stderr);
-        for line_result in reader.lines() {
-            match line_result {
-                Ok(line) => {
-                    // Log in real-time
-                    debug!(target: "SCRIPT", script_path = %script_path, "{}", line);
-                    // Buffer for post-mortem
-                    buffer_clone.push_line(line);
-                }
+    let (capture, mut sink) = StderrCapture::with_sink(script_path);
+
+    thread::spawn(move || {
+        let mut chunk = [0u8; 8 * 1024];
+        loop {
+            match stderr.read(&mut chunk) {
+                Ok(0) => break,
+                Ok(read) => sink.feed(&chunk[..read]),
+                Err(e) if e.kind() == std::io::ErrorKind::Interrupted => {}
                 Err(e) => {
                     warn!(target: "SCRIPT", error = %e, "stderr read error");
                     break;
                 }
             }
         }
+        sink.finish();
         debug!(target: "SCRIPT", "stderr reader exiting");
     });
 
-    StderrCapture {
-        buffer,
-        join_handle,
-    }
+    capture
 }
 
 #[cfg(test)]
@@ -577,4 +744,49 @@ mod tests {
         assert!(contents.contains("line-one"));
         assert!(contents.contains("line-two"));
     }
+
+    #[test]
+    fn test_line_sink_joins_lines_split_across_chunks() {
+        let (capture, mut sink) = StderrCapture::with_sink("/test/script.ts".to_string());
+
+        sink.feed(b"first ha");
+        sink.feed(b"lf\r\nsecond\nunterminated");
+        sink.finish();
+
+        assert!(capture.wait_with_timeout(Duration::from_millis(1)));
+        assert_eq!(
+            capture.buffer.get_contents(),
+            "first half\nsecond\nunterminated"
+        );
+        let stats = capture.stats();
+        assert_eq!(stats.lines, 3);
+        assert_eq!(stats.bytes, 31);
+        assert_eq!(stats.dropped_bytes, 0);
+    }
+
+    #[test]
+    fn test_line_sink_bounds_lines_without_newlines() {
+        let (capture, mut sink) = StderrCapture::with_sink("/test/script.ts".to_string());
+        let chunk = vec![b'x'; 1024];
+
+        for _ in 0..64 {
+            sink.feed(&chunk);
+        }
+        sink.feed(b"\nafter\n");
+        sink.finish();
+
+        let stats = capture.stats();
+        assert_eq!(stats.lines, 2);
+        assert_eq!(stats.dropped_bytes, (64 * 1024 - MAX_LINE_BYTES) as u64);
+        assert!(capture.buffer.get_contents().ends_with("after"));
+    }
+
+    #[test]
+    fn test_wait_with_timeout_returns_false_while_stream_open() {
+        let (capture, mut sink) = StderrCapture::with_sink("/test/script.ts".to_string());
+
+        assert!(!capture.wait_with_timeout(Duration::from_millis(10)));
+        sink.finish();
+        assert!(capture.wait_with_timeout(Duration::from_millis(10)));
+    }
 }
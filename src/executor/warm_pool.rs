@@ -0,0 +1,570 @@
+//! Pre-warmed bun workers for instant script launch
+//!
+//! A cold launch pays bun startup plus the SDK preload before the script can
+//! send its first protocol message. The pool keeps a few workers that have
+//! already done both: each runs `bun run --preload kit-sdk.ts warm-runner.ts`
+//! and parks until it reads one `warmRun` JSONL line on stdin naming the
+//! script and its argv. The runner then imports the script in-process, so
+//! from the first prompt onwards the worker speaks the normal protocol and
+//! the caller gets an ordinary [`ScriptSession`].
+//!
+//! Workers are single-use: taking one schedules a background refill. Parked
+//! workers exit on their own after the configured idle timeout (and when the
+//! app goes away and their stdin closes), so an idle app does not keep bun
+//! processes around indefinitely. A reaper thread waits on them once the
+//! timeout passes so they do not linger as zombies; expired workers are not
+//! replaced until the next launch.
+//!
+//! Only launches without extra environment are served warm: the SDK reads
+//! some environment at preload time, which has already happened.
+
+use super::runner::{find_sdk_path, session_from_child, spawn_script_process, ScriptSession};
+use std::io::Write;
+use std::path::{Path, PathBuf};
+use std::process::Child;
+use std::sync::{Mutex, OnceLock};
+use std::time::{Duration, Instant};
+use tracing::{debug, info, warn};
+
+/// Bootstrap executed by warm workers after the SDK preload.
+const WARM_RUNNER_SOURCE: &str = r#"// Script Kit warm runtime worker. Managed by the app; rewritten on launch.
+// Parks after the SDK preload until the app hands over a script on stdin.
+const idleMs = Number(process.argv[2]) || 600_000;
+const idleTimer = setTimeout(() => process.exit(0), idleMs);
+let buffer = '';
+
+const exitWhenOrphaned = () => process.exit(0);
+const onData = (chunk: string | Buffer) => {
+  buffer += chunk.toString();
+  const newline = buffer.indexOf('\n');
+  if (newline === -1) return;
+
+  process.stdin.off('data', onData);
+  process.stdin.off('end', exitWhenOrphaned);
+  clearTimeout(idleTimer);
+  (process.stdin as any).unref?.();
+
+  const handoff = JSON.parse(buffer.slice(0, newline));
+  process.argv = [process.argv[0], handoff.scriptPath, ...handoff.args];
+  import(handoff.scriptPath).catch((error) => {
+    console.error(error);
+    process.exit(1);
+  });
+};
+
+(process.stdin as any).ref?.();
+process.stdin.on('data', onData);
+process.stdin.on('end', exitWhenOrphaned);
+"#;
+
+/// Workers this close to their idle timeout are not handed out, so a script
+/// never lands on a worker that is about to exit.
+const HANDOUT_AGE_MARGIN: Duration = Duration::from_secs(5);
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+struct WarmPoolSettings {
+    size: usize,
+    idle_timeout: Duration,
+}
+
+struct WarmWorker {
+    child: Child,
+    sdk_path: PathBuf,
+    spawned_at: Instant,
+}
+
+impl WarmWorker {
+    /// Whether this worker can still take a launch for `sdk_path`.
+    fn is_usable(&mut self, sdk_path: &Path, idle_timeout: Duration) -> bool {
+        self.sdk_path == sdk_path
+            && self.spawned_at.elapsed() + HANDOUT_AGE_MARGIN < idle_timeout
+            && matches!(self.child.try_wait(), Ok(None))
+    }
+
+    /// Whether this worker exited or outlived `idle_timeout` while parked.
+    fn has_expired(&mut self, idle_timeout: Duration) -> bool {
+        self.spawned_at.elapsed() >= idle_timeout || !matches!(self.child.try_wait(), Ok(None))
+    }
+
+    fn discard(mut self) {
+        let _ = self.child.kill();
+        let _ = self.child.wait();
+    }
+}
+
+struct WarmPool {
+    settings: WarmPoolSettings,
+    idle: Vec<WarmWorker>,
+    refilling: bool,
+    reaping: bool,
+}
+
+static WARM_POOL: Mutex<WarmPool> = Mutex::new(WarmPool {
+    settings: WarmPoolSettings {
+        size: 0,
+        idle_timeout: Duration::from_secs(
+            crate::config::defaults::DEFAULT_WARM_RUNTIME_IDLE_SECONDS,
+        ),
+    },
+    idle: Vec::new(),
+    refilling: false,
+    reaping: false,
+});
+
+/// Apply pool settings from config and start warming workers.
+///
+/// A size of 0 disables the pool and kills any parked workers.
+pub fn configure_warm_runtime_pool(size: usize, idle_timeout: Duration) {
+    let excess = {
+        let mut pool = WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        pool.settings = WarmPoolSettings { size, idle_timeout };
+        let keep = pool.idle.len().min(size);
+        pool.idle.split_off(keep)
+    };
+    for worker in excess {
+        worker.discard();
+    }
+    info!(
+        category = "EXEC",
+        pool_size = size,
+        idle_timeout_secs = idle_timeout.as_secs(),
+        "Warm runtime pool configured"
+    );
+    schedule_refill();
+}
+
+/// Hand `script_path` to a parked worker preloaded with `sdk_path`.
+///
+/// Returns `None` when no usable worker is parked; the caller then falls
+/// back to a cold spawn. Either way a refill is scheduled.
+pub(crate) fn take_warm_session(
+    sdk_path: &Path,
+    script_path: &str,
+    argv: &[String],
+) -> Option<ScriptSession> {
+    let start = Instant::now();
+    let session = loop {
+        let worker = {
+            let mut pool = WARM_POOL
+                .lock()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            if pool.settings.size == 0 {
+                return None;
+            }
+            pool.idle
+                .pop()
+                .map(|worker| (worker, pool.settings.idle_timeout))
+        };
+        let Some((mut worker, idle_timeout)) = worker else {
+            debug!(category = "EXEC", "Warm runtime pool empty");
+            break None;
+        };
+        if !worker.is_usable(sdk_path, idle_timeout) {
+            worker.discard();
+            continue;
+        }
+        match hand_off(worker, script_path, argv) {
+            Ok(session) => break Some(session),
+            Err(e) => {
+                warn!(category = "EXEC", error = %e, "Warm runtime handoff failed");
+            }
+        }
+    };
+
+    if let Some(session) = &session {
+        info!(
+            category = "EXEC",
+            pid = session.process_handle.pid,
+            script_path = %script_path,
+            duration_ms = start.elapsed().as_millis() as u64,
+            "Script handed to warm runtime"
+        );
+    }
+    schedule_refill();
+    session
+}
+
+/// Number of workers currently parked (benchmarks wait on this).
+#[cfg(test)]
+pub(crate) fn parked_warm_workers() -> usize {
+    WARM_POOL
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+        .idle
+        .len()
+}
+
+fn hand_off(
+    mut worker: WarmWorker,
+    script_path: &str,
+    argv: &[String],
+) -> Result<ScriptSession, String> {
+    let line = handoff_line(script_path, argv);
+    let write_result = match worker.child.stdin.as_mut() {
+        Some(stdin) => stdin
+            .write_all(line.as_bytes())
+            .and_then(|()| stdin.flush())
+            .map_err(|e| format!("Failed to hand script to warm runtime: {}", e)),
+        None => Err("Warm runtime has no stdin".to_string()),
+    };
+    if let Err(e) = write_result {
+        worker.discard();
+        return Err(e);
+    }
+    session_from_child(worker.child, script_path, "executor::warm_pool")
+}
+
+fn handoff_line(script_path: &str, argv: &[String]) -> String {
+    let mut line = serde_json::json!({
+        "type": "warmRun",
+        "scriptPath": script_path,
+        "args": argv,
+    })
+    .to_string();
+    line.push('\n');
+    line
+}
+
+/// Top the pool up to its configured size on a background thread.
+fn schedule_refill() {
+    {
+        let mut pool = WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        if pool.refilling || pool.idle.len() >= pool.settings.size {
+            return;
+        }
+        pool.refilling = true;
+    }
+
+    let spawned = std::thread::Builder::new()
+        .name("warm-runtime-pool".to_string())
+        .spawn(refill_pool);
+    if let Err(e) = spawned {
+        warn!(category = "EXEC", error = %e, "Failed to start warm runtime refill");
+        WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+            .refilling = false;
+    }
+}
+
+fn refill_pool() {
+    let Some((sdk_path, runner_path)) = find_sdk_path().and_then(|sdk| {
+        let runner = ensure_warm_runner(&sdk)?;
+        Some((sdk, runner))
+    }) else {
+        warn!(
+            category = "EXEC",
+            "Warm runtime pool disabled: SDK or warm runner unavailable"
+        );
+        WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+            .refilling = false;
+        return;
+    };
+
+    loop {
+        let settings = {
+            let mut pool = WARM_POOL
+                .lock()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            if pool.idle.len() >= pool.settings.size {
+                pool.refilling = false;
+                return;
+            }
+            pool.settings
+        };
+
+        let worker = match spawn_worker(&sdk_path, &runner_path, settings.idle_timeout) {
+            Ok(worker) => worker,
+            Err(e) => {
+                warn!(category = "EXEC", error = %e, "Failed to spawn warm runtime");
+                WARM_POOL
+                    .lock()
+                    .unwrap_or_else(|poisoned| poisoned.into_inner())
+                    .refilling = false;
+                return;
+            }
+        };
+
+        let mut pool = WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        if pool.idle.len() < pool.settings.size {
+            debug!(
+                category = "EXEC",
+                pid = worker.child.id(),
+                parked = pool.idle.len() + 1,
+                "Warm runtime parked"
+            );
+            pool.idle.push(worker);
+            drop(pool);
+            schedule_reaper();
+        } else {
+            drop(pool);
+            worker.discard();
+        }
+    }
+}
+
+/// Reap parked workers as their idle timeouts pass, on a background thread
+/// that stops once nothing is parked.
+fn schedule_reaper() {
+    {
+        let mut pool = WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        if pool.reaping || pool.idle.is_empty() {
+            return;
+        }
+        pool.reaping = true;
+    }
+
+    let spawned = std::thread::Builder::new()
+        .name("warm-runtime-reaper".to_string())
+        .spawn(reap_idle_workers);
+    if let Err(e) = spawned {
+        warn!(category = "EXEC", error = %e, "Failed to start warm runtime reaper");
+        WARM_POOL
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+            .reaping = false;
+    }
+}
+
+fn reap_idle_workers() {
+    loop {
+        let (expired, next_deadline) = {
+            let mut pool = WARM_POOL
+                .lock()
+                .unwrap_or_else(|poisoned| poisoned.into_inner());
+            let idle_timeout = pool.settings.idle_timeout;
+            let expired = take_expired(&mut pool.idle, idle_timeout);
+            let next_deadline = pool
+                .idle
+                .iter()
+                .map(|worker| worker.spawned_at + idle_timeout)
+                .min();
+            if next_deadline.is_none() {
+                pool.reaping = false;
+            }
+            (expired, next_deadline)
+        };
+        for worker in expired {
+            debug!(
+                category = "EXEC",
+                pid = worker.child.id(),
+                "Warm runtime idle timeout reaped"
+            );
+            worker.discard();
+        }
+        let Some(deadline) = next_deadline else {
+            return;
+        };
+        std::thread::sleep(deadline.saturating_duration_since(Instant::now()));
+    }
+}
+
+/// Remove the workers that have exited or outlived `idle_timeout`, keeping
+/// the rest in order.
+fn take_expired(idle: &mut Vec<WarmWorker>, idle_timeout: Duration) -> Vec<WarmWorker> {
+    let mut expired = Vec::new();
+    for mut worker in std::mem::take(idle) {
+        if worker.has_expired(idle_timeout) {
+            expired.push(worker);
+        } else {
+            idle.push(worker);
+        }
+    }
+    expired
+}
+
+fn spawn_worker(
+    sdk_path: &Path,
+    runner_path: &Path,
+    idle_timeout: Duration,
+) -> Result<WarmWorker, String> {
+    let sdk = sdk_path.to_string_lossy();
+    let runner = runner_path.to_string_lossy();
+    let idle_ms = idle_timeout.as_millis().to_string();
+    let child = spawn_script_process("bun", &["run", "--preload", &sdk, &runner, &idle_ms], &[])?;
+    Ok(WarmWorker {
+        child,
+        sdk_path: sdk_path.to_path_buf(),
+        spawned_at: Instant::now(),
+    })
+}
+
+/// Write the warm runner next to the SDK (once per process, only if changed).
+fn ensure_warm_runner(sdk_path: &Path) -> Option<PathBuf> {
+    static WARM_RUNNER: OnceLock<Option<PathBuf>> = OnceLock::new();
+    WARM_RUNNER
+        .get_or_init(|| {
+            let runner_path = sdk_path.with_file_name("warm-runner.ts");
+            if std::fs::read_to_string(&runner_path).ok().as_deref() == Some(WARM_RUNNER_SOURCE) {
+                return Some(runner_path);
+            }
+            // Atomic write: temp file then rename to prevent partial reads
+            let temp_path = runner_path.with_extension("tmp");
+            let written = std::fs::write(&temp_path, WARM_RUNNER_SOURCE)
+                .and_then(|()| std::fs::rename(&temp_path, &runner_path));
+            match written {
+                Ok(()) => Some(runner_path),
+                Err(e) => {
+                    warn!(
+                        category = "EXEC",
+                        path = %runner_path.display(),
+                        error = %e,
+                        "Failed to write warm runner"
+                    );
+                    None
+                }
+            }
+        })
+        .clone()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_handoff_line_is_single_jsonl_message() {
+        let line = handoff_line("/tmp/a \"b\".ts", &["x\ny".to_string()]);
+        assert!(line.ends_with('\n'));
+        assert_eq!(line.matches('\n').count(), 1);
+
+        let value: serde_json::Value = serde_json::from_str(line.trim_end()).unwrap();
+        assert_eq!(value["type"], "warmRun");
+        assert_eq!(value["scriptPath"], "/tmp/a \"b\".ts");
+        assert_eq!(value["args"], serde_json::json!(["x\ny"]));
+    }
+
+    #[test]
+    fn test_warm_runner_imports_handed_off_script_with_its_argv() {
+        if which::which("bun").is_err() {
+            eprintln!("skipping warm runner test because bun is not installed");
+            return;
+        }
+        let temp_dir = tempfile::tempdir().unwrap();
+        let runner_path = temp_dir.path().join("warm-runner.ts");
+        std::fs::write(&runner_path, WARM_RUNNER_SOURCE).unwrap();
+        let script_path = temp_dir.path().join("argv.ts");
+        std::fs::write(
+            &script_path,
+            "console.log(JSON.stringify(process.argv.slice(1)));\n",
+        )
+        .unwrap();
+        let script = script_path.to_string_lossy().into_owned();
+        let runner = runner_path.to_string_lossy().into_owned();
+
+        let mut child = spawn_script_process("bun", &["run", &runner, "60000"], &[])
+            .expect("spawn should succeed");
+        let args = vec!["--flag".to_string(), "two words".to_string()];
+        child
+            .stdin
+            .as_mut()
+            .expect("runner stdin")
+            .write_all(handoff_line(&script, &args).as_bytes())
+            .unwrap();
+        let output = child.wait_with_output().expect("runner should exit");
+
+        let argv: Vec<String> =
+            serde_json::from_slice(&output.stdout).expect("script should print its argv");
+        assert_eq!(argv, vec![script, args[0].clone(), args[1].clone()]);
+    }
+
+    #[test]
+    fn test_warm_runner_exits_after_idle_timeout() {
+        if which::which("bun").is_err() {
+            eprintln!("skipping warm runner test because bun is not installed");
+            return;
+        }
+        let temp_dir = tempfile::tempdir().unwrap();
+        let runner_path = temp_dir.path().join("warm-runner.ts");
+        std::fs::write(&runner_path, WARM_RUNNER_SOURCE).unwrap();
+        let runner = runner_path.to_string_lossy().into_owned();
+
+        let mut child = spawn_script_process("bun", &["run", &runner, "200"], &[])
+            .expect("spawn should succeed");
+        let deadline = Instant::now() + Duration::from_secs(10);
+        let status = loop {
+            if let Some(status) = child.try_wait().unwrap() {
+                break status;
+            }
+            assert!(Instant::now() < deadline, "idle runner should exit");
+            std::thread::sleep(Duration::from_millis(20));
+        };
+        assert!(status.success());
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn test_take_expired_removes_exited_and_timed_out_workers() {
+        let worker = |script: &str, age: Duration| WarmWorker {
+            child: spawn_script_process("sh", &["-c", script], &[]).expect("spawn should succeed"),
+            sdk_path: PathBuf::from("/sdk/kit-sdk.ts"),
+            spawned_at: Instant::now() - age,
+        };
+        let mut exited = worker("exit 0", Duration::ZERO);
+        let _ = exited.child.wait();
+        let mut idle = vec![
+            exited,
+            worker("sleep 30", Duration::from_secs(10)),
+            worker("sleep 30", Duration::ZERO),
+        ];
+
+        let expired = take_expired(&mut idle, Duration::from_secs(5));
+        assert_eq!(expired.len(), 2);
+        assert_eq!(idle.len(), 1);
+        for worker in expired.into_iter().chain(idle) {
+            let pid = worker.child.id();
+            worker.discard();
+            // Reaped: the pid no longer names a child of this process.
+            // SAFETY: non-blocking waitpid on a pid we spawned.
+            let reaped = unsafe { libc::waitpid(pid as i32, std::ptr::null_mut(), libc::WNOHANG) };
+            assert_eq!(reaped, -1);
+        }
+    }
+
+    #[cfg(unix)]
+    #[test]
+    fn test_hand_off_turns_parked_worker_into_session() {
+        // Stand-in worker: answers a warmRun handoff with a first message.
+        let child = spawn_script_process(
+            "sh",
+            &[
+                "-c",
+                "IFS= read -r line; case \"$line\" in *warmRun*/tmp/hello.ts*|*/tmp/hello.ts*warmRun*) printf '{\"type\":\"beep\"}\\n';; esac",
+            ],
+            &[],
+        )
+        .expect("spawn should succeed");
+        let mut worker = WarmWorker {
+            child,
+            sdk_path: PathBuf::from("/sdk/kit-sdk.ts"),
+            spawned_at: Instant::now(),
+        };
+        let idle_timeout = Duration::from_secs(60);
+        assert!(worker.is_usable(Path::new("/sdk/kit-sdk.ts"), idle_timeout));
+        assert!(!worker.is_usable(Path::new("/other/kit-sdk.ts"), idle_timeout));
+        assert!(!worker.is_usable(Path::new("/sdk/kit-sdk.ts"), HANDOUT_AGE_MARGIN));
+
+        let session = hand_off(worker, "/tmp/hello.ts", &["--flag".to_string()])
+            .expect("handoff should succeed");
+        let mut split = session.split();
+        let first = split
+            .stdout_reader
+            .next_message()
+            .expect("worker should answer the handoff")
+            .expect("worker should send one message");
+        assert!(matches!(first, crate::protocol::Message::Beep { .. }));
+
+        split.process_handle.kill();
+        let _ = split.child.wait();
+    }
+}
@@ -145,6 +145,9 @@ pub mod builtins;
 pub mod day_page;
 pub mod favicons;
 
+// Unified index behind the launcher's passive notes/history sections
+pub mod root_search_index;
+
 // Typed handle for path-prompt action ids. Physically lives under
 // `src/app_impl/` (pulled into the binary via `include!`); the lib
 // re-exports the same file so the inline round-trip tests run under
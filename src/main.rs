@@ -186,6 +186,9 @@ mod favicons;
 mod favorites;
 mod menu_bar;
 
+// Unified index behind the launcher's passive notes/history sections
+mod root_search_index;
+
 // Frontmost app tracker - Background observer for tracking active application
 #[cfg(target_os = "macos")]
 mod frontmost_app_tracker;
@@ -163,6 +163,18 @@
         extra_secret_patterns: secret_rejection.extra_secret_patterns,
     });
 
+    // Resolve bun/node/SDK paths once and keep them valid from a directory
+    // watcher, so script launches do not re-probe the filesystem.
+    executor::start_runtime_path_validator();
+
+    // Park pre-warmed bun workers (SDK already preloaded) for script launches.
+    // Refilling happens on a background thread, so this never blocks startup.
+    let process_limits = loaded_config.get_process_limits();
+    executor::configure_warm_runtime_pool(
+        process_limits.warm_pool_size(),
+        process_limits.warm_pool_idle_timeout(),
+    );
+
     // Initialize clipboard history monitoring (background thread)
     if let Err(e) = clipboard_history::init_clipboard_history() {
         logging::log(
@@ -1739,20 +1751,20 @@ app.run(move |cx: &mut App| {
                         }
                     }
 
-                    // Rescan disk off the UI thread and replace the in-memory
+                    // Rescan disk off the UI thread and update the in-memory
                     // cache — scan_applications() alone only clones the cache,
                     // so new/removed apps would never appear until restart.
-                    cx.background_executor()
-                        .spawn(async move {
-                            let _ = app_launcher::scan_applications_fresh();
-                        })
+                    // Unchanged bundles are skipped by mtime.
+                    let delta = cx
+                        .background_executor()
+                        .spawn(async move { app_launcher::scan_applications_incremental() })
                         .await;
 
-                    // Notify UI to re-fetch cached apps and invalidate search caches
-                    // This ensures new apps appear in search results immediately
+                    // Patch the UI's app list and invalidate search caches only
+                    // when something actually changed.
                     cx.update(|cx| {
                         app_entity_for_apps.update(cx, |view, ctx| {
-                            view.refresh_apps(ctx);
+                            view.apply_app_scan_delta(&delta, ctx);
                         });
                     });
                 }
@@ -2318,6 +2330,7 @@ cx.spawn(async move |cx: &mut gpui::AsyncApp| {
                                 // Passive AX-only selection sniff for the "Rewrite
                                 // selection" hint chip — mirrors show_main_window_helper.
                                 view.refresh_shown_selection_hint(ctx);
+                                crate::context_snapshot::prefetch_context_on_launcher_open();
 
                                 // Run-14 Pass-13 fix: echo a windowVisibilityAck
                                 // back so `session.sh rpc … {"type":"show",
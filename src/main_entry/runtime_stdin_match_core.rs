@@ -105,6 +105,7 @@
                                 // Passive AX-only selection sniff for the "Rewrite
                                 // selection" hint chip — mirrors show_main_window_helper.
                                 view.refresh_shown_selection_hint(ctx);
+                                crate::context_snapshot::prefetch_context_on_launcher_open();
                             }
                             ExternalCommand::Hide { ref request_id } => {
                                 let rid = request_id.as_deref().unwrap_or("-");
@@ -642,6 +642,9 @@ pub(crate) struct ScriptListApp {
     builtin_entries: Vec<builtins::BuiltInEntry>,
     /// Cached list of installed applications for main search and AppLauncherView
     apps: Vec<app_launcher::AppInfo>,
+    /// App-cache generation `apps` was read at; `None` until the first read.
+    /// An incremental scan delta only patches the list it was computed from.
+    apps_generation: Option<u64>,
     /// P0 FIX: Cached clipboard entries for ClipboardHistoryView (avoids cloning per frame)
     cached_clipboard_entries: Vec<clipboard_history::ClipboardEntryMeta>,
     /// Sequential paste state machine (Raycast-style paste-one-at-a-time)
@@ -704,6 +707,9 @@ pub(crate) struct ScriptListApp {
     root_file_source_chip_visible_limit: usize,
     /// Frozen cache-refreshable passive rows for the current root-search query frame.
     root_passive_frame: Option<RootPassiveFrame>,
+    /// Passive sources that missed the frame deadline, waiting for
+    /// `start_root_passive_late_section_pump` to patch them into the frame.
+    root_passive_late_sections: Option<crate::root_passive_sources::RootPassiveLateSections>,
     // ── Root "From Your Brain" async semantic pass state ────────────
     /// Async hybrid (FTS+cosine) brain hits keyed by the trimmed search text
     /// they were computed for. Preferred over the sync lexical pass while the
@@ -1077,7 +1083,7 @@ pub(crate) struct ScriptListApp {
     pub(crate) current_main_menu_theme: crate::designs::MainMenuThemeVariant,
     // Toast manager for notification queue
     toast_manager: ToastManager,
-    // Cache for decoded clipboard images (entry_id -> RenderImage)
+    // Cache for decoded clipboard list thumbnails (entry_id -> RenderImage)
     clipboard_image_cache: std::collections::HashMap<String, Arc<gpui::RenderImage>>,
     // Frecency store for tracking script usage
     frecency_store: FrecencyStore,
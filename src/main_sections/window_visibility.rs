@@ -297,6 +297,9 @@ fn show_main_window_helper(
         // "Rewrite selection" hint chip. Must run at show time, while the
         // frontmost app still owns AX focus; never touches the pasteboard.
         view.refresh_shown_selection_hint(ctx);
+        // Speculative cheap context capture so a Tab AI handoff from this
+        // show can reuse it instead of blocking. AX-only, no keystrokes.
+        crate::context_snapshot::prefetch_context_on_launcher_open();
         if needs_reset_before_show {
             view.reset_to_script_list(ctx);
         } else if restore_after_focus_loss && matches!(view.current_view, AppView::ScriptList) {
@@ -0,0 +1,364 @@
+//! Revision-tagged serialization cache for the script and scriptlet catalogs.
+//!
+//! Agents poll `scripts://`, `scriptlets://`, `kit://scripts` and
+//! `kit://scriptlets` far more often than the catalog changes. The MCP server
+//! reads the catalog through [`loaded_catalog`], which reloads from disk only
+//! when the script watcher has bumped
+//! [`crate::scripts::catalog_write_revision`]. Each catalog keeps one
+//! snapshot of its compact per-entry JSON; a read of the loaded catalog at the
+//! revision its snapshot was built or verified at returns it without touching
+//! the entries.
+//!
+//! Any other slice (app state, tests) falls back to a content fingerprint, so
+//! equal catalogs still share a snapshot. A new fingerprint bumps the
+//! process-wide snapshot revision; the fingerprint itself doubles as the ETag
+//! so `ifNoneMatch` keeps working even when two catalogs alternate.
+//!
+//! `kit://scripts?limit=N&cursor=C&ifNoneMatch=E` (and the scriptlets
+//! equivalent) page over the cached entries. Cursors embed the ETag of the
+//! snapshot they were issued from, and a cursor from an older catalog is
+//! rejected rather than silently skipping or repeating entries.
+
+use super::{
+    parse_u64_query_param, query_string_param, ScriptResourceEntry, ScriptletResourceEntry,
+};
+use crate::scripts::{Script, Scriptlet};
+use std::collections::hash_map::DefaultHasher;
+use std::hash::Hasher;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, OnceLock};
+
+/// Page size used when a client passes `cursor` without `limit`.
+pub(super) const CATALOG_DEFAULT_PAGE_LIMIT: usize = 200;
+
+/// Hard cap on a single catalog page.
+pub(super) const CATALOG_MAX_PAGE_LIMIT: usize = 1000;
+
+static NEXT_CATALOG_REVISION: AtomicU64 = AtomicU64::new(1);
+static LOADED_CATALOG: Mutex<Option<LoadedCatalog>> = Mutex::new(None);
+static SCRIPTS_SNAPSHOT: Mutex<Option<CachedSnapshot>> = Mutex::new(None);
+static SCRIPTLETS_SNAPSHOT: Mutex<Option<CachedSnapshot>> = Mutex::new(None);
+
+/// Scripts and scriptlets as loaded from disk at one catalog write revision.
+#[derive(Clone)]
+pub(crate) struct LoadedCatalog {
+    write_revision: u64,
+    pub(crate) scripts: Arc<[Arc<Script>]>,
+    pub(crate) scriptlets: Arc<[Arc<Scriptlet>]>,
+}
+
+/// The on-disk catalog, reloaded only when a script or scriptlet was written
+/// since the last load.
+pub(crate) fn loaded_catalog() -> LoadedCatalog {
+    let mut guard = LOADED_CATALOG
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner());
+    let write_revision = crate::scripts::catalog_write_revision();
+    if let Some(catalog) = guard.as_ref() {
+        if catalog.write_revision == write_revision {
+            return catalog.clone();
+        }
+    }
+
+    let catalog = LoadedCatalog {
+        write_revision,
+        scripts: crate::scripts::read_scripts().into(),
+        scriptlets: crate::scripts::load_scriptlets().into(),
+    };
+    tracing::debug!(
+        category = "MCP",
+        write_revision,
+        scripts = catalog.scripts.len(),
+        scriptlets = catalog.scriptlets.len(),
+        "Reloaded script catalog from disk"
+    );
+    *guard = Some(catalog.clone());
+    catalog
+}
+
+/// Write revision of `entries` when it is the slice [`loaded_catalog`] holds.
+/// The held `Arc` keeps that allocation alive, so a pointer match cannot be a
+/// different catalog reusing the address.
+fn loaded_write_revision<T>(
+    entries: &[T],
+    side: impl FnOnce(&LoadedCatalog) -> &[T],
+) -> Option<u64> {
+    let guard = LOADED_CATALOG
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner());
+    let catalog = guard.as_ref()?;
+    std::ptr::eq(side(catalog), entries).then_some(catalog.write_revision)
+}
+
+/// A catalog's current snapshot and the loaded-catalog write revision it is
+/// known to match, if any.
+struct CachedSnapshot {
+    snapshot: Arc<CatalogSnapshot>,
+    write_revision: Option<u64>,
+}
+
+/// Serialized view of one catalog at one revision.
+#[derive(Debug)]
+pub(super) struct CatalogSnapshot {
+    fingerprint: u64,
+    /// Monotonic revision, bumped whenever the catalog fingerprint changes.
+    pub(super) revision: u64,
+    /// Opaque validator clients echo back through `ifNoneMatch`.
+    pub(super) etag: String,
+    /// Compact JSON for each entry, in catalog order.
+    entries: Vec<Box<str>>,
+    /// Compact JSON array of every entry, joined on first full read.
+    full_array: OnceLock<String>,
+}
+
+impl CatalogSnapshot {
+    pub(super) fn len(&self) -> usize {
+        self.entries.len()
+    }
+
+    /// Compact JSON array of the whole catalog.
+    pub(super) fn full_array(&self) -> &str {
+        self.full_array
+            .get_or_init(|| join_json_array(&self.entries))
+    }
+}
+
+/// Snapshot of the script catalog, rebuilt only when its contents change.
+pub(super) fn scripts_snapshot(scripts: &[Arc<Script>]) -> Result<Arc<CatalogSnapshot>, String> {
+    let write_revision = loaded_write_revision(scripts, |catalog| &catalog.scripts);
+    cached_snapshot(
+        &SCRIPTS_SNAPSHOT,
+        "scripts",
+        write_revision,
+        || {
+            let mut hasher = DefaultHasher::new();
+            hasher.write_usize(scripts.len());
+            for script in scripts {
+                ScriptResourceEntry::hash_source(script, &mut hasher);
+            }
+            hasher.finish()
+        },
+        || {
+            scripts
+                .iter()
+                .map(|script| serde_json::to_string(&ScriptResourceEntry::from(script.as_ref())))
+                .collect()
+        },
+    )
+}
+
+/// Snapshot of the scriptlet catalog, rebuilt only when its contents change.
+pub(super) fn scriptlets_snapshot(
+    scriptlets: &[Arc<Scriptlet>],
+) -> Result<Arc<CatalogSnapshot>, String> {
+    let write_revision = loaded_write_revision(scriptlets, |catalog| &catalog.scriptlets);
+    cached_snapshot(
+        &SCRIPTLETS_SNAPSHOT,
+        "scriptlets",
+        write_revision,
+        || {
+            let mut hasher = DefaultHasher::new();
+            hasher.write_usize(scriptlets.len());
+            for scriptlet in scriptlets {
+                ScriptletResourceEntry::hash_source(scriptlet, &mut hasher);
+            }
+            hasher.finish()
+        },
+        || {
+            scriptlets
+                .iter()
+                .map(|scriptlet| {
+                    serde_json::to_string(&ScriptletResourceEntry::from(scriptlet.as_ref()))
+                })
+                .collect()
+        },
+    )
+}
+
+/// Returns the cached snapshot without hashing when `write_revision` is the
+/// one it was last matched at; otherwise fingerprints the entries and only
+/// serializes when the fingerprint moved.
+fn cached_snapshot(
+    slot: &Mutex<Option<CachedSnapshot>>,
+    catalog: &'static str,
+    write_revision: Option<u64>,
+    fingerprint: impl FnOnce() -> u64,
+    serialize_entries: impl FnOnce() -> Result<Vec<String>, serde_json::Error>,
+) -> Result<Arc<CatalogSnapshot>, String> {
+    let mut guard = slot.lock().unwrap_or_else(|poisoned| poisoned.into_inner());
+    if let Some(cached) = guard.as_ref() {
+        if write_revision.is_some() && cached.write_revision == write_revision {
+            return Ok(Arc::clone(&cached.snapshot));
+        }
+    }
+
+    let fingerprint = fingerprint();
+    if let Some(cached) = guard.as_mut() {
+        if cached.snapshot.fingerprint == fingerprint {
+            cached.write_revision = write_revision;
+            return Ok(Arc::clone(&cached.snapshot));
+        }
+    }
+
+    let entries = serialize_entries()
+        .map_err(|e| format!("Failed to serialize {catalog}: {e}"))?
+        .into_iter()
+        .map(String::into_boxed_str)
+        .collect::<Vec<_>>();
+    let snapshot = Arc::new(CatalogSnapshot {
+        fingerprint,
+        revision: NEXT_CATALOG_REVISION.fetch_add(1, Ordering::Relaxed),
+        etag: format!("{fingerprint:016x}"),
+        entries,
+        full_array: OnceLock::new(),
+    });
+    tracing::debug!(
+        category = "MCP",
+        catalog,
+        revision = snapshot.revision,
+        count = snapshot.len(),
+        "Rebuilt catalog resource snapshot"
+    );
+    *guard = Some(CachedSnapshot {
+        snapshot: Arc::clone(&snapshot),
+        write_revision,
+    });
+    Ok(snapshot)
+}
+
+fn join_json_array<S: AsRef<str>>(entries: &[S]) -> String {
+    let capacity = entries
+        .iter()
+        .map(|entry| entry.as_ref().len() + 1)
+        .sum::<usize>()
+        + 2;
+    let mut out = String::with_capacity(capacity);
+    out.push('[');
+    for (index, entry) in entries.iter().enumerate() {
+        if index > 0 {
+            out.push(',');
+        }
+        out.push_str(entry.as_ref());
+    }
+    out.push(']');
+    out
+}
+
+/// Render the schema-versioned `kit://scripts` / `kit://scriptlets` envelope
+/// for `uri`, honouring `ifNoneMatch`, `cursor` and `limit`.
+///
+/// Without any of those parameters the whole catalog is returned, matching
+/// the pre-paging document shape plus `revision` and `etag`. `count` is
+/// always the total catalog size, not the page size.
+pub(super) fn render_catalog_document(
+    snapshot: &CatalogSnapshot,
+    uri: &str,
+    schema_version: u32,
+    list_key: &str,
+) -> Result<String, String> {
+    let total = snapshot.len();
+    let mut out = format!(
+        "{{\"schemaVersion\":{schema_version},\"count\":{total},\"revision\":{},\"etag\":\"{}\"",
+        snapshot.revision, snapshot.etag
+    );
+
+    if query_string_param(uri, "ifNoneMatch").as_deref() == Some(snapshot.etag.as_str()) {
+        out.push_str(&format!(",\"unchanged\":true,\"{list_key}\":[]}}"));
+        return Ok(out);
+    }
+
+    let cursor = query_string_param(uri, "cursor").filter(|cursor| !cursor.is_empty());
+    let limit = parse_u64_query_param(uri, "limit");
+    if cursor.is_none() && limit.is_none() {
+        out.push_str(&format!(",\"{list_key}\":"));
+        out.push_str(snapshot.full_array());
+        out.push('}');
+        return Ok(out);
+    }
+
+    let start = match cursor {
+        Some(cursor) => parse_catalog_cursor(&cursor, snapshot)?,
+        None => 0,
+    };
+    let limit = limit
+        .map(|limit| (limit as usize).clamp(1, CATALOG_MAX_PAGE_LIMIT))
+        .unwrap_or(CATALOG_DEFAULT_PAGE_LIMIT);
+    let end = start.saturating_add(limit).min(total);
+
+    out.push_str(&format!(",\"{list_key}\":"));
+    out.push_str(&join_json_array(&snapshot.entries[start..end]));
+    if end < total {
+        out.push_str(&format!(",\"nextCursor\":\"{}.{end}\"", snapshot.etag));
+    }
+    out.push('}');
+    Ok(out)
+}
+
+fn parse_catalog_cursor(cursor: &str, snapshot: &CatalogSnapshot) -> Result<usize, String> {
+    let (etag, offset) = cursor
+        .split_once('.')
+        .ok_or_else(|| format!("Invalid catalog cursor: {cursor}"))?;
+    if etag != snapshot.etag {
+        return Err(format!(
+            "Catalog cursor is stale: the catalog changed (now revision {}). Restart paging without a cursor.",
+            snapshot.revision
+        ));
+    }
+    let offset = offset
+        .parse::<usize>()
+        .map_err(|_| format!("Invalid catalog cursor: {cursor}"))?;
+    if offset > snapshot.len() {
+        return Err(format!("Invalid catalog cursor: {cursor}"));
+    }
+    Ok(offset)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn cached_snapshot_skips_fingerprint_at_matched_write_revision() {
+        let slot = Mutex::new(None);
+        let serialize = || Ok(vec!["{\"name\":\"one\"}".to_string()]);
+
+        let first = cached_snapshot(&slot, "test", Some(7), || 1, serialize).unwrap();
+        let same = cached_snapshot(
+            &slot,
+            "test",
+            Some(7),
+            || panic!("fingerprinted at a matched write revision"),
+            || panic!("reserialized at a matched write revision"),
+        )
+        .unwrap();
+        assert!(Arc::ptr_eq(&first, &same));
+
+        // A write that left the contents alone rehashes but keeps the snapshot.
+        let rehashed = cached_snapshot(
+            &slot,
+            "test",
+            Some(8),
+            || 1,
+            || panic!("reserialized an unchanged catalog"),
+        )
+        .unwrap();
+        assert!(Arc::ptr_eq(&first, &rehashed));
+
+        // Slices that are not the loaded catalog always fingerprint.
+        let mut fingerprinted = false;
+        let other = cached_snapshot(
+            &slot,
+            "test",
+            None,
+            || {
+                fingerprinted = true;
+                2
+            },
+            serialize,
+        )
+        .unwrap();
+        assert!(fingerprinted);
+        assert_ne!(other.etag, first.etag);
+        assert_eq!(other.full_array(), "[{\"name\":\"one\"}]");
+    }
+}
@@ -7,8 +7,11 @@
 //!
 //! Resources are read-only data that clients can access without tool calls.
 
+mod catalog_cache;
 mod transaction_resources;
 
+pub(crate) use catalog_cache::loaded_catalog;
+
 // --- merged from part_000.rs ---
 use crate::scripts::Script;
 use crate::scripts::Scriptlet;
@@ -94,6 +97,18 @@ impl From<&Script> for ScriptResourceEntry {
         }
     }
 }
+impl ScriptResourceEntry {
+    /// Feed exactly the fields [`From<&Script>`] reads into `state`, so the
+    /// catalog cache notices every change that would alter the entry.
+    pub(crate) fn hash_source(script: &Script, state: &mut impl std::hash::Hasher) {
+        use std::hash::Hash;
+        script.name.hash(state);
+        script.path.hash(state);
+        script.extension.hash(state);
+        script.description.hash(state);
+        script.schema.is_some().hash(state);
+    }
+}
 /// Scriptlet metadata for the scriptlets:// resource  
 #[derive(Debug, Clone, PartialEq, Eq, Serialize, Deserialize)]
 pub struct ScriptletResourceEntry {
@@ -126,6 +141,18 @@ impl From<&Scriptlet> for ScriptletResourceEntry {
         }
     }
 }
+impl ScriptletResourceEntry {
+    /// Feed exactly the fields [`From<&Scriptlet>`] reads into `state`.
+    pub(crate) fn hash_source(scriptlet: &Scriptlet, state: &mut impl std::hash::Hasher) {
+        use std::hash::Hash;
+        scriptlet.name.hash(state);
+        scriptlet.tool.hash(state);
+        scriptlet.description.hash(state);
+        scriptlet.group.hash(state);
+        scriptlet.keyword.hash(state);
+        scriptlet.shortcut.hash(state);
+    }
+}
 /// Get all available MCP resources
 pub fn get_resource_definitions() -> Vec<McpResource> {
     let mut resources = vec![
@@ -208,7 +235,7 @@ pub fn get_resource_definitions() -> Vec<McpResource> {
             uri: "kit://scripts".to_string(),
             name: "Scripts (versioned)".to_string(),
             description: Some(
-                "Schema-versioned list of all scripts discovered from installed plugins with metadata. plugins/main/scripts/ is the default personal plugin. Safe for repeated reads."
+                "Schema-versioned list of all scripts discovered from installed plugins with metadata. plugins/main/scripts/ is the default personal plugin. Safe for repeated reads: pass ?ifNoneMatch=<etag> for an unchanged reply and ?limit=N&cursor=<nextCursor> to page large catalogs."
                     .to_string(),
             ),
             mime_type: "application/json".to_string(),
@@ -217,7 +244,7 @@ pub fn get_resource_definitions() -> Vec<McpResource> {
             uri: "kit://scriptlets".to_string(),
             name: "Scriptlets (versioned)".to_string(),
             description: Some(
-                "Schema-versioned list of all scriptlets from markdown extension files with metadata."
+                "Schema-versioned list of all scriptlets from markdown extension files with metadata. Supports ?ifNoneMatch=<etag> and ?limit=N&cursor=<nextCursor>."
                     .to_string(),
             ),
             mime_type: "application/json".to_string(),
@@ -366,12 +393,22 @@ pub fn get_resource_definitions() -> Vec<McpResource> {
             ),
             mime_type: "application/json".to_string(),
         },
+        McpResource {
+            uri: SQLITE_DIAGNOSTICS_URI.to_string(),
+            name: "SQLite Query Stats".to_string(),
+            description: Some(
+                "Per-query lock wait and execution time for every app database since launch (count, average and max in microseconds), with each database's read-connection count."
+                    .to_string(),
+            ),
+            mime_type: "application/json".to_string(),
+        },
     ];
     resources.extend(transaction_resources::transaction_resource_definitions());
     resources
 }
 
 pub const PROTOCOL_STATS_DIAGNOSTICS_URI: &str = "kit://diagnostics/protocol-stats";
+pub const SQLITE_DIAGNOSTICS_URI: &str = "kit://diagnostics/sqlite";
 /// Read a specific resource by URI
 ///
 /// # Arguments
@@ -393,8 +430,12 @@ pub fn read_resource(
         "kit://state" => read_state_resource(app_state),
         "scripts://" => read_scripts_resource(scripts),
         "scriptlets://" => read_scriptlets_resource(scriptlets),
-        "kit://scripts" => read_kit_scripts_resource(scripts),
-        "kit://scriptlets" => read_kit_scriptlets_resource(scriptlets),
+        _ if uri == "kit://scripts" || uri.starts_with("kit://scripts?") => {
+            read_kit_scripts_resource(uri, scripts)
+        }
+        _ if uri == "kit://scriptlets" || uri.starts_with("kit://scriptlets?") => {
+            read_kit_scriptlets_resource(uri, scriptlets)
+        }
         "kit://sdk-reference" => read_sdk_reference_resource(),
         FAILED_SCRIPTS_RESOURCE_URI => read_kit_failed_scripts_resource(),
         SCRIPT_TEMPLATES_RESOURCE_URI => read_kit_script_templates_resource(),
@@ -445,6 +486,7 @@ pub fn read_resource(
         STDIN_COMMANDS_REFERENCE_URI => read_stdin_commands_resource(),
         TRIGGER_BUILTINS_REFERENCE_URI => read_trigger_builtins_resource(),
         PROTOCOL_STATS_DIAGNOSTICS_URI => read_protocol_stats_resource(),
+        SQLITE_DIAGNOSTICS_URI => read_sqlite_stats_resource(),
         _ if transaction_resources::is_transaction_resource_uri(uri) => {
             transaction_resources::read_transaction_resource(uri)
         }
@@ -785,32 +827,20 @@ fn read_computer_use_readiness_resource() -> Result<ResourceContent, String> {
 
 /// Read scripts:// resource
 fn read_scripts_resource(scripts: &[Arc<Script>]) -> Result<ResourceContent, String> {
-    let entries: Vec<ScriptResourceEntry> = scripts
-        .iter()
-        .map(|s| ScriptResourceEntry::from(s.as_ref()))
-        .collect();
-    let json = serde_json::to_string_pretty(&entries)
-        .map_err(|e| format!("Failed to serialize scripts: {}", e))?;
-
+    let snapshot = catalog_cache::scripts_snapshot(scripts)?;
     Ok(ResourceContent {
         uri: "scripts://".to_string(),
         mime_type: "application/json".to_string(),
-        text: json,
+        text: snapshot.full_array().to_string(),
     })
 }
 /// Read scriptlets:// resource
 fn read_scriptlets_resource(scriptlets: &[Arc<Scriptlet>]) -> Result<ResourceContent, String> {
-    let entries: Vec<ScriptletResourceEntry> = scriptlets
-        .iter()
-        .map(|s| ScriptletResourceEntry::from(s.as_ref()))
-        .collect();
-    let json = serde_json::to_string_pretty(&entries)
-        .map_err(|e| format!("Failed to serialize scriptlets: {}", e))?;
-
+    let snapshot = catalog_cache::scriptlets_snapshot(scriptlets)?;
     Ok(ResourceContent {
         uri: "scriptlets://".to_string(),
         mime_type: "application/json".to_string(),
-        text: json,
+        text: snapshot.full_array().to_string(),
     })
 }
 
@@ -884,8 +914,21 @@ pub const SCRIPT_TEMPLATES_RESOURCE_SCHEMA_VERSION: u32 = 1;
 #[serde(rename_all = "camelCase")]
 pub struct ScriptsResourceDocument {
     pub schema_version: u32,
+    /// Total catalog size, even when `scripts` holds a single page.
     pub count: usize,
     pub scripts: Vec<ScriptResourceEntry>,
+    /// Catalog revision the document was served from.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub revision: Option<u64>,
+    /// Validator to echo back as `?ifNoneMatch=` on the next read.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub etag: Option<String>,
+    /// `true` when `ifNoneMatch` matched; `scripts` is then empty.
+    #[serde(default, skip_serializing_if = "std::ops::Not::not")]
+    pub unchanged: bool,
+    /// Cursor for the next page when `limit`/`cursor` paging is in use.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub next_cursor: Option<String>,
 }
 
 /// Schema-versioned envelope for scriptlet metadata.
@@ -893,8 +936,17 @@ pub struct ScriptsResourceDocument {
 #[serde(rename_all = "camelCase")]
 pub struct ScriptletsResourceDocument {
     pub schema_version: u32,
+    /// Total catalog size, even when `scriptlets` holds a single page.
     pub count: usize,
     pub scriptlets: Vec<ScriptletResourceEntry>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub revision: Option<u64>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub etag: Option<String>,
+    #[serde(default, skip_serializing_if = "std::ops::Not::not")]
+    pub unchanged: bool,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub next_cursor: Option<String>,
 }
 
 /// A single failed-script entry for the `kit://failed-scripts` resource.
@@ -1892,21 +1944,24 @@ fn build_harness_workflow() -> HarnessWorkflow {
     }
 }
 
-/// Read kit://scripts schema-versioned resource
-fn read_kit_scripts_resource(scripts: &[Arc<Script>]) -> Result<ResourceContent, String> {
-    let entries: Vec<ScriptResourceEntry> = scripts
-        .iter()
-        .map(|s| ScriptResourceEntry::from(s.as_ref()))
-        .collect();
-    let doc = ScriptsResourceDocument {
-        schema_version: SCRIPTS_RESOURCE_SCHEMA_VERSION,
-        count: entries.len(),
-        scripts: entries,
-    };
-    let json = serde_json::to_string_pretty(&doc)
-        .map_err(|e| format!("Failed to serialize scripts document: {e}"))?;
+/// Read kit://scripts schema-versioned resource.
+///
+/// Served from the revision-tagged catalog cache; see
+/// [`catalog_cache::render_catalog_document`] for `ifNoneMatch`, `cursor`
+/// and `limit`.
+fn read_kit_scripts_resource(
+    uri: &str,
+    scripts: &[Arc<Script>],
+) -> Result<ResourceContent, String> {
+    let snapshot = catalog_cache::scripts_snapshot(scripts)?;
+    let json = catalog_cache::render_catalog_document(
+        &snapshot,
+        uri,
+        SCRIPTS_RESOURCE_SCHEMA_VERSION,
+        "scripts",
+    )?;
     Ok(ResourceContent {
-        uri: "kit://scripts".to_string(),
+        uri: uri.to_string(),
         mime_type: "application/json".to_string(),
         text: json,
     })
@@ -1964,21 +2019,20 @@ fn read_kit_script_templates_resource() -> Result<ResourceContent, String> {
     })
 }
 
-/// Read kit://scriptlets schema-versioned resource
-fn read_kit_scriptlets_resource(scriptlets: &[Arc<Scriptlet>]) -> Result<ResourceContent, String> {
-    let entries: Vec<ScriptletResourceEntry> = scriptlets
-        .iter()
-        .map(|s| ScriptletResourceEntry::from(s.as_ref()))
-        .collect();
-    let doc = ScriptletsResourceDocument {
-        schema_version: SCRIPTLETS_RESOURCE_SCHEMA_VERSION,
-        count: entries.len(),
-        scriptlets: entries,
-    };
-    let json = serde_json::to_string_pretty(&doc)
-        .map_err(|e| format!("Failed to serialize scriptlets document: {e}"))?;
+/// Read kit://scriptlets schema-versioned resource.
+fn read_kit_scriptlets_resource(
+    uri: &str,
+    scriptlets: &[Arc<Scriptlet>],
+) -> Result<ResourceContent, String> {
+    let snapshot = catalog_cache::scriptlets_snapshot(scriptlets)?;
+    let json = catalog_cache::render_catalog_document(
+        &snapshot,
+        uri,
+        SCRIPTLETS_RESOURCE_SCHEMA_VERSION,
+        "scriptlets",
+    )?;
     Ok(ResourceContent {
-        uri: "kit://scriptlets".to_string(),
+        uri: uri.to_string(),
         mime_type: "application/json".to_string(),
         text: json,
     })
@@ -2916,6 +2970,20 @@ fn read_protocol_stats_resource() -> Result<ResourceContent, String> {
     })
 }
 
+/// Read the `kit://diagnostics/sqlite` resource
+fn read_sqlite_stats_resource() -> Result<ResourceContent, String> {
+    let report = serde_json::json!({
+        "databases": crate::utils::sqlite_pool::query_report(),
+    });
+    let text = serde_json::to_string_pretty(&report)
+        .map_err(|e| format!("failed to serialize sqlite query stats: {e}"))?;
+    Ok(ResourceContent {
+        uri: SQLITE_DIAGNOSTICS_URI.to_string(),
+        mime_type: "application/json".to_string(),
+        text,
+    })
+}
+
 /// Convert resource content to JSON-RPC result format
 pub fn resource_content_to_value(content: ResourceContent) -> Value {
     serde_json::json!({
@@ -3629,7 +3697,7 @@ mod tests {
 
         assert_eq!(
             resources.len(),
-            29,
+            30,
             "Resource registry count should be updated when new MCP resources land"
         );
 
@@ -4243,6 +4311,155 @@ mod tests {
         assert!(doc.scriptlets.is_empty());
     }
 
+    #[test]
+    fn kit_scripts_resource_reports_unchanged_for_matching_etag() {
+        let scripts = wrap_scripts(vec![
+            test_script("Etag Alpha", None),
+            test_script("Etag Beta", None),
+        ]);
+
+        let first: ScriptsResourceDocument = serde_json::from_str(
+            &read_resource("kit://scripts", &scripts, &[], None)
+                .unwrap()
+                .text,
+        )
+        .unwrap();
+        let etag = first.etag.clone().expect("etag on full read");
+        assert!(first.revision.is_some());
+        assert!(!first.unchanged);
+
+        // A freshly loaded catalog with the same contents keeps the etag.
+        let reloaded = wrap_scripts(vec![
+            test_script("Etag Alpha", None),
+            test_script("Etag Beta", None),
+        ]);
+        let content = read_resource(
+            &format!("kit://scripts?ifNoneMatch={etag}"),
+            &reloaded,
+            &[],
+            None,
+        )
+        .unwrap();
+        let unchanged: ScriptsResourceDocument = serde_json::from_str(&content.text).unwrap();
+        assert!(unchanged.unchanged);
+        assert_eq!(unchanged.count, 2);
+        assert!(unchanged.scripts.is_empty());
+        assert_eq!(unchanged.etag.as_deref(), Some(etag.as_str()));
+
+        let edited = wrap_scripts(vec![
+            test_script("Etag Alpha", Some("now documented")),
+            test_script("Etag Beta", None),
+        ]);
+        let content = read_resource(
+            &format!("kit://scripts?ifNoneMatch={etag}"),
+            &edited,
+            &[],
+            None,
+        )
+        .unwrap();
+        let changed: ScriptsResourceDocument = serde_json::from_str(&content.text).unwrap();
+        assert!(!changed.unchanged);
+        assert_eq!(changed.scripts.len(), 2);
+        assert_ne!(changed.etag.as_deref(), Some(etag.as_str()));
+    }
+
+    #[test]
+    fn kit_scripts_resource_pages_with_cursor() {
+        let scripts = wrap_scripts(
+            (0..5)
+                .map(|index| test_script(&format!("Paged Script {index}"), None))
+                .collect(),
+        );
+
+        let mut names = Vec::new();
+        let mut uri = "kit://scripts?limit=2".to_string();
+        let mut pages = 0;
+        loop {
+            let content = read_resource(&uri, &scripts, &[], None).unwrap();
+            assert_eq!(content.uri, uri);
+            let doc: ScriptsResourceDocument = serde_json::from_str(&content.text).unwrap();
+            assert_eq!(doc.count, 5);
+            assert!(doc.scripts.len() <= 2);
+            names.extend(doc.scripts.into_iter().map(|entry| entry.name));
+            pages += 1;
+            match doc.next_cursor {
+                Some(cursor) => uri = format!("kit://scripts?limit=2&cursor={cursor}"),
+                None => break,
+            }
+        }
+
+        assert_eq!(pages, 3);
+        let expected: Vec<String> = (0..5)
+            .map(|index| format!("Paged Script {index}"))
+            .collect();
+        assert_eq!(names, expected);
+    }
+
+    #[test]
+    fn kit_scripts_resource_rejects_cursor_from_older_catalog() {
+        let scripts = wrap_scripts(vec![
+            test_script("Stale One", None),
+            test_script("Stale Two", None),
+        ]);
+        let content = read_resource("kit://scripts?limit=1", &scripts, &[], None).unwrap();
+        let doc: ScriptsResourceDocument = serde_json::from_str(&content.text).unwrap();
+        let cursor = doc.next_cursor.expect("second page cursor");
+
+        let grown = wrap_scripts(vec![
+            test_script("Stale One", None),
+            test_script("Stale Two", None),
+            test_script("Stale Three", None),
+        ]);
+        let error = read_resource(
+            &format!("kit://scripts?limit=1&cursor={cursor}"),
+            &grown,
+            &[],
+            None,
+        )
+        .expect_err("stale cursor must not resolve");
+        assert!(error.contains("stale"), "unexpected error: {error}");
+    }
+
+    #[test]
+    fn kit_scriptlets_resource_supports_paging_and_unchanged() {
+        let scriptlets = wrap_scriptlets(vec![
+            test_scriptlet("Page Open", "open", None),
+            test_scriptlet("Page Paste", "paste", None),
+            test_scriptlet("Page Bash", "bash", None),
+        ]);
+
+        let content = read_resource("kit://scriptlets?limit=2", &[], &scriptlets, None).unwrap();
+        let page: ScriptletsResourceDocument = serde_json::from_str(&content.text).unwrap();
+        assert_eq!(page.count, 3);
+        assert_eq!(page.scriptlets.len(), 2);
+        assert!(page.next_cursor.is_some());
+
+        let etag = page.etag.expect("etag");
+        let content = read_resource(
+            &format!("kit://scriptlets?ifNoneMatch={etag}"),
+            &[],
+            &scriptlets,
+            None,
+        )
+        .unwrap();
+        let unchanged: ScriptletsResourceDocument = serde_json::from_str(&content.text).unwrap();
+        assert!(unchanged.unchanged);
+        assert!(unchanged.scriptlets.is_empty());
+    }
+
+    #[test]
+    fn legacy_scripts_resource_is_compact_and_matches_entries() {
+        let scripts = wrap_scripts(vec![test_script("Compact", Some("one line"))]);
+        let content = read_resource("scripts://", &scripts, &[], None).unwrap();
+        assert!(!content.text.contains('\n'));
+
+        let entries: Vec<ScriptResourceEntry> = serde_json::from_str(&content.text).unwrap();
+        assert_eq!(
+            entries,
+            vec![ScriptResourceEntry::from(scripts[0].as_ref())]
+        );
+    }
+
     #[test]
     fn sdk_reference_resource_returns_valid_document() {
         let content = read_resource("kit://sdk-reference", &[], &[], None).expect("should resolve");
@@ -507,9 +507,9 @@ fn handle_rpc_request(
     );
 
     // Load scripts and scriptlets for context-aware responses
-    // This allows resources/read and tools/list to return actual data
-    let scripts = crate::scripts::read_scripts();
-    let scriptlets = crate::scripts::load_scriptlets();
+    // This allows resources/read and tools/list to return actual data.
+    // Reloaded from disk only after the script watcher saw a write.
+    let catalog = crate::mcp_resources::loaded_catalog();
 
     // Parse and handle request with full context
     let response = match mcp_protocol::parse_request(&body_str) {
@@ -519,8 +519,8 @@ fn handle_rpc_request(
                 .build()?;
             runtime.block_on(mcp_protocol::handle_request_with_runtime_context(
                 request,
-                &scripts,
-                &scriptlets,
+                &catalog.scripts,
+                &catalog.scriptlets,
                 None,
                 Some(&runtime_context),
             ))
@@ -0,0 +1,215 @@
+//! Compact binary encoding for cached menu hierarchies.
+//!
+//! Layout: the `SKM` magic, a format version byte, then the top-level item
+//! count followed by each item in pre-order. Integers are LEB128 varints and
+//! strings are length-prefixed UTF-8. Each item is:
+//!
+//! ```text
+//! flags: u8 (bit0 enabled, bit1 has shortcut, bit2 explicit menu_path)
+//! title: str
+//! shortcut: str                      (if bit1)
+//! menu_path: varint count, str...    (if bit2)
+//! children: varint count, item...
+//! ```
+//!
+//! `menu_path` is almost always the parent path plus the item title, so it is
+//! only written when it differs from that.
+
+use super::MenuBarItem;
+use anyhow::{bail, Context, Result};
+
+const MAGIC: &[u8; 3] = b"SKM";
+const FORMAT_VERSION: u8 = 1;
+
+const FLAG_ENABLED: u8 = 1 << 0;
+const FLAG_SHORTCUT: u8 = 1 << 1;
+const FLAG_EXPLICIT_PATH: u8 = 1 << 2;
+
+/// Menus nest a handful of levels; anything deeper is a corrupt blob.
+const MAX_DEPTH: usize = 64;
+
+pub(super) fn encode_menu(items: &[MenuBarItem]) -> Vec<u8> {
+    let mut out = Vec::with_capacity(64 + items.len() * 32);
+    out.extend_from_slice(MAGIC);
+    out.push(FORMAT_VERSION);
+    write_varint(&mut out, items.len() as u64);
+    let mut parent_path = Vec::new();
+    for item in items {
+        encode_item(&mut out, item, &mut parent_path);
+    }
+    out
+}
+
+fn encode_item<'a>(out: &mut Vec<u8>, item: &'a MenuBarItem, parent_path: &mut Vec<&'a str>) {
+    let derived_path = item.menu_path.len() == parent_path.len() + 1
+        && item.menu_path.last().map(String::as_str) == Some(item.title.as_str())
+        && item
+            .menu_path
+            .iter()
+            .zip(parent_path.iter())
+            .all(|(segment, parent)| segment == parent);
+
+    let mut flags = 0;
+    if item.enabled {
+        flags |= FLAG_ENABLED;
+    }
+    if item.shortcut.is_some() {
+        flags |= FLAG_SHORTCUT;
+    }
+    if !derived_path {
+        flags |= FLAG_EXPLICIT_PATH;
+    }
+    out.push(flags);
+    write_str(out, &item.title);
+    if let Some(shortcut) = &item.shortcut {
+        write_str(out, shortcut);
+    }
+    if !derived_path {
+        write_varint(out, item.menu_path.len() as u64);
+        for segment in &item.menu_path {
+            write_str(out, segment);
+        }
+    }
+
+    write_varint(out, item.children.len() as u64);
+    parent_path.push(&item.title);
+    for child in &item.children {
+        encode_item(out, child, parent_path);
+    }
+    parent_path.pop();
+}
+
+pub(super) fn decode_menu(bytes: &[u8]) -> Result<Vec<MenuBarItem>> {
+    let mut reader = Reader { bytes, pos: 0 };
+    if reader.take(MAGIC.len())? != MAGIC {
+        bail!("Menu cache blob has an unknown header");
+    }
+    let version = reader.byte()?;
+    if version != FORMAT_VERSION {
+        bail!("Unsupported menu cache format version {version}");
+    }
+
+    let count = reader.len()?;
+    let mut items = Vec::with_capacity(count);
+    let parent_path = Vec::new();
+    for _ in 0..count {
+        items.push(decode_item(&mut reader, &parent_path, 0)?);
+    }
+    if reader.pos != bytes.len() {
+        bail!("Menu cache blob has trailing bytes");
+    }
+    Ok(items)
+}
+
+fn decode_item(
+    reader: &mut Reader<'_>,
+    parent_path: &[String],
+    depth: usize,
+) -> Result<MenuBarItem> {
+    if depth > MAX_DEPTH {
+        bail!("Menu cache blob nests deeper than {MAX_DEPTH} levels");
+    }
+
+    let flags = reader.byte()?;
+    let title = reader.string()?;
+    let shortcut = if flags & FLAG_SHORTCUT != 0 {
+        Some(reader.string()?)
+    } else {
+        None
+    };
+    let menu_path = if flags & FLAG_EXPLICIT_PATH != 0 {
+        let segments = reader.len()?;
+        let mut path = Vec::with_capacity(segments);
+        for _ in 0..segments {
+            path.push(reader.string()?);
+        }
+        path
+    } else {
+        let mut path = Vec::with_capacity(parent_path.len() + 1);
+        path.extend_from_slice(parent_path);
+        path.push(title.clone());
+        path
+    };
+
+    let child_count = reader.len()?;
+    let mut children = Vec::with_capacity(child_count);
+    if child_count > 0 {
+        let mut child_parent = Vec::with_capacity(parent_path.len() + 1);
+        child_parent.extend_from_slice(parent_path);
+        child_parent.push(title.clone());
+        for _ in 0..child_count {
+            children.push(decode_item(reader, &child_parent, depth + 1)?);
+        }
+    }
+
+    Ok(MenuBarItem {
+        title,
+        enabled: flags & FLAG_ENABLED != 0,
+        shortcut,
+        children,
+        menu_path,
+    })
+}
+
+fn write_varint(out: &mut Vec<u8>, mut value: u64) {
+    while value >= 0x80 {
+        out.push((value as u8) | 0x80);
+        value >>= 7;
+    }
+    out.push(value as u8);
+}
+
+fn write_str(out: &mut Vec<u8>, value: &str) {
+    write_varint(out, value.len() as u64);
+    out.extend_from_slice(value.as_bytes());
+}
+
+struct Reader<'a> {
+    bytes: &'a [u8],
+    pos: usize,
+}
+
+impl<'a> Reader<'a> {
+    fn take(&mut self, len: usize) -> Result<&'a [u8]> {
+        let end = self
+            .pos
+            .checked_add(len)
+            .filter(|end| *end <= self.bytes.len())
+            .context("Menu cache blob is truncated")?;
+        let slice = &self.bytes[self.pos..end];
+        self.pos = end;
+        Ok(slice)
+    }
+
+    fn byte(&mut self) -> Result<u8> {
+        Ok(self.take(1)?[0])
+    }
+
+    fn varint(&mut self) -> Result<u64> {
+        let mut value = 0u64;
+        for shift in (0..64).step_by(7) {
+            let byte = self.byte()?;
+            value |= u64::from(byte & 0x7f) << shift;
+            if byte & 0x80 == 0 {
+                return Ok(value);
+            }
+        }
+        bail!("Menu cache blob has an overlong varint")
+    }
+
+    /// A count or length, bounded by the bytes left so corrupt input cannot
+    /// trigger huge allocations.
+    fn len(&mut self) -> Result<usize> {
+        let value = self.varint()?;
+        if value > (self.bytes.len() - self.pos) as u64 {
+            bail!("Menu cache blob declares {value} entries past its end");
+        }
+        Ok(value as usize)
+    }
+
+    fn string(&mut self) -> Result<String> {
+        let len = self.len()?;
+        let bytes = self.take(len)?;
+        String::from_utf8(bytes.to_vec()).context("Menu cache blob has invalid UTF-8")
+    }
+}
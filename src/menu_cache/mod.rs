@@ -3,15 +3,21 @@
 //! SQLite-backed persistence for caching application menu bar data.
 //! Caches menu hierarchies by bundle_id to avoid expensive rescanning.
 //! Follows the same patterns as notes/storage.rs for consistency.
+//!
+//! Hierarchies are stored as a compact binary blob (see [`codec`]).
+
+mod codec;
 
 // --- merged from part_000.rs ---
 use anyhow::{Context, Result};
 use rusqlite::{params, Connection, OptionalExtension};
 use serde::{Deserialize, Serialize};
 use std::path::PathBuf;
-use std::sync::{Arc, Mutex, OnceLock};
+use std::sync::{Arc, OnceLock};
 use std::time::{SystemTime, UNIX_EPOCH};
 use tracing::{debug, info};
+
+use crate::utils::sqlite_pool::{SqlitePool, DEFAULT_READ_CONNECTIONS};
 /// A menu bar item with its hierarchy
 #[derive(Debug, Clone, Serialize, Deserialize, PartialEq)]
 pub struct MenuBarItem {
@@ -21,8 +27,11 @@ pub struct MenuBarItem {
     pub children: Vec<MenuBarItem>,
     pub menu_path: Vec<String>, // e.g., ["File", "New Window"]
 }
-/// Global database connection for menu cache
-static MENU_CACHE_DB: OnceLock<Arc<Mutex<Connection>>> = OnceLock::new();
+/// Bumped whenever the on-disk layout changes; older caches are dropped and
+/// rebuilt on the next scan.
+const MENU_CACHE_SCHEMA_VERSION: i32 = 2;
+/// Global database pool for menu cache (writer plus read-only WAL connections)
+static MENU_CACHE_DB: OnceLock<Arc<SqlitePool>> = OnceLock::new();
 /// Get the path to the menu cache database
 fn get_menu_cache_db_path() -> PathBuf {
     let kit_dir = dirs::home_dir()
@@ -50,13 +59,48 @@ pub fn init_menu_cache_db() -> Result<()> {
     }
 
     let conn = Connection::open(&db_path).context("Failed to open menu cache database")?;
+    // WAL so cache lookups read alongside a rescan's writes.
+    conn.pragma_update(None, "journal_mode", "WAL")
+        .context("Failed to enable WAL for menu cache database")?;
+    create_menu_cache_schema(&conn)?;
+
+    info!(db_path = %db_path.display(), "Menu cache database initialized");
+
+    // Use get_or_init pattern to handle race condition where another thread
+    // might have initialized the DB between our check and set
+    let _ = MENU_CACHE_DB.get_or_init(|| {
+        Arc::new(SqlitePool::new(
+            "menu_cache",
+            &db_path,
+            conn,
+            DEFAULT_READ_CONNECTIONS,
+        ))
+    });
+
+    Ok(())
+}
+/// Create (or migrate) the menu cache tables.
+///
+/// The cache is disposable, so a schema version change drops the old tables
+/// instead of converting JSON rows in place.
+fn create_menu_cache_schema(conn: &Connection) -> Result<()> {
+    let version: i32 = conn
+        .query_row("PRAGMA user_version", [], |row| row.get(0))
+        .unwrap_or(0);
+    if version != MENU_CACHE_SCHEMA_VERSION {
+        conn.execute_batch(
+            r#"
+            DROP TABLE IF EXISTS menu_cache;
+            "#,
+        )
+        .context("Failed to drop outdated menu cache tables")?;
+    }
 
-    // Create tables
     conn.execute_batch(
         r#"
         CREATE TABLE IF NOT EXISTS menu_cache (
             bundle_id TEXT PRIMARY KEY,
-            menu_json TEXT NOT NULL,
+            menu_blob BLOB NOT NULL,
             last_scanned INTEGER NOT NULL,
             app_version TEXT
         );
@@ -64,18 +108,16 @@ pub fn init_menu_cache_db() -> Result<()> {
         CREATE INDEX IF NOT EXISTS idx_menu_cache_last_scanned ON menu_cache(last_scanned);
         "#,
     )
-    .context("Failed to create menu cache table")?;
-
-    info!(db_path = %db_path.display(), "Menu cache database initialized");
-
-    // Use get_or_init pattern to handle race condition where another thread
-    // might have initialized the DB between our check and set
-    let _ = MENU_CACHE_DB.get_or_init(|| Arc::new(Mutex::new(conn)));
+    .context("Failed to create menu cache tables")?;
 
+    conn.execute_batch(&format!(
+        "PRAGMA user_version = {MENU_CACHE_SCHEMA_VERSION}"
+    ))
+    .context("Failed to record menu cache schema version")?;
     Ok(())
 }
-/// Get a reference to the menu cache database connection
-fn get_db() -> Result<Arc<Mutex<Connection>>> {
+/// Get a reference to the menu cache database pool
+fn get_db() -> Result<Arc<SqlitePool>> {
     MENU_CACHE_DB
         .get()
         .cloned()
@@ -90,14 +132,12 @@ fn current_timestamp() -> i64 {
 }
 /// Get cached menu items for an application by bundle_id
 pub fn get_cached_menu(bundle_id: &str) -> Result<Option<Vec<MenuBarItem>>> {
-    let db = get_db()?;
-    let conn = db
-        .lock()
-        .map_err(|e| anyhow::anyhow!("DB lock error: {}", e))?;
-
-    let result: Option<String> = conn
+    get_db()?.with_read("get_cached_menu", |conn| load_cached_menu(conn, bundle_id))
+}
+fn load_cached_menu(conn: &Connection, bundle_id: &str) -> Result<Option<Vec<MenuBarItem>>> {
+    let result: Option<Vec<u8>> = conn
         .query_row(
-            "SELECT menu_json FROM menu_cache WHERE bundle_id = ?1",
+            "SELECT menu_blob FROM menu_cache WHERE bundle_id = ?1",
             params![bundle_id],
             |row| row.get(0),
         )
@@ -105,9 +145,8 @@ pub fn get_cached_menu(bundle_id: &str) -> Result<Option<Vec<MenuBarItem>>> {
         .context("Failed to query menu cache")?;
 
     match result {
-        Some(json) => {
-            let items: Vec<MenuBarItem> =
-                serde_json::from_str(&json).context("Failed to deserialize menu items")?;
+        Some(blob) => {
+            let items = codec::decode_menu(&blob).context("Failed to decode menu items")?;
             debug!(bundle_id = %bundle_id, item_count = items.len(), "Retrieved cached menu");
             Ok(Some(items))
         }
@@ -123,30 +162,36 @@ pub fn set_cached_menu(
     items: &[MenuBarItem],
     app_version: Option<&str>,
 ) -> Result<()> {
-    let db = get_db()?;
-    let conn = db
-        .lock()
-        .map_err(|e| anyhow::anyhow!("DB lock error: {}", e))?;
-
-    let menu_json = serde_json::to_string(items).context("Failed to serialize menu items")?;
+    get_db()?.with_write("set_cached_menu", |conn| {
+        store_cached_menu(conn, bundle_id, items, app_version)
+    })
+}
+fn store_cached_menu(
+    conn: &Connection,
+    bundle_id: &str,
+    items: &[MenuBarItem],
+    app_version: Option<&str>,
+) -> Result<()> {
+    let menu_blob = codec::encode_menu(items);
     let timestamp = current_timestamp();
 
     conn.execute(
         r#"
-        INSERT INTO menu_cache (bundle_id, menu_json, last_scanned, app_version)
+        INSERT INTO menu_cache (bundle_id, menu_blob, last_scanned, app_version)
         VALUES (?1, ?2, ?3, ?4)
         ON CONFLICT(bundle_id) DO UPDATE SET
-            menu_json = excluded.menu_json,
+            menu_blob = excluded.menu_blob,
             last_scanned = excluded.last_scanned,
             app_version = excluded.app_version
         "#,
-        params![bundle_id, menu_json, timestamp, app_version],
+        params![bundle_id, menu_blob, timestamp, app_version],
     )
     .context("Failed to save menu cache")?;
 
     debug!(
         bundle_id = %bundle_id,
         item_count = items.len(),
+        blob_bytes = menu_blob.len(),
         app_version = app_version.unwrap_or("none"),
         "Menu cache updated"
     );
@@ -154,19 +199,15 @@ pub fn set_cached_menu(
 }
 /// Check if the cache for a bundle_id is still valid (not expired)
 pub fn is_cache_valid(bundle_id: &str, max_age_secs: u64) -> Result<bool> {
-    let db = get_db()?;
-    let conn = db
-        .lock()
-        .map_err(|e| anyhow::anyhow!("DB lock error: {}", e))?;
-
-    let result: Option<i64> = conn
-        .query_row(
+    let result: Option<i64> = get_db()?.with_read("is_cache_valid", |conn| {
+        conn.query_row(
             "SELECT last_scanned FROM menu_cache WHERE bundle_id = ?1",
             params![bundle_id],
             |row| row.get(0),
         )
         .optional()
-        .context("Failed to query cache validity")?;
+        .context("Failed to query cache validity")
+    })?;
 
     match result {
         Some(last_scanned) => {
@@ -191,35 +232,28 @@ pub fn is_cache_valid(bundle_id: &str, max_age_secs: u64) -> Result<bool> {
 }
 /// Delete cached menu for an application (useful when app is uninstalled)
 pub fn delete_cached_menu(bundle_id: &str) -> Result<()> {
-    let db = get_db()?;
-    let conn = db
-        .lock()
-        .map_err(|e| anyhow::anyhow!("DB lock error: {}", e))?;
-
-    conn.execute(
-        "DELETE FROM menu_cache WHERE bundle_id = ?1",
-        params![bundle_id],
-    )
-    .context("Failed to delete menu cache")?;
+    get_db()?.with_write("delete_cached_menu", |conn| {
+        conn.execute(
+            "DELETE FROM menu_cache WHERE bundle_id = ?1",
+            params![bundle_id],
+        )
+        .context("Failed to delete menu cache")
+    })?;
 
     info!(bundle_id = %bundle_id, "Menu cache entry deleted");
     Ok(())
 }
 /// Prune cache entries older than the specified age in seconds
 pub fn prune_old_cache_entries(max_age_secs: u64) -> Result<usize> {
-    let db = get_db()?;
-    let conn = db
-        .lock()
-        .map_err(|e| anyhow::anyhow!("DB lock error: {}", e))?;
-
     let cutoff = current_timestamp() - max_age_secs as i64;
 
-    let count = conn
-        .execute(
+    let count = get_db()?.with_write("prune_old_cache_entries", |conn| {
+        conn.execute(
             "DELETE FROM menu_cache WHERE last_scanned < ?1",
             params![cutoff],
         )
-        .context("Failed to prune old cache entries")?;
+        .context("Failed to prune old cache entries")
+    })?;
 
     if count > 0 {
         info!(count, max_age_secs, "Pruned old menu cache entries");
@@ -229,14 +263,10 @@ pub fn prune_old_cache_entries(max_age_secs: u64) -> Result<usize> {
 }
 /// Get the total number of cached menus
 pub fn get_cache_count() -> Result<usize> {
-    let db = get_db()?;
-    let conn = db
-        .lock()
-        .map_err(|e| anyhow::anyhow!("DB lock error: {}", e))?;
-
-    let count: i64 = conn
-        .query_row("SELECT COUNT(*) FROM menu_cache", [], |row| row.get(0))
-        .context("Failed to count cache entries")?;
+    let count: i64 = get_db()?.with_read("get_cache_count", |conn| {
+        conn.query_row("SELECT COUNT(*) FROM menu_cache", [], |row| row.get(0))
+            .context("Failed to count cache entries")
+    })?;
 
     Ok(count as usize)
 }
@@ -249,6 +279,7 @@ pub fn get_cache_count() -> Result<usize> {
 #[cfg(test)]
 mod tests {
     use super::*;
+    use std::sync::Mutex;
     use std::thread;
     use std::time::Duration;
     use tempfile::TempDir;
@@ -259,16 +290,7 @@ mod tests {
         let db_path = temp_dir.path().join("test-menu-cache.sqlite");
 
         let conn = Connection::open(&db_path)?;
-        conn.execute_batch(
-            r#"
-            CREATE TABLE IF NOT EXISTS menu_cache (
-                bundle_id TEXT PRIMARY KEY,
-                menu_json TEXT NOT NULL,
-                last_scanned INTEGER NOT NULL,
-                app_version TEXT
-            );
-            "#,
-        )?;
+        create_menu_cache_schema(&conn)?;
 
         Ok((temp_dir, Arc::new(Mutex::new(conn))))
     }
@@ -324,39 +346,23 @@ mod tests {
         // Insert
         {
             let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-            let menu_json = serde_json::to_string(&items).unwrap();
-            let timestamp = current_timestamp();
-            conn.execute(
-                r#"
-                INSERT INTO menu_cache (bundle_id, menu_json, last_scanned, app_version)
-                VALUES (?1, ?2, ?3, ?4)
-                "#,
-                params![bundle_id, menu_json, timestamp, "17.0"],
-            )
-            .expect("Insert should succeed");
+            store_cached_menu(&conn, bundle_id, &items, Some("17.0"))
+                .expect("Insert should succeed");
         }
 
         // Retrieve
         {
             let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-            let result: Option<String> = conn
-                .query_row(
-                    "SELECT menu_json FROM menu_cache WHERE bundle_id = ?1",
-                    params![bundle_id],
-                    |row| row.get(0),
-                )
-                .optional()
-                .expect("Query should succeed");
-
-            assert!(result.is_some(), "Should have cached menu");
-            let retrieved: Vec<MenuBarItem> =
-                serde_json::from_str(&result.unwrap()).expect("Should deserialize");
+            let retrieved = load_cached_menu(&conn, bundle_id)
+                .expect("Query should succeed")
+                .expect("Should have cached menu");
 
             assert_eq!(retrieved.len(), 2, "Should have 2 top-level menu items");
             assert_eq!(retrieved[0].title, "File");
             assert_eq!(retrieved[1].title, "Edit");
             assert_eq!(retrieved[0].children.len(), 2);
             assert_eq!(retrieved[0].children[0].shortcut, Some("Cmd+N".to_string()));
+            assert_eq!(retrieved, items);
         }
     }
 
@@ -371,15 +377,12 @@ mod tests {
         let old_timestamp = current_timestamp() - 5;
         {
             let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-            let menu_json = serde_json::to_string(&items).unwrap();
+            store_cached_menu(&conn, bundle_id, &items, None).expect("Insert should succeed");
             conn.execute(
-                r#"
-                INSERT INTO menu_cache (bundle_id, menu_json, last_scanned, app_version)
-                VALUES (?1, ?2, ?3, ?4)
-                "#,
-                params![bundle_id, menu_json, old_timestamp, None::<String>],
+                "UPDATE menu_cache SET last_scanned = ?1 WHERE bundle_id = ?2",
+                params![old_timestamp, bundle_id],
             )
-            .expect("Insert should succeed");
+            .expect("Backdate should succeed");
         }
 
         // Check with 10 second max age - should be valid
@@ -441,16 +444,8 @@ mod tests {
 
         {
             let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-            let menu_json = serde_json::to_string(&initial_items).unwrap();
-            let timestamp = current_timestamp();
-            conn.execute(
-                r#"
-                INSERT INTO menu_cache (bundle_id, menu_json, last_scanned, app_version)
-                VALUES (?1, ?2, ?3, ?4)
-                "#,
-                params![bundle_id, menu_json, timestamp, "1.0"],
-            )
-            .expect("Initial insert should succeed");
+            store_cached_menu(&conn, bundle_id, &initial_items, Some("1.0"))
+                .expect("Initial insert should succeed");
         }
 
         // Verify initial state
@@ -491,30 +486,18 @@ mod tests {
 
         {
             let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-            let menu_json = serde_json::to_string(&updated_items).unwrap();
-            let timestamp = current_timestamp();
-            conn.execute(
-                r#"
-                INSERT INTO menu_cache (bundle_id, menu_json, last_scanned, app_version)
-                VALUES (?1, ?2, ?3, ?4)
-                ON CONFLICT(bundle_id) DO UPDATE SET
-                    menu_json = excluded.menu_json,
-                    last_scanned = excluded.last_scanned,
-                    app_version = excluded.app_version
-                "#,
-                params![bundle_id, menu_json, timestamp, "2.0"],
-            )
-            .expect("Upsert should succeed");
+            store_cached_menu(&conn, bundle_id, &updated_items, Some("2.0"))
+                .expect("Upsert should succeed");
         }
 
         // Verify update
         {
             let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-            let (version, json, count): (Option<String>, String, i64) = conn
+            let (version, count): (Option<String>, i64) = conn
                 .query_row(
-                    "SELECT app_version, menu_json, (SELECT COUNT(*) FROM menu_cache) FROM menu_cache WHERE bundle_id = ?1",
+                    "SELECT app_version, (SELECT COUNT(*) FROM menu_cache) FROM menu_cache WHERE bundle_id = ?1",
                     params![bundle_id],
-                    |row| Ok((row.get(0)?, row.get(1)?, row.get(2)?)),
+                    |row| Ok((row.get(0)?, row.get(1)?)),
                 )
                 .expect("Query should succeed");
 
@@ -524,8 +507,7 @@ mod tests {
             // Should still be only 1 row (upsert, not insert)
             assert_eq!(count, 1, "Should have exactly 1 row after upsert");
 
-            // Menu items should be updated
-            let items: Vec<MenuBarItem> = serde_json::from_str(&json).unwrap();
+            let items = load_cached_menu(&conn, bundle_id).unwrap().unwrap();
             assert_eq!(items.len(), 2, "Should have 2 menu items after update");
         }
     }
@@ -537,14 +519,7 @@ mod tests {
         let bundle_id = "com.nonexistent.App";
 
         let conn = db.lock().unwrap_or_else(|e| e.into_inner());
-        let result: Option<String> = conn
-            .query_row(
-                "SELECT menu_json FROM menu_cache WHERE bundle_id = ?1",
-                params![bundle_id],
-                |row| row.get(0),
-            )
-            .optional()
-            .expect("Query should succeed");
+        let result = load_cached_menu(&conn, bundle_id).expect("Query should succeed");
 
         assert!(result.is_none(), "Should return None for missing cache");
     }
@@ -569,4 +544,53 @@ mod tests {
         assert_eq!(items[0], deserialized[0]);
         assert_eq!(items[1], deserialized[1]);
     }
+
+    #[test]
+    fn test_binary_codec_round_trips_and_is_smaller_than_json() {
+        let mut items = create_test_menu_items();
+        // A path that is not parent + title must survive the round trip.
+        items[1].children[0].menu_path = vec!["Edit".to_string(), "Copy Special".to_string()];
+        items[1].children[0].enabled = false;
+
+        let blob = codec::encode_menu(&items);
+        assert_eq!(codec::decode_menu(&blob).unwrap(), items);
+        assert!(blob.len() < serde_json::to_string(&items).unwrap().len());
+
+        assert!(codec::decode_menu(&blob[..blob.len() - 1]).is_err());
+        assert!(codec::decode_menu(b"{\"title\":1}").is_err());
+        assert_eq!(
+            codec::decode_menu(&codec::encode_menu(&[])).unwrap(),
+            vec![]
+        );
+    }
+
+    #[test]
+    fn test_schema_upgrade_drops_json_cache() {
+        let temp_dir = TempDir::new().unwrap();
+        let conn = Connection::open(temp_dir.path().join("legacy.sqlite")).unwrap();
+        conn.execute_batch(
+            r#"
+            CREATE TABLE menu_cache (
+                bundle_id TEXT PRIMARY KEY,
+                menu_json TEXT NOT NULL,
+                last_scanned INTEGER NOT NULL,
+                app_version TEXT
+            );
+            INSERT INTO menu_cache VALUES ('com.apple.Safari', '[]', 0, NULL);
+            "#,
+        )
+        .unwrap();
+
+        create_menu_cache_schema(&conn).unwrap();
+
+        assert!(load_cached_menu(&conn, "com.apple.Safari")
+            .unwrap()
+            .is_none());
+        // Re-running on an up-to-date schema keeps existing rows.
+        store_cached_menu(&conn, "com.apple.Safari", &create_test_menu_items(), None).unwrap();
+        create_menu_cache_schema(&conn).unwrap();
+        assert!(load_cached_menu(&conn, "com.apple.Safari")
+            .unwrap()
+            .is_some());
+    }
 }
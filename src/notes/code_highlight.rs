@@ -10,7 +10,6 @@ use std::sync::{LazyLock, Mutex};
 
 use syntect::easy::HighlightLines;
 use syntect::highlighting::{Style, Theme, ThemeSet};
-use syntect::parsing::SyntaxSet;
 use syntect::util::LinesWithEndings;
 use tracing::warn;
 
@@ -51,35 +50,8 @@ pub struct HighlightedCodeBlock {
     pub lines: Vec<CodeLine>,
 }
 
-static SYNTAX_SET: LazyLock<SyntaxSet> = LazyLock::new(SyntaxSet::load_defaults_newlines);
-static DARK_THEME: LazyLock<Theme> = LazyLock::new(|| {
-    let themes = ThemeSet::load_defaults();
-    themes
-        .themes
-        .get("base16-ocean.dark")
-        .cloned()
-        .unwrap_or_else(|| match themes.themes.values().next().cloned() {
-            Some(theme) => theme,
-            None => {
-                warn!("Failed to find dark theme in defaults, using fallback");
-                Theme::default()
-            }
-        })
-});
-static LIGHT_THEME: LazyLock<Theme> = LazyLock::new(|| {
-    let themes = ThemeSet::load_defaults();
-    themes
-        .themes
-        .get("base16-ocean.light")
-        .cloned()
-        .unwrap_or_else(|| match themes.themes.values().next().cloned() {
-            Some(theme) => theme,
-            None => {
-                warn!("Failed to find light theme in defaults, using fallback");
-                Theme::default()
-            }
-        })
-});
+/// Used only if the shared default ThemeSet is somehow empty.
+static FALLBACK_THEME: LazyLock<Theme> = LazyLock::new(Theme::default);
 
 /// Global cache for syntax highlighting results.
 /// Keyed by hash of (code, language, is_dark) to avoid re-running syntect
@@ -95,24 +67,24 @@ fn highlight_cache_key(code: &str, language: Option<&str>, is_dark: bool) -> u64
     hasher.finish()
 }
 
-fn syntax_set() -> &'static SyntaxSet {
-    &SYNTAX_SET
-}
-
-fn dark_theme() -> &'static Theme {
-    &DARK_THEME
-}
-
-fn light_theme() -> &'static Theme {
-    &LIGHT_THEME
-}
-
-fn theme_for_mode(is_dark: bool) -> &'static Theme {
-    if is_dark {
-        dark_theme()
+/// Pick the Notes theme for the mode from the shared default ThemeSet.
+fn theme_for_mode(themes: &'static ThemeSet, is_dark: bool) -> &'static Theme {
+    let name = if is_dark {
+        "base16-ocean.dark"
     } else {
-        light_theme()
-    }
+        "base16-ocean.light"
+    };
+    themes
+        .themes
+        .get(name)
+        .or_else(|| themes.themes.values().next())
+        .unwrap_or_else(|| {
+            warn!(
+                theme = name,
+                "Failed to find theme in defaults, using fallback"
+            );
+            &FALLBACK_THEME
+        })
 }
 
 fn style_to_hex_color(style: &Style) -> u32 {
@@ -213,14 +185,32 @@ pub fn highlight_code_lines(code: &str, language: Option<&str>, is_dark: bool) -
         }
     }
 
-    let ps = syntax_set();
-    let theme = theme_for_mode(is_dark);
     let default_color = if is_dark {
         DEFAULT_TEXT_COLOR_DARK
     } else {
         DEFAULT_TEXT_COLOR_LIGHT
     };
 
+    // Syntax/theme sets are shared with `crate::syntax` and loaded in the
+    // background; until then return uncached plain text instead of blocking.
+    let Some((ps, themes)) = crate::syntax::loaded_highlighting_assets() else {
+        return LinesWithEndings::from(code)
+            .map(|line| {
+                let clean_line = line.trim_end_matches('\n');
+                let spans = if clean_line.is_empty() {
+                    Vec::new()
+                } else {
+                    vec![CodeSpan {
+                        text: clean_line.to_string(),
+                        color: default_color,
+                    }]
+                };
+                CodeLine { spans }
+            })
+            .collect();
+    };
+    let theme = theme_for_mode(themes, is_dark);
+
     let language = language
         .and_then(normalize_language)
         .unwrap_or_else(|| "text".to_string());
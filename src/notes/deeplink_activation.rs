@@ -175,9 +175,19 @@ pub(crate) fn read_cheap_kit_resource_preview(uri: &str) -> Result<KitResourcePr
         ));
     }
 
+    // Catalog resources are served as compact JSON; re-indent for reading.
+    let body = if resource.mime_type == "application/json" {
+        serde_json::from_str::<serde_json::Value>(&resource.text)
+            .ok()
+            .and_then(|value| serde_json::to_string_pretty(&value).ok())
+            .unwrap_or_else(|| resource.text.clone())
+    } else {
+        resource.text.clone()
+    };
+
     const MAX_PREVIEW_CHARS: usize = 120_000;
-    let mut text: String = resource.text.chars().take(MAX_PREVIEW_CHARS).collect();
-    let truncated = resource.text.chars().count() > MAX_PREVIEW_CHARS;
+    let mut text: String = body.chars().take(MAX_PREVIEW_CHARS).collect();
+    let truncated = body.chars().count() > MAX_PREVIEW_CHARS;
     if truncated {
         text.push_str("\n\n[… resource preview truncated …]");
     }
@@ -58,10 +58,11 @@ pub(crate) use storage::{
     count_active_notes_with_tag, delete_note_cart_item, delete_note_cart_items,
     delete_note_permanently, get_all_notes, get_deleted_notes, get_note, get_note_aliases,
     get_note_backlink_count, get_note_backlinks, get_note_outbound_link_count, get_note_tags,
-    init_notes_db, list_note_cart_items, list_note_cart_items_deduped, note_file_path,
-    notes_brain_days_dir, root_notes_query_is_eligible, save_note, save_note_cart_item,
-    search_notes, search_root_notes_meta, search_root_notes_meta_cached,
-    search_root_notes_meta_direct, NoteBacklinkSummary, RootNoteSearchHit, RootNotesSectionOptions,
+    init_notes_db, list_note_cart_items, list_note_cart_items_deduped,
+    load_root_notes_index_documents, note_file_path, notes_brain_days_dir,
+    root_notes_index_generation, root_notes_query_is_eligible, save_note, save_note_cart_item,
+    search_notes, search_root_notes_meta, search_root_notes_meta_direct, NoteBacklinkSummary,
+    RootNoteIndexDocument, RootNoteSearchHit, RootNotesSectionOptions,
 };
 
 /// Tag that promotes a note to a standing agent instruction.
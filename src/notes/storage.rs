@@ -8,7 +8,7 @@ use chrono::{DateTime, Utc};
 use notify::{recommended_watcher, RecursiveMode, Watcher};
 use rusqlite::{params, Connection, OptionalExtension};
 use sha2::{Digest, Sha256};
-use std::collections::{HashMap, HashSet};
+use std::collections::HashMap;
 use std::fs;
 use std::path::{Path, PathBuf};
 use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
@@ -17,6 +17,7 @@ use std::time::{Duration, Instant};
 use tracing::{debug, info, warn};
 
 use crate::brain::substrate::{BrainFrontmatter, BrainSlugDir, BrainSubstrate};
+use crate::utils::sqlite_pool::{SqlitePool, DEFAULT_READ_CONNECTIONS};
 
 use super::metadata;
 use super::model::{Note, NoteId};
@@ -24,11 +25,10 @@ use super::model::{Note, NoteId};
 /// SQLite index schema generation — bump when index shape changes.
 const NOTES_INDEX_SCHEMA_VERSION: i32 = 2;
 
-/// Global database connection for notes
-static NOTES_DB: OnceLock<Arc<Mutex<Connection>>> = OnceLock::new();
+/// Global database pool for notes (writer + read-only WAL connections)
+static NOTES_DB: OnceLock<Arc<SqlitePool>> = OnceLock::new();
 static NOTES_SUBSTRATE: OnceLock<Arc<BrainSubstrate>> = OnceLock::new();
 static NOTE_CONTENT_HASHES: OnceLock<Mutex<HashMap<NoteId, String>>> = OnceLock::new();
-static ROOT_NOTES_SEARCH_CACHE: OnceLock<Mutex<RootNotesSearchCache>> = OnceLock::new();
 static ROOT_NOTES_SEARCH_CACHE_GENERATION: AtomicU64 = AtomicU64::new(0);
 static NOTES_STORAGE_GENERATION: AtomicU64 = AtomicU64::new(0);
 static NOTES_DIR_WATCHER_STARTED: AtomicBool = AtomicBool::new(false);
@@ -73,52 +73,22 @@ pub(crate) struct NoteBacklinkSummary {
     pub updated_at: DateTime<Utc>,
 }
 
-#[derive(Clone, Debug, Hash, PartialEq, Eq)]
-struct RootNotesSearchCacheKey {
-    query: String,
-    enabled: bool,
-    max_results: usize,
-    min_query_chars: usize,
-    search_content: bool,
-}
-
-#[derive(Clone, Debug, Hash, PartialEq, Eq)]
-struct RootNotesSearchFlightKey {
-    generation: u64,
-    search: RootNotesSearchCacheKey,
-}
-
-#[derive(Default)]
-struct RootNotesSearchCache {
-    hits_by_query: HashMap<RootNotesSearchCacheKey, Vec<RootNoteSearchHit>>,
-    in_flight: HashSet<RootNotesSearchFlightKey>,
-}
-
-fn root_notes_search_cache() -> &'static Mutex<RootNotesSearchCache> {
-    ROOT_NOTES_SEARCH_CACHE.get_or_init(|| Mutex::new(RootNotesSearchCache::default()))
-}
-
-fn root_notes_search_cache_key(
-    query: &str,
-    options: RootNotesSectionOptions,
-) -> RootNotesSearchCacheKey {
-    RootNotesSearchCacheKey {
-        query: query.trim().to_string(),
-        enabled: options.enabled,
-        max_results: options.max_results,
-        min_query_chars: options.min_query_chars,
-        search_content: options.search_content,
-    }
+/// A live note as the root search index stores it: the launcher row plus
+/// the body text it is searched by.
+#[derive(Debug, Clone)]
+pub(crate) struct RootNoteIndexDocument {
+    pub hit: RootNoteSearchHit,
+    pub content: String,
 }
 
 fn invalidate_root_notes_search_cache() {
     ROOT_NOTES_SEARCH_CACHE_GENERATION.fetch_add(1, Ordering::Relaxed);
     NOTES_STORAGE_GENERATION.fetch_add(1, Ordering::Relaxed);
-    if let Some(cache) = ROOT_NOTES_SEARCH_CACHE.get() {
-        if let Ok(mut guard) = cache.lock() {
-            guard.hits_by_query.clear();
-        }
-    }
+}
+
+/// Change feed for the root search index: moves on every note write.
+pub(crate) fn root_notes_index_generation() -> u64 {
+    ROOT_NOTES_SEARCH_CACHE_GENERATION.load(Ordering::Relaxed)
 }
 
 pub(crate) fn automation_storage_identity() -> serde_json::Value {
@@ -192,11 +162,11 @@ pub(crate) fn notes_brain_days_dir() -> PathBuf {
 }
 
 pub(crate) fn note_file_path(id: NoteId) -> Result<Option<PathBuf>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-    let slug = lookup_note_slug(&conn, id)?;
-    slug.map(|slug| notes_substrate().map(|substrate| substrate.paths().note_file(&slug)))
-        .transpose()
+    with_read_conn("notes_file_path", |conn| {
+        let slug = lookup_note_slug(&conn, id)?;
+        slug.map(|slug| notes_substrate().map(|substrate| substrate.paths().note_file(&slug)))
+            .transpose()
+    })
 }
 
 fn notes_substrate() -> Result<Arc<BrainSubstrate>> {
@@ -1108,7 +1078,8 @@ pub fn init_notes_db() -> Result<()> {
     let _ = fs::create_dir_all(substrate.paths().notes_dir());
     let _ = fs::create_dir_all(substrate.paths().trash_dir());
 
-    if let Some(db) = NOTES_DB.get() {
+    if let Some(pool) = NOTES_DB.get() {
+        let db = pool.writer();
         let conn = db.lock().map_err(db_lock_err)?;
 
         conn.execute_batch("PRAGMA foreign_keys=ON;")
@@ -1152,7 +1123,14 @@ pub fn init_notes_db() -> Result<()> {
 
     info!(db_path = %db_path.display(), "Notes database initialized");
 
-    let _ = NOTES_DB.get_or_init(|| Arc::new(Mutex::new(conn)));
+    let _ = NOTES_DB.get_or_init(|| {
+        Arc::new(SqlitePool::new(
+            "notes",
+            &db_path,
+            conn,
+            DEFAULT_READ_CONNECTIONS,
+        ))
+    });
 
     start_notes_dir_watcher();
     Ok(())
@@ -1179,14 +1157,23 @@ pub fn rebuild_notes_search_index() -> Result<()> {
     rebuild_notes_search_index_with_conn(&conn)
 }
 
-/// Get a reference to the notes database connection
+/// Get a reference to the notes database writer connection
 fn get_db() -> Result<Arc<Mutex<Connection>>> {
     NOTES_DB
         .get()
-        .cloned()
+        .map(|pool| pool.writer())
         .ok_or_else(|| anyhow::anyhow!("Notes database not initialized"))
 }
 
+/// Run a pure-SELECT closure on a notes read connection so UI-thread reads
+/// and searches never queue behind index rebuilds or saves on the writer.
+fn with_read_conn<T>(label: &'static str, f: impl FnOnce(&Connection) -> Result<T>) -> Result<T> {
+    NOTES_DB
+        .get()
+        .ok_or_else(|| anyhow::anyhow!("Notes database not initialized"))?
+        .with_read(label, f)
+}
+
 /// Save a note (insert or update)
 pub fn save_note(note: &Note) -> Result<()> {
     let substrate = notes_substrate()?;
@@ -1393,23 +1380,22 @@ pub(crate) fn count_active_notes_with_tag(tag: &str) -> Result<u64> {
     };
 
     init_notes_db()?;
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let count: i64 = conn
-        .query_row(
-            r#"
-            SELECT COUNT(DISTINCT t.note_id)
-            FROM note_tags t
-            JOIN notes n ON n.id = t.note_id
-            WHERE t.normalized_tag = ?1 AND n.deleted_at IS NULL
-            "#,
-            params![normalized],
-            |row| row.get(0),
-        )
-        .context("Failed to count notes with tag")?;
+    with_read_conn("notes_count_with_tag", |conn| {
+        let count: i64 = conn
+            .query_row(
+                r#"
+                SELECT COUNT(DISTINCT t.note_id)
+                FROM note_tags t
+                JOIN notes n ON n.id = t.note_id
+                WHERE t.normalized_tag = ?1 AND n.deleted_at IS NULL
+                "#,
+                params![normalized],
+                |row| row.get(0),
+            )
+            .context("Failed to count notes with tag")?;
 
-    Ok(count.max(0) as u64)
+        Ok(count.max(0) as u64)
+    })
 }
 
 /// Result of resolving a wiki-link target reference against note aliases.
@@ -1427,106 +1413,102 @@ pub(crate) fn resolve_note_ref(target: &str) -> Result<NoteRefResolution> {
         return Ok(NoteRefResolution::NotFound);
     }
 
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT DISTINCT a.note_id
-            FROM note_aliases a
-            JOIN notes n ON n.id = a.note_id
-            WHERE a.slug = ?1 AND n.deleted_at IS NULL
-            "#,
-        )
-        .context("Failed to prepare note ref resolution query")?;
-    let matches = stmt
-        .query_map(params![slug], |row| row.get::<_, String>(0))
-        .context("Failed to query note aliases for ref resolution")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect note ref matches")?;
-
-    match matches.len() {
-        0 => Ok(NoteRefResolution::NotFound),
-        1 => Ok(NoteId::parse(&matches[0])
-            .map(NoteRefResolution::Unique)
-            .unwrap_or(NoteRefResolution::NotFound)),
-        _ => Ok(NoteRefResolution::Ambiguous),
-    }
+    with_read_conn("notes_resolve_ref", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT DISTINCT a.note_id
+                FROM note_aliases a
+                JOIN notes n ON n.id = a.note_id
+                WHERE a.slug = ?1 AND n.deleted_at IS NULL
+                "#,
+            )
+            .context("Failed to prepare note ref resolution query")?;
+        let matches = stmt
+            .query_map(params![slug], |row| row.get::<_, String>(0))
+            .context("Failed to query note aliases for ref resolution")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect note ref matches")?;
+
+        match matches.len() {
+            0 => Ok(NoteRefResolution::NotFound),
+            1 => Ok(NoteId::parse(&matches[0])
+                .map(NoteRefResolution::Unique)
+                .unwrap_or(NoteRefResolution::NotFound)),
+            _ => Ok(NoteRefResolution::Ambiguous),
+        }
+    })
 }
 
 pub fn get_note(id: NoteId) -> Result<Option<Note>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, title, content, created_at, updated_at, deleted_at, is_pinned, sort_order
-            FROM notes
-            WHERE id = ?1
-            "#,
-        )
-        .context("Failed to prepare get_note query")?;
+    with_read_conn("notes_get", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, title, content, created_at, updated_at, deleted_at, is_pinned, sort_order
+                FROM notes
+                WHERE id = ?1
+                "#,
+            )
+            .context("Failed to prepare get_note query")?;
 
-    let result = stmt
-        .query_row(params![id.as_str()], row_to_note)
-        .optional()
-        .context("Failed to get note")?;
+        let result = stmt
+            .query_row(params![id.as_str()], row_to_note)
+            .optional()
+            .context("Failed to get note")?;
 
-    Ok(result)
+        Ok(result)
+    })
 }
 
 /// Get all active notes (not deleted), sorted by pinned first then updated_at desc
 pub fn get_all_notes() -> Result<Vec<Note>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, title, content, created_at, updated_at, deleted_at, is_pinned, sort_order
-            FROM notes
-            WHERE deleted_at IS NULL
-            ORDER BY is_pinned DESC, updated_at DESC
-            "#,
-        )
-        .context("Failed to prepare get_all_notes query")?;
+    with_read_conn("notes_get_all", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, title, content, created_at, updated_at, deleted_at, is_pinned, sort_order
+                FROM notes
+                WHERE deleted_at IS NULL
+                ORDER BY is_pinned DESC, updated_at DESC
+                "#,
+            )
+            .context("Failed to prepare get_all_notes query")?;
 
-    let notes = stmt
-        .query_map([], row_to_note)
-        .context("Failed to query notes")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect notes")?;
+        let notes = stmt
+            .query_map([], row_to_note)
+            .context("Failed to query notes")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect notes")?;
 
-    debug!(count = notes.len(), "Retrieved all notes");
-    Ok(notes)
+        debug!(count = notes.len(), "Retrieved all notes");
+        Ok(notes)
+    })
 }
 
 /// Get notes in trash (soft-deleted)
 pub fn get_deleted_notes() -> Result<Vec<Note>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT id, title, content, created_at, updated_at, deleted_at, is_pinned, sort_order
-            FROM notes
-            WHERE deleted_at IS NOT NULL
-            ORDER BY deleted_at DESC
-            "#,
-        )
-        .context("Failed to prepare get_deleted_notes query")?;
+    with_read_conn("notes_get_deleted", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT id, title, content, created_at, updated_at, deleted_at, is_pinned, sort_order
+                FROM notes
+                WHERE deleted_at IS NOT NULL
+                ORDER BY deleted_at DESC
+                "#,
+            )
+            .context("Failed to prepare get_deleted_notes query")?;
 
-    let notes = stmt
-        .query_map([], row_to_note)
-        .context("Failed to query deleted notes")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect deleted notes")?;
+        let notes = stmt
+            .query_map([], row_to_note)
+            .context("Failed to query deleted notes")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect deleted notes")?;
 
-    debug!(count = notes.len(), "Retrieved deleted notes");
-    Ok(notes)
+        debug!(count = notes.len(), "Retrieved deleted notes");
+        Ok(notes)
+    })
 }
 
 /// Sanitize a query string for FTS5 MATCH
@@ -1547,75 +1529,74 @@ pub fn search_notes(query: &str) -> Result<Vec<Note>> {
         return get_all_notes();
     }
 
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    if let Some(metadata_notes) = search_notes_metadata_only(&conn, query)? {
-        debug!(query = %query, count = metadata_notes.len(), method = "metadata_only", "Note search completed");
-        return Ok(metadata_notes);
-    }
-
-    // Try FTS search first with sanitized query
-    let sanitized_query = sanitize_fts_query(query);
+    with_read_conn("notes_search", |conn| {
+        if let Some(metadata_notes) = search_notes_metadata_only(&conn, query)? {
+            debug!(query = %query, count = metadata_notes.len(), method = "metadata_only", "Note search completed");
+            return Ok(metadata_notes);
+        }
 
-    // FTS5 search with BM25 ranking
-    let fts_result: rusqlite::Result<Vec<Note>> = (|| {
-        let mut stmt = conn.prepare(
-            r#"
-            SELECT n.id, n.title, n.content, n.created_at, n.updated_at,
-                   n.deleted_at, n.is_pinned, n.sort_order
-            FROM notes n
-            INNER JOIN notes_fts fts ON n.rowid = fts.rowid
-            WHERE notes_fts MATCH ?1 AND n.deleted_at IS NULL
-            ORDER BY bm25(notes_fts)
-            LIMIT 200
-            "#,
-        )?;
+        // Try FTS search first with sanitized query
+        let sanitized_query = sanitize_fts_query(query);
 
-        let notes = stmt
-            .query_map(params![sanitized_query], row_to_note)?
-            .collect::<Result<Vec<_>, _>>()?;
-        Ok(notes)
-    })();
+        // FTS5 search with BM25 ranking
+        let fts_result: rusqlite::Result<Vec<Note>> = (|| {
+            let mut stmt = conn.prepare(
+                r#"
+                SELECT n.id, n.title, n.content, n.created_at, n.updated_at,
+                       n.deleted_at, n.is_pinned, n.sort_order
+                FROM notes n
+                INNER JOIN notes_fts fts ON n.rowid = fts.rowid
+                WHERE notes_fts MATCH ?1 AND n.deleted_at IS NULL
+                ORDER BY bm25(notes_fts)
+                LIMIT 200
+                "#,
+            )?;
 
-    match fts_result {
-        Ok(notes) => {
-            debug!(query = %query, count = notes.len(), method = "fts", "Note search completed");
+            let notes = stmt
+                .query_map(params![sanitized_query], row_to_note)?
+                .collect::<Result<Vec<_>, _>>()?;
             Ok(notes)
-        }
-        Err(e) => {
-            // FTS failed (possibly due to special characters), fall back to LIKE search
-            debug!(
-                query = %query,
-                error = %e,
-                method = "like_fallback",
-                "FTS search failed, using LIKE fallback"
-            );
-
-            let like_pattern = format!("%{}%", query);
-            let mut stmt = conn
-                .prepare(
-                    r#"
-                    SELECT id, title, content, created_at, updated_at,
-                           deleted_at, is_pinned, sort_order
-                    FROM notes
-                    WHERE deleted_at IS NULL
-                      AND (title LIKE ?1 OR content LIKE ?1)
-                    ORDER BY updated_at DESC
-                    "#,
-                )
-                .context("Failed to prepare LIKE fallback query")?;
+        })();
 
-            let notes = stmt
-                .query_map(params![like_pattern], row_to_note)
-                .context("Failed to execute LIKE fallback search")?
-                .collect::<Result<Vec<_>, _>>()
-                .context("Failed to collect LIKE fallback results")?;
+        match fts_result {
+            Ok(notes) => {
+                debug!(query = %query, count = notes.len(), method = "fts", "Note search completed");
+                Ok(notes)
+            }
+            Err(e) => {
+                // FTS failed (possibly due to special characters), fall back to LIKE search
+                debug!(
+                    query = %query,
+                    error = %e,
+                    method = "like_fallback",
+                    "FTS search failed, using LIKE fallback"
+                );
 
-            debug!(query = %query, count = notes.len(), method = "like_fallback", "Note search completed");
-            Ok(notes)
+                let like_pattern = format!("%{}%", query);
+                let mut stmt = conn
+                    .prepare(
+                        r#"
+                        SELECT id, title, content, created_at, updated_at,
+                               deleted_at, is_pinned, sort_order
+                        FROM notes
+                        WHERE deleted_at IS NULL
+                          AND (title LIKE ?1 OR content LIKE ?1)
+                        ORDER BY updated_at DESC
+                        "#,
+                    )
+                    .context("Failed to prepare LIKE fallback query")?;
+
+                let notes = stmt
+                    .query_map(params![like_pattern], row_to_note)
+                    .context("Failed to execute LIKE fallback search")?
+                    .collect::<Result<Vec<_>, _>>()
+                    .context("Failed to collect LIKE fallback results")?;
+
+                debug!(query = %query, count = notes.len(), method = "like_fallback", "Note search completed");
+                Ok(notes)
+            }
         }
-    }
+    })
 }
 
 fn search_notes_metadata_only(conn: &Connection, query: &str) -> Result<Option<Vec<Note>>> {
@@ -1684,45 +1665,45 @@ fn search_notes_by_metadata(conn: &Connection, mode: &str, query: &str) -> Resul
 }
 
 pub(crate) fn get_note_tags(note_id: NoteId) -> Result<Vec<String>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT tag
-            FROM note_tags
-            WHERE note_id = ?1
-            ORDER BY normalized_tag ASC
-            "#,
-        )
-        .context("Failed to prepare note tags query")?;
-    let tags = stmt
-        .query_map(params![note_id.as_str()], |row| row.get::<_, String>(0))
-        .context("Failed to query note tags")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect note tags")?;
-    Ok(tags)
+    with_read_conn("notes_tags", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT tag
+                FROM note_tags
+                WHERE note_id = ?1
+                ORDER BY normalized_tag ASC
+                "#,
+            )
+            .context("Failed to prepare note tags query")?;
+        let tags = stmt
+            .query_map(params![note_id.as_str()], |row| row.get::<_, String>(0))
+            .context("Failed to query note tags")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect note tags")?;
+        Ok(tags)
+    })
 }
 
 pub(crate) fn get_note_aliases(note_id: NoteId) -> Result<Vec<String>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT alias
-            FROM note_aliases
-            WHERE note_id = ?1
-            ORDER BY slug ASC
-            "#,
-        )
-        .context("Failed to prepare note aliases query")?;
-    let aliases = stmt
-        .query_map(params![note_id.as_str()], |row| row.get::<_, String>(0))
-        .context("Failed to query note aliases")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect note aliases")?;
-    Ok(aliases)
+    with_read_conn("notes_aliases", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT alias
+                FROM note_aliases
+                WHERE note_id = ?1
+                ORDER BY slug ASC
+                "#,
+            )
+            .context("Failed to prepare note aliases query")?;
+        let aliases = stmt
+            .query_map(params![note_id.as_str()], |row| row.get::<_, String>(0))
+            .context("Failed to query note aliases")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect note aliases")?;
+        Ok(aliases)
+    })
 }
 
 pub(crate) fn get_note_outbound_link_count(note_id: NoteId) -> Result<usize> {
@@ -1746,53 +1727,53 @@ pub(crate) fn get_note_backlink_count(note_id: NoteId) -> Result<usize> {
 }
 
 pub(crate) fn get_note_backlinks(note_id: NoteId) -> Result<Vec<NoteBacklinkSummary>> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-    let mut stmt = conn
-        .prepare(
-            r#"
-            SELECT DISTINCT n.id, n.title, n.updated_at
-            FROM note_links l
-            JOIN notes n ON n.id = l.source_note_id
-            WHERE l.target_note_id = ?1 AND n.deleted_at IS NULL
-            ORDER BY n.updated_at DESC
-            "#,
-        )
-        .context("Failed to prepare note backlinks query")?;
-    let backlinks = stmt
-        .query_map(params![note_id.as_str()], |row| {
-            let id: String = row.get(0)?;
-            let title: String = row.get(1)?;
-            let updated_at_str: String = row.get(2)?;
-            let id = NoteId::parse(&id).ok_or_else(|| {
-                rusqlite::Error::FromSqlConversionFailure(
-                    0,
-                    rusqlite::types::Type::Text,
-                    format!("Invalid backlink source note UUID: {id}").into(),
-                )
-            })?;
-            let updated_at = DateTime::parse_from_rfc3339(&updated_at_str)
-                .map(|dt| dt.with_timezone(&Utc))
-                .unwrap_or_else(|_| Utc::now());
-            Ok(NoteBacklinkSummary {
-                id,
-                title,
-                updated_at,
+    with_read_conn("notes_backlinks", |conn| {
+        let mut stmt = conn
+            .prepare(
+                r#"
+                SELECT DISTINCT n.id, n.title, n.updated_at
+                FROM note_links l
+                JOIN notes n ON n.id = l.source_note_id
+                WHERE l.target_note_id = ?1 AND n.deleted_at IS NULL
+                ORDER BY n.updated_at DESC
+                "#,
+            )
+            .context("Failed to prepare note backlinks query")?;
+        let backlinks = stmt
+            .query_map(params![note_id.as_str()], |row| {
+                let id: String = row.get(0)?;
+                let title: String = row.get(1)?;
+                let updated_at_str: String = row.get(2)?;
+                let id = NoteId::parse(&id).ok_or_else(|| {
+                    rusqlite::Error::FromSqlConversionFailure(
+                        0,
+                        rusqlite::types::Type::Text,
+                        format!("Invalid backlink source note UUID: {id}").into(),
+                    )
+                })?;
+                let updated_at = DateTime::parse_from_rfc3339(&updated_at_str)
+                    .map(|dt| dt.with_timezone(&Utc))
+                    .unwrap_or_else(|_| Utc::now());
+                Ok(NoteBacklinkSummary {
+                    id,
+                    title,
+                    updated_at,
+                })
             })
-        })
-        .context("Failed to query note backlinks")?
-        .collect::<Result<Vec<_>, _>>()
-        .context("Failed to collect note backlinks")?;
-    Ok(backlinks)
+            .context("Failed to query note backlinks")?
+            .collect::<Result<Vec<_>, _>>()
+            .context("Failed to collect note backlinks")?;
+        Ok(backlinks)
+    })
 }
 
 fn count_note_links(sql: &str, note_id: NoteId) -> Result<usize> {
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-    let count: i64 = conn
-        .query_row(sql, params![note_id.as_str()], |row| row.get(0))
-        .context("Failed to count note links")?;
-    Ok(count.max(0) as usize)
+    with_read_conn("notes_count_links", |conn| {
+        let count: i64 = conn
+            .query_row(sql, params![note_id.as_str()], |row| row.get(0))
+            .context("Failed to count note links")?;
+        Ok(count.max(0) as usize)
+    })
 }
 
 /// Search notes for root launcher rows without returning note body content.
@@ -1824,126 +1805,99 @@ pub(crate) fn search_root_notes_meta_direct(
     search_root_notes_meta(query, options)
 }
 
-/// Cache-only root notes lookup for the launcher foreground search path.
-///
-/// A cold query starts a background SQLite search and returns no hits for the
-/// active frame. The worker only warms a future frame cache; it does not notify
-/// or invalidate the current launcher rows.
-pub(crate) fn search_root_notes_meta_cached(
-    query: &str,
-    options: RootNotesSectionOptions,
-) -> Vec<RootNoteSearchHit> {
-    if !root_notes_query_is_eligible(query, options) {
-        return Vec::new();
-    }
-
-    let key = root_notes_search_cache_key(query, options);
-    let generation = ROOT_NOTES_SEARCH_CACHE_GENERATION.load(Ordering::Relaxed);
-    let flight = RootNotesSearchFlightKey {
-        generation,
-        search: key.clone(),
-    };
-
-    if let Ok(mut guard) = root_notes_search_cache().lock() {
-        if let Some(hits) = guard.hits_by_query.get(&key) {
-            return hits.clone();
-        }
-        if !guard.in_flight.insert(flight.clone()) {
-            return Vec::new();
-        }
-    } else {
-        return Vec::new();
-    }
-
-    let query = key.query.clone();
-    let key_for_worker = key.clone();
-    let flight_for_worker = flight.clone();
-    let spawn_result = std::thread::Builder::new()
-        .name("root-notes-search-cache".to_string())
-        .spawn(move || {
-            let hits = search_root_notes_meta(&query, options);
-            if let Ok(mut guard) = root_notes_search_cache().lock() {
-                guard.in_flight.remove(&flight_for_worker);
-                if ROOT_NOTES_SEARCH_CACHE_GENERATION.load(Ordering::Relaxed) == generation {
-                    guard.hits_by_query.insert(key_for_worker, hits);
-                }
-            }
-        });
-
-    if spawn_result.is_err() {
-        if let Ok(mut guard) = root_notes_search_cache().lock() {
-            guard.in_flight.remove(&flight);
-        }
-    }
-
-    Vec::new()
-}
-
-fn search_root_notes_meta_result(
-    query: &str,
-    options: RootNotesSectionOptions,
-) -> Result<Vec<RootNoteSearchHit>> {
+/// Every live note, pinned first then most recently updated, for the root
+/// search index. Blocking; runs on the index rebuild thread.
+pub(crate) fn load_root_notes_index_documents() -> Result<Vec<RootNoteIndexDocument>> {
     init_notes_db()?;
-    let db = get_db()?;
-    let conn = db.lock().map_err(db_lock_err)?;
-
-    let limit = options.max_results.clamp(1, 5) as i64;
-    let hits = if query.trim().is_empty() {
+    with_read_conn("notes_root_index", |conn| {
         let mut stmt = conn
             .prepare(
                 r#"
-                SELECT id, title, updated_at, is_pinned, length(content)
+                SELECT id, title, updated_at, is_pinned, length(content), content
                 FROM notes
                 WHERE deleted_at IS NULL
                 ORDER BY is_pinned DESC, updated_at DESC
-                LIMIT ?1
                 "#,
             )
-            .context("Failed to prepare root notes recent query")?;
-
-        let rows = stmt
-            .query_map(params![limit], row_to_root_note_hit)
-            .context("Failed to execute root notes recent query")?
+            .context("Failed to prepare root notes index query")?;
+        let documents = stmt
+            .query_map([], |row| {
+                Ok(RootNoteIndexDocument {
+                    hit: row_to_root_note_hit(row)?,
+                    content: row.get(5)?,
+                })
+            })
+            .context("Failed to execute root notes index query")?
             .collect::<Result<Vec<_>, _>>()
-            .context("Failed to collect root notes recent results")?;
-        rows
-    } else if options.search_content {
-        let sanitized_query = sanitize_fts_query(query);
-        let mut stmt = conn
-            .prepare(
-                r#"
-                SELECT n.id, n.title, n.updated_at, n.is_pinned, length(n.content)
-                FROM notes n
-                INNER JOIN notes_fts fts ON n.rowid = fts.rowid
-                WHERE notes_fts MATCH ?1 AND n.deleted_at IS NULL
-                ORDER BY bm25(notes_fts, 8.0, 1.0), n.is_pinned DESC, n.updated_at DESC
-                LIMIT ?2
-                "#,
-            )
-            .context("Failed to prepare root notes FTS query")?;
+            .context("Failed to collect root notes index documents")?;
+        Ok(documents)
+    })
+}
 
-        let hits = stmt
-            .query_map(params![sanitized_query, limit], row_to_root_note_hit)
-            .context("Failed to execute root notes FTS query")?
-            .collect::<Result<Vec<_>, _>>()
-            .context("Failed to collect root notes FTS results")?;
-        if hits.is_empty() {
-            search_root_notes_meta_like(&conn, query, true, limit)?
+fn search_root_notes_meta_result(
+    query: &str,
+    options: RootNotesSectionOptions,
+) -> Result<Vec<RootNoteSearchHit>> {
+    init_notes_db()?;
+    with_read_conn("notes_root_search", |conn| {
+        let limit = options.max_results.clamp(1, 5) as i64;
+        let hits = if query.trim().is_empty() {
+            let mut stmt = conn
+                .prepare(
+                    r#"
+                    SELECT id, title, updated_at, is_pinned, length(content)
+                    FROM notes
+                    WHERE deleted_at IS NULL
+                    ORDER BY is_pinned DESC, updated_at DESC
+                    LIMIT ?1
+                    "#,
+                )
+                .context("Failed to prepare root notes recent query")?;
+
+            let rows = stmt
+                .query_map(params![limit], row_to_root_note_hit)
+                .context("Failed to execute root notes recent query")?
+                .collect::<Result<Vec<_>, _>>()
+                .context("Failed to collect root notes recent results")?;
+            rows
+        } else if options.search_content {
+            let sanitized_query = sanitize_fts_query(query);
+            let mut stmt = conn
+                .prepare(
+                    r#"
+                    SELECT n.id, n.title, n.updated_at, n.is_pinned, length(n.content)
+                    FROM notes n
+                    INNER JOIN notes_fts fts ON n.rowid = fts.rowid
+                    WHERE notes_fts MATCH ?1 AND n.deleted_at IS NULL
+                    ORDER BY bm25(notes_fts, 8.0, 1.0), n.is_pinned DESC, n.updated_at DESC
+                    LIMIT ?2
+                    "#,
+                )
+                .context("Failed to prepare root notes FTS query")?;
+
+            let hits = stmt
+                .query_map(params![sanitized_query, limit], row_to_root_note_hit)
+                .context("Failed to execute root notes FTS query")?
+                .collect::<Result<Vec<_>, _>>()
+                .context("Failed to collect root notes FTS results")?;
+            if hits.is_empty() {
+                search_root_notes_meta_like(&conn, query, true, limit)?
+            } else {
+                hits
+            }
         } else {
-            hits
-        }
-    } else {
-        search_root_notes_meta_like(&conn, query, false, limit)?
-    };
+            search_root_notes_meta_like(&conn, query, false, limit)?
+        };
 
-    Ok(hits
-        .into_iter()
-        .enumerate()
-        .map(|(rank, mut hit)| {
-            hit.score = i32::MAX.saturating_sub(rank as i32);
-            hit
-        })
-        .collect())
+        Ok(hits
+            .into_iter()
+            .enumerate()
+            .map(|(rank, mut hit)| {
+                hit.score = i32::MAX.saturating_sub(rank as i32);
+                hit
+            })
+            .collect())
+    })
 }
 
 fn search_root_notes_meta_like(
@@ -0,0 +1,223 @@
+use std::io::{BufRead, BufReader, Write};
+use std::net::{TcpListener, TcpStream};
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::Arc;
+use std::time::Instant;
+
+use crate::ai::providers::{build_agent, stream_sse_lines};
+
+const REQUESTS: usize = 20;
+const TOKENS_PER_STREAM: usize = 20_000;
+const FRAMER_ROUNDS: usize = 10;
+
+#[derive(Debug, Default)]
+pub(crate) struct AiSseBenchReport {
+    pub requests: usize,
+    pub tokens_per_stream: usize,
+    pub fresh_agent_connections: usize,
+    pub fresh_agent_ttft_p50_ms: f64,
+    pub fresh_agent_tokens_per_sec: f64,
+    pub shared_agent_connections: usize,
+    pub shared_agent_ttft_p50_ms: f64,
+    pub shared_agent_tokens_per_sec: f64,
+    pub lines_framer_events_per_sec: f64,
+    pub reused_buffer_framer_events_per_sec: f64,
+}
+
+/// Streaming cost against a local mock SSE server: a fresh agent per request
+/// (what every re-created provider used to pay) versus the pooled agent the
+/// providers now share, reporting connections opened, time-to-first-token and
+/// tokens/sec. The framer is also timed alone on an in-memory body against the
+/// old `lines()` loop that allocated a `String` per line.
+///
+/// Returns `None` when the mock server cannot bind a loopback port.
+pub(crate) fn run_ai_sse_benchmark() -> Option<AiSseBenchReport> {
+    let body = Arc::new(synthetic_sse_body(TOKENS_PER_STREAM));
+    let (url, connections) = start_mock_sse_server(Arc::clone(&body))?;
+
+    let mut fresh_ttft = Vec::with_capacity(REQUESTS);
+    let mut fresh_secs = 0.0;
+    for _ in 0..REQUESTS {
+        let (ttft, secs) = stream_once(&build_agent(false), &url)?;
+        fresh_ttft.push(ttft);
+        fresh_secs += secs;
+    }
+    let fresh_agent_connections = connections.swap(0, Ordering::SeqCst);
+
+    let shared = build_agent(false);
+    let mut shared_ttft = Vec::with_capacity(REQUESTS);
+    let mut shared_secs = 0.0;
+    for _ in 0..REQUESTS {
+        let (ttft, secs) = stream_once(&shared, &url)?;
+        shared_ttft.push(ttft);
+        shared_secs += secs;
+    }
+    let shared_agent_connections = connections.load(Ordering::SeqCst);
+
+    let start = Instant::now();
+    for _ in 0..FRAMER_ROUNDS {
+        let mut events = 0;
+        frame_with_lines(body.as_bytes(), |_| events += 1).ok()?;
+        std::hint::black_box(events);
+    }
+    let lines_secs = start.elapsed().as_secs_f64();
+
+    let start = Instant::now();
+    for _ in 0..FRAMER_ROUNDS {
+        let mut events = 0;
+        stream_sse_lines(body.as_bytes(), |_| {
+            events += 1;
+            Ok(true)
+        })
+        .ok()?;
+        std::hint::black_box(events);
+    }
+    let reused_secs = start.elapsed().as_secs_f64();
+
+    let total_tokens = (REQUESTS * TOKENS_PER_STREAM) as f64;
+    let framed_events = (FRAMER_ROUNDS * TOKENS_PER_STREAM) as f64;
+    Some(AiSseBenchReport {
+        requests: REQUESTS,
+        tokens_per_stream: TOKENS_PER_STREAM,
+        fresh_agent_connections,
+        fresh_agent_ttft_p50_ms: median_ms(&mut fresh_ttft),
+        fresh_agent_tokens_per_sec: total_tokens / fresh_secs,
+        shared_agent_connections,
+        shared_agent_ttft_p50_ms: median_ms(&mut shared_ttft),
+        shared_agent_tokens_per_sec: total_tokens / shared_secs,
+        lines_framer_events_per_sec: framed_events / lines_secs,
+        reused_buffer_framer_events_per_sec: framed_events / reused_secs,
+    })
+}
+
+/// One streamed request; returns (time to first token, whole stream) in seconds.
+fn stream_once(agent: &ureq::Agent, url: &str) -> Option<(f64, f64)> {
+    let start = Instant::now();
+    let response = agent.get(url).call().ok()?;
+    let reader = BufReader::new(response.into_body().into_reader());
+    let mut first_token = None;
+    stream_sse_lines(reader, |_| {
+        first_token.get_or_insert_with(|| start.elapsed().as_secs_f64());
+        Ok(true)
+    })
+    .ok()?;
+    Some((first_token?, start.elapsed().as_secs_f64()))
+}
+
+/// The framer as it was: one `String` per line from `BufRead::lines`.
+fn frame_with_lines(reader: impl BufRead, mut on_data: impl FnMut(&str)) -> std::io::Result<()> {
+    let mut data_buf = String::new();
+    for line in reader.lines() {
+        let mut line = line?;
+        if line.ends_with('\r') {
+            line.pop();
+        }
+        if line.is_empty() {
+            if data_buf == "[DONE]" {
+                break;
+            }
+            if !data_buf.is_empty() {
+                on_data(&data_buf);
+                data_buf.clear();
+            }
+        } else if let Some(data) = line.strip_prefix("data: ") {
+            if !data_buf.is_empty() {
+                data_buf.push('\n');
+            }
+            data_buf.push_str(data);
+        }
+    }
+    Ok(())
+}
+
+fn synthetic_sse_body(tokens: usize) -> String {
+    let mut body = String::new();
+    for index in 0..tokens {
+        body.push_str(&format!(
+            "data: {{\"id\":\"chatcmpl-bench\",\"choices\":[{{\"index\":0,\"delta\":{{\"content\":\"tok{index} \"}}}}]}}\n\n"
+        ));
+    }
+    body.push_str("data: [DONE]\n\n");
+    body
+}
+
+/// Serve `body` as an SSE response to every request, keeping connections
+/// alive. Returns the URL and a counter of accepted connections.
+fn start_mock_sse_server(body: Arc<String>) -> Option<(String, Arc<AtomicUsize>)> {
+    let listener = TcpListener::bind("127.0.0.1:0").ok()?;
+    let url = format!("http://{}/v1/chat/completions", listener.local_addr().ok()?);
+    let connections = Arc::new(AtomicUsize::new(0));
+    let accepted = Arc::clone(&connections);
+    std::thread::Builder::new()
+        .name("ai-sse-bench-server".to_string())
+        .spawn(move || {
+            for stream in listener.incoming().flatten() {
+                accepted.fetch_add(1, Ordering::SeqCst);
+                let body = Arc::clone(&body);
+                let _ = std::thread::Builder::new()
+                    .name("ai-sse-bench-conn".to_string())
+                    .spawn(move || serve_connection(stream, &body));
+            }
+        })
+        .ok()?;
+    Some((url, connections))
+}
+
+fn serve_connection(stream: TcpStream, body: &str) {
+    let Ok(mut writer) = stream.try_clone() else {
+        return;
+    };
+    let mut reader = BufReader::new(stream);
+    let mut line = String::new();
+    loop {
+        // Request line and headers; GET requests carry no body.
+        loop {
+            line.clear();
+            match reader.read_line(&mut line) {
+                Ok(0) | Err(_) => return,
+                Ok(_) if line == "\r\n" || line == "\n" => break,
+                Ok(_) => {}
+            }
+        }
+        let head = format!(
+            "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nContent-Length: {}\r\n\r\n",
+            body.len()
+        );
+        if writer.write_all(head.as_bytes()).is_err()
+            || writer.write_all(body.as_bytes()).is_err()
+            || writer.flush().is_err()
+        {
+            return;
+        }
+    }
+}
+
+fn median_ms(samples: &mut [f64]) -> f64 {
+    samples.sort_by(f64::total_cmp);
+    samples.get(samples.len() / 2).copied().unwrap_or_default() * 1000.0
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release ai_sse_stream_benchmark -- --ignored --nocapture"]
+    fn ai_sse_stream_benchmark() {
+        let Some(report) = run_ai_sse_benchmark() else {
+            eprintln!("loopback mock server is unavailable; skipping AI SSE benchmark");
+            return;
+        };
+        eprintln!("{report:#?}");
+
+        assert_eq!(report.fresh_agent_connections, REQUESTS);
+        assert_eq!(
+            report.shared_agent_connections, 1,
+            "the shared agent should stream every request over one kept-alive connection: {report:#?}"
+        );
+        assert!(
+            report.reused_buffer_framer_events_per_sec > report.lines_framer_events_per_sec,
+            "framing into reused buffers should beat a String per line: {report:#?}"
+        );
+    }
+}
@@ -0,0 +1,113 @@
+use std::path::{Path, PathBuf};
+use std::time::Instant;
+
+use crate::brain::chunker::{
+    chunk_markdown, MarkdownChunks, CHUNK_OVERLAP_BYTES, CHUNK_TARGET_BYTES,
+};
+
+const ROUNDS: usize = 20;
+/// Markdown trees in this repo used as the note corpus: guides, scriptlet
+/// notes, agent docs and design docs written by hand.
+const CORPUS_DIRS: [&str; 3] = ["kit-init", "docs", "."];
+
+#[derive(Debug, Default)]
+pub(crate) struct BrainChunkBenchReport {
+    pub docs: usize,
+    pub corpus_bytes: usize,
+    pub chunks_per_round: usize,
+    pub collected_mb_per_sec: f64,
+    pub streamed_mb_per_sec: f64,
+}
+
+/// Chunker throughput over real markdown notes, both collected into a `Vec`
+/// (what the indexer does per batch) and streamed one chunk at a time.
+///
+/// Returns `None` when no markdown corpus is found next to the crate.
+pub(crate) fn run_brain_chunk_benchmark() -> Option<BrainChunkBenchReport> {
+    let root = Path::new(env!("CARGO_MANIFEST_DIR"));
+    let mut paths = Vec::new();
+    for dir in CORPUS_DIRS {
+        collect_markdown(&root.join(dir), dir != ".", &mut paths);
+    }
+    paths.sort();
+    paths.dedup();
+    let docs: Vec<String> = paths
+        .iter()
+        .filter_map(|path| std::fs::read_to_string(path).ok())
+        .filter(|doc| !doc.trim().is_empty())
+        .collect();
+    if docs.is_empty() {
+        return None;
+    }
+    let corpus_bytes: usize = docs.iter().map(String::len).sum();
+
+    let mut chunks_per_round = 0;
+    let start = Instant::now();
+    for _ in 0..ROUNDS {
+        chunks_per_round = docs
+            .iter()
+            .map(|doc| std::hint::black_box(chunk_markdown(doc)).len())
+            .sum();
+    }
+    let collected = start.elapsed().as_secs_f64();
+
+    let start = Instant::now();
+    for _ in 0..ROUNDS {
+        for doc in &docs {
+            for chunk in MarkdownChunks::new(doc, CHUNK_TARGET_BYTES, CHUNK_OVERLAP_BYTES) {
+                std::hint::black_box(chunk);
+            }
+        }
+    }
+    let streamed = start.elapsed().as_secs_f64();
+
+    let megabytes = (corpus_bytes * ROUNDS) as f64 / 1_000_000.0;
+    Some(BrainChunkBenchReport {
+        docs: docs.len(),
+        corpus_bytes,
+        chunks_per_round,
+        collected_mb_per_sec: megabytes / collected,
+        streamed_mb_per_sec: megabytes / streamed,
+    })
+}
+
+/// Markdown files under `dir`; the crate root itself is not recursed into
+/// (it holds `target/` and `node_modules/`).
+fn collect_markdown(dir: &Path, recurse: bool, out: &mut Vec<PathBuf>) {
+    let Ok(entries) = std::fs::read_dir(dir) else {
+        return;
+    };
+    for path in entries.flatten().map(|entry| entry.path()) {
+        if path.is_dir() {
+            if recurse {
+                collect_markdown(&path, true, out);
+            }
+        } else if path.extension().is_some_and(|ext| ext == "md") {
+            out.push(path);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release brain_chunk_throughput_benchmark -- --ignored --nocapture"]
+    fn brain_chunk_throughput_benchmark() {
+        let Some(report) = run_brain_chunk_benchmark() else {
+            eprintln!("no markdown corpus found; skipping brain chunk benchmark");
+            return;
+        };
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.chunks_per_round >= report.docs,
+            "every non-empty doc yields at least one chunk: {report:#?}"
+        );
+        assert!(
+            report.streamed_mb_per_sec > 50.0,
+            "chunking should keep well ahead of embedding: {report:#?}"
+        );
+    }
+}
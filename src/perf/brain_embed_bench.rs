@@ -0,0 +1,87 @@
+use std::time::Instant;
+
+use crate::brain::chunker::CHUNK_TARGET_BYTES;
+use crate::brain::embedder::{resolve_embed_model, BrainEmbedder};
+
+const CHUNKS: usize = 128;
+/// The brain indexer's embed batch size.
+const PACKED_BATCH: usize = 16;
+
+#[derive(Debug, Default)]
+pub(crate) struct BrainEmbedBenchReport {
+    pub chunks: usize,
+    pub one_per_request_chunks_per_sec: f64,
+    pub packed_chunks_per_sec: f64,
+}
+
+/// Embedding throughput on chunks the size the brain chunker emits:
+///
+/// - one text per request, the pre-packing loop's one decode per text;
+/// - packed: the indexer's 16-text requests, each split into multi-sequence
+///   decodes.
+///
+/// Returns `None` when the helper binary or an embedding model is unavailable.
+pub(crate) fn run_brain_embed_benchmark() -> Option<BrainEmbedBenchReport> {
+    let model = resolve_embed_model()?;
+    let embedder = BrainEmbedder::spawn(model).ok()?;
+    let chunks: Vec<String> = (0..CHUNKS).map(synthetic_chunk).collect();
+    let texts: Vec<&str> = chunks.iter().map(String::as_str).collect();
+
+    // Load the model before timing any mode.
+    embedder.embed(&texts[..1]).ok()?;
+
+    let start = Instant::now();
+    for &text in &texts {
+        embedder.embed(&[text]).ok()?;
+    }
+    let one_per_request = start.elapsed().as_secs_f64();
+
+    let start = Instant::now();
+    for batch in texts.chunks(PACKED_BATCH) {
+        embedder.embed(batch).ok()?;
+    }
+    let packed = start.elapsed().as_secs_f64();
+
+    Some(BrainEmbedBenchReport {
+        chunks: CHUNKS,
+        one_per_request_chunks_per_sec: CHUNKS as f64 / one_per_request,
+        packed_chunks_per_sec: CHUNKS as f64 / packed,
+    })
+}
+
+fn synthetic_chunk(index: usize) -> String {
+    let mut chunk = format!("## Note {index}\n\n");
+    let mut paragraph = 0;
+    while chunk.len() < CHUNK_TARGET_BYTES {
+        chunk.push_str(&format!(
+            "Meeting follow-ups for project {index}.{paragraph}: review the launch \
+             checklist, update the release notes, and confirm the rollout window with the \
+             team. Open questions include caching strategy, retry behaviour for flaky \
+             network calls, and whether clipboard history should be indexed.\n\n- [ ] \
+             draft summary {paragraph}\n- [ ] share with reviewers\n\n"
+        ));
+        paragraph += 1;
+    }
+    chunk.truncate(CHUNK_TARGET_BYTES);
+    chunk
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release brain_embed_throughput_benchmark -- --ignored --nocapture"]
+    fn brain_embed_throughput_benchmark() {
+        let Some(report) = run_brain_embed_benchmark() else {
+            eprintln!("embed helper or model is unavailable; skipping brain embed benchmark");
+            return;
+        };
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.packed_chunks_per_sec > report.one_per_request_chunks_per_sec,
+            "packed batches should embed more chunks per second: {report:#?}"
+        );
+    }
+}
@@ -0,0 +1,143 @@
+use std::time::Instant;
+
+use base64::Engine as _;
+use serde::Serialize;
+
+use crate::brain::embedder::parse_response_line;
+
+/// The brain indexer's embed batch size.
+const BATCH: usize = 16;
+/// Dimension of the common small GGUF embedding models.
+const DIM: usize = 768;
+const ROUNDS: usize = 200;
+
+#[derive(Debug, Default)]
+pub(crate) struct BrainEmbedWireBenchReport {
+    pub batch: usize,
+    pub dim: usize,
+    pub json_line_bytes: usize,
+    pub packed_line_bytes: usize,
+    pub json_round_trip_us: f64,
+    pub packed_round_trip_us: f64,
+}
+
+/// The helper's embed response for one batch, in both vector encodings.
+#[derive(Serialize)]
+struct WireResponse<'a> {
+    id: u64,
+    ok: bool,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    embeddings: Option<&'a [Vec<f32>]>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    embeddings_f32le_base64: Option<Vec<String>>,
+}
+
+/// Embed response round trip for one indexer batch: the helper serializing
+/// its vectors onto a stdout line and the embedder's reader parsing that line
+/// back into vectors. JSON number arrays (what every helper sent before the
+/// `hello` negotiation) versus base64 little-endian `f32` payloads. The
+/// helper is a separate binary, so its encoders are mirrored here.
+pub(crate) fn run_brain_embed_wire_benchmark() -> Option<BrainEmbedWireBenchReport> {
+    let vectors = synthetic_batch();
+    let mut scratch = Vec::new();
+
+    let json_line = encode_json(&vectors)?;
+    let packed_line = encode_packed(&vectors)?;
+    // Packed vectors are the exact bits; JSON floats only come back close.
+    if parse_response_line(&packed_line, &mut scratch)?.embeddings? != vectors {
+        return None;
+    }
+    let json_vectors = parse_response_line(&json_line, &mut scratch)?.embeddings?;
+    let mut pairs = json_vectors.iter().flatten().zip(vectors.iter().flatten());
+    if json_vectors.len() != BATCH || pairs.any(|(json, exact)| (json - exact).abs() > 1e-6) {
+        return None;
+    }
+
+    let start = Instant::now();
+    for _ in 0..ROUNDS {
+        let line = encode_json(std::hint::black_box(&vectors))?;
+        std::hint::black_box(parse_response_line(&line, &mut scratch)?);
+    }
+    let json_secs = start.elapsed().as_secs_f64();
+
+    let start = Instant::now();
+    for _ in 0..ROUNDS {
+        let line = encode_packed(std::hint::black_box(&vectors))?;
+        std::hint::black_box(parse_response_line(&line, &mut scratch)?);
+    }
+    let packed_secs = start.elapsed().as_secs_f64();
+
+    Some(BrainEmbedWireBenchReport {
+        batch: BATCH,
+        dim: DIM,
+        json_line_bytes: json_line.len(),
+        packed_line_bytes: packed_line.len(),
+        json_round_trip_us: json_secs * 1_000_000.0 / ROUNDS as f64,
+        packed_round_trip_us: packed_secs * 1_000_000.0 / ROUNDS as f64,
+    })
+}
+
+fn encode_json(vectors: &[Vec<f32>]) -> Option<String> {
+    serde_json::to_string(&WireResponse {
+        id: 1,
+        ok: true,
+        embeddings: Some(vectors),
+        embeddings_f32le_base64: None,
+    })
+    .ok()
+}
+
+fn encode_packed(vectors: &[Vec<f32>]) -> Option<String> {
+    let mut bytes = Vec::new();
+    let packed = vectors
+        .iter()
+        .map(|vector| {
+            bytes.clear();
+            bytes.extend(vector.iter().flat_map(|value| value.to_le_bytes()));
+            base64::engine::general_purpose::STANDARD.encode(&bytes)
+        })
+        .collect();
+    serde_json::to_string(&WireResponse {
+        id: 1,
+        ok: true,
+        embeddings: None,
+        embeddings_f32le_base64: Some(packed),
+    })
+    .ok()
+}
+
+/// Unit-normalized vectors with full-precision components, like real model
+/// output (short decimals would flatter the JSON encoding).
+fn synthetic_batch() -> Vec<Vec<f32>> {
+    (0..BATCH)
+        .map(|row| {
+            let raw: Vec<f32> = (0..DIM)
+                .map(|col| ((row * DIM + col) as f32 * 0.618_034).sin())
+                .collect();
+            let norm = raw.iter().map(|value| value * value).sum::<f32>().sqrt();
+            raw.iter().map(|value| value / norm).collect()
+        })
+        .collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release brain_embed_wire_round_trip_benchmark -- --ignored --nocapture"]
+    fn brain_embed_wire_round_trip_benchmark() {
+        let report =
+            run_brain_embed_wire_benchmark().expect("both encodings should round-trip the batch");
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.packed_line_bytes < report.json_line_bytes,
+            "packed vectors should be smaller on the wire: {report:#?}"
+        );
+        assert!(
+            report.packed_round_trip_us < report.json_round_trip_us,
+            "packed vectors should skip per-float formatting and parsing: {report:#?}"
+        );
+    }
+}
@@ -0,0 +1,76 @@
+use std::sync::atomic::AtomicBool;
+use std::sync::Arc;
+use std::time::Instant;
+
+use crate::ai::local_llm::model_locator::resolve_ghost_model;
+use crate::ai::local_llm::LoadedLocalLlm;
+use crate::scripts::search::ghost::{build_local_ghost_prompt, GhostContext};
+
+const QUERY: &str = "refactor the clipboard history search to use the shared index";
+
+#[derive(Debug, Default)]
+pub(crate) struct GhostPrefillBenchReport {
+    pub requests: usize,
+    pub prefill_tokens: Vec<usize>,
+    pub first_prefill_tokens: usize,
+    pub mean_prefill_tokens_after_first: f64,
+    pub p50_ms: f64,
+    pub p95_ms: f64,
+}
+
+/// Replays a query typed one keystroke at a time, the way the launcher fires
+/// ghost requests, and reports how much of each prompt the helper had to
+/// prefill plus completion latency.
+///
+/// Returns `None` when no ghost model is on disk or the helper cannot start.
+pub(crate) fn run_ghost_prefill_benchmark() -> Option<GhostPrefillBenchReport> {
+    let model = resolve_ghost_model(&crate::config::Config::default())?;
+    let mut llm = LoadedLocalLlm::load(&model).ok()?;
+    let context = GhostContext::default();
+    let cancel = Arc::new(AtomicBool::new(false));
+
+    let mut prefill_tokens = Vec::new();
+    let mut latencies_ms = Vec::new();
+    for end in (1..=QUERY.len()).filter(|end| QUERY.is_char_boundary(*end)) {
+        let prompt = build_local_ghost_prompt(&QUERY[..end], &context);
+        let started = Instant::now();
+        llm.generate_one_line(&prompt, &cancel)
+            .expect("ghost generation");
+        latencies_ms.push(started.elapsed().as_secs_f64() * 1000.0);
+        prefill_tokens.push(llm.last_prefill_tokens().unwrap_or(0));
+    }
+
+    let warm = &prefill_tokens[1..];
+    let mean_prefill_tokens_after_first =
+        warm.iter().sum::<usize>() as f64 / warm.len().max(1) as f64;
+    latencies_ms.sort_by(f64::total_cmp);
+    let p95_index = (latencies_ms.len() * 95 / 100).min(latencies_ms.len() - 1);
+    Some(GhostPrefillBenchReport {
+        requests: prefill_tokens.len(),
+        first_prefill_tokens: prefill_tokens[0],
+        mean_prefill_tokens_after_first,
+        p50_ms: latencies_ms[latencies_ms.len() / 2],
+        p95_ms: latencies_ms[p95_index],
+        prefill_tokens,
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release --features local-llm ghost_prefill_replay_benchmark -- --ignored --nocapture"]
+    fn ghost_prefill_replay_benchmark() {
+        let Some(report) = run_ghost_prefill_benchmark() else {
+            eprintln!("no ghost model on disk; skipping ghost prefill replay benchmark");
+            return;
+        };
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.mean_prefill_tokens_after_first < report.first_prefill_tokens as f64 / 4.0,
+            "keystroke prompts should reuse the cached prefix: {report:#?}"
+        );
+    }
+}
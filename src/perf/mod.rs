@@ -8,8 +8,26 @@
 //!
 //! Used to establish baseline metrics and identify performance bottlenecks.
 
+#[cfg(test)]
+pub(crate) mod ai_sse_bench;
+#[cfg(test)]
+pub(crate) mod brain_chunk_bench;
+#[cfg(test)]
+pub(crate) mod brain_embed_bench;
+#[cfg(test)]
+pub(crate) mod brain_embed_wire_bench;
+#[cfg(test)]
+pub(crate) mod brain_index_bench;
+#[cfg(all(test, target_os = "macos", feature = "local-llm"))]
+pub(crate) mod ghost_prefill_bench;
 #[cfg(test)]
 pub(crate) mod main_menu_history_render_bench;
+#[cfg(test)]
+pub(crate) mod script_launch_bench;
+#[cfg(test)]
+pub(crate) mod syntax_highlight_bench;
+#[cfg(test)]
+pub(crate) mod transaction_wait_bench;
 
 // --- merged from part_000.rs ---
 use std::collections::VecDeque;
@@ -321,6 +339,56 @@ impl Default for FrameTimer {
     }
 }
 // =============================================================================
+// LATENCY HISTOGRAM
+// =============================================================================
+
+/// Number of power-of-two microsecond buckets (bucket 20 is >= ~1s).
+const LATENCY_BUCKETS: usize = 21;
+
+/// Fixed-size log2 latency histogram: bucket `i` counts samples below
+/// `2^i` microseconds. Constant memory and O(1) record, so it can sit on hot
+/// paths (per keystroke, per source) where keeping raw samples would not.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct LatencyHistogram {
+    buckets: [u64; LATENCY_BUCKETS],
+    count: u64,
+    max_us: u64,
+}
+impl LatencyHistogram {
+    pub fn record(&mut self, elapsed: Duration) {
+        let us = elapsed.as_micros().min(u128::from(u64::MAX)) as u64;
+        let bucket = (u64::BITS - us.leading_zeros()) as usize;
+        self.buckets[bucket.min(LATENCY_BUCKETS - 1)] += 1;
+        self.count += 1;
+        self.max_us = self.max_us.max(us);
+    }
+
+    pub fn count(&self) -> u64 {
+        self.count
+    }
+
+    pub fn max(&self) -> Duration {
+        Duration::from_micros(self.max_us)
+    }
+
+    /// Upper bound of the bucket holding the `p`th percentile (0.0..=1.0),
+    /// capped at the observed maximum.
+    pub fn percentile(&self, p: f64) -> Duration {
+        if self.count == 0 {
+            return Duration::ZERO;
+        }
+        let target = ((self.count as f64) * p.clamp(0.0, 1.0)).ceil().max(1.0) as u64;
+        let mut seen = 0;
+        for (bucket, count) in self.buckets.iter().enumerate() {
+            seen += count;
+            if seen >= target {
+                return Duration::from_micros((1u64 << bucket).min(self.max_us.max(1)));
+            }
+        }
+        self.max()
+    }
+}
+// =============================================================================
 // GLOBAL PERF TRACKER
 // =============================================================================
 
@@ -590,6 +658,24 @@ mod tests {
         assert!(duration.unwrap().as_millis() >= 16);
     }
 
+    #[test]
+    fn test_latency_histogram_percentiles() {
+        let mut histogram = LatencyHistogram::default();
+        assert_eq!(histogram.percentile(0.5), Duration::ZERO);
+
+        for _ in 0..9 {
+            histogram.record(Duration::from_micros(300));
+        }
+        histogram.record(Duration::from_millis(40));
+
+        assert_eq!(histogram.count(), 10);
+        // 300us lands in the [256us, 512us) bucket.
+        assert_eq!(histogram.percentile(0.5), Duration::from_micros(512));
+        assert_eq!(histogram.percentile(0.9), Duration::from_micros(512));
+        assert_eq!(histogram.percentile(0.99), Duration::from_millis(40));
+        assert_eq!(histogram.max(), Duration::from_millis(40));
+    }
+
     #[test]
     fn test_timing_guard() {
         // Just ensure it doesn't panic
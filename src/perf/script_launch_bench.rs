@@ -0,0 +1,105 @@
+use std::path::Path;
+use std::time::{Duration, Instant};
+
+use crate::executor::runner::{find_sdk_path, spawn_script_with_extra_env, ScriptSession};
+use crate::executor::warm_pool::{
+    configure_warm_runtime_pool, parked_warm_workers, take_warm_session,
+};
+
+const SAMPLES: usize = 8;
+/// Time a parked worker gets to finish the SDK preload before it is used.
+const PRELOAD_SETTLE: Duration = Duration::from_millis(1500);
+const PARK_TIMEOUT: Duration = Duration::from_secs(10);
+const HELLO_WORLD_SCRIPT: &str = "await div(`<h1>Hello world</h1>`);\n";
+
+#[derive(Debug, Default)]
+pub(crate) struct ScriptLaunchBenchReport {
+    pub samples: usize,
+    pub cold_first_message_p50_ms: f64,
+    pub cold_first_message_max_ms: f64,
+    pub warm_first_message_p50_ms: f64,
+    pub warm_first_message_max_ms: f64,
+}
+
+/// Time from launch to the first protocol message for a hello-world script,
+/// spawning bun cold versus handing the script to a parked warm worker.
+///
+/// Returns `None` when bun or the SDK is unavailable.
+pub(crate) fn run_script_launch_benchmark() -> Option<ScriptLaunchBenchReport> {
+    let sdk_path = find_sdk_path()?;
+    let sdk = sdk_path.to_string_lossy().into_owned();
+    let temp_dir = tempfile::tempdir().ok()?;
+    let script_path = temp_dir.path().join("hello-world.ts");
+    std::fs::write(&script_path, HELLO_WORLD_SCRIPT).ok()?;
+    let script = script_path.to_string_lossy().into_owned();
+
+    let mut cold = Vec::with_capacity(SAMPLES);
+    for _ in 0..SAMPLES {
+        let start = Instant::now();
+        let session =
+            spawn_script_with_extra_env("bun", &["run", "--preload", &sdk, &script], &script, &[])
+                .ok()?;
+        cold.push(first_message_ms(session, start)?);
+    }
+
+    configure_warm_runtime_pool(1, Duration::from_secs(120));
+    let mut warm = Vec::with_capacity(SAMPLES);
+    for _ in 0..SAMPLES {
+        wait_for_parked_worker()?;
+        std::thread::sleep(PRELOAD_SETTLE);
+        let start = Instant::now();
+        let session = take_warm_session(Path::new(&sdk_path), &script, &[])?;
+        warm.push(first_message_ms(session, start)?);
+    }
+    configure_warm_runtime_pool(0, Duration::from_secs(120));
+
+    cold.sort_by(f64::total_cmp);
+    warm.sort_by(f64::total_cmp);
+    Some(ScriptLaunchBenchReport {
+        samples: SAMPLES,
+        cold_first_message_p50_ms: cold[SAMPLES / 2],
+        cold_first_message_max_ms: cold[SAMPLES - 1],
+        warm_first_message_p50_ms: warm[SAMPLES / 2],
+        warm_first_message_max_ms: warm[SAMPLES - 1],
+    })
+}
+
+fn first_message_ms(session: ScriptSession, start: Instant) -> Option<f64> {
+    let mut split = session.split();
+    let message = split.stdout_reader.next_message().ok().flatten();
+    let elapsed_ms = start.elapsed().as_secs_f64() * 1000.0;
+    split.process_handle.kill();
+    let _ = split.child.wait();
+    message.map(|_| elapsed_ms)
+}
+
+fn wait_for_parked_worker() -> Option<()> {
+    let deadline = Instant::now() + PARK_TIMEOUT;
+    while parked_warm_workers() == 0 {
+        if Instant::now() >= deadline {
+            return None;
+        }
+        std::thread::sleep(Duration::from_millis(10));
+    }
+    Some(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release script_launch_first_message_benchmark -- --ignored --nocapture"]
+    fn script_launch_first_message_benchmark() {
+        let Some(report) = run_script_launch_benchmark() else {
+            eprintln!("bun or the SDK is unavailable; skipping script launch benchmark");
+            return;
+        };
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.warm_first_message_p50_ms < report.cold_first_message_p50_ms,
+            "warm launches should reach the first message sooner: {report:#?}"
+        );
+    }
+}
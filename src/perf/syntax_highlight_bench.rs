@@ -0,0 +1,120 @@
+use std::hint::black_box;
+use std::time::Instant;
+
+use crate::syntax::{highlight_code_lines, highlight_code_lines_from_scratch};
+
+const LINE_COUNT: usize = 5_000;
+const SAMPLES: usize = 40;
+const WARMUP: usize = 5;
+const LANGUAGE: &str = "typescript";
+
+#[derive(Debug, Default)]
+pub(crate) struct SyntaxHighlightBenchReport {
+    pub line_count: usize,
+    pub samples: usize,
+    pub scratch_p50_ms: f64,
+    pub single_line_edit_p50_ms: f64,
+    pub single_line_edit_p95_ms: f64,
+    pub tail_append_p50_ms: f64,
+    pub tail_append_p95_ms: f64,
+}
+
+pub(crate) fn run_syntax_highlight_benchmark() -> SyntaxHighlightBenchReport {
+    let mut lines = synthetic_source(LINE_COUNT);
+
+    let mut scratch_ms = Vec::with_capacity(SAMPLES);
+    for ix in 0..(SAMPLES / 4 + WARMUP) {
+        let code = lines.join("\n");
+        let start = Instant::now();
+        black_box(highlight_code_lines_from_scratch(&code, LANGUAGE, true));
+        if ix >= WARMUP {
+            scratch_ms.push(elapsed_ms(start));
+        }
+    }
+
+    // Prime the incremental cache with the full document.
+    black_box(highlight_code_lines(&lines.join("\n"), LANGUAGE, true));
+
+    let mut edit_ms = Vec::with_capacity(SAMPLES);
+    for ix in 0..(SAMPLES + WARMUP) {
+        let edited_line = (ix * 997) % LINE_COUNT;
+        lines[edited_line] = format!("    const edited{ix} = {ix};");
+        let code = lines.join("\n");
+        let start = Instant::now();
+        black_box(highlight_code_lines(&code, LANGUAGE, true));
+        if ix >= WARMUP {
+            edit_ms.push(elapsed_ms(start));
+        }
+    }
+
+    let mut append_ms = Vec::with_capacity(SAMPLES);
+    let mut code = lines.join("\n");
+    for ix in 0..(SAMPLES + WARMUP) {
+        code.push_str(&format!("\nconsole.log(\"appended {ix}\");"));
+        let start = Instant::now();
+        black_box(highlight_code_lines(&code, LANGUAGE, true));
+        if ix >= WARMUP {
+            append_ms.push(elapsed_ms(start));
+        }
+    }
+
+    SyntaxHighlightBenchReport {
+        line_count: LINE_COUNT,
+        samples: SAMPLES,
+        scratch_p50_ms: percentile(&mut scratch_ms, 0.50),
+        single_line_edit_p50_ms: percentile(&mut edit_ms, 0.50),
+        single_line_edit_p95_ms: percentile(&mut edit_ms, 0.95),
+        tail_append_p50_ms: percentile(&mut append_ms, 0.50),
+        tail_append_p95_ms: percentile(&mut append_ms, 0.95),
+    }
+}
+
+fn synthetic_source(line_count: usize) -> Vec<String> {
+    (0..line_count)
+        .map(|ix| match ix % 6 {
+            0 => format!("export async function handler{ix}(input: string) {{"),
+            1 => format!("    // step {ix}: normalize input"),
+            2 => format!("    const value{ix} = input.trim().split(\",\").map(Number);"),
+            3 => format!(
+                "    if (value{ix}.length > {ix}) {{ return `too many ${{value{ix}.length}}`; }}"
+            ),
+            4 => format!("    return value{ix}.reduce((a, b) => a + b, 0);"),
+            _ => "}".to_string(),
+        })
+        .collect()
+}
+
+fn elapsed_ms(start: Instant) -> f64 {
+    start.elapsed().as_secs_f64() * 1000.0
+}
+
+fn percentile(values: &mut [f64], quantile: f64) -> f64 {
+    if values.is_empty() {
+        return 0.0;
+    }
+
+    values.sort_by(|a, b| a.total_cmp(b));
+    let index = ((values.len() - 1) as f64 * quantile).round() as usize;
+    values[index]
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release syntax_highlight_incremental_benchmark -- --ignored --nocapture"]
+    fn syntax_highlight_incremental_benchmark() {
+        let report = run_syntax_highlight_benchmark();
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.single_line_edit_p50_ms * 4.0 <= report.scratch_p50_ms,
+            "single-line edits should resume from checkpoints: {report:#?}"
+        );
+        assert!(
+            report.tail_append_p50_ms * 4.0 <= report.scratch_p50_ms,
+            "tail appends should resume from checkpoints: {report:#?}"
+        );
+    }
+}
@@ -0,0 +1,205 @@
+use std::sync::mpsc;
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+
+use anyhow::Result;
+
+use crate::protocol::transaction_executor::{
+    execute_batch, TransactionStateNotifier, TransactionStateProvider,
+};
+use crate::protocol::{
+    BatchCommand, TransactionTrace, TransactionTraceMode, UiStateSnapshot, WaitCondition,
+    WaitNamedCondition,
+};
+
+const BATCH_STEPS: usize = 500;
+const RENDER_DELAY: Duration = Duration::from_millis(2);
+const POLL_INTERVAL_MS: u64 = 25;
+
+#[derive(Debug, Default)]
+pub(crate) struct TransactionWaitBenchReport {
+    pub steps: usize,
+    pub polling_wall_ms: f64,
+    pub polling_polls: usize,
+    pub polling_trace_bytes: usize,
+    pub full_snapshot_trace_bytes: usize,
+    pub event_driven_wall_ms: f64,
+    pub event_driven_polls: usize,
+    pub event_driven_trace_bytes: usize,
+}
+
+/// Provider that "renders" choices on a worker thread a few milliseconds after
+/// each `setInput`, like the real filter pipeline does.
+struct SimulatedRenderProvider {
+    snapshot: Arc<Mutex<UiStateSnapshot>>,
+    notifier: Arc<TransactionStateNotifier>,
+    render_tx: mpsc::Sender<()>,
+    event_driven: bool,
+}
+
+impl SimulatedRenderProvider {
+    fn new(event_driven: bool) -> Self {
+        let snapshot = Arc::new(Mutex::new(UiStateSnapshot {
+            window_visible: true,
+            window_focused: true,
+            prompt_type: Some("arg".to_string()),
+            visible_semantic_ids: (0..40).map(|ix| format!("choice:{ix}:item-{ix}")).collect(),
+            ..Default::default()
+        }));
+        let notifier = Arc::new(TransactionStateNotifier::new());
+        let (render_tx, render_rx) = mpsc::channel::<()>();
+        let worker_snapshot = Arc::clone(&snapshot);
+        let worker_notifier = Arc::clone(&notifier);
+        std::thread::spawn(move || {
+            while render_rx.recv().is_ok() {
+                std::thread::sleep(RENDER_DELAY);
+                if let Ok(mut snapshot) = worker_snapshot.lock() {
+                    snapshot.choice_count = 40;
+                }
+                worker_notifier.notify_changed();
+            }
+        });
+        Self {
+            snapshot,
+            notifier,
+            render_tx,
+            event_driven,
+        }
+    }
+}
+
+impl TransactionStateProvider for SimulatedRenderProvider {
+    fn snapshot(&self) -> UiStateSnapshot {
+        self.snapshot
+            .lock()
+            .map(|snapshot| snapshot.clone())
+            .unwrap_or_default()
+    }
+
+    fn set_input(&mut self, text: &str) -> Result<()> {
+        if let Ok(mut snapshot) = self.snapshot.lock() {
+            snapshot.input_value = Some(text.to_string());
+            snapshot.choice_count = 0;
+        }
+        self.notifier.notify_changed();
+        let _ = self.render_tx.send(());
+        Ok(())
+    }
+
+    fn select_by_value(&mut self, _value: &str, _submit: bool) -> Result<Option<String>> {
+        Ok(None)
+    }
+
+    fn select_by_semantic_id(
+        &mut self,
+        _semantic_id: &str,
+        _submit: bool,
+    ) -> Result<Option<String>> {
+        Ok(None)
+    }
+
+    fn state_notifier(&self) -> Option<&TransactionStateNotifier> {
+        self.event_driven.then_some(self.notifier.as_ref())
+    }
+}
+
+pub(crate) fn run_transaction_wait_benchmark() -> TransactionWaitBenchReport {
+    let commands = (0..BATCH_STEPS / 2)
+        .flat_map(|ix| {
+            [
+                BatchCommand::SetInput {
+                    text: format!("query {ix}"),
+                },
+                BatchCommand::WaitFor {
+                    condition: WaitCondition::Named(WaitNamedCondition::ChoicesRendered),
+                    timeout: Some(1_000),
+                    poll_interval: Some(POLL_INTERVAL_MS),
+                },
+            ]
+        })
+        .collect::<Vec<_>>();
+
+    let (polling_wall_ms, polling_trace) = run_batch(&commands, false);
+    let (event_driven_wall_ms, event_driven_trace) = run_batch(&commands, true);
+
+    TransactionWaitBenchReport {
+        steps: commands.len(),
+        polling_wall_ms,
+        polling_polls: poll_count(&polling_trace),
+        polling_trace_bytes: trace_bytes(&polling_trace),
+        full_snapshot_trace_bytes: trace_bytes(&with_full_poll_snapshots(polling_trace)),
+        event_driven_wall_ms,
+        event_driven_polls: poll_count(&event_driven_trace),
+        event_driven_trace_bytes: trace_bytes(&event_driven_trace),
+    }
+}
+
+fn run_batch(commands: &[BatchCommand], event_driven: bool) -> (f64, TransactionTrace) {
+    let mut provider = SimulatedRenderProvider::new(event_driven);
+    let request_id = format!(
+        "transaction-wait-bench-{}-{}-{}",
+        if event_driven { "event" } else { "poll" },
+        std::process::id(),
+        crate::protocol::transaction_trace::now_epoch_ms()
+    );
+    let start = Instant::now();
+    let output = execute_batch(
+        &mut provider,
+        request_id,
+        commands,
+        None,
+        TransactionTraceMode::On,
+    )
+    .expect("benchmark batch should run");
+    let wall_ms = start.elapsed().as_secs_f64() * 1000.0;
+    assert!(output.success, "benchmark batch should succeed");
+    (wall_ms, output.trace.expect("trace mode on"))
+}
+
+fn poll_count(trace: &TransactionTrace) -> usize {
+    trace
+        .commands
+        .iter()
+        .map(|command| command.polls.len())
+        .sum()
+}
+
+fn trace_bytes(trace: &TransactionTrace) -> usize {
+    serde_json::to_vec(trace).map_or(0, |bytes| bytes.len())
+}
+
+/// Rebuild the trace the way it was recorded before deltas: one full snapshot
+/// per poll observation.
+fn with_full_poll_snapshots(mut trace: TransactionTrace) -> TransactionTrace {
+    for command in &mut trace.commands {
+        let mut state = command.before.clone();
+        for poll in &mut command.polls {
+            if let Some(delta) = poll.delta.take() {
+                state.apply_delta(&delta);
+            }
+            poll.snapshot = state.clone();
+        }
+    }
+    trace
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release transaction_wait_batch_benchmark -- --ignored --nocapture"]
+    fn transaction_wait_batch_benchmark() {
+        let report = run_transaction_wait_benchmark();
+        eprintln!("{report:#?}");
+
+        assert!(
+            report.event_driven_wall_ms * 2.0 <= report.polling_wall_ms,
+            "event-driven waits should not pay the poll interval: {report:#?}"
+        );
+        assert!(
+            report.polling_trace_bytes * 2 <= report.full_snapshot_trace_bytes,
+            "delta traces should be much smaller than full-snapshot traces: {report:#?}"
+        );
+    }
+}
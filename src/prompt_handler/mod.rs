@@ -5730,6 +5730,7 @@ impl ScriptListApp {
                                     elapsed_ms: 0,
                                     condition_satisfied: true,
                                     snapshot: protocol::UiStateSnapshot::default(),
+                                    delta: None,
                                     matched_semantic_ids: Vec::new(),
                                 }],
                                 error: None,
@@ -5791,11 +5792,40 @@ impl ScriptListApp {
                             .unwrap_or_default()
                         };
 
+                        // Wake on the target entity's notifications so a change is
+                        // checked on the next effect flush; `pollInterval` stays as
+                        // the fallback for state that changes without a notify.
+                        let (changed_tx, changed_rx) = async_channel::bounded::<()>(1);
+                        let _state_subscription = {
+                            let notes_ent = notes_entity.clone();
+                            let detached_ent = detached_entity.clone();
+                            this.update(cx, move |_this, cx| {
+                                let wake = move || {
+                                    let _ = changed_tx.try_send(());
+                                };
+                                if let Some(ne) = notes_ent {
+                                    cx.observe(&ne, move |_, _, _| wake())
+                                } else if let Some(de) = detached_ent {
+                                    cx.observe(&de, move |_, _, _| wake())
+                                } else {
+                                    cx.observe_self(move |_, _| wake())
+                                }
+                            })
+                            .ok()
+                        };
+                        let executor = cx.background_executor().clone();
+
                         let mut polls: Vec<protocol::WaitPollObservation> = Vec::new();
                         let mut last_snapshot = before_snapshot.clone();
 
                         loop {
-                            cx.background_executor().timer(poll_dur).await;
+                            let wait = poll_dur.min(timeout_dur.saturating_sub(start.elapsed()));
+                            let changed = async { changed_rx.recv().await.ok() };
+                            let tick = async {
+                                executor.timer(wait).await;
+                                None
+                            };
+                            smol::future::or(changed, tick).await;
                             if start.elapsed() >= timeout_dur {
                                 let elapsed_ms = start.elapsed().as_millis() as u64;
                                 let error = crate::protocol::TransactionError {
@@ -5887,12 +5917,14 @@ impl ScriptListApp {
                             match poll_result {
                                 Ok((condition_satisfied, snapshot)) => {
                                     let elapsed_ms = start.elapsed().as_millis() as u64;
-                                    last_snapshot = snapshot.clone();
+                                    let delta = last_snapshot.diff(&snapshot);
+                                    last_snapshot = snapshot;
                                     polls.push(protocol::WaitPollObservation {
                                         attempt: polls.len() + 1,
                                         elapsed_ms,
                                         condition_satisfied,
-                                        snapshot,
+                                        snapshot: protocol::UiStateSnapshot::default(),
+                                        delta: Some(delta),
                                         matched_semantic_ids: Vec::new(),
                                     });
                                     if condition_satisfied {
@@ -33,6 +33,11 @@ pub fn render_markdown_with_scope(
 
     let parsed_blocks = parsed_blocks.unwrap_or_else(|| {
         let blocks = Arc::new(parse_markdown(text, colors.is_dark));
+        // Code blocks parsed before the syntect assets load are plain text;
+        // leave them uncached so the next render highlights them.
+        if !crate::syntax::highlighting_ready() {
+            return blocks;
+        }
         if let Ok(mut guard) = cache.lock() {
             // Cap cache size to prevent unbounded growth.
             // Use a high limit to avoid full-cache clears during streaming,
@@ -97,10 +97,11 @@ pub use types::{
     ScriptletMetadataData, SemanticQuality, SimulatedGpuiEvent, StateMatchSpec, SubmitValue,
     SuggestedHitPoint, SystemWindowInfo, TargetWindowBounds, TilePosition, TransactionCommandTrace,
     TransactionError, TransactionErrorCode, TransactionTrace, TransactionTraceMode,
-    TransactionTraceStatus, UiStateSnapshot, WaitCondition, WaitDetailedCondition,
-    WaitNamedCondition, WaitPollObservation, WindowActionType, ACTIVE_FOOTER_SCHEMA_VERSION,
-    AGENT_CHAT_STATE_SCHEMA_VERSION, AGENT_CHAT_TEST_PROBE_MAX_EVENTS,
-    AGENT_CHAT_TEST_PROBE_SCHEMA_VERSION, AUTOMATION_INSPECT_SCHEMA_VERSION,
-    AUTOMATION_SURFACE_SCHEMA_VERSION, AUTOMATION_WINDOW_SCHEMA_VERSION,
-    LAUNCHER_SURFACE_CONTRACT_SCHEMA_VERSION, TRANSACTION_TRACE_SCHEMA_VERSION,
+    TransactionTraceStatus, UiStateSnapshot, UiStateSnapshotDelta, WaitCondition,
+    WaitDetailedCondition, WaitNamedCondition, WaitPollObservation, WindowActionType,
+    ACTIVE_FOOTER_SCHEMA_VERSION, AGENT_CHAT_STATE_SCHEMA_VERSION,
+    AGENT_CHAT_TEST_PROBE_MAX_EVENTS, AGENT_CHAT_TEST_PROBE_SCHEMA_VERSION,
+    AUTOMATION_INSPECT_SCHEMA_VERSION, AUTOMATION_SURFACE_SCHEMA_VERSION,
+    AUTOMATION_WINDOW_SCHEMA_VERSION, LAUNCHER_SURFACE_CONTRACT_SCHEMA_VERSION,
+    TRANSACTION_TRACE_SCHEMA_VERSION,
 };
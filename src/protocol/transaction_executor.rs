@@ -15,6 +15,7 @@ use crate::protocol::types::batch_wait::{
 };
 use anyhow::Result;
 use std::path::Path;
+use std::sync::{Condvar, Mutex};
 use std::time::{Duration, Instant};
 
 // ── Default constants ──────────────────────────────────────────────────────
@@ -45,6 +46,67 @@ pub trait TransactionStateProvider {
     fn agent_chat_test_probe(&self, _tail: usize) -> crate::protocol::AgentChatTestProbeSnapshot {
         crate::protocol::AgentChatTestProbeSnapshot::default()
     }
+
+    /// Change notifier for providers whose state is mutated off the waiting
+    /// thread. When present, `waitFor` sleeps until the revision moves instead
+    /// of re-snapshotting every `pollInterval`. Providers that return one must
+    /// bump it for every change that can affect a wait condition, including
+    /// Agent Chat probe updates. Providers borrowing the GPUI `App` must not
+    /// return one, since waiting would block the thread that mutates them;
+    /// the prompt handler's async `waitFor` wakes on entity notifications
+    /// instead.
+    fn state_notifier(&self) -> Option<&TransactionStateNotifier> {
+        None
+    }
+}
+
+// ── Change notification ────────────────────────────────────────────────────
+
+/// Revision counter plus wake-up channel shared between a
+/// [`TransactionStateProvider`] and whatever mutates the state it reports.
+#[derive(Debug, Default)]
+pub struct TransactionStateNotifier {
+    revision: Mutex<u64>,
+    changed: Condvar,
+}
+
+impl TransactionStateNotifier {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Current state revision.
+    pub fn revision(&self) -> u64 {
+        *self
+            .revision
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+
+    /// Record a state change and wake every waiter. Returns the new revision.
+    pub fn notify_changed(&self) -> u64 {
+        let mut revision = self
+            .revision
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        *revision = revision.wrapping_add(1);
+        self.changed.notify_all();
+        *revision
+    }
+
+    /// Block until the revision differs from `seen` or `timeout` elapses.
+    /// Returns the revision observed on wake-up.
+    pub fn wait_for_change(&self, seen: u64, timeout: Duration) -> u64 {
+        let guard = self
+            .revision
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        let (guard, _) = self
+            .changed
+            .wait_timeout_while(guard, timeout, |revision| *revision == seen)
+            .unwrap_or_else(|poisoned| poisoned.into_inner());
+        *guard
+    }
 }
 
 // ── Condition matching ─────────────────────────────────────────────────────
@@ -288,7 +350,7 @@ fn command_name(command: &BatchCommand) -> &'static str {
     }
 }
 
-// ── Wait-for polling loop ──────────────────────────────────────────────────
+// ── Wait-for loop ──────────────────────────────────────────────────────────
 
 struct WaitResult {
     success: bool,
@@ -328,15 +390,23 @@ fn run_wait_for_command<P: TransactionStateProvider>(
         };
     }
 
+    let event_driven = provider.state_notifier().is_some();
     tracing::info!(
         target: "script_kit::transaction",
         index = index,
         timeout_ms = timeout,
         poll_interval_ms = poll_interval,
+        event_driven = event_driven,
         "transaction_wait_start"
     );
 
+    // Polls record only what changed since the previous observation, so a
+    // long wait holds one full snapshot rather than one per attempt.
+    let mut previous = before.clone();
     loop {
+        let revision = provider
+            .state_notifier()
+            .map(|notifier| notifier.revision());
         let elapsed_ms = started.elapsed().as_millis() as u64;
         let snapshot = provider.snapshot();
         let (ok, matched_ids) = matches_condition(provider, &snapshot, condition);
@@ -345,7 +415,8 @@ fn run_wait_for_command<P: TransactionStateProvider>(
             attempt: polls.len() + 1,
             elapsed_ms,
             condition_satisfied: ok,
-            snapshot: snapshot.clone(),
+            snapshot: UiStateSnapshot::default(),
+            delta: Some(previous.diff(&snapshot)),
             matched_semantic_ids: matched_ids,
         });
 
@@ -354,6 +425,7 @@ fn run_wait_for_command<P: TransactionStateProvider>(
                 target: "script_kit::transaction",
                 index = index,
                 elapsed_ms = elapsed_ms,
+                polls = polls.len(),
                 "transaction_wait_complete"
             );
             return WaitResult {
@@ -385,6 +457,7 @@ fn run_wait_for_command<P: TransactionStateProvider>(
                 target: "script_kit::transaction",
                 index = index,
                 elapsed_ms = elapsed_ms,
+                polls = polls.len(),
                 message = %error.message,
                 "transaction_wait_timeout"
             );
@@ -406,8 +479,17 @@ fn run_wait_for_command<P: TransactionStateProvider>(
                 },
             };
         }
-
-        std::thread::sleep(Duration::from_millis(poll_interval.max(1)));
+        previous = snapshot;
+
+        match (provider.state_notifier(), revision) {
+            (Some(notifier), Some(revision)) => {
+                // Wake on the next state change, or once more at the deadline
+                // so the timeout receipt carries a final observation.
+                let remaining = Duration::from_millis(timeout.saturating_sub(elapsed_ms));
+                notifier.wait_for_change(revision, remaining);
+            }
+            _ => std::thread::sleep(Duration::from_millis(poll_interval.max(1))),
+        }
     }
 }
 
@@ -372,14 +372,190 @@ pub struct UiStateSnapshot {
     pub agent_chat_cursor_index: Option<usize>,
 }
 
+impl UiStateSnapshot {
+    pub fn is_default(&self) -> bool {
+        *self == Self::default()
+    }
+
+    /// Fields of `next` that differ from `self`.
+    pub fn diff(&self, next: &UiStateSnapshot) -> UiStateSnapshotDelta {
+        fn changed<T: PartialEq + Clone>(before: &T, after: &T) -> Option<T> {
+            (before != after).then(|| after.clone())
+        }
+        fn changed_opt<T: PartialEq + Clone>(
+            name: &str,
+            before: &Option<T>,
+            after: &Option<T>,
+            cleared: &mut Vec<String>,
+        ) -> Option<T> {
+            if before == after {
+                return None;
+            }
+            if after.is_none() {
+                cleared.push(name.to_string());
+            }
+            after.clone()
+        }
+
+        let mut cleared = Vec::new();
+        UiStateSnapshotDelta {
+            window_visible: changed(&self.window_visible, &next.window_visible),
+            window_focused: changed(&self.window_focused, &next.window_focused),
+            prompt_type: changed_opt(
+                "promptType",
+                &self.prompt_type,
+                &next.prompt_type,
+                &mut cleared,
+            ),
+            input_value: changed_opt(
+                "inputValue",
+                &self.input_value,
+                &next.input_value,
+                &mut cleared,
+            ),
+            selected_value: changed_opt(
+                "selectedValue",
+                &self.selected_value,
+                &next.selected_value,
+                &mut cleared,
+            ),
+            focused_semantic_id: changed_opt(
+                "focusedSemanticId",
+                &self.focused_semantic_id,
+                &next.focused_semantic_id,
+                &mut cleared,
+            ),
+            visible_semantic_ids: changed(&self.visible_semantic_ids, &next.visible_semantic_ids),
+            choice_count: changed(&self.choice_count, &next.choice_count),
+            agent_chat_status: changed_opt(
+                "agentChatStatus",
+                &self.agent_chat_status,
+                &next.agent_chat_status,
+                &mut cleared,
+            ),
+            agent_chat_context_ready: changed(
+                &self.agent_chat_context_ready,
+                &next.agent_chat_context_ready,
+            ),
+            agent_chat_picker_open: changed(
+                &self.agent_chat_picker_open,
+                &next.agent_chat_picker_open,
+            ),
+            agent_chat_cursor_index: changed_opt(
+                "agentChatCursorIndex",
+                &self.agent_chat_cursor_index,
+                &next.agent_chat_cursor_index,
+                &mut cleared,
+            ),
+            cleared,
+        }
+    }
+
+    /// Replay a delta produced by [`UiStateSnapshot::diff`].
+    pub fn apply_delta(&mut self, delta: &UiStateSnapshotDelta) {
+        fn set<T: Clone>(field: &mut T, value: &Option<T>) {
+            if let Some(value) = value {
+                *field = value.clone();
+            }
+        }
+        fn set_opt<T: Clone>(field: &mut Option<T>, value: &Option<T>) {
+            if value.is_some() {
+                *field = value.clone();
+            }
+        }
+
+        set(&mut self.window_visible, &delta.window_visible);
+        set(&mut self.window_focused, &delta.window_focused);
+        set_opt(&mut self.prompt_type, &delta.prompt_type);
+        set_opt(&mut self.input_value, &delta.input_value);
+        set_opt(&mut self.selected_value, &delta.selected_value);
+        set_opt(&mut self.focused_semantic_id, &delta.focused_semantic_id);
+        set(&mut self.visible_semantic_ids, &delta.visible_semantic_ids);
+        set(&mut self.choice_count, &delta.choice_count);
+        set_opt(&mut self.agent_chat_status, &delta.agent_chat_status);
+        set(
+            &mut self.agent_chat_context_ready,
+            &delta.agent_chat_context_ready,
+        );
+        set(
+            &mut self.agent_chat_picker_open,
+            &delta.agent_chat_picker_open,
+        );
+        set_opt(
+            &mut self.agent_chat_cursor_index,
+            &delta.agent_chat_cursor_index,
+        );
+        for field in &delta.cleared {
+            match field.as_str() {
+                "promptType" => self.prompt_type = None,
+                "inputValue" => self.input_value = None,
+                "selectedValue" => self.selected_value = None,
+                "focusedSemanticId" => self.focused_semantic_id = None,
+                "agentChatStatus" => self.agent_chat_status = None,
+                "agentChatCursorIndex" => self.agent_chat_cursor_index = None,
+                _ => {}
+            }
+        }
+    }
+}
+
+/// Fields of a [`UiStateSnapshot`] that changed since the previous observation.
+///
+/// Unchanged fields are `None`. Optional snapshot fields that became `None`
+/// are listed in `cleared` by their wire name.
+#[derive(Clone, Debug, Serialize, Deserialize, PartialEq, Eq, Default)]
+#[serde(rename_all = "camelCase")]
+pub struct UiStateSnapshotDelta {
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub window_visible: Option<bool>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub window_focused: Option<bool>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub prompt_type: Option<String>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub input_value: Option<String>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub selected_value: Option<String>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub focused_semantic_id: Option<String>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub visible_semantic_ids: Option<Vec<String>>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub choice_count: Option<usize>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub agent_chat_status: Option<String>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub agent_chat_context_ready: Option<bool>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub agent_chat_picker_open: Option<bool>,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub agent_chat_cursor_index: Option<usize>,
+    #[serde(default, skip_serializing_if = "Vec::is_empty")]
+    pub cleared: Vec<String>,
+}
+
+impl UiStateSnapshotDelta {
+    pub fn is_empty(&self) -> bool {
+        *self == Self::default()
+    }
+}
+
 /// A single poll observation during a waitFor command.
+///
+/// The transaction executor records `delta` against the previous observation
+/// (the first one against the command's `before` snapshot) and leaves
+/// `snapshot` empty; replaying the deltas over `before` reconstructs each
+/// observed state. Older traces carry a full `snapshot` and no delta.
 #[derive(Clone, Debug, Serialize, Deserialize, PartialEq, Eq)]
 #[serde(rename_all = "camelCase")]
 pub struct WaitPollObservation {
     pub attempt: usize,
     pub elapsed_ms: u64,
     pub condition_satisfied: bool,
+    #[serde(default, skip_serializing_if = "UiStateSnapshot::is_default")]
     pub snapshot: UiStateSnapshot,
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub delta: Option<UiStateSnapshotDelta>,
     #[serde(default, skip_serializing_if = "Vec::is_empty")]
     pub matched_semantic_ids: Vec<String>,
 }
@@ -429,7 +605,11 @@ pub struct TransactionTrace {
     pub commands: Vec<TransactionCommandTrace>,
 }
 
-pub const TRANSACTION_TRACE_SCHEMA_VERSION: u32 = 1;
+/// Schema version for transaction traces.
+///
+/// v2: `polls[].snapshot` is no longer emitted; each poll carries only its
+///     `delta` against the previous observation.
+pub const TRANSACTION_TRACE_SCHEMA_VERSION: u32 = 2;
 
 fn default_transaction_trace_schema_version() -> u32 {
     TRANSACTION_TRACE_SCHEMA_VERSION
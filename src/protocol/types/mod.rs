@@ -58,8 +58,9 @@ pub use automation_window::{
 pub use batch_wait::{
     BatchCommand, BatchOptions, BatchResultEntry, StateMatchSpec, TransactionCommandTrace,
     TransactionError, TransactionErrorCode, TransactionTrace, TransactionTraceMode,
-    TransactionTraceStatus, UiStateSnapshot, WaitCondition, WaitDetailedCondition,
-    WaitNamedCondition, WaitPollObservation, TRANSACTION_TRACE_SCHEMA_VERSION,
+    TransactionTraceStatus, UiStateSnapshot, UiStateSnapshotDelta, WaitCondition,
+    WaitDetailedCondition, WaitNamedCondition, WaitPollObservation,
+    TRANSACTION_TRACE_SCHEMA_VERSION,
 };
 pub use chat::{ChatMessagePosition, ChatMessageRole, ChatPromptConfig, ChatPromptMessage};
 pub use elements_actions_scriptlets::{
@@ -223,13 +223,14 @@ impl ScriptListApp {
 
         // P0 FIX: Reference data from self instead of taking ownership
         // P1 FIX: NEVER do synchronous SQLite queries or image decoding in render loop!
-        // Only copy from global cache (populated async by background prewarm thread).
+        // Only copy thumbnails from the global cache (populated async by the background
+        // prewarm thread). Rows never use full-resolution images.
         // Images not yet cached will show placeholder with dimensions from metadata.
         for entry in &self.cached_clipboard_entries {
             if entry.content_type == clipboard_history::ContentType::Image {
-                // Only use already-cached images - NO synchronous fetch/decode
+                // Only use already-cached thumbnails - NO synchronous fetch/decode
                 if !self.clipboard_image_cache.contains_key(&entry.id) {
-                    if let Some(cached) = clipboard_history::get_cached_image(&entry.id) {
+                    if let Some(cached) = clipboard_history::get_cached_thumbnail(&entry.id) {
                         self.clipboard_image_cache.insert(entry.id.clone(), cached);
                     }
                     // If not in global cache yet, background thread will populate it.
@@ -671,6 +672,12 @@ impl ScriptListApp {
         let selected_entry = filtered_entries
             .get(selected_index)
             .map(|(_, e)| (*e).clone());
+        if let Some(entry) = selected_entry
+            .as_ref()
+            .filter(|entry| entry.content_type == clipboard_history::ContentType::Image)
+        {
+            self.request_clipboard_full_image(&entry.id, cx);
+        }
         let preview_panel = self.render_clipboard_preview_panel(
             &selected_entry,
             &image_cache,
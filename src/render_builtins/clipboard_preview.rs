@@ -1,4 +1,25 @@
 impl ScriptListApp {
+    /// Decode the selected clipboard image at full resolution off the UI
+    /// thread, then re-render so the preview swaps its thumbnail for it.
+    /// No-op when already cached or a decode for this entry is in flight.
+    fn request_clipboard_full_image(&self, entry_id: &str, cx: &mut Context<Self>) {
+        if !clipboard_history::begin_full_image_load(entry_id) {
+            return;
+        }
+
+        let entry_id = entry_id.to_string();
+        cx.spawn(async move |this, cx| {
+            let loaded = cx
+                .background_executor()
+                .spawn(async move { clipboard_history::load_full_image(&entry_id).is_some() })
+                .await;
+            if loaded {
+                let _ = this.update(cx, |_, cx| cx.notify());
+            }
+        })
+        .detach();
+    }
+
     /// Render the preview panel for clipboard history
     fn render_clipboard_preview_panel(
         &self,
@@ -134,7 +155,10 @@ impl ScriptListApp {
                     clipboard_history::ContentType::Image => {
                         let width = entry.image_width.unwrap_or(0);
                         let height = entry.image_height.unwrap_or(0);
-                        let cached_image = image_cache.get(&entry.id).cloned();
+                        // Full resolution once the lazy decode lands; the list
+                        // thumbnail stands in until then.
+                        let cached_image = clipboard_history::get_cached_image(&entry.id)
+                            .or_else(|| image_cache.get(&entry.id).cloned());
                         let dimensions = if width > 0 && height > 0 {
                             format!("{}×{} pixels", width, height)
                         } else {
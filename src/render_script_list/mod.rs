@@ -833,6 +833,8 @@ impl ScriptListApp {
         // When filter is empty, use frecency-grouped results with RECENT/MAIN sections
         // When filtering, use flat fuzzy search results
         let (grouped_items, flat_results) = self.get_grouped_results_cached();
+        // Passive sources that missed the frame deadline patch in as they land.
+        self.start_root_passive_late_section_pump(cx);
         let get_results_elapsed = render_list_start.elapsed();
 
         // Deduplicate render logs: only log when meaningful state changes (not cursor blink)
@@ -0,0 +1,972 @@
+//! Unified in-memory search index for the root launcher's passive sections.
+//!
+//! Notes, clipboard history, dictation history and Agent Chat history used
+//! to answer root typing through their own caches: an exact-query SQLite
+//! cache for notes (every new keystroke missed it) and, for the others, a
+//! clone of the whole cached history re-lowercased and rescanned per query.
+//! They now share one index:
+//!
+//! - each source is a partition of pre-normalized documents plus trigram
+//!   postings, rebuilt off the UI thread whenever the source's change feed
+//!   (a generation bumped by its writes and cache refreshes) moves;
+//! - a query is normalized and tokenized once, candidates come from the
+//!   trigram postings, and every requested source is ranked in the same
+//!   pass with the field weights its own search uses;
+//! - a stale partition keeps answering until its rebuild lands and a cold
+//!   one answers empty, so the foreground never waits on a store.
+//!
+//! Explicit source filters (`notes:` and friends) still run the sources'
+//! `*_direct` searches. Browser tabs and history keep their own snapshots.
+//!
+//! Brain is deliberately not a partition, although its section is part of
+//! the passive frame. Its ranking is not a per-field weight: FTS5 `bm25`
+//! rank positions are fused with recent attention signals and deduplicated
+//! by content (`brain::search::brain_search`), and the async semantic pass
+//! reuses that same fusion with cosine ranks. A trigram partition would
+//! rank brain rows differently from the hybrid results that replace them a
+//! moment later. Brain therefore keeps its own lexical job, and that job is
+//! skipped once semantic hits for the exact query are in.
+
+use std::collections::HashMap;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Arc, Mutex, MutexGuard};
+
+use crate::ai::agent_chat::ui::history::{
+    AgentChatHistoryEntry, AgentChatHistorySearchField, AgentChatHistorySearchHit,
+    RootAgentChatHistorySectionOptions,
+};
+use crate::clipboard_history::{ClipboardEntryMeta, RootClipboardHistorySectionOptions};
+use crate::dictation::{
+    DictationHistoryEntry, DictationHistorySearchField, RootDictationHistorySearchHit,
+    RootDictationHistorySectionOptions,
+};
+use crate::notes::{RootNoteSearchHit, RootNotesSectionOptions};
+
+/// Note bodies are indexed up to this many characters.
+const NOTE_CONTENT_INDEX_MAX_CHARS: usize = 8 * 1024;
+
+/// Length of a dictation row preview (see `build_history_entry`).
+const DICTATION_SNIPPET_MAX_CHARS: usize = 120;
+
+/// Per-token score for one field: `prefix` when the field starts with the
+/// token, otherwise `contains` when it contains it. A field with neither
+/// weight is not searched.
+#[derive(Debug, Clone, Copy)]
+struct FieldWeight {
+    prefix: u32,
+    contains: u32,
+}
+
+impl FieldWeight {
+    const OFF: Self = Self::contains(0);
+
+    const fn contains(contains: u32) -> Self {
+        Self {
+            prefix: 0,
+            contains,
+        }
+    }
+
+    fn searched(self) -> bool {
+        self.prefix > 0 || self.contains > 0
+    }
+}
+
+/// Notes: title, then body. Mirrors the title-first ordering of the notes
+/// FTS (`bm25` title weight 8) and LIKE fallbacks.
+const NOTE_TITLE_WEIGHT: FieldWeight = FieldWeight {
+    prefix: 80,
+    contains: 40,
+};
+const NOTE_CONTENT_WEIGHT: FieldWeight = FieldWeight::contains(10);
+
+/// Clipboard: the preview text, matched as one phrase in cache order.
+const CLIPBOARD_WEIGHTS: [FieldWeight; 1] = [FieldWeight::contains(1)];
+
+/// Dictation: transcript (+ preview), target, timestamps and duration, as in
+/// `dictation::history::rank_history_entries`.
+const DICTATION_WEIGHTS: [FieldWeight; 3] = [
+    FieldWeight {
+        prefix: 80,
+        contains: 30,
+    },
+    FieldWeight::contains(20),
+    FieldWeight::contains(5),
+];
+
+/// Agent Chat: title, preview, transcript text and timestamp, as in
+/// `agent_chat::ui::history::rank_history_entries`.
+const AGENT_CHAT_WEIGHTS: [FieldWeight; 4] = [
+    FieldWeight {
+        prefix: 80,
+        contains: 40,
+    },
+    FieldWeight::contains(20),
+    FieldWeight::contains(8),
+    FieldWeight::contains(4),
+];
+
+/// Collapse whitespace runs to single spaces and lowercase. Shared by the
+/// documents and the query so containment means the same thing everywhere.
+pub(crate) fn normalize_search_text(value: &str) -> String {
+    let mut normalized = String::with_capacity(value.len());
+    for word in value.split_whitespace() {
+        if !normalized.is_empty() {
+            normalized.push(' ');
+        }
+        normalized.extend(word.chars().flat_map(char::to_lowercase));
+    }
+    normalized
+}
+
+/// A root query, normalized once for every partition.
+#[derive(Debug, Clone)]
+struct IndexQuery {
+    /// The whole query as one token, for phrase-matched sources.
+    phrase: Vec<String>,
+    tokens: Vec<String>,
+}
+
+impl IndexQuery {
+    fn new(query: &str) -> Self {
+        let phrase = normalize_search_text(query);
+        let tokens = phrase
+            .split(' ')
+            .filter(|token| !token.is_empty())
+            .map(ToOwned::to_owned)
+            .collect();
+        Self {
+            phrase: if phrase.is_empty() {
+                Vec::new()
+            } else {
+                vec![phrase]
+            },
+            tokens,
+        }
+    }
+}
+
+/// Cut `text` down to `max_chars` around the first occurrence of `token`
+/// (normalized), with ellipses where it was cut. `None` when the token is
+/// absent or already visible in the head-truncated preview.
+pub(crate) fn snippet_around(text: &str, token: &str, max_chars: usize) -> Option<String> {
+    let collapsed = text.split_whitespace().collect::<Vec<_>>().join(" ");
+    let lower = normalize_search_text(&collapsed);
+    let match_start = lower[..lower.find(token)?].chars().count();
+    let token_chars = token.chars().count();
+    if match_start + token_chars <= max_chars {
+        return None;
+    }
+
+    // Lowercasing can change the char count of a few scripts; clamp to the
+    // original text rather than trusting the offset exactly.
+    let chars: Vec<char> = collapsed.chars().collect();
+    let lead = max_chars.saturating_sub(token_chars) / 3;
+    let match_start = match_start.min(chars.len());
+    let mut from = match_start.saturating_sub(lead);
+    // Start on a word when the lead-in has a break to snap to.
+    if let Some(space) = chars[from..match_start].iter().position(|ch| *ch == ' ') {
+        if from > 0 {
+            from += space + 1;
+        }
+    }
+    let to = (from + max_chars).min(chars.len());
+    let mut snippet = String::with_capacity(max_chars + 8);
+    if from > 0 {
+        snippet.push('\u{2026}');
+    }
+    snippet.extend(&chars[from..to]);
+    if to < chars.len() {
+        snippet.push('\u{2026}');
+    }
+    Some(snippet)
+}
+
+fn trigram_key(window: &[u8]) -> u32 {
+    (u32::from(window[0]) << 16) | (u32::from(window[1]) << 8) | u32::from(window[2])
+}
+
+/// One source document: its normalized fields and where it sits in the
+/// source's own order.
+#[derive(Debug)]
+struct IndexedDoc<T> {
+    item: T,
+    /// Position in the source's listing, for scan limits.
+    position: usize,
+    /// Tie-break between equal scores; lower ranks first.
+    rank: usize,
+    /// Normalized text per field. Multi-part fields join their parts with
+    /// `\n`, which no token can contain, so a match never spans two parts
+    /// and `starts_with` only ever sees the first part.
+    fields: Vec<String>,
+}
+
+#[derive(Debug)]
+struct IndexMatch<'a, T> {
+    item: &'a T,
+    score: u32,
+    field: usize,
+    rank: usize,
+}
+
+/// One source's documents with byte-trigram postings over all their fields.
+#[derive(Debug)]
+struct Partition<T> {
+    generation: u64,
+    docs: Vec<IndexedDoc<T>>,
+    /// Trigram -> ascending doc ids containing it in any field.
+    postings: HashMap<u32, Vec<u32>>,
+}
+
+impl<T> Partition<T> {
+    fn build(generation: u64, docs: Vec<IndexedDoc<T>>) -> Self {
+        let mut postings: HashMap<u32, Vec<u32>> = HashMap::new();
+        let mut doc_trigrams = Vec::new();
+        for (id, doc) in docs.iter().enumerate() {
+            doc_trigrams.clear();
+            for field in &doc.fields {
+                doc_trigrams.extend(field.as_bytes().windows(3).map(trigram_key));
+            }
+            doc_trigrams.sort_unstable();
+            doc_trigrams.dedup();
+            for key in &doc_trigrams {
+                postings.entry(*key).or_default().push(id as u32);
+            }
+        }
+        Self {
+            generation,
+            docs,
+            postings,
+        }
+    }
+
+    /// Docs holding every trigram of every token, or `None` when no token is
+    /// long enough to have one (every doc is a candidate then).
+    fn candidates(&self, tokens: &[String]) -> Option<Vec<u32>> {
+        let mut keys: Vec<u32> = tokens
+            .iter()
+            .flat_map(|token| token.as_bytes().windows(3).map(trigram_key))
+            .collect();
+        if keys.is_empty() {
+            return None;
+        }
+        keys.sort_unstable();
+        keys.dedup();
+
+        let mut lists = Vec::with_capacity(keys.len());
+        for key in keys {
+            match self.postings.get(&key) {
+                Some(list) => lists.push(list.as_slice()),
+                None => return Some(Vec::new()),
+            }
+        }
+        lists.sort_by_key(|list| list.len());
+        let mut ids = lists[0].to_vec();
+        for list in &lists[1..] {
+            ids.retain(|id| list.binary_search(id).is_ok());
+            if ids.is_empty() {
+                break;
+            }
+        }
+        Some(ids)
+    }
+
+    /// Rank docs among the first `scan_limit` of the source. Every token must
+    /// appear in some searched field; the score sums each field's weights and
+    /// `field` is the first field with the highest score.
+    fn search(
+        &self,
+        tokens: &[String],
+        weights: &[FieldWeight],
+        scan_limit: usize,
+        limit: usize,
+    ) -> Vec<IndexMatch<'_, T>> {
+        let mut matches: Vec<_> = match self.candidates(tokens) {
+            Some(ids) => ids
+                .into_iter()
+                .filter_map(|id| match_doc(&self.docs[id as usize], tokens, weights, scan_limit))
+                .collect(),
+            None => self
+                .docs
+                .iter()
+                .filter_map(|doc| match_doc(doc, tokens, weights, scan_limit))
+                .collect(),
+        };
+
+        matches.sort_by(|a, b| b.score.cmp(&a.score).then_with(|| a.rank.cmp(&b.rank)));
+        matches.truncate(limit);
+        matches
+    }
+}
+
+fn match_doc<'a, T>(
+    doc: &'a IndexedDoc<T>,
+    tokens: &[String],
+    weights: &[FieldWeight],
+    scan_limit: usize,
+) -> Option<IndexMatch<'a, T>> {
+    if doc.position >= scan_limit {
+        return None;
+    }
+    let (score, field) = score_fields(&doc.fields, tokens, weights)?;
+    Some(IndexMatch {
+        item: &doc.item,
+        score,
+        field,
+        rank: doc.rank,
+    })
+}
+
+fn score_fields(
+    fields: &[String],
+    tokens: &[String],
+    weights: &[FieldWeight],
+) -> Option<(u32, usize)> {
+    let searched = || {
+        fields
+            .iter()
+            .zip(weights)
+            .filter(|(_, weight)| weight.searched())
+            .map(|(field, _)| field)
+    };
+    if !tokens
+        .iter()
+        .all(|token| searched().any(|field| field.contains(token.as_str())))
+    {
+        return None;
+    }
+
+    let mut total = 0;
+    let mut best = (0, 0);
+    for (index, (field, weight)) in fields.iter().zip(weights).enumerate() {
+        let score: u32 = tokens
+            .iter()
+            .map(|token| {
+                if weight.prefix > 0 && field.starts_with(token.as_str()) {
+                    weight.prefix
+                } else if field.contains(token.as_str()) {
+                    weight.contains
+                } else {
+                    0
+                }
+            })
+            .sum();
+        total += score;
+        if score > best.0 {
+            best = (score, index);
+        }
+    }
+    Some((total, best.1))
+}
+
+/// Ranks for a newest-first tie-break by `timestamp`, keeping the source's
+/// order among equal timestamps.
+fn recency_ranks<T>(items: &[T], timestamp: impl Fn(&T) -> &str) -> Vec<usize> {
+    let mut order: Vec<usize> = (0..items.len()).collect();
+    order.sort_by(|a, b| timestamp(&items[*b]).cmp(timestamp(&items[*a])));
+    let mut ranks = vec![0; items.len()];
+    for (rank, index) in order.into_iter().enumerate() {
+        ranks[index] = rank;
+    }
+    ranks
+}
+
+// ── Source documents ─────────────────────────────────────────────────
+
+fn note_docs(
+    documents: Vec<crate::notes::RootNoteIndexDocument>,
+) -> Vec<IndexedDoc<RootNoteSearchHit>> {
+    documents
+        .into_iter()
+        .enumerate()
+        .map(|(position, document)| {
+            let content: String = document
+                .content
+                .chars()
+                .take(NOTE_CONTENT_INDEX_MAX_CHARS)
+                .collect();
+            IndexedDoc {
+                fields: vec![
+                    normalize_search_text(&document.hit.title),
+                    normalize_search_text(&content),
+                ],
+                item: document.hit,
+                position,
+                rank: position,
+            }
+        })
+        .collect()
+}
+
+fn clipboard_docs(entries: &[ClipboardEntryMeta]) -> Vec<IndexedDoc<ClipboardEntryMeta>> {
+    entries
+        .iter()
+        .enumerate()
+        .filter(|(_, entry)| crate::clipboard_history::root_clipboard_entry_is_eligible(entry))
+        .map(|(position, entry)| IndexedDoc {
+            fields: vec![normalize_search_text(&entry.text_preview)],
+            item: entry.clone(),
+            position,
+            rank: position,
+        })
+        .collect()
+}
+
+fn dictation_docs(entries: Vec<DictationHistoryEntry>) -> Vec<IndexedDoc<DictationHistoryEntry>> {
+    let ranks = recency_ranks(&entries, |entry| entry.timestamp.as_str());
+    entries
+        .into_iter()
+        .zip(ranks)
+        .enumerate()
+        .map(|(position, (entry, rank))| IndexedDoc {
+            fields: vec![
+                format!(
+                    "{}\n{}",
+                    normalize_search_text(&entry.transcript),
+                    normalize_search_text(&entry.preview)
+                ),
+                normalize_search_text(&entry.target),
+                format!(
+                    "{}\n{}\n{}",
+                    normalize_search_text(&entry.timestamp),
+                    normalize_search_text(&crate::dictation::format_history_timestamp(
+                        &entry.timestamp
+                    )),
+                    normalize_search_text(&crate::dictation::format_history_duration_ms(
+                        entry.audio_duration_ms
+                    ))
+                ),
+            ],
+            item: entry,
+            position,
+            rank,
+        })
+        .collect()
+}
+
+fn agent_chat_docs(entries: Vec<AgentChatHistoryEntry>) -> Vec<IndexedDoc<AgentChatHistoryEntry>> {
+    let ranks = recency_ranks(&entries, |entry| entry.timestamp.as_str());
+    entries
+        .into_iter()
+        .zip(ranks)
+        .enumerate()
+        .map(|(position, (entry, rank))| IndexedDoc {
+            fields: vec![
+                normalize_search_text(entry.title_display()),
+                normalize_search_text(entry.preview_display()),
+                normalize_search_text(&entry.search_text),
+                normalize_search_text(&entry.timestamp),
+            ],
+            item: entry,
+            position,
+            rank,
+        })
+        .collect()
+}
+
+// ── Shared index ─────────────────────────────────────────────────────
+
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+enum IndexedSource {
+    Notes,
+    ClipboardHistory,
+    DictationHistory,
+    AgentChatHistory,
+}
+
+impl IndexedSource {
+    fn name(self) -> &'static str {
+        match self {
+            Self::Notes => "notes",
+            Self::ClipboardHistory => "clipboard_history",
+            Self::DictationHistory => "dictation_history",
+            Self::AgentChatHistory => "agent_chat_history",
+        }
+    }
+
+    /// The source's change feed. `None` while its store is cold; the feed
+    /// starts warming it.
+    fn generation(self) -> Option<u64> {
+        match self {
+            Self::Notes => Some(crate::notes::root_notes_index_generation()),
+            Self::ClipboardHistory => {
+                crate::clipboard_history::root_clipboard_history_index_generation()
+            }
+            Self::DictationHistory => crate::dictation::root_dictation_history_index_generation(),
+            Self::AgentChatHistory => {
+                crate::ai::agent_chat::ui::history::root_agent_chat_history_index_generation()
+            }
+        }
+    }
+
+    fn indexed_generation(self, index: &RootSearchIndex) -> Option<u64> {
+        match self {
+            Self::Notes => index.notes.as_ref().map(|partition| partition.generation),
+            Self::ClipboardHistory => index
+                .clipboard_history
+                .as_ref()
+                .map(|partition| partition.generation),
+            Self::DictationHistory => index
+                .dictation_history
+                .as_ref()
+                .map(|partition| partition.generation),
+            Self::AgentChatHistory => index
+                .agent_chat_history
+                .as_ref()
+                .map(|partition| partition.generation),
+        }
+    }
+
+    fn rebuild_flag(self) -> &'static AtomicBool {
+        static REBUILDING: [AtomicBool; 4] = [
+            AtomicBool::new(false),
+            AtomicBool::new(false),
+            AtomicBool::new(false),
+            AtomicBool::new(false),
+        ];
+        &REBUILDING[self as usize]
+    }
+}
+
+#[derive(Default)]
+struct RootSearchIndex {
+    notes: Option<Arc<Partition<RootNoteSearchHit>>>,
+    clipboard_history: Option<Arc<Partition<ClipboardEntryMeta>>>,
+    dictation_history: Option<Arc<Partition<DictationHistoryEntry>>>,
+    agent_chat_history: Option<Arc<Partition<AgentChatHistoryEntry>>>,
+}
+
+static INDEX: Mutex<RootSearchIndex> = Mutex::new(RootSearchIndex {
+    notes: None,
+    clipboard_history: None,
+    dictation_history: None,
+    agent_chat_history: None,
+});
+
+fn index() -> MutexGuard<'static, RootSearchIndex> {
+    INDEX
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner())
+}
+
+/// Store `partition` unless a newer one landed first.
+fn publish<T>(slot: &mut Option<Arc<Partition<T>>>, partition: Partition<T>) {
+    if slot
+        .as_ref()
+        .is_some_and(|current| current.generation > partition.generation)
+    {
+        return;
+    }
+    *slot = Some(Arc::new(partition));
+}
+
+/// Start a background rebuild of `source` if its feed moved past the
+/// indexed generation and no rebuild is already running.
+fn refresh_if_stale(source: IndexedSource) {
+    let Some(generation) = source.generation() else {
+        return;
+    };
+    if source.indexed_generation(&index()) == Some(generation) {
+        return;
+    }
+    let flag = source.rebuild_flag();
+    if flag.swap(true, Ordering::AcqRel) {
+        return;
+    }
+    let spawned = std::thread::Builder::new()
+        .name("root-search-index".to_string())
+        .spawn(move || {
+            rebuild(source, generation);
+            source.rebuild_flag().store(false, Ordering::Release);
+        });
+    if spawned.is_err() {
+        flag.store(false, Ordering::Release);
+    }
+}
+
+/// Load `source` and swap in its new partition. `generation` was read before
+/// loading, so a write racing the load only costs one more rebuild.
+fn rebuild(source: IndexedSource, generation: u64) {
+    let started = std::time::Instant::now();
+    let documents = match source {
+        IndexedSource::Notes => match crate::notes::load_root_notes_index_documents() {
+            Ok(documents) => {
+                let partition = Partition::build(generation, note_docs(documents));
+                let count = partition.docs.len();
+                publish(&mut index().notes, partition);
+                count
+            }
+            Err(error) => {
+                tracing::warn!(
+                    target: "script_kit::root_passive",
+                    %error,
+                    "root search index could not load notes"
+                );
+                return;
+            }
+        },
+        IndexedSource::ClipboardHistory => {
+            let entries = crate::clipboard_history::get_entry_cache().lock().clone();
+            let partition = Partition::build(generation, clipboard_docs(&entries));
+            let count = partition.docs.len();
+            publish(&mut index().clipboard_history, partition);
+            count
+        }
+        IndexedSource::DictationHistory => {
+            let partition =
+                Partition::build(generation, dictation_docs(crate::dictation::load_history()));
+            let count = partition.docs.len();
+            publish(&mut index().dictation_history, partition);
+            count
+        }
+        IndexedSource::AgentChatHistory => {
+            let partition = Partition::build(
+                generation,
+                agent_chat_docs(crate::ai::agent_chat::ui::history::load_history()),
+            );
+            let count = partition.docs.len();
+            publish(&mut index().agent_chat_history, partition);
+            count
+        }
+    };
+    tracing::debug!(
+        target: "script_kit::root_passive",
+        source = source.name(),
+        generation,
+        documents,
+        elapsed_ms = started.elapsed().as_secs_f64() * 1000.0,
+        "root search index partition rebuilt"
+    );
+}
+
+/// Which sources one root query wants from the index. `None` leaves a
+/// source out (ineligible, filtered, or served by its direct search).
+#[derive(Debug, Clone, Default)]
+pub(crate) struct RootSearchIndexRequest {
+    pub notes: Option<RootNotesSectionOptions>,
+    pub clipboard_history: Option<RootClipboardHistorySectionOptions>,
+    pub dictation_history: Option<RootDictationHistorySectionOptions>,
+    pub agent_chat_history: Option<RootAgentChatHistorySectionOptions>,
+}
+
+impl RootSearchIndexRequest {
+    pub(crate) fn is_empty(&self) -> bool {
+        self.notes.is_none()
+            && self.clipboard_history.is_none()
+            && self.dictation_history.is_none()
+            && self.agent_chat_history.is_none()
+    }
+}
+
+/// Per-source top hits for one query; `Some` exactly for requested sources.
+#[derive(Debug, Clone, Default)]
+pub(crate) struct RootSearchIndexHits {
+    pub notes: Option<Vec<RootNoteSearchHit>>,
+    pub clipboard_history: Option<Vec<ClipboardEntryMeta>>,
+    pub dictation_history: Option<Vec<RootDictationHistorySearchHit>>,
+    pub agent_chat_history: Option<Vec<AgentChatHistorySearchHit>>,
+}
+
+impl RootSearchIndexHits {
+    pub(crate) fn hit_count(&self) -> usize {
+        self.notes.as_ref().map_or(0, Vec::len)
+            + self.clipboard_history.as_ref().map_or(0, Vec::len)
+            + self.dictation_history.as_ref().map_or(0, Vec::len)
+            + self.agent_chat_history.as_ref().map_or(0, Vec::len)
+    }
+}
+
+/// Answer every requested passive source from the shared index in one pass.
+/// Cache-only: stale or cold partitions are rebuilt in the background for a
+/// future frame and never block or notify the current one.
+pub(crate) fn search_root_passive_sources(
+    query: &str,
+    request: &RootSearchIndexRequest,
+) -> RootSearchIndexHits {
+    let requested = [
+        (IndexedSource::Notes, request.notes.is_some()),
+        (
+            IndexedSource::ClipboardHistory,
+            request.clipboard_history.is_some(),
+        ),
+        (
+            IndexedSource::DictationHistory,
+            request.dictation_history.is_some(),
+        ),
+        (
+            IndexedSource::AgentChatHistory,
+            request.agent_chat_history.is_some(),
+        ),
+    ];
+    for (source, wanted) in requested {
+        if wanted {
+            refresh_if_stale(source);
+        }
+    }
+
+    let (notes, clipboard_history, dictation_history, agent_chat_history) = {
+        let index = index();
+        (
+            index.notes.clone(),
+            index.clipboard_history.clone(),
+            index.dictation_history.clone(),
+            index.agent_chat_history.clone(),
+        )
+    };
+    let query = IndexQuery::new(query);
+
+    RootSearchIndexHits {
+        notes: request.notes.map(|options| {
+            notes.map_or_else(Vec::new, |partition| {
+                search_notes(&partition, &query, options)
+            })
+        }),
+        clipboard_history: request.clipboard_history.map(|options| {
+            clipboard_history.map_or_else(Vec::new, |partition| {
+                partition
+                    .search(
+                        &query.phrase,
+                        &CLIPBOARD_WEIGHTS,
+                        options.scan_limit,
+                        options.max_results,
+                    )
+                    .into_iter()
+                    .map(|hit| hit.item.clone())
+                    .collect()
+            })
+        }),
+        dictation_history: request.dictation_history.map(|options| {
+            dictation_history.map_or_else(Vec::new, |partition| {
+                search_dictation(&partition, &query, options)
+            })
+        }),
+        agent_chat_history: request.agent_chat_history.map(|options| {
+            agent_chat_history.map_or_else(Vec::new, |partition| {
+                partition
+                    .search(
+                        &query.tokens,
+                        &AGENT_CHAT_WEIGHTS,
+                        usize::MAX,
+                        options.max_results,
+                    )
+                    .into_iter()
+                    .map(|hit| AgentChatHistorySearchHit {
+                        entry: hit.item.clone(),
+                        score: hit.score,
+                        matched_field: match hit.field {
+                            0 => AgentChatHistorySearchField::Title,
+                            1 => AgentChatHistorySearchField::Preview,
+                            2 => AgentChatHistorySearchField::SearchText,
+                            _ => AgentChatHistorySearchField::Timestamp,
+                        },
+                    })
+                    .collect()
+            })
+        }),
+    }
+}
+
+fn search_notes(
+    partition: &Partition<RootNoteSearchHit>,
+    query: &IndexQuery,
+    options: RootNotesSectionOptions,
+) -> Vec<RootNoteSearchHit> {
+    let content_weight = if options.search_content {
+        NOTE_CONTENT_WEIGHT
+    } else {
+        FieldWeight::OFF
+    };
+    partition
+        .search(
+            &query.tokens,
+            &[NOTE_TITLE_WEIGHT, content_weight],
+            usize::MAX,
+            options.max_results.clamp(1, 5),
+        )
+        .into_iter()
+        .enumerate()
+        .map(|(rank, hit)| RootNoteSearchHit {
+            score: i32::MAX.saturating_sub(rank as i32),
+            ..hit.item.clone()
+        })
+        .collect()
+}
+
+fn search_dictation(
+    partition: &Partition<DictationHistoryEntry>,
+    query: &IndexQuery,
+    options: RootDictationHistorySectionOptions,
+) -> Vec<RootDictationHistorySearchHit> {
+    partition
+        .search(
+            &query.tokens,
+            &DICTATION_WEIGHTS,
+            options.scan_limit,
+            options.max_results,
+        )
+        .into_iter()
+        .map(|hit| {
+            let entry = hit.item;
+            // A match past the stored preview gets a snippet around it.
+            let preview = query
+                .tokens
+                .iter()
+                .find_map(|token| {
+                    snippet_around(&entry.transcript, token, DICTATION_SNIPPET_MAX_CHARS)
+                })
+                .unwrap_or_else(|| entry.preview.clone());
+            RootDictationHistorySearchHit {
+                id: entry.id.clone(),
+                preview,
+                target: entry.target.clone(),
+                timestamp: entry.timestamp.clone(),
+                audio_duration_ms: entry.audio_duration_ms,
+                score: hit.score,
+                matched_field: match hit.field {
+                    0 => DictationHistorySearchField::Transcript,
+                    1 => DictationHistorySearchField::Target,
+                    _ => DictationHistorySearchField::Timestamp,
+                },
+            }
+        })
+        .collect()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn doc(position: usize, fields: &[&str]) -> IndexedDoc<usize> {
+        IndexedDoc {
+            item: position,
+            position,
+            rank: position,
+            fields: fields
+                .iter()
+                .map(|field| normalize_search_text(field))
+                .collect(),
+        }
+    }
+
+    fn items(matches: Vec<IndexMatch<'_, usize>>) -> Vec<usize> {
+        matches.into_iter().map(|hit| *hit.item).collect()
+    }
+
+    #[test]
+    fn test_normalize_collapses_whitespace_and_lowercases() {
+        assert_eq!(
+            normalize_search_text("  Hello\n\tWORLD  again "),
+            "hello world again"
+        );
+        assert_eq!(normalize_search_text(""), "");
+    }
+
+    #[test]
+    fn test_weights_rank_title_prefix_over_body_matches() {
+        let partition = Partition::build(
+            1,
+            vec![
+                doc(0, &["weekly sync", "notes about the release"]),
+                doc(1, &["Release checklist", "ship it"]),
+                doc(2, &["groceries", "milk eggs"]),
+                doc(3, &["plan", "the release window"]),
+            ],
+        );
+        let query = IndexQuery::new("Release");
+        let matches = partition.search(
+            &query.tokens,
+            &[NOTE_TITLE_WEIGHT, NOTE_CONTENT_WEIGHT],
+            usize::MAX,
+            10,
+        );
+        assert_eq!(matches[0].field, 0);
+        assert_eq!(
+            items(matches),
+            vec![1, 0, 3],
+            "equal scores keep source order"
+        );
+
+        let title_only = partition.search(
+            &query.tokens,
+            &[NOTE_TITLE_WEIGHT, FieldWeight::OFF],
+            usize::MAX,
+            10,
+        );
+        assert_eq!(
+            items(title_only),
+            vec![1],
+            "unsearched fields cannot satisfy a token"
+        );
+    }
+
+    #[test]
+    fn test_every_token_must_match_some_field() {
+        let partition = Partition::build(
+            1,
+            vec![
+                doc(0, &["deploy script", "runs nightly"]),
+                doc(1, &["deploy notes", "manual"]),
+            ],
+        );
+        let query = IndexQuery::new("deploy nightly");
+        assert_eq!(
+            items(partition.search(&query.tokens, &AGENT_CHAT_WEIGHTS[..2], usize::MAX, 10)),
+            vec![0]
+        );
+
+        // Tokens shorter than a trigram fall back to scanning every doc.
+        let short = IndexQuery::new("ru");
+        assert_eq!(partition.candidates(&short.tokens), None);
+        assert_eq!(
+            items(partition.search(&short.tokens, &AGENT_CHAT_WEIGHTS[..2], usize::MAX, 10)),
+            vec![0]
+        );
+        assert_eq!(
+            partition.candidates(&IndexQuery::new("zzz").tokens),
+            Some(Vec::new())
+        );
+    }
+
+    #[test]
+    fn test_phrase_queries_respect_scan_limit_and_order() {
+        let partition = Partition::build(
+            1,
+            vec![
+                doc(0, &["meeting at noon"]),
+                doc(1, &["noon meeting"]),
+                doc(2, &["Meeting   at noon tomorrow"]),
+            ],
+        );
+        let query = IndexQuery::new("meeting at");
+        assert_eq!(
+            items(partition.search(&query.phrase, &CLIPBOARD_WEIGHTS, usize::MAX, 10)),
+            vec![0, 2]
+        );
+        assert_eq!(
+            items(partition.search(&query.phrase, &CLIPBOARD_WEIGHTS, 2, 10)),
+            vec![0]
+        );
+        assert_eq!(
+            items(partition.search(&query.phrase, &CLIPBOARD_WEIGHTS, usize::MAX, 1)),
+            vec![0]
+        );
+    }
+
+    #[test]
+    fn test_recency_ranks_put_newest_first() {
+        let stamps = ["2026-01-02", "2026-03-01", "2026-01-02"];
+        assert_eq!(recency_ranks(&stamps, |stamp| *stamp), vec![1, 0, 2]);
+    }
+
+    #[test]
+    fn test_snippet_only_when_match_is_past_the_preview() {
+        assert_eq!(snippet_around("Remember the   milk", "milk", 40), None);
+        assert_eq!(snippet_around("nothing here", "milk", 40), None);
+
+        let long = format!("{} then buy MILK and bread", "filler ".repeat(20));
+        let snippet = snippet_around(&long, "milk", 30).expect("match is past the preview");
+        assert!(snippet.starts_with('\u{2026}'), "{snippet}");
+        assert!(snippet.contains("MILK"), "{snippet}");
+        assert!(snippet.chars().count() <= 32, "{snippet}");
+    }
+}
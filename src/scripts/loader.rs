@@ -4,6 +4,7 @@
 //! ~/.scriptkit/plugins/*/scripts/ directories.
 
 use std::path::Path;
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::Arc;
 use tracing::{debug, info, instrument, warn};
 
@@ -16,6 +17,21 @@ use super::scriptlet_loader::extract_kit_from_path;
 use super::types::Script;
 use super::validation::{validate_script_catalog, ScriptCatalogReport};
 
+/// Bumped by the script watcher for every script or scriptlet change on disk.
+static CATALOG_WRITE_REVISION: AtomicU64 = AtomicU64::new(0);
+
+/// Record a script or scriptlet write. Catalogs cached against
+/// [`catalog_write_revision`] reload on their next read.
+pub fn note_catalog_write() {
+    CATALOG_WRITE_REVISION.fetch_add(1, Ordering::Release);
+}
+
+/// Revision of the on-disk script and scriptlet catalogs. Sample it before
+/// loading so a write that lands mid-load still moves the revision on.
+pub fn catalog_write_revision() -> u64 {
+    CATALOG_WRITE_REVISION.load(Ordering::Acquire)
+}
+
 /// Reads scripts from all discovered plugin roots.
 ///
 /// Consumes `discover_plugins()` so every loaded script carries explicit
@@ -52,7 +52,9 @@ pub(crate) use self::grouping::pin_alias_match_first;
 #[allow(unused_imports)]
 pub(crate) use self::grouping::prepend_root_brain_inbox_section;
 #[allow(unused_imports)]
-pub use self::loader::{read_scripts, read_scripts_report};
+pub use self::loader::{
+    catalog_write_revision, note_catalog_write, read_scripts, read_scripts_report,
+};
 pub use self::scheduling::register_scheduled_scripts;
 pub use self::scriptlet_loader::{load_scriptlets, read_scriptlets_from_file};
 #[allow(unused_imports)]
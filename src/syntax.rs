@@ -6,25 +6,51 @@
 //! NOTE: syntect's default syntax set doesn't include TypeScript, so we use
 //! JavaScript syntax for .ts files (which works well for highlighting).
 //!
-//! Performance: SyntaxSet and ThemeSet are cached as lazy statics since
-//! loading them takes ~50ms each.
+//! Performance: the SyntaxSet and ThemeSet are loaded once per process and
+//! shared with the Notes highlighter. `prewarm_highlighting_assets` loads them
+//! on a background thread at startup; highlighting calls that arrive before
+//! that finishes get plain-text lines instead of blocking the UI thread on
+//! the load, and `highlighting_ready` lets callers avoid caching that fallback.
+//!
+//! `highlight_code_lines` is incremental: recently highlighted documents keep
+//! their per-line output plus parse/highlight state checkpoints every
+//! `CHECKPOINT_INTERVAL` lines. A call whose code shares a prefix with a cached
+//! document (same syntax and theme) resumes from the nearest checkpoint before
+//! the first changed line, and stops early once its state re-converges with
+//! the cached state inside the unchanged suffix. Editors, previews and
+//! streaming code blocks therefore only pay for the lines that changed.
 
 #![allow(dead_code)]
 
-use std::sync::OnceLock;
+use std::collections::hash_map::DefaultHasher;
+use std::hash::{Hash, Hasher};
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::{Mutex, OnceLock};
 use syntect::easy::HighlightLines;
-use syntect::highlighting::{Style, Theme, ThemeSet};
-use syntect::parsing::SyntaxSet;
+use syntect::highlighting::{
+    HighlightIterator, HighlightState, Highlighter, Style, Theme, ThemeSet,
+};
+use syntect::parsing::{ParseState, ScopeStack, SyntaxReference, SyntaxSet};
 use syntect::util::LinesWithEndings;
+use tracing::{info, warn};
 
 /// Cached SyntaxSet - loading takes ~50ms, so we cache it globally
 static SYNTAX_SET: OnceLock<SyntaxSet> = OnceLock::new();
 
-/// Cached dark theme - loading takes ~50ms, so we cache it globally
-static DARK_THEME: OnceLock<Theme> = OnceLock::new();
+/// Cached default ThemeSet - shared by both modes and the Notes highlighter
+static THEME_SET: OnceLock<ThemeSet> = OnceLock::new();
+
+/// Set once the background asset load has been started.
+static PREWARM_STARTED: AtomicBool = AtomicBool::new(false);
+
+/// Lines between parse/highlight state checkpoints in incremental documents.
+const CHECKPOINT_INTERVAL: usize = 64;
 
-/// Cached light theme - loading takes ~50ms, so we cache it globally
-static LIGHT_THEME: OnceLock<Theme> = OnceLock::new();
+/// Number of recently highlighted documents kept for incremental reuse.
+const MAX_INCREMENTAL_DOCUMENTS: usize = 16;
+
+/// Recently highlighted documents, most recently used last.
+static INCREMENTAL_DOCUMENTS: OnceLock<Mutex<Vec<HighlightedDocument>>> = OnceLock::new();
 
 /// Default foreground color for dark mode (light gray text on dark background)
 const DEFAULT_COLOR_DARK: u32 = 0xcccccc;
@@ -37,22 +63,20 @@ fn get_syntax_set() -> &'static SyntaxSet {
     SYNTAX_SET.get_or_init(SyntaxSet::load_defaults_newlines)
 }
 
-/// Get the cached dark theme, loading it if necessary
+/// Get the cached ThemeSet, loading it if necessary
+fn get_theme_set() -> &'static ThemeSet {
+    THEME_SET.get_or_init(ThemeSet::load_defaults)
+}
+
+/// Get the dark theme from the cached ThemeSet
 fn get_dark_theme() -> &'static Theme {
-    DARK_THEME.get_or_init(|| {
-        let ts = ThemeSet::load_defaults();
-        // Clone the theme so we can move it into the static
-        ts.themes["base16-eighties.dark"].clone()
-    })
+    &get_theme_set().themes["base16-eighties.dark"]
 }
 
-/// Get the cached light theme, loading it if necessary
+/// Get the light theme from the cached ThemeSet
 fn get_light_theme() -> &'static Theme {
-    LIGHT_THEME.get_or_init(|| {
-        let ts = ThemeSet::load_defaults();
-        // base16-ocean.light is a good light theme from syntect defaults
-        ts.themes["base16-ocean.light"].clone()
-    })
+    // base16-ocean.light is a good light theme from syntect defaults
+    &get_theme_set().themes["base16-ocean.light"]
 }
 
 /// Get the appropriate theme based on dark/light mode
@@ -64,6 +88,57 @@ fn get_theme(is_dark: bool) -> &'static Theme {
     }
 }
 
+/// Load the syntax and theme sets on a background thread.
+///
+/// Call once at startup so the first preview never pays the load on the UI
+/// thread. Subsequent calls are no-ops.
+pub fn prewarm_highlighting_assets() {
+    if PREWARM_STARTED.swap(true, Ordering::AcqRel) {
+        return;
+    }
+
+    let spawned = std::thread::Builder::new()
+        .name("syntax-assets-prewarm".into())
+        .spawn(|| {
+            let started = std::time::Instant::now();
+            let syntax_count = get_syntax_set().syntaxes().len();
+            let theme_count = get_theme_set().themes.len();
+            info!(
+                event = "syntax_assets_prewarmed",
+                elapsed_ms = started.elapsed().as_millis() as u64,
+                syntax_count,
+                theme_count,
+            );
+        });
+    if let Err(error) = spawned {
+        warn!(event = "syntax_assets_prewarm_spawn_failed", %error);
+        PREWARM_STARTED.store(false, Ordering::Release);
+    }
+}
+
+/// Whether highlighting assets are loaded, i.e. highlighting output is final
+/// rather than the plain-text fallback.
+pub fn highlighting_ready() -> bool {
+    SYNTAX_SET.get().is_some() && THEME_SET.get().is_some()
+}
+
+/// The shared syntax and theme sets, or `None` while they are still loading.
+///
+/// Returning `None` also kicks off the background load. Tests load
+/// synchronously so highlighting output stays deterministic.
+pub(crate) fn loaded_highlighting_assets() -> Option<(&'static SyntaxSet, &'static ThemeSet)> {
+    if cfg!(test) {
+        return Some((get_syntax_set(), get_theme_set()));
+    }
+    match (SYNTAX_SET.get(), THEME_SET.get()) {
+        (Some(ps), Some(themes)) => Some((ps, themes)),
+        _ => {
+            prewarm_highlighting_assets();
+            None
+        }
+    }
+}
+
 /// Get the default text color for the given theme mode
 fn get_default_color(is_dark: bool) -> u32 {
     if is_dark {
@@ -145,75 +220,290 @@ fn map_language_to_syntax(language: &str) -> &str {
     }
 }
 
-/// Highlight code with syntax coloring, returning lines of spans
-///
-/// # Arguments
-/// * `code` - The source code to highlight
-/// * `language` - The language identifier (e.g., "typescript", "javascript", "markdown", "ts", "js", "md")
-/// * `is_dark` - Whether to use dark theme (true) or light theme (false)
+/// Resolve the syntect syntax for a language name/extension.
 ///
-/// # Returns
-/// A vector of `HighlightedLine` structs, each containing spans for one line.
-/// This preserves line structure for proper rendering.
-pub fn highlight_code_lines(code: &str, language: &str, is_dark: bool) -> Vec<HighlightedLine> {
-    let ps = get_syntax_set();
-    let theme = get_theme(is_dark);
-
-    // Default foreground color for plain text based on theme
-    let default_color = get_default_color(is_dark);
-
+/// Unknown languages fall back to JavaScript, which highlights most script-like
+/// snippets better than plain text.
+fn resolve_syntax<'a>(ps: &'a SyntaxSet, language: &str) -> &'a SyntaxReference {
     let syntax_name = map_language_to_syntax(language);
-
-    // Try to find the syntax by name, or fall back to JavaScript for unknown
-    let syntax = ps
-        .find_syntax_by_name(syntax_name)
+    ps.find_syntax_by_name(syntax_name)
         .or_else(|| ps.find_syntax_by_extension(language))
         .or_else(|| ps.find_syntax_by_name("JavaScript")) // Better fallback than plain text
-        .unwrap_or_else(|| ps.find_syntax_plain_text());
+        .unwrap_or_else(|| ps.find_syntax_plain_text())
+}
 
-    let mut highlighter = HighlightLines::new(syntax, theme);
-    let mut result = Vec::new();
+/// Parser and highlighter state before a given line.
+#[derive(Debug, Clone, PartialEq, Eq)]
+struct LineCheckpoint {
+    parse: ParseState,
+    highlight: HighlightState,
+}
 
-    for line in LinesWithEndings::from(code) {
-        let mut line_spans: Vec<HighlightedSpan> = Vec::new();
+/// A highlighted document retained for incremental re-highlighting.
+#[derive(Debug, Clone)]
+struct HighlightedDocument {
+    syntax_name: String,
+    is_dark: bool,
+    /// Hash of each source line (including its trailing newline).
+    line_hashes: Vec<u64>,
+    lines: Vec<HighlightedLine>,
+    /// `(line_index, state before that line)`, sorted by line index. The
+    /// first entry is always the initial state at line 0.
+    checkpoints: Vec<(usize, LineCheckpoint)>,
+}
 
-        match highlighter.highlight_line(line, ps) {
-            Ok(ranges) => {
-                for (style, text) in ranges {
-                    if !text.is_empty() {
-                        // Strip trailing newline for cleaner rendering
-                        let clean_text = text.trim_end_matches('\n');
-                        if !clean_text.is_empty() {
-                            let color = style_to_hex_color(&style);
-
-                            // PERF: Merge adjacent spans with the same color
-                            // This dramatically reduces span count (from ~230/line to ~10-20/line)
-                            if let Some(last) = line_spans.last_mut() {
-                                if last.color == color {
-                                    // Merge with previous span
-                                    last.text.push_str(clean_text);
-                                    continue;
-                                }
+fn hash_line(line: &str) -> u64 {
+    let mut hasher = DefaultHasher::new();
+    line.hash(&mut hasher);
+    hasher.finish()
+}
+
+fn common_prefix_len(a: &[u64], b: &[u64]) -> usize {
+    a.iter().zip(b).take_while(|(x, y)| x == y).count()
+}
+
+/// Common suffix length, never overlapping the first `prefix` lines of either side.
+fn common_suffix_len(a: &[u64], b: &[u64], prefix: usize) -> usize {
+    let max = a.len().min(b.len()) - prefix;
+    a.iter()
+        .rev()
+        .zip(b.iter().rev())
+        .take(max)
+        .take_while(|(x, y)| x == y)
+        .count()
+}
+
+/// Highlight one line, advancing `state` past it.
+fn highlight_line_spans(
+    line: &str,
+    state: &mut LineCheckpoint,
+    highlighter: &Highlighter<'_>,
+    ps: &SyntaxSet,
+    default_color: u32,
+) -> HighlightedLine {
+    let mut line_spans: Vec<HighlightedSpan> = Vec::new();
+
+    match state.parse.parse_line(line, ps) {
+        Ok(ops) => {
+            let ranges = HighlightIterator::new(&mut state.highlight, &ops[..], line, highlighter);
+            for (style, text) in ranges {
+                if !text.is_empty() {
+                    // Strip trailing newline for cleaner rendering
+                    let clean_text = text.trim_end_matches('\n');
+                    if !clean_text.is_empty() {
+                        let color = style_to_hex_color(&style);
+
+                        // PERF: Merge adjacent spans with the same color
+                        // This dramatically reduces span count (from ~230/line to ~10-20/line)
+                        if let Some(last) = line_spans.last_mut() {
+                            if last.color == color {
+                                // Merge with previous span
+                                last.text.push_str(clean_text);
+                                continue;
                             }
-                            line_spans.push(HighlightedSpan::new(clean_text, color));
                         }
+                        line_spans.push(HighlightedSpan::new(clean_text, color));
                     }
                 }
             }
-            Err(_) => {
-                // On error, push the line as plain text
-                let clean_line = line.trim_end_matches('\n');
-                if !clean_line.is_empty() {
-                    line_spans.push(HighlightedSpan::new(clean_line, default_color));
-                }
+        }
+        Err(_) => {
+            // On error, push the line as plain text
+            let clean_line = line.trim_end_matches('\n');
+            if !clean_line.is_empty() {
+                line_spans.push(HighlightedSpan::new(clean_line, default_color));
             }
         }
+    }
+
+    HighlightedLine { spans: line_spans }
+}
 
-        result.push(HighlightedLine { spans: line_spans });
+/// Highlight `source_lines`, reusing output and checkpoints from `base` when given.
+///
+/// `base` must have been produced for the same syntax and theme.
+fn highlight_document(
+    base: Option<HighlightedDocument>,
+    source_lines: &[&str],
+    line_hashes: Vec<u64>,
+    syntax: &SyntaxReference,
+    is_dark: bool,
+) -> HighlightedDocument {
+    let ps = get_syntax_set();
+    let highlighter = Highlighter::new(get_theme(is_dark));
+    let default_color = get_default_color(is_dark);
+
+    let mut doc = base.unwrap_or_else(|| HighlightedDocument {
+        syntax_name: syntax.name.clone(),
+        is_dark,
+        line_hashes: Vec::new(),
+        lines: Vec::new(),
+        checkpoints: vec![(
+            0,
+            LineCheckpoint {
+                parse: ParseState::new(syntax),
+                highlight: HighlightState::new(&highlighter, ScopeStack::new()),
+            },
+        )],
+    });
+
+    let old_len = doc.line_hashes.len();
+    let new_len = line_hashes.len();
+    let prefix = common_prefix_len(&doc.line_hashes, &line_hashes);
+    if prefix == old_len && prefix == new_len {
+        return doc;
     }
+    let suffix = common_suffix_len(&doc.line_hashes, &line_hashes, prefix);
+    // First line (in new indexing) of the unchanged suffix.
+    let suffix_start = new_len - suffix;
+
+    // Resume from the last checkpoint at or before the first changed line.
+    let resume_ix = doc
+        .checkpoints
+        .partition_point(|(line, _)| *line <= prefix)
+        .saturating_sub(1);
+    let old_checkpoints = doc.checkpoints.split_off(resume_ix + 1);
+    let mut old_lines = doc.lines.split_off(doc.checkpoints[resume_ix].0);
+    let start = doc.lines.len();
+    let mut state = doc.checkpoints[resume_ix].1.clone();
+    let mut last_checkpoint_line = start;
+
+    let mut old_checkpoint_iter = old_checkpoints.into_iter().peekable();
+    for (line_ix, line) in source_lines.iter().enumerate().skip(start) {
+        if line_ix >= suffix_start && line_ix > start {
+            // Inside the unchanged suffix: once our state matches the cached
+            // state before the same source line, the rest of the old output is
+            // still valid and can be spliced in.
+            let old_line_ix = line_ix + old_len - new_len;
+            while old_checkpoint_iter
+                .peek()
+                .is_some_and(|(old_line, _)| *old_line < old_line_ix)
+            {
+                old_checkpoint_iter.next();
+            }
+            if old_checkpoint_iter
+                .peek()
+                .is_some_and(|(old_line, old_state)| {
+                    *old_line == old_line_ix && *old_state == state
+                })
+            {
+                let old_start = old_line_ix - start;
+                doc.lines.extend(old_lines.drain(old_start..));
+                doc.checkpoints.extend(
+                    old_checkpoint_iter
+                        .map(|(old_line, old_state)| (old_line + new_len - old_len, old_state)),
+                );
+                doc.line_hashes = line_hashes;
+                return doc;
+            }
+        }
 
-    // If no lines were produced, return empty vec
-    result
+        if line_ix - last_checkpoint_line >= CHECKPOINT_INTERVAL {
+            doc.checkpoints.push((line_ix, state.clone()));
+            last_checkpoint_line = line_ix;
+        }
+        doc.lines.push(highlight_line_spans(
+            line,
+            &mut state,
+            &highlighter,
+            ps,
+            default_color,
+        ));
+    }
+
+    doc.line_hashes = line_hashes;
+    doc
+}
+
+/// Unhighlighted lines in the default color, used while assets are loading.
+fn plain_text_lines(code: &str, is_dark: bool) -> Vec<HighlightedLine> {
+    let default_color = get_default_color(is_dark);
+    LinesWithEndings::from(code)
+        .map(|line| {
+            let clean_line = line.trim_end_matches('\n');
+            let spans = if clean_line.is_empty() {
+                Vec::new()
+            } else {
+                vec![HighlightedSpan::new(clean_line, default_color)]
+            };
+            HighlightedLine { spans }
+        })
+        .collect()
+}
+
+/// Highlight code with syntax coloring, returning lines of spans
+///
+/// Results are produced incrementally against recently highlighted documents
+/// (see the module docs), so repeated calls with edited or appended code only
+/// re-highlight the changed region.
+///
+/// # Arguments
+/// * `code` - The source code to highlight
+/// * `language` - The language identifier (e.g., "typescript", "javascript", "markdown", "ts", "js", "md")
+/// * `is_dark` - Whether to use dark theme (true) or light theme (false)
+///
+/// # Returns
+/// A vector of `HighlightedLine` structs, each containing spans for one line.
+/// This preserves line structure for proper rendering. Until the highlighting
+/// assets are loaded the lines are plain text in the default color.
+pub fn highlight_code_lines(code: &str, language: &str, is_dark: bool) -> Vec<HighlightedLine> {
+    if code.is_empty() {
+        return Vec::new();
+    }
+
+    let Some((ps, _)) = loaded_highlighting_assets() else {
+        return plain_text_lines(code, is_dark);
+    };
+    let syntax = resolve_syntax(ps, language);
+    let source_lines: Vec<&str> = LinesWithEndings::from(code).collect();
+    let line_hashes: Vec<u64> = source_lines.iter().map(|line| hash_line(line)).collect();
+
+    let documents = INCREMENTAL_DOCUMENTS.get_or_init(|| Mutex::new(Vec::new()));
+
+    // Take the cached document that best overlaps this code. It is only reused
+    // when at least half of its lines survive; otherwise highlighting from
+    // scratch is about as cheap and keeps the unrelated document cached.
+    let base = documents.lock().ok().and_then(|mut guard| {
+        let (best_ix, best_shared) = guard
+            .iter()
+            .enumerate()
+            .filter(|(_, doc)| doc.is_dark == is_dark && doc.syntax_name == syntax.name)
+            .map(|(ix, doc)| {
+                let prefix = common_prefix_len(&doc.line_hashes, &line_hashes);
+                (
+                    ix,
+                    prefix + common_suffix_len(&doc.line_hashes, &line_hashes, prefix),
+                )
+            })
+            .max_by_key(|(_, shared)| *shared)?;
+        (best_shared > 0 && best_shared * 2 >= guard[best_ix].line_hashes.len())
+            .then(|| guard.remove(best_ix))
+    });
+
+    let doc = highlight_document(base, &source_lines, line_hashes, syntax, is_dark);
+    let lines = doc.lines.clone();
+
+    if let Ok(mut guard) = documents.lock() {
+        if guard.len() >= MAX_INCREMENTAL_DOCUMENTS {
+            guard.remove(0);
+        }
+        guard.push(doc);
+    }
+
+    lines
+}
+
+/// Highlight code lines without consulting or populating the incremental cache.
+#[cfg(test)]
+pub(crate) fn highlight_code_lines_from_scratch(
+    code: &str,
+    language: &str,
+    is_dark: bool,
+) -> Vec<HighlightedLine> {
+    let syntax = resolve_syntax(get_syntax_set(), language);
+    let source_lines: Vec<&str> = LinesWithEndings::from(code).collect();
+    let line_hashes = source_lines.iter().map(|line| hash_line(line)).collect();
+    highlight_document(None, &source_lines, line_hashes, syntax, is_dark).lines
 }
 
 /// Highlight code with syntax coloring (flat span list for backward compatibility)
@@ -225,22 +515,21 @@ pub fn highlight_code_lines(code: &str, language: &str, is_dark: bool) -> Vec<Hi
 ///
 /// # Returns
 /// A vector of `HighlightedSpan` structs, each containing a text segment and its color.
-/// If the language is not recognized, returns the code as plain text with default color.
+/// If the language is not recognized, or the highlighting assets are still
+/// loading, returns the code as plain text with default color.
 pub fn highlight_code(code: &str, language: &str, is_dark: bool) -> Vec<HighlightedSpan> {
-    let ps = get_syntax_set();
-    let theme = get_theme(is_dark);
-
     // Default foreground color for plain text based on theme
     let default_color = get_default_color(is_dark);
 
-    let syntax_name = map_language_to_syntax(language);
+    let Some((ps, _)) = loaded_highlighting_assets() else {
+        if code.is_empty() {
+            return Vec::new();
+        }
+        return vec![HighlightedSpan::new(code, default_color)];
+    };
+    let theme = get_theme(is_dark);
 
-    // Try to find the syntax by name, or fall back to JavaScript for unknown
-    let syntax = ps
-        .find_syntax_by_name(syntax_name)
-        .or_else(|| ps.find_syntax_by_extension(language))
-        .or_else(|| ps.find_syntax_by_name("JavaScript")) // Better fallback than plain text
-        .unwrap_or_else(|| ps.find_syntax_plain_text());
+    let syntax = resolve_syntax(ps, language);
 
     let mut highlighter = HighlightLines::new(syntax, theme);
     let mut result: Vec<HighlightedSpan> = Vec::new();
@@ -422,6 +711,89 @@ mod tests {
         assert!(!lines[1].spans.is_empty());
     }
 
+    fn line_spans(lines: &[HighlightedLine]) -> Vec<Vec<HighlightedSpan>> {
+        lines.iter().map(|line| line.spans.clone()).collect()
+    }
+
+    fn synthetic_js(line_count: usize) -> Vec<String> {
+        (0..line_count)
+            .map(|ix| match ix % 4 {
+                0 => format!("function f{ix}(a, b) {{"),
+                1 => format!("    const s{ix} = \"value {ix}\"; // note"),
+                2 => format!("    return a + b * {ix};"),
+                _ => "}".to_string(),
+            })
+            .collect()
+    }
+
+    fn assert_incremental_matches_scratch(code: &str, language: &str) {
+        let incremental = highlight_code_lines(code, language, true);
+        let scratch = highlight_code_lines_from_scratch(code, language, true);
+        assert_eq!(line_spans(&incremental), line_spans(&scratch));
+    }
+
+    #[test]
+    fn test_incremental_edits_match_from_scratch() {
+        let mut lines = synthetic_js(400);
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+
+        // Same-length edit that does not change parser state.
+        lines[200] = "    return a - b;".to_string();
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+
+        // Opening a block comment changes the state of every following line.
+        lines[120] = "    /* unterminated".to_string();
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+
+        // Closing it again must re-converge with the original highlighting.
+        lines[121] = "    */".to_string();
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+
+        // Inserted and deleted lines shift the unchanged suffix.
+        lines.insert(10, "let inserted = `template ${1}`;".to_string());
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+        lines.drain(300..305);
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+    }
+
+    #[test]
+    fn test_incremental_appends_match_from_scratch() {
+        let mut code = String::new();
+        for line in synthetic_js(300) {
+            code.push_str(&line);
+            assert_incremental_matches_scratch(&code, "js");
+            code.push('\n');
+        }
+        assert_incremental_matches_scratch(&code, "js");
+    }
+
+    #[test]
+    fn test_incremental_truncation_matches_from_scratch() {
+        let lines = synthetic_js(200);
+        assert_incremental_matches_scratch(&lines.join("\n"), "javascript");
+        assert_incremental_matches_scratch(&lines[..130].join("\n"), "javascript");
+        assert_incremental_matches_scratch(&lines[..1].join("\n"), "javascript");
+    }
+
+    #[test]
+    fn test_plain_text_fallback_preserves_lines() {
+        let lines = plain_text_lines("const a = 1;\n\nconst b = 2;", true);
+        assert_eq!(lines.len(), 3);
+        assert_eq!(
+            lines[0].spans,
+            vec![HighlightedSpan::new("const a = 1;", DEFAULT_COLOR_DARK)]
+        );
+        assert!(lines[1].spans.is_empty());
+        assert_eq!(lines[2].spans[0].text, "const b = 2;");
+    }
+
+    #[test]
+    fn test_prewarm_makes_assets_ready() {
+        prewarm_highlighting_assets();
+        assert!(loaded_highlighting_assets().is_some());
+        assert!(highlighting_ready());
+    }
+
     #[test]
     fn test_highlight_produces_colors() {
         // Use JavaScript which IS in syntect defaults
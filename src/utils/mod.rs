@@ -5,10 +5,12 @@
 //! - `assets`: Asset path resolution
 //! - `paths`: Path highlighting for search results
 //! - `tailwind`: Tailwind CSS class mapping
+//! - `sqlite_pool`: Writer + read-connection pool shared by the app databases
 
 mod applescript;
 pub mod assets;
 pub(crate) mod db_permissions;
+pub(crate) mod sqlite_pool;
 mod html;
 mod paths;
 mod tailwind;
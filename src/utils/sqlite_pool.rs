@@ -0,0 +1,514 @@
+//! Shared SQLite access layer: one writer connection plus a small pool of
+//! read-only WAL connections per database.
+//!
+//! Every app database used to keep a single global `Arc<Mutex<Connection>>`,
+//! so a UI-thread read (clipboard history page, notes search) queued behind
+//! whatever background write held the lock. In WAL mode SQLite lets readers
+//! proceed concurrently with the writer, but only through distinct
+//! connections. `SqlitePool` keeps the existing writer handle (stores still
+//! hand it out for writes and migrations) and routes pure SELECTs through
+//! [`SqlitePool::with_read`], which picks a free read connection and never
+//! touches the writer mutex.
+//!
+//! Every `with_read`/`with_write` call records lock wait and execution time
+//! per query label (see [`SqlitePool::query_stats`]); slow queries are logged,
+//! and [`query_report`] collects every open pool for the
+//! `kit://diagnostics/sqlite` resource.
+//!
+//! Statements are still prepared per call: rusqlite's statement cache lives
+//! behind its `cache` feature, which this build disables (it would add the
+//! `hashlink` dependency). Because each reader is a long-lived connection,
+//! enabling it later only means switching hot queries to `prepare_cached`.
+
+use anyhow::{anyhow, Context as _, Result};
+use rusqlite::{Connection, OpenFlags};
+use std::collections::HashMap;
+use std::path::Path;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex, MutexGuard, Weak};
+use std::time::{Duration, Instant};
+
+/// Read connections opened per database by default.
+pub(crate) const DEFAULT_READ_CONNECTIONS: usize = 3;
+
+/// Same busy timeout the stores already use for their writer connections.
+const READ_BUSY_TIMEOUT_MS: i64 = 5000;
+
+/// Queries slower than this (wait + execution) are logged.
+const SLOW_QUERY_THRESHOLD: Duration = Duration::from_millis(16);
+
+/// Aggregated timing for one query label.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub(crate) struct QueryStats {
+    pub count: u64,
+    /// Time spent waiting for a connection lock.
+    pub total_wait_us: u64,
+    pub max_wait_us: u64,
+    /// Time spent running the closure once the connection was held.
+    pub total_exec_us: u64,
+    pub max_exec_us: u64,
+}
+
+impl QueryStats {
+    fn record(&mut self, wait: Duration, exec: Duration) {
+        let wait_us = wait.as_micros() as u64;
+        let exec_us = exec.as_micros() as u64;
+        self.count += 1;
+        self.total_wait_us += wait_us;
+        self.max_wait_us = self.max_wait_us.max(wait_us);
+        self.total_exec_us += exec_us;
+        self.max_exec_us = self.max_exec_us.max(exec_us);
+    }
+}
+
+type StatsTable = Mutex<HashMap<&'static str, QueryStats>>;
+
+/// Every pool opened in this process, for [`query_report`]. Weak so a dropped
+/// pool (tests, a reopened clipboard db) falls out of the report.
+static OPEN_POOLS: Mutex<Vec<(&'static str, usize, Weak<StatsTable>)>> = Mutex::new(Vec::new());
+
+/// One database in [`query_report`].
+#[derive(Debug, Clone, PartialEq, serde::Serialize)]
+#[serde(rename_all = "camelCase")]
+pub(crate) struct DatabaseQueryReport {
+    pub database: &'static str,
+    pub read_connections: usize,
+    /// Sorted by total execution time, slowest first.
+    pub queries: Vec<QueryReportRow>,
+}
+
+#[derive(Debug, Clone, PartialEq, serde::Serialize)]
+#[serde(rename_all = "camelCase")]
+pub(crate) struct QueryReportRow {
+    pub label: &'static str,
+    pub count: u64,
+    pub avg_wait_us: u64,
+    pub max_wait_us: u64,
+    pub avg_exec_us: u64,
+    pub max_exec_us: u64,
+}
+
+/// Per-query timing of every open pool since app start.
+pub(crate) fn query_report() -> Vec<DatabaseQueryReport> {
+    let mut pools = OPEN_POOLS
+        .lock()
+        .unwrap_or_else(|poisoned| poisoned.into_inner());
+    pools.retain(|(_, _, stats)| stats.strong_count() > 0);
+    pools
+        .iter()
+        .filter_map(|(database, read_connections, stats)| {
+            let stats = stats.upgrade()?;
+            let queries = sorted_stats(&stats)
+                .into_iter()
+                .map(|(label, stats)| {
+                    let count = stats.count.max(1);
+                    QueryReportRow {
+                        label,
+                        count: stats.count,
+                        avg_wait_us: stats.total_wait_us / count,
+                        max_wait_us: stats.max_wait_us,
+                        avg_exec_us: stats.total_exec_us / count,
+                        max_exec_us: stats.max_exec_us,
+                    }
+                })
+                .collect();
+            Some(DatabaseQueryReport {
+                database,
+                read_connections: *read_connections,
+                queries,
+            })
+        })
+        .collect()
+}
+
+fn sorted_stats(stats: &StatsTable) -> Vec<(&'static str, QueryStats)> {
+    let mut stats: Vec<_> = stats
+        .lock()
+        .map(|guard| guard.iter().map(|(label, s)| (*label, *s)).collect())
+        .unwrap_or_default();
+    stats.sort_by(|a, b| b.1.total_exec_us.cmp(&a.1.total_exec_us));
+    stats
+}
+
+pub(crate) struct SqlitePool {
+    name: &'static str,
+    writer: Arc<Mutex<Connection>>,
+    readers: Vec<Mutex<Connection>>,
+    next_reader: AtomicUsize,
+    stats: Arc<StatsTable>,
+}
+
+impl SqlitePool {
+    /// Wrap an already-initialized writer connection (pragmas, schema and
+    /// migrations applied by the owning store) and open `read_connections`
+    /// read-only connections to the same file.
+    ///
+    /// Read connections are best-effort: if they cannot be opened (e.g. an
+    /// in-memory database) reads fall back to the writer.
+    pub(crate) fn new(
+        name: &'static str,
+        path: &Path,
+        writer: Connection,
+        read_connections: usize,
+    ) -> Self {
+        let mut readers = Vec::with_capacity(read_connections);
+        if path.is_file() {
+            for _ in 0..read_connections {
+                match open_read_connection(path) {
+                    Ok(conn) => readers.push(Mutex::new(conn)),
+                    Err(error) => {
+                        tracing::warn!(
+                            target: "script_kit::sqlite",
+                            db = name,
+                            %error,
+                            "could not open read connection; reads fall back to the writer"
+                        );
+                        break;
+                    }
+                }
+            }
+        }
+
+        let stats = Arc::new(Mutex::new(HashMap::new()));
+        OPEN_POOLS
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+            .push((name, readers.len(), Arc::downgrade(&stats)));
+
+        Self {
+            name,
+            writer: Arc::new(Mutex::new(writer)),
+            readers,
+            next_reader: AtomicUsize::new(0),
+            stats,
+        }
+    }
+
+    /// The shared writer connection, for call sites that manage the lock
+    /// themselves (transactions, migrations, legacy helpers).
+    pub(crate) fn writer(&self) -> Arc<Mutex<Connection>> {
+        self.writer.clone()
+    }
+
+    pub(crate) fn read_connection_count(&self) -> usize {
+        self.readers.len()
+    }
+
+    /// Run a closure against the writer connection.
+    pub(crate) fn with_write<T>(
+        &self,
+        label: &'static str,
+        f: impl FnOnce(&mut Connection) -> Result<T>,
+    ) -> Result<T> {
+        let started = Instant::now();
+        let mut conn = self
+            .writer
+            .lock()
+            .map_err(|_| anyhow!("{} db lock poisoned", self.name))?;
+        let wait = started.elapsed();
+        let result = f(&mut conn);
+        drop(conn);
+        self.record(label, wait, started.elapsed() - wait);
+        result
+    }
+
+    /// Run a pure-SELECT closure on a read connection so it never queues
+    /// behind the writer. MUST NOT write: read connections are READ_ONLY.
+    pub(crate) fn with_read<T>(
+        &self,
+        label: &'static str,
+        f: impl FnOnce(&Connection) -> Result<T>,
+    ) -> Result<T> {
+        if self.readers.is_empty() {
+            return self.with_write(label, |conn| f(conn));
+        }
+
+        let started = Instant::now();
+        let conn = self.acquire_reader()?;
+        let wait = started.elapsed();
+        let result = f(&conn);
+        drop(conn);
+        self.record(label, wait, started.elapsed() - wait);
+        result
+    }
+
+    /// Snapshot of per-label timing, sorted by total execution time.
+    pub(crate) fn query_stats(&self) -> Vec<(&'static str, QueryStats)> {
+        sorted_stats(&self.stats)
+    }
+
+    /// Take the first idle reader starting from a rotating index; if every
+    /// reader is busy, wait on the next one in rotation (another reader, never
+    /// the writer).
+    fn acquire_reader(&self) -> Result<MutexGuard<'_, Connection>> {
+        let start = self.next_reader.fetch_add(1, Ordering::Relaxed) % self.readers.len();
+        for offset in 0..self.readers.len() {
+            let ix = (start + offset) % self.readers.len();
+            if let Ok(conn) = self.readers[ix].try_lock() {
+                return Ok(conn);
+            }
+        }
+        self.readers[start]
+            .lock()
+            .map_err(|_| anyhow!("{} read db lock poisoned", self.name))
+    }
+
+    fn record(&self, label: &'static str, wait: Duration, exec: Duration) {
+        if wait + exec >= SLOW_QUERY_THRESHOLD {
+            tracing::debug!(
+                target: "script_kit::sqlite",
+                db = self.name,
+                query = label,
+                wait_ms = wait.as_secs_f64() * 1000.0,
+                exec_ms = exec.as_secs_f64() * 1000.0,
+                "slow sqlite query"
+            );
+        }
+        if let Ok(mut stats) = self.stats.lock() {
+            stats.entry(label).or_default().record(wait, exec);
+        }
+    }
+}
+
+/// Open a read-only connection that follows the WAL created by the writer.
+/// No schema or journal pragmas: those belong to the writer.
+fn open_read_connection(path: &Path) -> Result<Connection> {
+    let conn = Connection::open_with_flags(
+        path,
+        OpenFlags::SQLITE_OPEN_READ_ONLY
+            | OpenFlags::SQLITE_OPEN_URI
+            | OpenFlags::SQLITE_OPEN_NO_MUTEX,
+    )
+    .with_context(|| format!("open read-only connection to {}", path.display()))?;
+    conn.pragma_update(None, "busy_timeout", READ_BUSY_TIMEOUT_MS)
+        .context("read connection busy_timeout")?;
+    Ok(conn)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::Barrier;
+
+    fn open_test_pool(dir: &tempfile::TempDir, readers: usize) -> SqlitePool {
+        let path = dir.path().join("pool.sqlite");
+        let writer = Connection::open(&path).expect("open writer");
+        writer
+            .execute_batch(
+                "PRAGMA journal_mode=WAL;
+                 CREATE TABLE items (id INTEGER PRIMARY KEY, body TEXT NOT NULL);",
+            )
+            .expect("init schema");
+        SqlitePool::new("test", &path, writer, readers)
+    }
+
+    #[test]
+    fn reads_see_committed_writes() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = open_test_pool(&dir, 2);
+        assert_eq!(pool.read_connection_count(), 2);
+
+        pool.with_write("insert", |conn| {
+            conn.execute("INSERT INTO items (body) VALUES ('a'), ('b')", [])?;
+            Ok(())
+        })
+        .expect("insert");
+
+        let count: i64 = pool
+            .with_read("count", |conn| {
+                Ok(conn.query_row("SELECT COUNT(*) FROM items", [], |row| row.get(0))?)
+            })
+            .expect("count");
+        assert_eq!(count, 2);
+
+        let stats = pool.query_stats();
+        assert!(stats
+            .iter()
+            .any(|(label, s)| *label == "count" && s.count == 1));
+        assert!(stats
+            .iter()
+            .any(|(label, s)| *label == "insert" && s.count == 1));
+    }
+
+    #[test]
+    fn query_report_lists_open_pools_until_dropped() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = open_test_pool(&dir, 2);
+        pool.with_read("report_probe", |conn| {
+            Ok(conn.query_row("SELECT COUNT(*) FROM items", [], |row| row.get::<_, i64>(0))?)
+        })
+        .expect("count");
+
+        let has_probe = || {
+            query_report().iter().any(|db| {
+                db.database == "test"
+                    && db.read_connections == 2
+                    && db
+                        .queries
+                        .iter()
+                        .any(|row| row.label == "report_probe" && row.count == 1)
+            })
+        };
+        assert!(has_probe());
+        drop(pool);
+        assert!(!has_probe(), "dropped pools leave the report");
+    }
+
+    #[test]
+    fn read_connections_reject_writes() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = open_test_pool(&dir, 1);
+        let result = pool.with_read("bad_write", |conn| {
+            conn.execute("INSERT INTO items (body) VALUES ('x')", [])?;
+            Ok(())
+        });
+        assert!(result.is_err());
+    }
+
+    #[test]
+    fn in_memory_database_falls_back_to_writer() {
+        let writer = Connection::open_in_memory().expect("open in-memory");
+        writer
+            .execute_batch("CREATE TABLE items (id INTEGER PRIMARY KEY);")
+            .expect("schema");
+        let pool = SqlitePool::new("memory", Path::new(":memory:"), writer, 3);
+        assert_eq!(pool.read_connection_count(), 0);
+        let count: i64 = pool
+            .with_read("count", |conn| {
+                Ok(conn.query_row("SELECT COUNT(*) FROM items", [], |row| row.get(0))?)
+            })
+            .expect("count");
+        assert_eq!(count, 0);
+    }
+
+    #[test]
+    fn reads_do_not_wait_for_held_writer() {
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = Arc::new(open_test_pool(&dir, 2));
+        let barrier = Arc::new(Barrier::new(2));
+
+        let writer_pool = pool.clone();
+        let writer_barrier = barrier.clone();
+        let writer = std::thread::spawn(move || {
+            writer_pool
+                .with_write("slow_write", |conn| {
+                    let tx = conn.transaction()?;
+                    tx.execute("INSERT INTO items (body) VALUES ('pending')", [])?;
+                    writer_barrier.wait();
+                    std::thread::sleep(Duration::from_millis(300));
+                    tx.commit()?;
+                    Ok(())
+                })
+                .expect("slow write");
+        });
+
+        barrier.wait();
+        let started = Instant::now();
+        let count: i64 = pool
+            .with_read("count", |conn| {
+                Ok(conn.query_row("SELECT COUNT(*) FROM items", [], |row| row.get(0))?)
+            })
+            .expect("count");
+        let elapsed = started.elapsed();
+        writer.join().expect("writer thread");
+
+        // The uncommitted row is invisible and the read did not queue behind
+        // the 300ms write transaction.
+        assert_eq!(count, 0);
+        assert!(
+            elapsed < Duration::from_millis(150),
+            "read waited {elapsed:?}"
+        );
+    }
+
+    #[test]
+    #[ignore = "performance benchmark: run with cargo test --release sqlite_pool_contention_benchmark -- --ignored --nocapture"]
+    fn sqlite_pool_contention_benchmark() {
+        const READERS: usize = 4;
+        const READS_PER_THREAD: usize = 500;
+        const WRITES: usize = 200;
+
+        let dir = tempfile::tempdir().expect("tempdir");
+        let pool = Arc::new(open_test_pool(&dir, DEFAULT_READ_CONNECTIONS));
+        pool.with_write("seed", |conn| {
+            let tx = conn.transaction()?;
+            for ix in 0..5_000 {
+                tx.execute(
+                    "INSERT INTO items (body) VALUES (?1)",
+                    [format!("seed row {ix}")],
+                )?;
+            }
+            tx.commit()?;
+            Ok(())
+        })
+        .expect("seed");
+
+        let run = |use_readers: bool| -> (Duration, Duration) {
+            let started = Instant::now();
+            let writer_pool = pool.clone();
+            let writer = std::thread::spawn(move || {
+                for ix in 0..WRITES {
+                    writer_pool
+                        .with_write("bench_write", |conn| {
+                            let tx = conn.transaction()?;
+                            for _ in 0..20 {
+                                tx.execute(
+                                    "INSERT INTO items (body) VALUES (?1)",
+                                    [format!("write {ix}")],
+                                )?;
+                            }
+                            tx.commit()?;
+                            Ok(())
+                        })
+                        .expect("bench write");
+                }
+            });
+
+            let mut max_read = Duration::ZERO;
+            let handles: Vec<_> = (0..READERS)
+                .map(|_| {
+                    let pool = pool.clone();
+                    std::thread::spawn(move || {
+                        let mut max_read = Duration::ZERO;
+                        for _ in 0..READS_PER_THREAD {
+                            let read_started = Instant::now();
+                            let query = |conn: &Connection| -> Result<i64> {
+                                Ok(conn.query_row(
+                                    "SELECT COUNT(*) FROM items WHERE body LIKE 'seed%'",
+                                    [],
+                                    |row| row.get(0),
+                                )?)
+                            };
+                            if use_readers {
+                                pool.with_read("bench_read", query).expect("read");
+                            } else {
+                                pool.with_write("bench_read_on_writer", |conn| query(conn))
+                                    .expect("read");
+                            }
+                            max_read = max_read.max(read_started.elapsed());
+                        }
+                        max_read
+                    })
+                })
+                .collect();
+            for handle in handles {
+                max_read = max_read.max(handle.join().expect("reader thread"));
+            }
+            writer.join().expect("writer thread");
+            (started.elapsed(), max_read)
+        };
+
+        let (single_total, single_max_read) = run(false);
+        let (pooled_total, pooled_max_read) = run(true);
+        eprintln!(
+            "single connection: total={single_total:?} max_read={single_max_read:?}\n\
+             pooled readers:    total={pooled_total:?} max_read={pooled_max_read:?}\n\
+             stats={:#?}",
+            pool.query_stats()
+        );
+        assert!(
+            pooled_max_read <= single_max_read,
+            "pooled reads should not wait longer than reads on the writer"
+        );
+    }
+}
@@ -254,6 +254,7 @@ impl ScriptWatcherSpec {
                 );
                 self.full_reload_at = None;
                 self.pending.clear();
+                crate::scripts::note_catalog_write();
                 return vec![ScriptReloadEvent::FullReload];
             }
         }
@@ -273,6 +274,9 @@ impl ScriptWatcherSpec {
                 true
             }
         });
+        if !events.is_empty() {
+            crate::scripts::note_catalog_write();
+        }
 
         events
     }
@@ -340,6 +344,9 @@ impl ScriptWatcherSpec {
                     self.pending.clear();
                 }
             }
+            // Bump now so cached catalogs reload promptly, and again on flush
+            // in case one was loaded between the write and this event.
+            crate::scripts::note_catalog_write();
 
             if self.pending.len() >= self.storm_threshold {
                 warn!(
@@ -244,6 +244,7 @@ fn wait_for_result_with_trace_receipt_serializes() {
                     choice_count: 0,
                     ..Default::default()
                 },
+                delta: None,
                 matched_semantic_ids: vec![],
             }],
             error: Some(TransactionError {
@@ -153,12 +153,12 @@ fn history_render_prep_static_gate_has_thresholds_and_row_identity_proof() {
 
 #[test]
 fn passive_source_speed_contract_stays_linked_to_runtime_log_parser() {
-    let filtering = read("src/app_impl/filtering_cache.rs");
+    let passive_sources = read("src/app_impl/root_passive_sources.rs");
     let typing_benchmark = read("scripts/agentic/root-typing-lag-benchmark.ts");
     let passive_contract = read("tests/source_audits/root_unified_passive_source_perf_contract.rs");
 
     assert_contains(
-        &filtering,
+        &passive_sources,
         "[PASSIVE_SOURCE_DONE]",
         "passive-source timing logs",
     );
@@ -174,7 +174,7 @@ fn passive_source_speed_contract_stays_linked_to_runtime_log_parser() {
     );
     assert_contains(
         &passive_contract,
-        "timed_root_passive_source",
+        "RootPassiveSourceJob::new",
         "passive-source source audit",
     );
 }
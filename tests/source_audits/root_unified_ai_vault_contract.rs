@@ -79,6 +79,10 @@ fn root_unified_ai_vault_contract() {
     assert!(ai_vault.contains("root_ai_vault_snapshot_status"));
     assert!(ai_vault.contains("ai_vault_cache_generation"));
     assert!(ai_vault.contains("fn read_claude_vault_hits("));
+    assert!(ai_vault.contains("struct ClaudeVaultIndex"));
+    assert!(ai_vault.contains("ai-vault-index.sqlite"));
+    assert!(ai_vault.contains("fn tail_claude_vault_file("));
+    assert!(ai_vault.contains("serde_json::from_slice::<ClaudeLogLine>(line)"));
     assert!(ai_vault.contains("fn read_codex_vault_hits("));
     assert!(ai_vault.contains("fn read_codex_vault_hits_via_state_db("));
     assert!(ai_vault.contains("fn read_codex_vault_hits_from_session_index("));
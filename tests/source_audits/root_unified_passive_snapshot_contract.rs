@@ -139,10 +139,7 @@ fn filtering_cache_freezes_passive_snapshot_hits_per_query_frame() {
         "same-query passive frames should reuse the frozen hit vectors"
     );
     assert!(
-        filtering_cache.contains("search_root_notes_meta_cached(")
-            && filtering_cache.contains("search_root_clipboard_history_meta_cached(")
-            && filtering_cache.contains("search_root_dictation_history_cached(")
-            && filtering_cache.contains("search_history_cached(")
+        filtering_cache.contains("search_root_passive_sources(")
             && filtering_cache.contains("search_root_browser_tabs_meta_cached(")
             && filtering_cache.contains("search_root_browser_history_meta_direct(")
             && filtering_cache.contains("&root_passive_frame.note_hits")
@@ -177,14 +174,16 @@ fn foreground_grouping_uses_cache_only_passive_sources() {
         .expect("root_passive_frame_for_current_query should exist");
 
     for required in [
-        "search_root_notes_meta_cached(",
-        "search_root_clipboard_history_meta_cached(",
-        "search_root_dictation_history_cached(",
-        "search_history_cached(",
+        "RootSearchIndexRequest",
+        "index_request.notes = Some(",
+        "index_request.clipboard_history = Some(",
+        "index_request.dictation_history = Some(",
+        "index_request.agent_chat_history = Some(",
+        "search_root_passive_sources(",
     ] {
         assert!(
             frame_fn.contains(required),
-            "root passive frame should use cache-only foreground source `{required}`"
+            "root passive frame should route implicit sources through the shared index: `{required}`"
         );
     }
 
@@ -203,40 +202,52 @@ fn foreground_grouping_uses_cache_only_passive_sources() {
 
 #[test]
 fn cold_passive_sources_warm_future_frames_without_publishing() {
+    let index = include_str!("../../src/root_search_index.rs");
     let notes = include_str!("../../src/notes/storage.rs");
     let agent_chat = include_str!("../../src/ai/agent_chat/ui/history.rs");
     let clipboard = include_str!("../../src/clipboard_history/cache.rs");
     let dictation = include_str!("../../src/dictation/history.rs");
 
-    for (source_name, source, cached_fn, warmer) in [
+    assert!(
+        index.contains("\"root-search-index\"") && !index.contains("cx.notify"),
+        "the shared index should rebuild partitions on a background thread"
+    );
+
+    for (source_name, source, feed_fn, warmer) in [
+        (
+            "root_search_index",
+            index,
+            "fn search_root_passive_sources(",
+            "root-search-index",
+        ),
         (
             "notes",
             notes,
-            "search_root_notes_meta_cached(",
-            "root-notes-search-cache",
+            "fn root_notes_index_generation(",
+            "fn load_root_notes_index_documents(",
         ),
         (
             "agent_chat_history",
             agent_chat,
-            "search_history_cached(",
+            "fn root_agent_chat_history_index_generation(",
             "root-agent_chat-history-cache",
         ),
         (
             "clipboard_history",
             clipboard,
-            "search_root_clipboard_history_meta_cached(",
+            "fn root_clipboard_history_index_generation(",
             "root-clipboard-history-cache",
         ),
         (
             "dictation_history",
             dictation,
-            "search_root_dictation_history_cached(",
+            "fn root_dictation_history_index_generation(",
             "root-dictation-history-cache",
         ),
     ] {
         assert!(
-            source.contains(cached_fn) && source.contains(warmer),
-            "{source_name} should expose a cache-only root search and background warmer"
+            source.contains(feed_fn) && source.contains(warmer),
+            "{source_name} should feed the root search index and warm off the UI thread"
         );
         assert!(
             !source.contains("invalidate_grouped_cache")
@@ -1,6 +1,7 @@
 #[test]
 fn root_passive_frame_times_every_passive_source() {
     let filtering = include_str!("../../src/app_impl/filtering_cache.rs");
+    let passive_sources = include_str!("../../src/app_impl/root_passive_sources.rs");
     let section = filtering
         .split("fn root_passive_frame_for_current_query(")
         .nth(1)
@@ -8,15 +9,17 @@ fn root_passive_frame_times_every_passive_source() {
         .expect("root_passive_frame_for_current_query should exist");
 
     assert!(
-        filtering.contains("fn timed_root_passive_source<T>("),
-        "passive-source timing helper should exist"
+        passive_sources.contains("fn run(self, query_len: usize) -> Option<RootPassiveSection>")
+            && passive_sources.contains("record_root_passive_source_latency("),
+        "every passive-source job should be timed into the latency histogram"
     );
     assert!(
-        filtering.contains("[PASSIVE_SOURCE_DONE]"),
+        passive_sources.contains("[PASSIVE_SOURCE_DONE]"),
         "passive-source timing logs should be parseable by benchmarks"
     );
 
     for source in [
+        "brain",
         "notes",
         "todo",
         "clipboard_history",
@@ -27,8 +30,8 @@ fn root_passive_frame_times_every_passive_source() {
         "browser_history",
     ] {
         assert!(
-            section.contains(&format!("\"{source}\"")),
-            "{source} should be timed in the root passive frame"
+            section.contains(&format!("RootPassiveSourceJob::new(\"{source}\"")),
+            "{source} should run as a timed passive-source job in the root passive frame"
         );
     }
 }
@@ -42,10 +45,10 @@ fn root_passive_frame_times_every_passive_source() {
 fn implicit_browser_history_uses_cached_lookup_on_typing_path() {
     let filtering = include_str!("../../src/app_impl/filtering_cache.rs");
     let section = filtering
-        .split("let browser_history_hits = timed_root_passive_source(")
+        .split("RootPassiveSourceJob::new(\"browser_history\"")
         .nth(1)
-        .and_then(|rest| rest.split("let frame = crate::RootPassiveFrame").next())
-        .expect("browser history passive branch should exist");
+        .and_then(|rest| rest.split("let job_count = jobs.len();").next())
+        .expect("browser history passive job should exist");
 
     assert!(
         section.contains("explicit_browser_history"),
@@ -97,13 +100,13 @@ fn cached_browser_history_lookup_is_nonblocking() {
 fn implicit_browser_tabs_uses_cached_lookup_on_typing_path() {
     let filtering = include_str!("../../src/app_impl/filtering_cache.rs");
     let section = filtering
-        .split("let browser_tab_hits =")
+        .split("RootPassiveSourceJob::new(\"browser_tabs\"")
         .nth(1)
         .and_then(|rest| {
-            rest.split("let browser_history_hits = timed_root_passive_source(")
+            rest.split("RootPassiveSourceJob::new(\"browser_history\"")
                 .next()
         })
-        .expect("browser tabs passive branch should exist");
+        .expect("browser tabs passive job should exist");
 
     assert!(
         section.contains("explicit_browser_tabs"),
@@ -330,3 +333,42 @@ fn implicit_browser_tabs_queries_start_app_managed_refresh_without_direct_lookup
         "app-managed warmup must not switch ordinary typing to direct foreground lookup"
     );
 }
+
+/// WHY: one slow explicit `*_direct` source used to delay every section.
+/// Sources fan out concurrently with a per-frame deadline, and stragglers
+/// patch into the same frame instead of invalidating it.
+#[test]
+fn root_passive_sources_fan_out_with_deadline_and_late_patching() {
+    let filtering = include_str!("../../src/app_impl/filtering_cache.rs");
+    let passive_sources = include_str!("../../src/app_impl/root_passive_sources.rs");
+    let render = include_str!("../../src/render_script_list/mod.rs");
+
+    assert!(
+        filtering.contains("self.fan_out_root_passive_sources_for_frame(&key, jobs)"),
+        "root passive frame should dispatch source jobs through the fan-out"
+    );
+    assert!(
+        passive_sources.contains("ROOT_PASSIVE_FRAME_DEADLINE")
+            && passive_sources.contains("rx.recv_timeout(remaining)"),
+        "fan-out should wait for sources only until the frame deadline"
+    );
+    let apply_late = passive_sources
+        .split("fn apply_root_passive_late_section(")
+        .nth(1)
+        .expect("late section patching should exist");
+    assert!(
+        apply_late.contains("&frame.key == key")
+            && apply_late.contains("self.invalidate_grouped_cache();")
+            && !apply_late.contains("self.root_passive_frame = None"),
+        "late sections should patch the matching frame without invalidating it"
+    );
+    assert!(
+        apply_late.contains("main_menu_selection_snapshot")
+            && apply_late.contains("reconcile_script_list_after_results_refresh"),
+        "late sections must use the shared identity-preserving reconcile"
+    );
+    assert!(
+        render.contains("self.start_root_passive_late_section_pump(cx);"),
+        "script list render should start delivering late passive sections"
+    );
+}
@@ -6,7 +6,7 @@
 
 use anyhow::Result;
 use script_kit_gpui::protocol::transaction_executor::{
-    execute_batch, execute_wait_for, TransactionStateProvider,
+    execute_batch, execute_wait_for, TransactionStateNotifier, TransactionStateProvider,
 };
 use script_kit_gpui::protocol::transaction_trace::{
     append_transaction_trace, read_latest_transaction_trace,
@@ -15,6 +15,8 @@ use script_kit_gpui::protocol::{
     BatchCommand, TransactionErrorCode, TransactionTrace, TransactionTraceMode,
     TransactionTraceStatus, UiStateSnapshot, WaitCondition, WaitNamedCondition,
 };
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
 
 // ── Fake provider ──────────────────────────────────────────────────────────
 
@@ -230,6 +232,126 @@ fn wait_for_on_failure_trace_absent_on_success() {
     );
 }
 
+/// Provider whose state is mutated from another thread and announced through
+/// a [`TransactionStateNotifier`].
+#[derive(Clone, Default)]
+struct NotifyingProvider {
+    snapshot: Arc<Mutex<UiStateSnapshot>>,
+    notifier: Arc<TransactionStateNotifier>,
+}
+
+impl NotifyingProvider {
+    fn update_later(
+        &self,
+        delay: Duration,
+        update: impl FnOnce(&mut UiStateSnapshot) + Send + 'static,
+    ) {
+        let snapshot = Arc::clone(&self.snapshot);
+        let notifier = Arc::clone(&self.notifier);
+        std::thread::spawn(move || {
+            std::thread::sleep(delay);
+            update(&mut snapshot.lock().unwrap());
+            notifier.notify_changed();
+        });
+    }
+}
+
+impl TransactionStateProvider for NotifyingProvider {
+    fn snapshot(&self) -> UiStateSnapshot {
+        self.snapshot.lock().unwrap().clone()
+    }
+
+    fn set_input(&mut self, text: &str) -> Result<()> {
+        self.snapshot.lock().unwrap().input_value = Some(text.to_string());
+        self.notifier.notify_changed();
+        Ok(())
+    }
+
+    fn select_by_value(&mut self, _value: &str, _submit: bool) -> Result<Option<String>> {
+        Ok(None)
+    }
+
+    fn select_by_semantic_id(
+        &mut self,
+        _semantic_id: &str,
+        _submit: bool,
+    ) -> Result<Option<String>> {
+        Ok(None)
+    }
+
+    fn state_notifier(&self) -> Option<&TransactionStateNotifier> {
+        Some(&self.notifier)
+    }
+}
+
+#[test]
+fn wait_for_wakes_on_state_change_instead_of_poll_interval() {
+    let mut provider = NotifyingProvider::default();
+    provider.update_later(Duration::from_millis(20), |snapshot| {
+        snapshot.window_visible = true;
+        snapshot.choice_count = 2;
+    });
+
+    let started = Instant::now();
+    let result = execute_wait_for(
+        &mut provider,
+        format!("wait-event-driven-{}", std::process::id()),
+        &WaitCondition::Named(WaitNamedCondition::ChoicesRendered),
+        Some(5_000),
+        Some(2_000),
+        TransactionTraceMode::On,
+    )
+    .expect("waitFor should complete");
+
+    assert!(result.success);
+    assert!(
+        started.elapsed() < Duration::from_millis(1_000),
+        "waitFor should wake on the change, not after the 2s poll interval"
+    );
+    let trace = result.trace.expect("trace mode on");
+    assert_eq!(
+        trace.commands[0].polls.len(),
+        2,
+        "one observation before the change and one after it"
+    );
+}
+
+#[test]
+fn wait_for_polls_record_replayable_deltas() {
+    let mut provider = NotifyingProvider::default();
+    provider.update_later(Duration::from_millis(10), |snapshot| {
+        snapshot.input_value = Some("app".to_string());
+    });
+    provider.update_later(Duration::from_millis(30), |snapshot| {
+        snapshot.input_value = None;
+        snapshot.window_focused = true;
+    });
+
+    let result = execute_wait_for(
+        &mut provider,
+        format!("wait-deltas-{}", std::process::id()),
+        &WaitCondition::Named(WaitNamedCondition::WindowFocused),
+        Some(5_000),
+        None,
+        TransactionTraceMode::On,
+    )
+    .expect("waitFor should complete");
+
+    assert!(result.success);
+    let command = &result.trace.expect("trace mode on").commands[0];
+    let mut replayed = command.before.clone();
+    for poll in &command.polls {
+        assert_eq!(
+            poll.snapshot,
+            UiStateSnapshot::default(),
+            "polls should not clone full snapshots"
+        );
+        replayed.apply_delta(poll.delta.as_ref().expect("poll delta"));
+    }
+    assert_eq!(replayed, command.after);
+    assert_eq!(replayed.input_value, None);
+}
+
 // ── batch tests ────────────────────────────────────────────────────────────
 
 #[test]